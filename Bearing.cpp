@@ -902,6 +902,7 @@ double BearingHeading(char *dxCallPrefix) {
   float deltaLong;  // For radians conversion
   float x, y;       // Temporary variables
 
+  DisplayInvalidate();                       // The map covers the waterfall
   countryIndex = FindCountry(dxCallPrefix);  // do coutry lookup
 
   if (countryIndex != -1) {              // Did we find prefix??
@@ -238,7 +238,7 @@ void ButtonZoom() {
     void
 *****/
 void ButtonFilter() {
-  switchFilterSideband = !switchFilterSideband;
+  switchFilterSideband = (switchFilterSideband + 1) % 3;    // Low edge, high edge, FILTER_SHIFT
   ControlFilterF();
   FilterBandwidth();
   SetFreq();
@@ -292,6 +292,7 @@ void ButtonMode()  //====== Changed AFP 10-05-22  =================
   //fLoCutOld = bands[currentBand].FLoCut;
   //fHiCutOld = bands[currentBand].FHiCut;
 
+  DisplayInvalidate();
   tft.fillWindow();
   DrawSpectrumDisplayContainer();
   DrawFrequencyBarValue();
@@ -2,6 +2,10 @@
 #include "SDT.h"
 #endif
 
+float32_t DMAMEM cwDecodeI[256];      // The decoder works on 256 samples, the low-latency path gathers them here
+float32_t DMAMEM cwDecodeQ[256];
+uint32_t cwDecodeFill = 0;
+
 //=================  AFP10-18-22 ================
 /*****
   Purpose: Select CW Filter. CWFilterIndex has these values:
@@ -27,7 +31,9 @@ void SelectCWFilter()
 }
 //=================  AFP10-18-22 ================
 /*****
-  Purpose: to process CW specific signals
+  Purpose: to process CW specific signals. The decoder needs 256 samples at a time; when the
+           low-latency path runs shorter blocks they are collected in cwDecodeI/Q and the
+           decoder runs once every 256 samples, as it always has.
 
   Paramter list:
     void
@@ -39,13 +45,41 @@ void SelectCWFilter()
 void DoCWReceiveProcessing() {  // All New AFP 09-19-22
   float goertzelMagnitude1;
   float goertzelMagnitude2;
+  float32_t *I_in = float_buffer_L;
+  float32_t *Q_in = float_buffer_R;
+  uint32_t mark;
+  float32_t *float_buffer_L_CW;
+  float32_t *float_buffer_R_CW;
+  float32_t *float_Corr_BufferL;
+  float32_t *float_Corr_BufferR;
+
+  if (BUF_N_DF < 256) {
+    arm_copy_f32(float_buffer_L, &cwDecodeI[cwDecodeFill], BUF_N_DF);
+    arm_copy_f32(float_buffer_R, &cwDecodeQ[cwDecodeFill], BUF_N_DF);
+    cwDecodeFill += BUF_N_DF;
+    if (cwDecodeFill < 256) {
+      return;
+    }
+    cwDecodeFill = 0;
+    I_in = cwDecodeI;
+    Q_in = cwDecodeQ;
+  }
+  mark = ScratchMark();
+  float_buffer_L_CW = ScratchAlloc(256);
+  float_buffer_R_CW = ScratchAlloc(256);
+  float_Corr_BufferL = ScratchAlloc(511);
+  float_Corr_BufferR = ScratchAlloc(511);
+  if (float_Corr_BufferR == NULL) {               // Scratch arena full, skip this block
+    ScratchRelease(mark);
+    return;
+  }
   //arm_copy_f32(float_buffer_L, float_buffer_L_CW, 256);
   //arm_copy_f32(float_buffer_R, float_buffer_R_CW, 256);
   //arm_biquad_cascade_df2T_f32(&S1_CW_Filter, float_buffer_R, float_buffer_R_CW, 256);//AFP 09-01-22
   //arm_biquad_cascade_df2T_f32(&S1_CW_Filter, float_buffer_L, float_buffer_L_CW, 256);//AFP 09-01-22
 
-  arm_fir_f32(&FIR_CW_DecodeL, float_buffer_L, float_buffer_L_CW, 256); // AFP 10-25-22  Park McClellan FIR filter const Group delay
- arm_fir_f32(&FIR_CW_DecodeR, float_buffer_R, float_buffer_R_CW, 256);  // AFP 10-25-22
+  arm_fir_f32(&FIR_CW_DecodeL, I_in, float_buffer_L_CW, 256); // AFP 10-25-22  Park McClellan FIR filter const Group delay
+ arm_fir_f32(&FIR_CW_DecodeR, Q_in, float_buffer_R_CW, 256);  // AFP 10-25-22
 
   if (decoderFlag == DECODE_ON) {                  // AFP 09-27-22
 
@@ -72,20 +106,26 @@ void DoCWReceiveProcessing() {  // All New AFP 09-19-22
     //Combine Correlation and Gowetzel Coefficients
     combinedCoeff = 10 * aveCorrResult * 100 * goertzelMagnitude;
     combinedCoeff2 = combinedCoeff;
-    // ==========  Changed CW decode "lock" indicator
+    // ==========  Changed CW decode "lock" indicator, drawn through the display queue
     if (combinedCoeff > 50) {   // AFP 10-26-22
-      tft.fillRect(745, 448,  15 , 15, RA8875_GREEN);
+      cwLockState = 1;
     }
     else if (combinedCoeff < 50) {   // AFP 10-26-22
       CWLevelTimer = millis();
       if (CWLevelTimer - CWLevelTimerOld > 2000) {
         CWLevelTimerOld = millis();
-        tft.fillRect(744, 447,  17 , 17, RA8875_BLACK);
+        cwLockState = 0;
       }
     }
+    if (cwLockState != cwLockPosted && decoderFlag == DECODE_ON) {
+      if (cwLockState == 1) {
+        DisplayQueueFillRect(DISPLAY_KEY_CW_LOCK, 745, 448, 15, 15, RA8875_GREEN);
+      } else {
+        DisplayQueueFillRect(DISPLAY_KEY_CW_LOCK, 744, 447, 17, 17, RA8875_BLACK);
+      }
+      cwLockPosted = cwLockState;
+    }
     combinedCoeff2Old = combinedCoeff2;
-    tft.drawFastVLine(BAND_INDICATOR_X - 8 + 25, AUDIO_SPECTRUM_BOTTOM - 118, 118, RA8875_GREEN); //CW lower freq indicator
-    tft.drawFastVLine(BAND_INDICATOR_X - 8 + 35, AUDIO_SPECTRUM_BOTTOM - 118, 118, RA8875_GREEN); //CW upper freq indicator
     if (combinedCoeff > 50) { // if  have a reasonable corr coeff, >50, then we have a keeper. // AFP 10-26-22
       audioTemp = 1;
     } else {
@@ -94,6 +134,7 @@ void DoCWReceiveProcessing() {  // All New AFP 09-19-22
     //==============  acquire data on CW  ================
     DoCWDecoding(audioTemp);
   }
+  ScratchRelease(mark);
 }
 
 /*****
@@ -273,7 +314,8 @@ void SetKeyType()
 //==================================== Decoder =================
 
 /*****
-  Purpose: This function displays the decoded Morse code below waterfall. Arranged as:
+  Purpose: This function adds a decoded character to the decode buffer. The buffer is shown below the
+           waterfall by UpdateDecodeDisplay(), since this runs in the DSP task.
 
   Parameter list:
     char currentLetter
@@ -294,11 +336,80 @@ void MorseCharacterDisplay(char currentLetter)
     decodeBuffer[col - 1] = currentLetter;                                  // Add to end
     decodeBuffer[col] = '\0';                                               // Make is a string
   }
+  DisplayQueueValue(DISPLAY_CMD_CW_TEXT, DISPLAY_KEY_CW_TEXT, 0);           // ShowDecodedText() copies the buffer
+}
+
+/*****
+  Purpose: Draw the CW filter lines on the audio spectrum while the decoder is on. The decoder's
+           own output comes through the display queue, see DisplayQueue.cpp. Called once per
+           display frame from ShowSpectrum().
+
+  Parameter list:
+    void
+
+  Return value
+    void
+*****/
+void UpdateDecodeDisplay()
+{
+  if (decoderFlag != DECODE_ON) {
+    return;
+  }
+  tft.drawFastVLine(BAND_INDICATOR_X - 8 + 25, AUDIO_SPECTRUM_BOTTOM - 118, 118, RA8875_GREEN); //CW lower freq indicator
+  tft.drawFastVLine(BAND_INDICATOR_X - 8 + 35, AUDIO_SPECTRUM_BOTTOM - 118, 118, RA8875_GREEN); //CW upper freq indicator
+}
+
+/*****
+  Purpose: Show the decoded text. Drawn from the display queue after MorseCharacterDisplay() adds
+           a character.
+
+  Parameter list:
+    void
+
+  Return value
+    void
+*****/
+void ShowDecodedText()
+{
+  char text[sizeof(decodeBuffer)];
+
+  if (decoderFlag != DECODE_ON) {
+    return;
+  }
+  DSPNoInterrupts();                                                        // Don't let the decoder slide the buffer mid-copy
+  memcpy(text, decodeBuffer, sizeof(text));
+  DSPInterrupts();
+  text[sizeof(text) - 1] = '\0';
   tft.fillRect(CW_TEXT_START_X, CW_TEXT_START_Y, CW_MESSAGE_WIDTH, CW_MESSAGE_HEIGHT * 2, RA8875_BLACK);
   tft.setFontScale( (enum RA8875tsize) 1);
   tft.setTextColor(RA8875_WHITE);
   tft.setCursor(CW_TEXT_START_X, CW_TEXT_START_Y);
-  tft.print(decodeBuffer);
+  tft.print(text);
+}
+
+/*****
+  Purpose: Show the decoder's estimate of the sending speed. Drawn from the display queue.
+
+  Parameter list:
+    long wpm
+
+  Return value
+    void
+*****/
+void ShowWPMEstimate(long wpm)
+{
+  if (decoderFlag != DECODE_ON) {
+    return;
+  }
+  tft.setFontScale( (enum RA8875tsize) 0);                                  // Show estimated WPM
+  tft.setTextColor(RA8875_GREEN);
+  tft.fillRect(DECODER_X + 104, DECODER_Y, tft.getFontWidth() * 10, tft.getFontHeight(), RA8875_BLACK);
+  tft.setCursor(DECODER_X + 105, DECODER_Y);
+  tft.print("(");
+  tft.print(wpm);
+  tft.print(" WPM)");
+  tft.setTextColor(RA8875_WHITE);
+  tft.setFontScale( (enum RA8875tsize) 3);
 }
 
 
@@ -394,6 +505,7 @@ void DrawSignalPlotFrame()
 {
   int offset;
   float val = 0.0;
+  WaterfallScrollReset();                             // The plot is drawn where the waterfall scrolls
   tft.fillRect(WATERFALL_LEFT_X, FIRST_WATERFALL_LINE - 5, MAX_WATERFALL_WIDTH + 10, MAX_WATERFALL_ROWS + 30, RA8875_BLACK);
 
   tft.setFontScale(0);
@@ -495,15 +607,7 @@ void DoCWDecoding(int audioValue)
       MorseCharacterDisplay(bigMorseCodeTree[currentDecoderIndex]);
       if (gapLength > ditLength * 4.5) {      // good over 15WPM on W1AW; no Fransworth
         MorseCharacterDisplay(' ');
-        tft.setFontScale( (enum RA8875tsize) 0);                        // Show estimated WPM
-        tft.setTextColor(RA8875_GREEN);
-        tft.fillRect(DECODER_X + 104, DECODER_Y, tft.getFontWidth() * 10, tft.getFontHeight(), RA8875_BLACK);
-        tft.setCursor(DECODER_X + 105, DECODER_Y);
-        tft.print("(");
-        tft.print(1200L / (dahLength / 3));
-        tft.print(" WPM)");
-        tft.setTextColor(RA8875_WHITE);
-        tft.setFontScale( (enum RA8875tsize) 3);
+        DisplayQueueValue(DISPLAY_CMD_CW_WPM, DISPLAY_KEY_CW_WPM, 1200L / (dahLength / 3));   // Estimated WPM
       }
       currentDecoderIndex = 0;                    //Reset everything if char or word
       currentDashJump     = DECODER_BUFFER_SIZE;
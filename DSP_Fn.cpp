@@ -434,15 +434,15 @@ void AGC()
   float32_t mult;
   if (AGCMode == 0)  // AGC OFF
   {
-    for (unsigned i = 0; i < FFT_length / 2; i++)
+    for (unsigned i = 0; i < BUF_N_DF; i++)
     {
-      iFFT_buffer[FFT_length + 2 * i + 0] = fixed_gain * iFFT_buffer[FFT_length + 2 * i + 0];
-      iFFT_buffer[FFT_length + 2 * i + 1] = fixed_gain * iFFT_buffer[FFT_length + 2 * i + 1];
+      convOutput[2 * i + 0] = fixed_gain * convOutput[2 * i + 0];
+      convOutput[2 * i + 1] = fixed_gain * convOutput[2 * i + 1];
     }
     return;
   }
 
-  for (unsigned i = 0; i < FFT_length / 2; i++)
+  for (unsigned i = 0; i < BUF_N_DF; i++)
   {
     if (++out_index >= (int)ring_buffsize)
       out_index -= ring_buffsize;
@@ -452,8 +452,8 @@ void AGC()
     out_sample[0] = ring[2 * out_index + 0];
     out_sample[1] = ring[2 * out_index + 1];
     abs_out_sample = abs_ring[out_index];
-    ring[2 * in_index + 0] = iFFT_buffer[FFT_length + 2 * i + 0];
-    ring[2 * in_index + 1] = iFFT_buffer[FFT_length + 2 * i + 1];
+    ring[2 * in_index + 0] = convOutput[2 * i + 0];
+    ring[2 * in_index + 1] = convOutput[2 * i + 1];
     if (pmode == 0) // MAGNITUDE CALCULATION
       abs_ring[in_index] = max(fabs(ring[2 * in_index + 0]), fabs(ring[2 * in_index + 1]));
     else
@@ -571,8 +571,8 @@ void AGC()
     //#else
     //  mult = (out_target - slope_constant * min (0.0, log10f(inv_max_input * volts))) / volts;
     //#endif
-    iFFT_buffer[FFT_length + 2 * i + 0] = out_sample[0] * mult;
-    iFFT_buffer[FFT_length + 2 * i + 1] = out_sample[1] * mult;
+    convOutput[2 * i + 0] = out_sample[0] * mult;
+    convOutput[2 * i + 1] = out_sample[1] * mult;
   }
 }
 
@@ -588,9 +588,9 @@ void AGC()
     void
 *****/
 void DecodeIQ() {
-  for (unsigned i = 0; i < FFT_length / 2; i++) {
-    float_buffer_L[i] = iFFT_buffer[FFT_length + i * 2];
-    float_buffer_R[i] = iFFT_buffer[FFT_length + i * 2 + 1];
+  for (unsigned i = 0; i < BUF_N_DF; i++) {
+    float_buffer_L[i] = convOutput[i * 2];
+    float_buffer_R[i] = convOutput[i * 2 + 1];
   }
 }
 
@@ -0,0 +1,183 @@
+#ifndef BEENHERE
+#include "SDT.h"
+#endif
+
+/**********************************************************************************
+  Complex half-band decimator
+
+  Takes the 192 kHz I/Q stream down to 24 kHz in three half-band stages of 2. The old chain
+  ran arm_fir_decimate_f32() by 4 then by 2, once for I and once for Q, and recomputed the
+  filters each time the bandwidth changed. Here I and Q go through each stage together, so each
+  coefficient is loaded once for both channels. Only the output samples are computed. In a
+  half-band filter every other tap is zero and the rest are symmetric, so an output costs
+  (numTaps + 1) / 4 multiplies per channel plus the center tap.
+
+  The passband is fixed at the widest filter the receiver offers, and the filter mask does the
+  actual band limiting, so nothing needs redesigning when the bandwidth changes. InitDecimator()
+  sizes each stage from the requested stopband attenuation. Lower attenuation means fewer taps,
+  which is the tap count/attenuation trade-off.
+**********************************************************************************/
+
+struct decimator rxDecimator;
+struct decimator txDecimator;
+DMAMEM float32_t rxResampleWork[2 * (2048 + DEC_MAX_TAPS)];   // Interleaved I/Q, BUFFER_SIZE * N_BLOCKS plus history
+DMAMEM float32_t txResampleWork[2 * (2048 + DEC_MAX_TAPS)];   // Shared by each side's decimator and interpolator
+
+/*****
+  Purpose: Number of taps a half-band stage needs for a given passband and stopband attenuation,
+           using the Kaiser estimate, rounded up to the 4k + 3 form a half-band filter needs
+
+  Parameter list:
+    float32_t att           stopband attenuation, dB
+    float32_t passband      passband edge, Hz
+    float32_t rate          input sample rate, Hz
+
+  Return value;
+    int                     tap count, at most DEC_MAX_TAPS
+*****/
+int HalfBandTaps(float32_t att, float32_t passband, float32_t rate)
+{
+  float32_t transition = (rate / 2.0 - 2.0 * passband) / rate;   // Stopband starts at rate / 2 - passband
+  int taps = (int)ceilf((att - 7.95) / (14.36 * transition)) + 1;
+
+  taps = (taps / 4) * 4 + 3;
+  if (taps > DEC_MAX_TAPS) {
+    taps = DEC_MAX_TAPS;
+  }
+  return taps;
+}
+
+/*****
+  Purpose: Design one half-band stage, a Kaiser windowed sinc with its cutoff at a quarter of the
+           input rate, and clear its history. Only the nonzero side taps are stored, nearest the
+           center first. They are scaled so the DC gain is exactly 1.
+
+  Parameter list:
+    struct halfBandStage *stage
+    int numTaps             4k + 3
+    float32_t att           stopband attenuation, dB, sets the window shape
+
+  Return value;
+    void
+*****/
+void InitHalfBandStage(struct halfBandStage *stage, int numTaps, float32_t att)
+{
+  int middle = (numTaps - 1) / 2;
+  float32_t beta;
+  float32_t izb;
+  float32_t x;
+  float32_t sum = 0.0;
+
+  if (att >= 50.0) {
+    beta = 0.1102 * (att - 8.71);
+  } else {
+    beta = 0.5842 * powf((att - 20.96), 0.4) + 0.07886 * (att - 20.96);
+  }
+  izb = Izero(beta);
+
+  stage->numTaps = numTaps;
+  for (int k = 0; k < (numTaps + 1) / 4; k++) {
+    int d = 2 * k + 1;                                    // Offset from the center tap
+    x = (float32_t)d / middle;
+    stage->coeffs[k] = ((k & 1) ? -1.0 : 1.0) / (PI * d) * Izero(beta * sqrtf(1.0 - x * x)) / izb;
+    sum += 2.0 * stage->coeffs[k];
+  }
+  for (int k = 0; k < (numTaps + 1) / 4; k++) {
+    stage->coeffs[k] *= 0.5 / sum;                        // Side taps sum to 0.5, center tap is 0.5
+  }
+  memset(stage->history, 0, sizeof(stage->history));
+}
+
+/*****
+  Purpose: Set up a three stage decimate-by-8 chain
+
+  Parameter list:
+    struct decimator *dec
+    float32_t *work         interleaved scratch, 2 * (2048 + DEC_MAX_TAPS) floats
+    float32_t att           stopband attenuation, dB
+    float32_t passband      widest signal to keep, Hz
+    float32_t rate          input sample rate, Hz
+
+  Return value;
+    void
+*****/
+void InitDecimator(struct decimator *dec, float32_t *work, float32_t att, float32_t passband, float32_t rate)
+{
+  dec->work = work;
+  for (int i = 0; i < DEC_STAGES; i++) {
+    InitHalfBandStage(&dec->stage[i], HalfBandTaps(att, passband, rate), att);
+#ifdef DEBUG
+    Serial.printf("Decimator stage %d: %d taps at %.0f Hz\n", i + 1, dec->stage[i].numTaps, rate);
+#endif
+    rate /= 2.0;
+  }
+}
+
+/*****
+  Purpose: Run one half-band stage. The input is copied, interleaved, behind the stage history so
+           every output can be computed from one buffer, then the newest numTaps - 1 inputs are
+           kept as history for the next block. Output may overwrite input.
+
+  Parameter list:
+    struct halfBandStage *stage
+    float32_t *work         interleaved scratch
+    float32_t *I_in         blockSize samples
+    float32_t *Q_in
+    float32_t *I_out        blockSize / 2 samples
+    float32_t *Q_out
+    uint32_t blockSize      even
+
+  Return value;
+    void
+*****/
+FASTRUN void HalfBandDecimate(struct halfBandStage *stage, float32_t *work, float32_t *I_in, float32_t *Q_in, float32_t *I_out, float32_t *Q_out, uint32_t blockSize)
+{
+  int historySize = 2 * (stage->numTaps - 1);
+  int sideTaps = (stage->numTaps + 1) / 4;
+  int middle = (stage->numTaps - 1) / 2;
+  const float32_t *h = stage->coeffs;
+  const float32_t center = 0.5;
+  float32_t *in = &work[historySize];
+  float32_t accI, accQ;
+
+  memcpy(work, stage->history, historySize * sizeof(float32_t));
+  for (unsigned i = 0; i < blockSize; i++) {
+    in[2 * i]     = I_in[i];
+    in[2 * i + 1] = Q_in[i];
+  }
+
+  for (unsigned m = 0; m < blockSize / 2; m++) {
+    const float32_t *x = &work[2 * (2 * m + middle)];    // Center tap
+    accI = center * x[0];
+    accQ = center * x[1];
+    for (int k = 0; k < sideTaps; k++) {
+      int d = 2 * (2 * k + 1);
+      accI += h[k] * (x[-d] + x[d]);
+      accQ += h[k] * (x[1 - d] + x[1 + d]);
+    }
+    I_out[m] = accI;
+    Q_out[m] = accQ;
+  }
+
+  memcpy(stage->history, &work[2 * blockSize], historySize * sizeof(float32_t));
+}
+
+/*****
+  Purpose: Decimate an I/Q block by 8, in place
+
+  Parameter list:
+    struct decimator *dec
+    float32_t *I_buffer     blockSize samples in, blockSize / 8 out
+    float32_t *Q_buffer
+    uint32_t blockSize      multiple of 8
+
+  Return value;
+    void
+*****/
+FASTRUN void Decimate(struct decimator *dec, float32_t *I_buffer, float32_t *Q_buffer, uint32_t blockSize)
+{
+  for (int i = 0; i < DEC_STAGES; i++) {
+    HalfBandDecimate(&dec->stage[i], dec->work, I_buffer, Q_buffer, I_buffer, Q_buffer, blockSize);
+    blockSize /= 2;
+  }
+}
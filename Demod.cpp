@@ -16,26 +16,22 @@
   // http://svn.tapr.org/repos_sdr_hpsdr/trunk/W5WC/PowerSDR_HPSDR_mRX_PS/Source/wdsp/
 *****/
 void AMDecodeSAM() {
+  static int32_t offsetPosted = INT32_MIN;
+  int32_t offsetTenths;
+
   // taken from Warren Pratt´s WDSP, 2016
   // http://svn.tapr.org/repos_sdr_hpsdr/trunk/W5WC/PowerSDR_HPSDR_mRX_PS/Source/wdsp/
   // http://svn.tapr.org/repos_sdr_hpsdr/trunk/W5WC/PowerSDR_HPSDR_mRX_PS/Source/wdsp/
   //phzerror = 0;
-  tft.setFontScale( (enum RA8875tsize) 0);
-  tft.fillRect(OPERATION_STATS_X + 160, FREQUENCY_Y + 30, tft.getFontWidth() * 11, tft.getFontHeight(), RA8875_BLUE);        // AFP 11-01-22 Clear top-left menu area
-  tft.setCursor(OPERATION_STATS_X + 160, FREQUENCY_Y + 30);   // AFP 11-01-22
-  tft.setTextColor(RA8875_WHITE);
-  // tft.fill//Rect(OPERATION_STATS_X + 155, FREQUENCY_Y + 30, tft.getFontWidth() * 11, tft.getFontHeight(), RA8875_BLUE);
-    tft.print("(SAM) ");  //AFP 11-01-22
-  for (unsigned i = 0; i < FFT_length / 2 ; i++)
+  for (unsigned i = 0; i < BUF_N_DF ; i++)
   {
     float32_t Sin, Cos;
-    Sin = arm_sin_f32(phzerror);
-    Cos = arm_cos_f32(phzerror);
+    FastSinCos(phzerror, &Sin, &Cos);
 
-    ai = Cos * iFFT_buffer[FFT_length + i * 2];
-    bi = Sin * iFFT_buffer[FFT_length + i * 2];
-    aq = Cos * iFFT_buffer[FFT_length + i * 2 + 1];
-    bq = Sin * iFFT_buffer[FFT_length + i * 2 + 1];
+    ai = Cos * convOutput[i * 2];
+    bi = Sin * convOutput[i * 2];
+    aq = Cos * convOutput[i * 2 + 1];
+    bq = Sin * convOutput[i * 2 + 1];
 
     corr[0] = +ai + bq;
     corr[1] = -bi + aq;
@@ -59,7 +55,7 @@ void AMDecodeSAM() {
       audiou = audiou + dc_insertu - dcu;
     }
     float_buffer_R[i] = audiou;
-    det = ApproxAtan2(corr[1], corr[0]);
+    det = FastAtan2(corr[1], corr[0]);
 
     del_out = fil_out;
     omega2 = omega2 + g2 * det;
@@ -88,69 +84,32 @@ void AMDecodeSAM() {
   SAM_carrier_freq_offset=0.9*SAM_carrier_freq_offsetOld+0.1*SAM_carrier_freq_offset;
   //            SAM_display_count = 0;
   SAM_lowpass = SAM_carrier;
+  SAM_carrier_freq_offsetOld=SAM_carrier_freq_offset;
 
-  if (SAM_carrier_freq_offset != SAM_carrier_freq_offsetOld) {
-    tft.fillRect(OPERATION_STATS_X + 200, FREQUENCY_Y + 30, tft.getFontWidth() * 8, tft.getFontHeight(), RA8875_BLUE);
-    tft.print(0.20024*SAM_carrier_freq_offset, 1); //AFP 11-01-22
+  offsetTenths = lroundf(2.0024 * SAM_carrier_freq_offset);   // 0.20024 Hz a unit, shown to one decimal place
+  if (offsetTenths != offsetPosted) {                           // Drawn by ShowSAMOffset() through the display queue
+    DisplayQueueValue(DISPLAY_CMD_SAM_OFFSET, DISPLAY_KEY_SAM_OFFSET, offsetTenths);
+    offsetPosted = offsetTenths;
   }
-  SAM_carrier_freq_offsetOld=SAM_carrier_freq_offset;
 }
 
-/*****  AFP 11-03-22
-  Purpose: ApproxAtan2
+/*****
+  Purpose: Show the SAM carrier offset computed by AMDecodeSAM(). Drawn from the display queue,
+           which AMDecodeSAM() posts to only when the shown value changes.
   Parameter list:
-    void
+    int32_t offsetTenths    tenths of a Hz
   Return value;
     void
 *****/
-float ApproxAtan2(float y, float x)
+void ShowSAMOffset(int32_t offsetTenths)
 {
-  if (x != 0.0f)
-  {
-    if (fabsf(x) > fabsf(y))
-    {
-      const float z = y / x;
-      if (x > 0.0f)
-      {
-        // atan2(y,x) = atan(y/x) if x > 0
-        return ApproxAtan(z);
-      }
-      else if (y >= 0.0f)
-      {
-        // atan2(y,x) = atan(y/x) + PI if x < 0, y >= 0
-        return ApproxAtan(z) + PI;
-      }
-      else
-      {
-        // atan2(y,x) = atan(y/x) - PI if x < 0, y < 0
-        return ApproxAtan(z) - PI;
-      }
-    }
-    else // Use property atan(y/x) = PI/2 - atan(x/y) if |y/x| > 1.
-    {
-      const float z = x / y;
-      if (y > 0.0f)
-      {
-        // atan2(y,x) = PI/2 - atan(x/y) if |y/x| > 1, y > 0
-        return -ApproxAtan(z) + TPI;
-      }
-      else
-      {
-        // atan2(y,x) = -PI/2 - atan(x/y) if |y/x| > 1, y < 0
-        return -ApproxAtan(z) - TPI;
-      }
-    }
-  }
-  else
-  {
-    if (y > 0.0f) // x = 0, y > 0
-    {
-      return TPI;
-    }
-    else if (y < 0.0f) // x = 0, y < 0
-    {
-      return -TPI;
-    }
+  if (bands[currentBandA].mode != DEMOD_SAM) {
+    return;
   }
-  return 0.0f; // x,y = 0. Could return NaN instead.
+  char buff[WIDGET_TEXT_MAX + 1];
+
+  tft.setFontScale( (enum RA8875tsize) 0);
+  snprintf(buff, sizeof(buff), "(SAM) %.1f", offsetTenths / 10.0);   //AFP 11-01-22
+  WidgetText(WIDGET_DEMOD, OPERATION_STATS_X + 160, FREQUENCY_Y + 30, 11, RA8875_WHITE, RA8875_BLUE, buff);   // BandInformation() leaves it while the background is blue
 }
+
@@ -18,6 +18,11 @@ const uint16_t gradient[] = {
 };
 
 uint16_t waterfall[MAX_WATERFALL_WIDTH];
+volatile int spectrumRedrawAll = 1;                                              // Set when the spectrum or audio plots were cleared
+int16_t traceTop[MAX_WATERFALL_WIDTH];                                           // Rows of the trace on the screen, TRACE_UNKNOWN if not known
+int16_t traceBottom[MAX_WATERFALL_WIDTH];
+int16_t audioShown[AUDIO_SPECTRUM_PIXELS];                                       // Audio bar heights on the screen
+int waterfallScrollTop = 0;                                                      // Waterfall row at the top of the scroll window
 
 
 /*****
@@ -29,6 +34,7 @@ uint16_t waterfall[MAX_WATERFALL_WIDTH];
     void
 *****/
 void DrawAudioSpectContainer() {
+  spectrumRedrawAll = 1;
   tft.drawRect(BAND_INDICATOR_X - 9 , SPECTRUM_BOTTOM - 118, 255, 118, RA8875_GREEN);
   for (int k = 0; k < 6; k++) {
         tft.drawFastVLine(BAND_INDICATOR_X - 10 + k * 43.8, SPECTRUM_BOTTOM, 15, RA8875_GREEN);
@@ -62,14 +68,137 @@ void ShowName()
   tft.print(VERSION);
 }
 
+/*****
+  Purpose: Screen rows of the trace segment in one panadapter column, joining the previous
+           column's point to this one's
+
+  Parameter list:
+    const int16_t *pixelnew
+    int x1                  column, 1 or more
+    int16_t *top            first row
+    int16_t *bottom         last row
+
+  Return value;
+    void
+*****/
+void TraceRows(const int16_t *pixelnew, int x1, int16_t *top, int16_t *bottom)
+{
+  int y  = spectrumNoiseFloor - constrain(pixelnew[x1], 0, base_y);
+  int y1 = spectrumNoiseFloor - constrain(pixelnew[x1 - 1], 0, base_y);
+
+  *top    = min(y, y1);
+  *bottom = max(y, y1);
+}
+
+/*****
+  Purpose: Redraw a run of panadapter columns whose trace changed. One black rectangle clears the
+           rows the old trace used in all of them, then the new trace and the hold pixels are
+           drawn column by column.
+
+  Parameter list:
+    const struct spectrumFrame *frame
+    int start               first column of the run
+    int end                 one past the last column
+    int drawTrace           0 to clear the run without drawing a trace
+
+  Return value;
+    void
+*****/
+void SpectrumRunDraw(const struct spectrumFrame *frame, int start, int end, int drawTrace)
+{
+  int eraseStart  = start;
+  int eraseTop    = SPECTRUM_TOP_Y + SPECTRUM_HEIGHT;         // Nothing to clear yet
+  int eraseBottom = 0;
+  int16_t top, bottom;
+
+  for (int x = start; x < end; x++) {
+    if (traceTop[x] == TRACE_UNKNOWN) {                       // Cleared by someone else, clear the whole plot
+      eraseStart  = max(start, SPECTRUM_LEFT_X);              // but leave the box edge alone
+      eraseTop    = SPECTRUM_TOP_Y + 1;
+      eraseBottom = SPECTRUM_TOP_Y + SPECTRUM_HEIGHT - 2;
+      break;
+    }
+    if (traceBottom[x] >= traceTop[x]) {
+      eraseTop    = min(eraseTop, traceTop[x]);
+      eraseBottom = max(eraseBottom, traceBottom[x]);
+    }
+  }
+  if (eraseBottom >= eraseTop && end > eraseStart) {
+    tft.fillRect(eraseStart, eraseTop, end - eraseStart, eraseBottom - eraseTop + 1, RA8875_BLACK);
+    DisplaySpiCount(SPI_BYTES_SHAPE);
+  }
+  for (int x = start; x < end; x++) {
+    top    = 0;                                               // No trace
+    bottom = -1;
+    if (drawTrace) {
+      TraceRows(frame->pixelnew, x, &top, &bottom);
+      tft.drawFastVLine(x, top, bottom - top + 1, RA8875_YELLOW);
+      DisplaySpiCount(SPI_BYTES_SHAPE);
+    }
+    traceTop[x]    = top;
+    traceBottom[x] = bottom;
+    if (eraseBottom >= eraseTop) {
+      SpectrumHoldDraw(frame, x, min((int)top, eraseTop), max((int)bottom, eraseBottom), top, bottom);
+    } else {
+      SpectrumHoldDraw(frame, x, top, bottom, top, bottom);
+    }
+  }
+}
+
+/*****
+  Purpose: Bring one audio spectrum bar to its new height, drawing only the part that changed
+
+  Parameter list:
+    int x1                  column, less than AUDIO_SPECTRUM_PIXELS
+    int bar                 height in pixels
+
+  Return value;
+    int                     1 if anything was drawn
+*****/
+int AudioBarDraw(int x1, int bar)
+{
+  int x      = BAND_INDICATOR_X - 8 + x1;
+  int bottom = AUDIO_SPECTRUM_BOTTOM - 4;                     // Lowest row of a bar
+  int shown  = audioShown[x1];
+
+  if (shown == bar) {
+    return 0;
+  }
+  if (shown == TRACE_UNKNOWN) {
+    tft.drawFastVLine(x, SPECTRUM_BOTTOM - 116, 115, RA8875_BLACK);
+    DisplaySpiCount(SPI_BYTES_SHAPE);
+    shown = 0;
+  }
+  if (bar != shown) {
+    DisplaySpiCount(SPI_BYTES_SHAPE);
+  }
+  if (bar > shown) {
+    tft.drawFastVLine(x, bottom - bar + 1, bar - shown, RA8875_MAGENTA);
+  } else if (bar < shown) {
+    tft.drawFastVLine(x, bottom - shown + 1, shown - bar, RA8875_BLACK);
+  }
+  audioShown[x1] = bar;
+  return 1;
+}
+
 FASTRUN                                     // Place in tightly-coupled memory
 /*****
   Purpose: Show Spectrum display
-            Note that this routine calls the Audio process Function during each display cycle,
-            for each of the 512 display frequency bins.  This means that the audio is refreshed at the maximum rate
-            and does not have to wait for the display to complete drawinf the full spectrum.
-            However, the display data are only updated ONCE during each full display cycle,
-            ensuring consistent data for the erase/draw cycle at each frequency point.
+            The receive audio runs in the DSP task (DSPTimerISR()), independent of this routine. Each time
+            a frame is due, at the rate FramePacer.cpp sets, and the DSP has room it publishes one frame
+            of display data (panadapter, audio spectrum) through the spectrumFrames[] ring. This routine
+            waits for the next frame, polling the filter and tuning encoders while it waits, does the
+            display work that used to be done inside ProcessIQData(), then draws the frame and gives it
+            back.
+
+            Every RA8875 command is an SPI transaction, and the time spent on them comes out of the
+            time the DSP task has. So only what changed is drawn. traceTop[] and traceBottom[] hold
+            the rows of the trace on the screen in each column; runs of columns that differ are
+            redrawn with SpectrumRunDraw(), and the audio bars grow or shrink by the difference. The
+            centerline, the axis and the filter markers are drawn only when something drew over them
+            or they moved. spectrumRedrawAll starts again from a clear plot after a screen redraw, and
+            every SPECTRUM_REFRESH_FRAMES frames everything is redrawn anyway, in case something
+            else drew over the plots.
 
   Parameter list:
     void
@@ -79,126 +208,250 @@ FASTRUN                                     // Place in tightly-coupled memory
 *****/
 void ShowSpectrum()  //AFP Extensively Modified 3-15-21 Adjusted 12-13-21 to align all elements
 {
+  static int refreshCount     = 0;
+  static int noiseFloorShown  = 0;
   int centerLine              =  (MAX_WATERFALL_WIDTH + SPECTRUM_LEFT_X) / 2;
   int middleSlice             = centerLine / 2;                               // Approximate center element
-  int j2;
   int x1                      = 0; //AFP
   int h                       = SPECTRUM_HEIGHT + 3;
   int filterLoPositionMarker;
   int filterHiPositionMarker;
+  int loColumn, hiColumn;
+  int drawTrace, forceAll, markersMoved;
+  int markersDamaged          = 0;
+  int centerDamaged           = 0;
+  int runStart                = -1;
+  int bar;
+  int waterfallLine;
+  uint32_t drawStart;
+  int16_t top, bottom;
+  int16_t *pixelnew;
+  int16_t *audioYPixel;
+  struct spectrumFrame *frame;
+
+  while ((frame = SpectrumFrameGet()) == NULL) {          // Wait for the DSP task to finish a frame
+    if (DSPTaskRunning() == 0 || keyPressedOn == 1) {
+      return;
+    }
+    FilterSetSSB();
+    EncoderCenterTune();
+#ifdef IQ_REPLAY
+    IQReplayService();                                    // The DSP task needs replay samples to make the frame
+#endif
+  }
+  drawStart   = micros();
+  pixelnew    = frame->pixelnew;
+  audioYPixel = frame->audioYPixel;
+
+  // Set frequency here only to minimize interruption to signal stream during tuning
+  if (centerTuneFlag == 1) { //AFP 10-04-22
+    DrawBandWidthIndicatorBar();
+    ShowFrequency();
+    SetFreq();            //AFP 10-04-22
+  }                       //AFP 10-04-22
+  centerTuneFlag = 0;     //AFP 10-04-22
+  UpdateFineTuneDisplay();
+  if (calibrateFlag == 1) {
+    CalibrateOptions(IQChoice);
+  }
+  DisplaydbM();
+  if (T41State == CW_RECEIVE) {
+    UpdateDecodeDisplay();
+  }
+  DisplayQueueDrain();                                        // What the DSP task posted, see DisplayQueue.cpp
 
-  for (int j = 0; j < MAX_WATERFALL_WIDTH - 1; j++) {     // map pixel colors
-    j2 = map(j, 0, MAX_WATERFALL_WIDTH, 0, SPECTRUM_RES - 1);
-    pixelnew2[j] = pixelnew[j2];
-    pixelold2[j] = pixelold[j2];
-
+  forceAll = 0;
+  if (spectrumRedrawAll || spectrumNoiseFloor != noiseFloorShown) {    // The plots were cleared, or everything moves
+    for (x1 = 0; x1 < MAX_WATERFALL_WIDTH; x1++) {
+      traceTop[x1] = TRACE_UNKNOWN;
+    }
+    for (x1 = 0; x1 < AUDIO_SPECTRUM_PIXELS; x1++) {
+      audioShown[x1] = TRACE_UNKNOWN;
+    }
+    spectrumRedrawAll = 0;
+    noiseFloorShown   = spectrumNoiseFloor;
+    forceAll = 1;
+  }
+  if (++refreshCount >= SPECTRUM_REFRESH_FRAMES) {
+    refreshCount = 0;
+    forceAll = 1;
   }
 
-  tft.drawFastVLine(centerLine, SPECTRUM_TOP_Y, h, RA8875_GREEN);     // Draws centerline on spectrum display
+  // The following lines calculate the position of the Filter bar below the spectrum display
+  // and the filter markers on the audio spectrum
+  filterLoPositionMarker = map(bands[currentBand].FLoCut, 0, 6000, 0, 256);
+  filterHiPositionMarker = map(bands[currentBand].FHiCut, 0, 6000, 0, 256);
+  loColumn = abs(filterLoPositionMarker) + 2;                 // Audio column under each marker
+  hiColumn = abs(filterHiPositionMarker) + 1;
+  markersMoved = (filterLoPositionMarker != filterLoPositionMarkerOld || filterHiPositionMarker != filterHiPositionMarkerOld);
+  if (markersMoved) {
+    if (abs(filterLoPositionMarkerOld) + 2 < AUDIO_SPECTRUM_PIXELS) {     // Clear the old markers with their columns
+      audioShown[abs(filterLoPositionMarkerOld) + 2] = TRACE_UNKNOWN;
+    }
+    if (abs(filterHiPositionMarkerOld) + 1 < AUDIO_SPECTRUM_PIXELS) {
+      audioShown[abs(filterHiPositionMarkerOld) + 1] = TRACE_UNKNOWN;
+    }
+    DrawBandWidthIndicatorBar();
+  }
+  filterLoPositionMarkerOld = filterLoPositionMarker;
+  filterHiPositionMarkerOld = filterHiPositionMarker;
+  tft.writeTo(L1);
 
+  drawTrace = (xmtMode == SSB_MODE || T41State == CW_RECEIVE);    //====== CW Receive code AFP 08-04-22
   pixelnew[0] = 0;
   pixelnew[1] = 0;
-  pixelold[0] = 0;
-  pixelold[1] = 0;
 
   for (x1 = 1; x1 < MAX_WATERFALL_WIDTH - 1; x1++)  //AFP, JJP changed init from 0 to 1 for x1: out of bounds addressing in line 112
     //Draws the main Spectrum, Waterfall and Audio displays
   {
-    if (x1 == 1) {
-      updateDisplayFlag = 1;      //Set flag so the display data are saved only once during each display refresh cycle at the start of the cycle, not 512 times
-    }  else {
-      updateDisplayFlag = 0;      //  Do not save the the display data for the remainder of the     
-    }
     FilterSetSSB();               // Insert Filter encoder update here  AFP 06-22-22
-   
-    if (T41State == SSB_RECEIVE || T41State == CW_RECEIVE ) { // AFP 08-24-22
-      ProcessIQData();            // Call the Audio process from within the display routine to eliminate conflicts with drawing the spectrum and waterfall displays
-    }
-    
     EncoderCenterTune();          // Moved the tuning encoder to reduce lag times and interference during tuning.
-    
-    y_new  = pixelnew[x1];
-    y1_new = pixelnew[x1 - 1];
-    y_old  = pixelold[x1];
-    y_old2 = pixelold[x1 - 1];
-
-    // I don't like this coding style, but do it here so more lines can be seen at once
-    if (y_new > base_y)      y_new = base_y;
-    if (y_old > base_y)      y_old = base_y;
-    if (y_old2 > base_y)     y_old2 = base_y;
-    if (y1_new > base_y)     y1_new = base_y;
-
-    if (y_new < 0)            y_new = 0;
-    if (y_old < 0)            y_old = 0;
-    if (y_old2 < 0)          y_old2 = 0;
-    if (y1_new < 0)          y1_new = 0;
-
-    //====== CW Receive code AFP 08-04-22  =================
-    if (xmtMode == SSB_MODE) {
-      tft.drawLine(x1 , spectrumNoiseFloor - y_old2, x1  , spectrumNoiseFloor - y_old , RA8875_BLACK);   // Erase old...
-      tft.drawLine(x1 , spectrumNoiseFloor - y1_new, x1 , spectrumNoiseFloor - y_new , RA8875_YELLOW);  // Draw new
+
+    y_new = constrain(pixelnew[x1], 0, base_y);
+    top    = 0;
+    bottom = -1;
+    if (drawTrace) {
+      TraceRows(pixelnew, x1, &top, &bottom);
     }
-    if (T41State == CW_RECEIVE) {
-      if (currentBand < 2) {
-        tft.drawLine(x1 , spectrumNoiseFloor - y_old2, x1 , spectrumNoiseFloor - y_old , RA8875_BLACK);   // Erase old...
-        tft.drawLine(x1 , spectrumNoiseFloor - y1_new, x1 , spectrumNoiseFloor - y_new , RA8875_YELLOW);  // Draw new
+    if (forceAll || top != traceTop[x1] || bottom != traceBottom[x1]) {
+      if (runStart < 0) {
+        runStart = x1;
       }
-      if (currentBand >= 2) {
-        tft.drawLine(x1  , spectrumNoiseFloor - y_old2, x1  , spectrumNoiseFloor - y_old , RA8875_BLACK); // Erase old...
-        tft.drawLine(x1  , spectrumNoiseFloor - y1_new, x1  , spectrumNoiseFloor - y_new , RA8875_YELLOW); // Draw new
+    } else {
+      if (runStart >= 0) {
+        SpectrumRunDraw(frame, runStart, x1, drawTrace);
+        centerDamaged |= (centerLine >= runStart && centerLine < x1);
+        runStart = -1;
       }
+      SpectrumHoldDraw(frame, x1, 0, -1, top, bottom);
     }
-    //============= End new code
+
     if (x1 < 253) { //AFP 09-01-22
       if ( keyPressedOn == 1) {//AFP 09-01-22
+        SpectrumFrameRelease();
+        spectrumRedrawAll = 1;                                // Part of the frame is not on the screen
         return;//AFP 09-01-22
-      } else {//AFP 09-01-22
-        tft.drawFastVLine(BAND_INDICATOR_X - 8 + x1, SPECTRUM_BOTTOM - 116, 115, RA8875_BLACK);                     //AFP Erase old AUDIO spectrum line
-        if (audioYPixel[x1] != 0) {
-          if (audioYPixel[x1] > CLIP_AUDIO_PEAK)             // audioSpectrumHeight = 118
-            audioYPixel[x1] = CLIP_AUDIO_PEAK;
-          if (x1 == middleSlice) {
-            smeterLength = y_new;
-          }
-          tft.drawFastVLine(BAND_INDICATOR_X - 8 + x1, AUDIO_SPECTRUM_BOTTOM - audioYPixel[x1] - 1, audioYPixel[x1] - 2, RA8875_MAGENTA);   //AFP draw new AUDIO spectrum line
-        }
-        tft.drawFastHLine(SPECTRUM_LEFT_X - 1, SPECTRUM_TOP_Y + SPECTRUM_HEIGHT , MAX_WATERFALL_WIDTH,  RA8875_YELLOW);
-        // The following lines calculate the position of the Filter bar below the spectrum display
-        // and then draw the Audio spectrum in its own container to the right of the Main spectrum display
-
-        filterLoPositionMarker = map(bands[currentBand].FLoCut, 0, 6000, 0, 256);
-        filterHiPositionMarker = map(bands[currentBand].FHiCut, 0, 6000, 0, 256);
-        //Draw Fiter indicator lines on audio plot AFP 10-30-22
-        tft.drawLine(BAND_INDICATOR_X -6+ abs(filterLoPositionMarker), SPECTRUM_BOTTOM-3, BAND_INDICATOR_X-6  + abs(filterLoPositionMarker), SPECTRUM_BOTTOM - 112, RA8875_LIGHT_GREY);
-        tft.drawLine(BAND_INDICATOR_X -7 + abs(filterHiPositionMarker), SPECTRUM_BOTTOM-3, BAND_INDICATOR_X -7 + abs(filterHiPositionMarker), SPECTRUM_BOTTOM - 112, RA8875_LIGHT_GREY);
-
-        if (filterLoPositionMarker != filterLoPositionMarkerOld || filterHiPositionMarker != filterHiPositionMarkerOld) {
-          DrawBandWidthIndicatorBar();
+      }
+      bar = min(audioYPixel[x1], CLIP_AUDIO_PEAK);            // audioSpectrumHeight = 118
+      if (bar != 0) {
+        if (x1 == middleSlice) {
+          smeterLength = y_new;
         }
-        filterLoPositionMarkerOld = filterLoPositionMarker;
-        filterHiPositionMarkerOld = filterHiPositionMarker;
+        bar = max(bar - 2, 0);
+      }
+      if (forceAll && audioShown[x1] != TRACE_UNKNOWN) {
+        audioShown[x1] = TRACE_UNKNOWN;                       // Redraw the whole bar
+      }
+      if (AudioBarDraw(x1, bar) && (x1 == loColumn || x1 == hiColumn)) {
+        markersDamaged = 1;
       }
     }
 
-    waterfall[x1] = gradient[y_new - 20];
-    tft.writeTo(L1);
+    waterfall[x1] = gradient[constrain(y_new - 20, 0, (int)(sizeof(gradient) / sizeof(gradient[0])) - 1)];   // Not past either end on a quiet or a strong signal
   }
   // End for(...) Draw MAX_WATERFALL_WIDTH spectral points
-  // Use the Block Transfer Engine (BTE) to move waterfall down a line
+  if (runStart >= 0) {
+    SpectrumRunDraw(frame, runStart, x1, drawTrace);
+    centerDamaged |= (centerLine >= runStart);
+  }
+
+  if (centerDamaged || forceAll) {
+    tft.drawFastVLine(centerLine, SPECTRUM_TOP_Y, h, RA8875_GREEN);     // Draws centerline on spectrum display
+    if (traceBottom[centerLine] >= traceTop[centerLine]) {               // The trace goes over it
+      tft.drawFastVLine(centerLine, traceTop[centerLine], traceBottom[centerLine] - traceTop[centerLine] + 1, RA8875_YELLOW);
+    }
+    SpectrumHoldDraw(frame, centerLine, SPECTRUM_TOP_Y, SPECTRUM_TOP_Y + h - 1, traceTop[centerLine], traceBottom[centerLine]);
+    tft.drawFastHLine(SPECTRUM_LEFT_X - 1, SPECTRUM_TOP_Y + SPECTRUM_HEIGHT , MAX_WATERFALL_WIDTH,  RA8875_YELLOW);
+    DisplaySpiCount(3 * SPI_BYTES_SHAPE);
+  }
+  if (markersMoved || markersDamaged || forceAll) {
+    //Draw Fiter indicator lines on audio plot AFP 10-30-22
+    tft.drawLine(BAND_INDICATOR_X -6+ abs(filterLoPositionMarker), SPECTRUM_BOTTOM-3, BAND_INDICATOR_X-6  + abs(filterLoPositionMarker), SPECTRUM_BOTTOM - 112, RA8875_LIGHT_GREY);
+    tft.drawLine(BAND_INDICATOR_X -7 + abs(filterHiPositionMarker), SPECTRUM_BOTTOM-3, BAND_INDICATOR_X -7 + abs(filterHiPositionMarker), SPECTRUM_BOTTOM - 112, RA8875_LIGHT_GREY);
+    DisplaySpiCount(2 * SPI_BYTES_SHAPE);
+  }
+  waterfallLine = frame->waterfallLine;
+  SpectrumFrameRelease();                                     // DSP task may reuse the slot
 
   if ( keyPressedOn == 1) {
     return;
-  }  else {
-    tft.BTE_move(WATERFALL_LEFT_X, FIRST_WATERFALL_LINE, MAX_WATERFALL_WIDTH, MAX_WATERFALL_ROWS - 2, WATERFALL_LEFT_X, FIRST_WATERFALL_LINE + 1, 1, 2);
-    while (tft.readStatus())                                  // Make sure it is done.  Memory moves can take time.
-      ;
-    // Now bring waterfall back to the beginning of the 2nd row.
-    tft.BTE_move(WATERFALL_LEFT_X, FIRST_WATERFALL_LINE + 1, MAX_WATERFALL_WIDTH, MAX_WATERFALL_ROWS - 2, WATERFALL_LEFT_X, FIRST_WATERFALL_LINE + 1, 2);
-    while (tft.readStatus())                                  // Make sure it's done.
-      ;
-  }
-  // Then write new row data into the missing top row to get a scroll effect using display hardware, not the CPU.
-  tft.writeRect(WATERFALL_LEFT_X, FIRST_WATERFALL_LINE, MAX_WATERFALL_WIDTH, 1, waterfall);
+  }
+  if (waterfallLine) {                                        // At waterfallTargetFPS, see FramePacer.cpp
+    WaterfallAddLine(waterfall);
+  }
+  PacerFrameDrawn(micros() - drawStart, waterfallLine);
+}
+
+/*****
+  Purpose: Set up the RA8875 scroll window over the waterfall. Layer 1 only, so what is drawn on
+           layer 2 over the waterfall stays put. Called after the layers are set up.
+
+  Parameter list:
+    void
+
+  Return value;
+    void
+*****/
+void WaterfallScrollInit()
+{
+  tft.setScrollMode(LAYER1ONLY);
+  tft.setScrollWindow(WATERFALL_LEFT_X, WATERFALL_LEFT_X + MAX_WATERFALL_WIDTH - 1, FIRST_WATERFALL_LINE, FIRST_WATERFALL_LINE + WATERFALL_SCROLL_ROWS - 1);
+  WaterfallScrollReset();
+}
+
+/*****
+  Purpose: Put the waterfall scroll offset back to 0, so layer 1 shows the waterfall rows where
+           they are in memory. Must be called before anything else draws over the waterfall on
+           layer 1, such as a full screen clear, or it is shown rotated by the offset.
+
+  Parameter list:
+    void
+
+  Return value;
+    void
+*****/
+void WaterfallScrollReset()
+{
+  waterfallScrollTop = 0;
+  tft.scroll(0, 0);
+}
+
+/*****
+  Purpose: Forget everything known about what is on the screen, before it is cleared. The
+           waterfall scroll goes back to 0, the status widgets are drawn whole the next time and
+           the spectrum plots start again from a clear plot.
+
+  Parameter list:
+    void
+
+  Return value;
+    void
+*****/
+void DisplayInvalidate()
+{
+  WaterfallScrollReset();
+  WidgetsInvalidate();
+  spectrumRedrawAll = 1;
+}
+
+/*****
+  Purpose: Add a line at the top of the waterfall. The waterfall rows are a circular buffer in the
+           scroll window. The new line is written over the oldest one and the vertical scroll
+           offset moved to show it at the top, so one 512 pixel row and one register write
+           replace the two BTE moves of the whole waterfall, and the waits on them, used before.
+
+  Parameter list:
+    uint16_t *line          MAX_WATERFALL_WIDTH pixels
+
+  Return value;
+    void
+*****/
+void WaterfallAddLine(uint16_t *line)
+{
+  waterfallScrollTop = (waterfallScrollTop + WATERFALL_SCROLL_ROWS - 1) % WATERFALL_SCROLL_ROWS;
+  tft.writeRect(WATERFALL_LEFT_X, FIRST_WATERFALL_LINE + waterfallScrollTop, MAX_WATERFALL_WIDTH, 1, line);
+  tft.scroll(0, waterfallScrollTop);
+  DisplaySpiCount(SPI_BYTES_SHAPE + MAX_WATERFALL_WIDTH * SPI_BYTES_ROW_PIXEL + 2 * SPI_BYTES_REGISTER);
 }
 
 /*****
@@ -253,6 +506,17 @@ void ShowBandwidth()
     tft.setTextColor(RA8875_LIGHT_GREY);
   MyDrawFloat((float)(bands[currentBand].FHiCut / 1000.0f), 1, FILTER_PARAMETERS_X + 80, FILTER_PARAMETERS_Y, buff);
   tft.print("kHz");
+  if (switchFilterSideband == FILTER_SHIFT)
+    tft.setTextColor(RA8875_WHITE);
+  else
+    tft.setTextColor(RA8875_LIGHT_GREY);
+  tft.fillRect(FILTER_PARAMETERS_X + 160, FILTER_PARAMETERS_Y, 80, 15, RA8875_BLACK);
+  if (switchFilterSideband == FILTER_SHIFT || PassbandShiftHz() != 0.0) {
+    tft.setCursor(FILTER_PARAMETERS_X + 160, FILTER_PARAMETERS_Y);
+    tft.print("IF");
+    tft.print(passbandShift / 1000.0f, 2);
+    tft.print("kHz");
+  }
 
   tft.setTextColor(RA8875_WHITE); // set text color to white for other print routines not to get confused ;-)
 }
@@ -334,6 +598,7 @@ void ShowSpectrumdBScale()
 *****/
 void DrawSpectrumDisplayContainer()
 {
+  spectrumRedrawAll = 1;
   tft.drawRect(SPECTRUM_LEFT_X - 1, SPECTRUM_TOP_Y, MAX_WATERFALL_WIDTH + 2, SPECTRUM_HEIGHT,  RA8875_YELLOW);  // Spectrum box
 }
 
@@ -506,41 +771,35 @@ void ShowAnalogGain()
 *****/
 void BandInformation() // SSB or CW
 {
+  char buff[WIDGET_TEXT_MAX + 1];
+  const char *demodText = NULL;
   float CWFilterPosition = 0.0;
 
   tft.setFontScale( (enum RA8875tsize) 0);
-  tft.setTextColor(RA8875_GREEN);
 
-  tft.setCursor(5, FREQUENCY_Y + 30);
-  tft.setTextColor(RA8875_WHITE);
-  tft.print("Center Freq");
-  tft.fillRect(100, FREQUENCY_Y + 30, 300, tft.getFontHeight(), RA8875_BLACK);  // Clear volume field
-  tft.setCursor(100, FREQUENCY_Y + 30);
-  tft.setTextColor(RA8875_LIGHT_ORANGE);
-    if (spectrum_zoom == SPECTRUM_ZOOM_1) { // AFP 11-02-22
-    tft.print(centerFreq + 48000);
+  WidgetText(WIDGET_CENTER_LABEL, 5, FREQUENCY_Y + 30, 11, RA8875_WHITE, RA8875_BLACK, "Center Freq");
+  if (spectrum_zoom == SPECTRUM_ZOOM_1) { // AFP 11-02-22
+    ltoa(centerFreq + 48000, buff, 10);
   } else {
-   tft.print(centerFreq);
-  }  
-  tft.fillRect(OPERATION_STATS_X + 50, FREQUENCY_Y + 30, 300, tft.getFontHeight(), RA8875_BLACK); // Clear volume field
-  tft.setTextColor(RA8875_LIGHT_ORANGE);
-  tft.setCursor(OPERATION_STATS_X + 50, FREQUENCY_Y + 30);
+    ltoa(centerFreq, buff, 10);
+  }
+  WidgetText(WIDGET_CENTER_FREQ, 100, FREQUENCY_Y + 30, 9, RA8875_LIGHT_ORANGE, RA8875_BLACK, buff);
   if (activeVFO == VFO_A) {
-    tft.print(bands[currentBandA].name);                           // Show band -- 40M
+    WidgetText(WIDGET_BAND, OPERATION_STATS_X + 50, FREQUENCY_Y + 30, 5, RA8875_LIGHT_ORANGE, RA8875_BLACK, bands[currentBandA].name);  // Show band -- 40M
   } else {
-    tft.print(bands[currentBandB].name);                           // Show band -- 40M
+    WidgetText(WIDGET_BAND, OPERATION_STATS_X + 50, FREQUENCY_Y + 30, 5, RA8875_LIGHT_ORANGE, RA8875_BLACK, bands[currentBandB].name);
   }
 
-  tft.fillRect(OPERATION_STATS_X + 90, FREQUENCY_Y + 30, 70, tft.getFontHeight(), RA8875_BLACK); //AFP 10-18-22
-  tft.setTextColor(RA8875_GREEN);
-  tft.setCursor(OPERATION_STATS_X + 90, FREQUENCY_Y + 30);               //AFP 10-18-22
-
   //================  AFP 10-19-22
   if (xmtMode == CW_MODE ) {
-    tft.fillRect(OPERATION_STATS_X + 85, FREQUENCY_Y + 30, 70, tft.getFontHeight(), RA8875_BLACK);
-    tft.print("CW ");
-    tft.setCursor(OPERATION_STATS_X + 115, FREQUENCY_Y + 30);  //AFP 10-18-22
-    tft.print(CWFilter[CWFilterIndex]);                        //AFP 10-18-22
+    snprintf(buff, sizeof(buff), "CW %s", CWFilter[CWFilterIndex]);       //AFP 10-18-22
+  } else {
+    strcpy(buff, "SSB");                                        // Which mode
+  }
+  if (WidgetText(WIDGET_MODE, OPERATION_STATS_X + 90, FREQUENCY_Y + 30, 9, RA8875_GREEN, RA8875_BLACK, buff)) {
+    WidgetForget(WIDGET_DEMOD);                                 // The last character reaches into the next field
+  }
+  if (xmtMode == CW_MODE && WidgetChanged(WIDGET_CW_SHADE, CWFilterIndex)) {
     tft.writeTo(L2);
     switch (CWFilterIndex) {
       case 0:
@@ -565,50 +824,39 @@ void BandInformation() // SSB or CW
 
     tft.fillRect(BAND_INDICATOR_X - 8, AUDIO_SPECTRUM_TOP, CWFilterPosition, 120, MAROON);
     tft.drawFastVLine(BAND_INDICATOR_X - 8 + CWFilterPosition, AUDIO_SPECTRUM_BOTTOM - 118, 118, RA8875_LIGHT_GREY);
+    DisplaySpiCount(2 * SPI_BYTES_SHAPE);
 
     tft.writeTo(L1);
     //================  AFP 10-19-22 =========
-  } else {
-    tft.fillRect(OPERATION_STATS_X + 90, FREQUENCY_Y + 30, 70, tft.getFontHeight(), RA8875_BLACK);
-    tft.print("SSB");                                           // Which mode
+  } else if (xmtMode != CW_MODE) {
+    WidgetForget(WIDGET_CW_SHADE);                              // Cleared with layer 2 before we are back in CW
   }
 
-  tft.fillRect(OPERATION_STATS_X + 160, FREQUENCY_Y + 30, tft.getFontWidth() * 11, tft.getFontHeight(), RA8875_BLACK);        // AFP 11-01-22 Clear top-left menu area
-  tft.setCursor(OPERATION_STATS_X + 160, FREQUENCY_Y + 30);   // AFP 11-01-22
-  tft.setTextColor(RA8875_WHITE);
-
-
-      switch (bands[currentBand].mode) {
-      case DEMOD_LSB :
-        if (activeVFO == VFO_A) {
-          tft.print(DEMOD[bands[currentBandA].mode].text);               // Which sideband //AFP 09-22-22
-        } else {
-          tft.print(DEMOD[bands[currentBandB].mode].text);               // Which sideband //AFP 09-22-22
-        }
-        break;
-      case DEMOD_USB :
-        if (activeVFO == VFO_A) {
-          tft.print(DEMOD[bands[currentBandA].mode].text);               // Which sideband //AFP 09-22-22
-        } else {
-          tft.print(DEMOD[bands[currentBandB].mode].text);               // Which sideband //AFP 09-22-22
-        }
-        break;
-      case DEMOD_AM:
-        tft.setTextColor(RA8875_WHITE);
-        tft.print("(AM)");  //AFP 09-22-22
-        break;
-      case DEMOD_SAM:  //AFP 11-01-22
-        tft.print("(SAM) ");  //AFP 11-01-22
-        break;
-   
+  switch (bands[currentBand].mode) {
+    case DEMOD_LSB :
+    case DEMOD_USB :
+      if (activeVFO == VFO_A) {
+        demodText = DEMOD[bands[currentBandA].mode].text;       // Which sideband //AFP 09-22-22
+      } else {
+        demodText = DEMOD[bands[currentBandB].mode].text;       // Which sideband //AFP 09-22-22
+      }
+      break;
+    case DEMOD_AM:
+      demodText = "(AM)";  //AFP 09-22-22
+      break;
+    case DEMOD_SAM:  //AFP 11-01-22
+      if (!WidgetValid(WIDGET_DEMOD) || widgets[WIDGET_DEMOD].background != RA8875_BLUE) {
+        demodText = "(SAM) ";                                   // Until ShowSAMOffset() has an offset to show
+      }
+      break;
   }
-  tft.fillRect(OPERATION_STATS_X + 275, FREQUENCY_Y + 30, tft.getFontWidth() * 5, tft.getFontHeight(), RA8875_BLACK);        // Clear top-left menu area
-  tft.setCursor(OPERATION_STATS_X + 275, FREQUENCY_Y + 30);
-  tft.setTextColor(RA8875_RED);
-  tft.print(transmitPowerLevel);                                // Power output
-  tft.print(" Watts");
+  if (demodText != NULL) {
+    WidgetText(WIDGET_DEMOD, OPERATION_STATS_X + 160, FREQUENCY_Y + 30, 11, RA8875_WHITE, RA8875_BLACK, demodText);
+  }
+  dtostrf(transmitPowerLevel, 0, 2, buff);                      // Power output
+  strcat(buff, " Watts");
+  WidgetText(WIDGET_POWER, OPERATION_STATS_X + 275, FREQUENCY_Y + 30, 11, RA8875_RED, RA8875_BLACK, buff);
   tft.setTextColor(RA8875_WHITE);
-
 }
 
 /*****
@@ -657,48 +905,39 @@ void FormatFrequency(long freq, char *freqBuffer)
 void ShowFrequency()
 {
   char freqBuffer[15];
+  uint16_t color;
+
   if (activeVFO == VFO_A) {           // Needed for edge checking
     currentBand = currentBandA;
   } else {
     currentBand = currentBandB;
   }
+  if (WidgetChanged(WIDGET_VFO, activeVFO)) {                 // The large and small digits swap places
+    tft.fillRect(FREQUENCY_X_SPLIT, FREQUENCY_Y - 12, VFOB_PIXEL_LENGTH, FREQUENCY_PIXEL_HI, RA8875_BLACK);
+    tft.fillRect(FREQUENCY_X,       FREQUENCY_Y - 12, VFOA_PIXEL_LENGTH, FREQUENCY_PIXEL_HI, RA8875_BLACK);
+    DisplaySpiCount(2 * SPI_BYTES_SHAPE);
+    WidgetForget(WIDGET_FREQ_MAIN);
+    WidgetForget(WIDGET_FREQ_OTHER);
+  }
 
+  FormatFrequency(TxRxFreq, freqBuffer);
+  if (TxRxFreq < bands[currentBand].fBandLow || TxRxFreq > bands[currentBand].fBandHigh) {
+    color = RA8875_RED;                                       // Out of band
+  } else {
+    color = RA8875_GREEN;                                     // In US band
+  }
   if (activeVFO == VFO_A) {
-    FormatFrequency(TxRxFreq, freqBuffer);
-    tft.setFont(&FreeMonoBold24pt7b);                         // Large font
-    if (TxRxFreq < bands[currentBandA].fBandLow || TxRxFreq > bands[currentBandA].fBandHigh) {
-      tft.setTextColor(RA8875_RED);                           // Out of band
-    } else {
-      tft.setTextColor(RA8875_GREEN);                         // In US band
-    }
-    tft.fillRect(FREQUENCY_X, FREQUENCY_Y - 12, VFOA_PIXEL_LENGTH, FREQUENCY_PIXEL_HI, RA8875_BLACK); // delete old freq
-    tft.setCursor(FREQUENCY_X, FREQUENCY_Y);
-    tft.print(freqBuffer);                                    // Show VFO_A
-
-    tft.setFont(&FreeMonoBold18pt7b);
-    tft.setTextColor(RA8875_LIGHT_GREY);
-    tft.setCursor(FREQUENCY_X_SPLIT + 20, FREQUENCY_Y + 6);
+    WidgetFontText(WIDGET_FREQ_MAIN, FREQUENCY_X, FREQUENCY_Y, FREQUENCY_CHARS, &FreeMonoBold24pt7b,
+                   FREQUENCY_Y - 12, FREQUENCY_PIXEL_HI, color, freqBuffer);       // Show VFO_A
     FormatFrequency(currentFreqB, freqBuffer);
-    tft.print(freqBuffer);    
+    WidgetFontText(WIDGET_FREQ_OTHER, FREQUENCY_X_SPLIT + 20, FREQUENCY_Y + 6, FREQUENCY_CHARS, &FreeMonoBold18pt7b,
+                   FREQUENCY_Y - 12, FREQUENCY_PIXEL_HI, RA8875_LIGHT_GREY, freqBuffer);
   } else {                                                    // Show VFO_B
-    FormatFrequency(TxRxFreq, freqBuffer);
-    tft.fillRect(FREQUENCY_X_SPLIT, FREQUENCY_Y - 12, VFOB_PIXEL_LENGTH, FREQUENCY_PIXEL_HI, RA8875_BLACK);
-    tft.setCursor(FREQUENCY_X_SPLIT, FREQUENCY_Y);
-    tft.setFont(&FreeMonoBold24pt7b);
-    if (TxRxFreq < bands[currentBandB].fBandLow || TxRxFreq > bands[currentBandB].fBandHigh) {
-      tft.setTextColor(RA8875_RED);
-    } else {
-      tft.setTextColor(RA8875_GREEN);
-    }
-    tft.print(freqBuffer);                                    // Show VFO_A
-
-    tft.setFont(&FreeMonoBold18pt7b);
-    FormatFrequency(TxRxFreq, freqBuffer);
-//    tft.fillRect(FREQUENCY_X, FREQUENCY_Y - 12, VFOA_PIXEL_LENGTH, FREQUENCY_PIXEL_HI, RA8875_BLACK); // delete old freq
-    tft.setTextColor(RA8875_LIGHT_GREY);
-    tft.setCursor(FREQUENCY_X, FREQUENCY_Y + 6);
+    WidgetFontText(WIDGET_FREQ_MAIN, FREQUENCY_X_SPLIT, FREQUENCY_Y, FREQUENCY_CHARS, &FreeMonoBold24pt7b,
+                   FREQUENCY_Y - 12, FREQUENCY_PIXEL_HI, color, freqBuffer);
     FormatFrequency(currentFreqA, freqBuffer);
-    tft.print(freqBuffer);                                    // Show VFO_A    
+    WidgetFontText(WIDGET_FREQ_OTHER, FREQUENCY_X, FREQUENCY_Y + 6, FREQUENCY_CHARS, &FreeMonoBold18pt7b,
+                   FREQUENCY_Y - 12, FREQUENCY_PIXEL_HI, RA8875_LIGHT_GREY, freqBuffer);    // Show VFO_A
   }
 
   tft.setFontDefault();
@@ -713,7 +952,6 @@ void ShowFrequency()
 void DisplaydbM()
 {
   char buff[10];
-  const char* unit_label;
   int16_t smeterPad;
   float32_t audioLogAveSq;
   float32_t slope         = 10.0;
@@ -721,19 +959,14 @@ void DisplaydbM()
 
   audioLogAveSq = 10 * log10f_fast(audioMaxSquaredAve) + 10; //AFP 09-18-22
   smeterPad = map(audioLogAveSq, 5, 35, 575, 635);   //AFP 09-18-22
-  tft.fillRect(SMETER_X + 1, SMETER_Y + 1, SMETER_BAR_LENGTH,    SMETER_BAR_HEIGHT, RA8875_BLACK);//AFP 09-18-22  Erase old bar
-  tft.fillRect(SMETER_X + 1, SMETER_Y + 1, smeterPad - SMETER_X, SMETER_BAR_HEIGHT, RA8875_RED);  //AFP 09-18-22
+  WidgetBar(WIDGET_SMETER, SMETER_X + 1, SMETER_Y + 1, SMETER_BAR_LENGTH, SMETER_BAR_HEIGHT, smeterPad - SMETER_X, RA8875_RED);  //AFP 09-18-22
   dbm = dbm_calibration + bands[currentBand].gainCorrection + (float32_t)attenuator +
         slope * log10f_fast(audioMaxSquaredAve) + cons - (float32_t)bands[currentBand].RFgain * 1.5;
-  tft.setTextColor(RA8875_WHITE);
 
-  unit_label        = "dBm";
   tft.setFontScale( (enum RA8875tsize) 0);
-
-  tft.fillRect(SMETER_X + 185, SMETER_Y, 80, tft.getFontHeight(), RA8875_BLACK);  // The dB figure at end of S meter
-  MyDrawFloat(dbm, 1, SMETER_X + 184, SMETER_Y, buff);
-  tft.setTextColor(RA8875_GREEN);
-  tft.print(unit_label);
+  dtostrf(dbm, FLOAT_PRECISION, 1, buff);                                 // The dB figure at end of S meter
+  WidgetText(WIDGET_DBM, SMETER_X + 184, SMETER_Y, FLOAT_PRECISION, RA8875_WHITE, RA8875_BLACK, buff);
+  WidgetText(WIDGET_DBM_UNIT, SMETER_X + 184 + FLOAT_PRECISION * tft.getFontWidth(), SMETER_Y, 3, RA8875_GREEN, RA8875_BLACK, "dBm");
 }
 
 /*****
@@ -752,6 +985,7 @@ void ShowTempAndLoad()
   int valueColor = RA8875_GREEN;
   double block_time;
   double processor_load;
+  int heaviestStage;
   elapsed_micros_mean = elapsed_micros_sum / elapsed_micros_idx_t;
 
   block_time = 128.0 / (double)SR[SampleRate].rate;           // one audio block is 128 samples and uses this in seconds
@@ -782,6 +1016,13 @@ void ShowTempAndLoad()
   tft.drawCircle(TEMP_X_OFFSET + 80, TEMP_Y_OFFSET + 5, 3, RA8875_GREEN);
   MyDrawFloat(processor_load, 1, TEMP_X_OFFSET + 150, TEMP_Y_OFFSET, buff);
   tft.print("%");
+  heaviestStage = ProfileHeaviestStage();                       // Stage using the most of the block time
+  tft.setTextColor(RA8875_WHITE);
+  tft.setCursor(TEMP_X_OFFSET + 250, TEMP_Y_OFFSET);
+  tft.print(profileStageNames[heaviestStage]);
+  tft.print(":");
+  MyDrawFloat(ProfileStageLoad(heaviestStage), 1, TEMP_X_OFFSET + 370, TEMP_Y_OFFSET, buff);
+  tft.print("%");
   elapsed_micros_idx_t = 0;
   elapsed_micros_sum = 0;
   elapsed_micros_mean = 0;
@@ -824,6 +1065,9 @@ void UpdateInfoWindow()
 {
   tft.fillRect(INFORMATION_WINDOW_X - 8, INFORMATION_WINDOW_Y, 250, 170, RA8875_BLACK);  // Clear fields
   tft.drawRect(BAND_INDICATOR_X - 10,    BAND_INDICATOR_Y - 2, 260, 200, RA8875_LIGHT_GREY); // Redraw Info Window Box
+  for (int id = WIDGET_VOLUME; id <= WIDGET_DECODER; id++) {    // The info window widgets are numbered together
+    WidgetForget(id);
+  }
 
   tft.setFontScale( (enum RA8875tsize) 1);
   UpdateVolumeField();
@@ -850,15 +1094,17 @@ void UpdateInfoWindow()
 *****/
 void UpdateVolumeField()
 {
+  char buff[WIDGET_TEXT_MAX + 1];
+
   tft.setFontScale( (enum RA8875tsize) 1);
 
-  tft.setCursor(BAND_INDICATOR_X + 20, BAND_INDICATOR_Y);       // Volume
-  tft.setTextColor(RA8875_WHITE);
-  tft.print("Vol:");
-  tft.setTextColor(RA8875_GREEN);
-  tft.fillRect(BAND_INDICATOR_X + 90, BAND_INDICATOR_Y, tft.getFontWidth() * 3 + 2, tft.getFontHeight(), RA8875_BLACK);
-  tft.setCursor(FIELD_OFFSET_X, BAND_INDICATOR_Y);
-  tft.print(audioVolume);
+  if (!WidgetValid(WIDGET_VOLUME)) {
+    tft.setCursor(BAND_INDICATOR_X + 20, BAND_INDICATOR_Y);     // Volume
+    tft.setTextColor(RA8875_WHITE);
+    tft.print("Vol:");
+  }
+  itoa(audioVolume, buff, 10);
+  WidgetText(WIDGET_VOLUME, FIELD_OFFSET_X, BAND_INDICATOR_Y, 3, RA8875_GREEN, RA8875_BLACK, buff);
 }
 /*****
   Purpose: Updates the AGC on the display
@@ -871,7 +1117,11 @@ void UpdateVolumeField()
 *****/
 void UpdateAGCField()
 {
+  if (!WidgetChanged(WIDGET_AGC, AGCMode)) {
+    return;
+  }
   tft.fillRect(AGC_X_OFFSET, AGC_Y_OFFSET, 100, tft.getFontHeight(), RA8875_BLACK);
+  DisplaySpiCount(SPI_BYTES_SHAPE + SPI_BYTES_TEXT + 5 * SPI_BYTES_CHAR);
   tft.setFontScale( (enum RA8875tsize) 1);
   tft.setCursor(BAND_INDICATOR_X + 150, BAND_INDICATOR_Y);
   switch (AGCMode) {                                          // The opted for AGC
@@ -915,22 +1165,20 @@ void UpdateAGCField()
 *****/
 void UpdateIncrementField()
 {
-  tft.setFontScale( (enum RA8875tsize) 0);
-  tft.setTextColor(RA8875_WHITE);                                 // Frequency increment
-  tft.setCursor(INCREMENT_X, INCREMENT_Y);
-  tft.print("Increment: ");
-  tft.setCursor(INCREMENT_X + 148, INCREMENT_Y);
-  tft.print("FT Inc: ");
-
-  tft.fillRect(INCREMENT_X + 90, INCREMENT_Y, tft.getFontWidth() * 7, tft.getFontHeight(), RA8875_BLACK);
-  tft.setCursor(FIELD_OFFSET_X - 3, INCREMENT_Y);
-  tft.setTextColor(RA8875_GREEN);
-  tft.print(freqIncrement);
+  char buff[WIDGET_TEXT_MAX + 1];
 
-  tft.fillRect(INCREMENT_X + 210, INCREMENT_Y, tft.getFontWidth() * 4, tft.getFontHeight(), RA8875_BLACK);
-  tft.setCursor(FIELD_OFFSET_X + 120, INCREMENT_Y);
-  tft.setTextColor(RA8875_GREEN);
-  tft.print(stepFT);
+  tft.setFontScale( (enum RA8875tsize) 0);
+  if (!WidgetValid(WIDGET_INCREMENT)) {
+    tft.setTextColor(RA8875_WHITE);                               // Frequency increment
+    tft.setCursor(INCREMENT_X, INCREMENT_Y);
+    tft.print("Increment: ");
+    tft.setCursor(INCREMENT_X + 148, INCREMENT_Y);
+    tft.print("FT Inc: ");
+  }
+  itoa(freqIncrement, buff, 10);
+  WidgetText(WIDGET_INCREMENT, FIELD_OFFSET_X - 3, INCREMENT_Y, 7, RA8875_GREEN, RA8875_BLACK, buff);
+  ultoa(stepFT, buff, 10);
+  WidgetText(WIDGET_FT_INCREMENT, FIELD_OFFSET_X + 120, INCREMENT_Y, 4, RA8875_GREEN, RA8875_BLACK, buff);
 }
 /*****
   Purpose: Updates the notch value on the display
@@ -943,6 +1191,12 @@ void UpdateIncrementField()
 *****/
 void UpdateNotchField()
 {
+  if (ANR_notchOn != 0) {
+    ANR_notchOn = 1; //AFP 10-21-22
+  }
+  if (!WidgetChanged(WIDGET_NOTCH, (NR_first_time != 0) * 2 + ANR_notchOn)) {
+    return;
+  }
   tft.setFontScale( (enum RA8875tsize) 0);
 
   if (NR_first_time == 0) {                                        // Notch setting
@@ -951,6 +1205,7 @@ void UpdateNotchField()
     tft.setTextColor(RA8875_WHITE);
   }
   tft.fillRect(NOTCH_X + 60, NOTCH_Y, 150, tft.getFontHeight() + 5, RA8875_BLACK);
+  DisplaySpiCount(SPI_BYTES_SHAPE + 2 * SPI_BYTES_TEXT + 13 * SPI_BYTES_CHAR);
   tft.setCursor(NOTCH_X - 32, NOTCH_Y);
   tft.print("AutoNotch:");
   tft.setCursor(FIELD_OFFSET_X, NOTCH_Y);
@@ -959,7 +1214,6 @@ void UpdateNotchField()
     tft.print("Off");
   } else {
     tft.print("On");
-    ANR_notchOn = 1; //AFP 10-21-22
   }
 }
 
@@ -976,13 +1230,12 @@ void UpdateZoomField()
 {
   tft.setFontScale( (enum RA8875tsize) 0);
 
-  tft.fillRect(ZOOM_X, ZOOM_Y, 100, tft.getFontHeight(), RA8875_BLACK);
-  tft.setTextColor(RA8875_WHITE);                                 // Display zoom factor
-  tft.setCursor(ZOOM_X, ZOOM_Y);
-  tft.print("Zoom:");
-  tft.setCursor(FIELD_OFFSET_X, ZOOM_Y);
-  tft.setTextColor(RA8875_GREEN);
-  tft.print(zoomOptions[zoomIndex]);
+  if (!WidgetValid(WIDGET_ZOOM)) {
+    tft.setTextColor(RA8875_WHITE);                               // Display zoom factor
+    tft.setCursor(ZOOM_X, ZOOM_Y);
+    tft.print("Zoom:");
+  }
+  WidgetText(WIDGET_ZOOM, FIELD_OFFSET_X, ZOOM_Y, 3, RA8875_GREEN, RA8875_BLACK, zoomOptions[zoomIndex]);
 }
 /*****
   Purpose: Updates the compression setting in Info Window
@@ -995,15 +1248,16 @@ void UpdateZoomField()
 *****/
 void UpdateCompressionField()
 {
-  tft.fillRect(COMPRESSION_X, COMPRESSION_Y, 200, 8, RA8875_BLACK);
+  char buff[WIDGET_TEXT_MAX + 1];
 
   tft.setFontScale( (enum RA8875tsize) 0);
-  tft.setTextColor(RA8875_WHITE);                                 // Display zoom factor
-  tft.setCursor(COMPRESSION_X, COMPRESSION_Y);
-  tft.print("Compress: ");
-  tft.setCursor(FIELD_OFFSET_X, COMPRESSION_Y);
-  tft.setTextColor(RA8875_GREEN);
-  tft.print(currentMicThreshold);
+  if (!WidgetValid(WIDGET_COMPRESSION)) {
+    tft.setTextColor(RA8875_WHITE);
+    tft.setCursor(COMPRESSION_X, COMPRESSION_Y);
+    tft.print("Compress: ");
+  }
+  itoa(currentMicThreshold, buff, 10);
+  WidgetText(WIDGET_COMPRESSION, FIELD_OFFSET_X, COMPRESSION_Y, 4, RA8875_GREEN, RA8875_BLACK, buff);
 }
 /*****
   Purpose: Updates whether the decoder is on or off
@@ -1016,6 +1270,9 @@ void UpdateCompressionField()
 *****/
 void UpdateDecoderField()
 {
+  if (!WidgetChanged(WIDGET_DECODER, decoderFlag * 2 + (xmtMode == CW_MODE))) {
+    return;
+  }
   tft.setFontScale( (enum RA8875tsize) 0);
 
   tft.setTextColor(RA8875_WHITE);                     // Display zoom factor
@@ -1023,6 +1280,7 @@ void UpdateDecoderField()
   tft.print("Decoder:");
   tft.setTextColor(RA8875_GREEN);
   tft.fillRect(DECODER_X + 60, DECODER_Y, tft.getFontWidth() * 20, tft.getFontHeight() + 5, RA8875_BLACK);
+  DisplaySpiCount(2 * SPI_BYTES_SHAPE + 3 * SPI_BYTES_TEXT + 25 * SPI_BYTES_CHAR);
   tft.setCursor(FIELD_OFFSET_X, DECODER_Y);
   if (decoderFlag == DECODE_ON) {                         // AFP 09-27-22
     tft.print("On ");
@@ -1051,21 +1309,22 @@ void UpdateDecoderField()
 *****/
 void UpdateWPMField()
 {
+  char buff[WIDGET_TEXT_MAX + 1];
+
   tft.setFontScale( (enum RA8875tsize) 0);
 
-  tft.setTextColor(RA8875_WHITE);                                 // Display zoom factor
-  tft.setCursor(WPM_X, WPM_Y);
-  tft.print("Keyer:");
-  tft.setTextColor(RA8875_GREEN);
-  tft.fillRect(WPM_X + 60, WPM_Y, tft.getFontWidth() * 15, tft.getFontHeight(), RA8875_BLACK);
-  tft.setCursor(FIELD_OFFSET_X, WPM_Y);
+  if (!WidgetValid(WIDGET_WPM)) {
+    tft.setTextColor(RA8875_WHITE);
+    tft.setCursor(WPM_X, WPM_Y);
+    tft.print("Keyer:");
+  }
   EEPROMData.currentWPM = currentWPM;
   if (EEPROMData.keyType == KEYER) {
-    tft.print("Paddles -- ");
-    tft.print(EEPROMData.currentWPM);
+    snprintf(buff, sizeof(buff), "Paddles -- %ld", (long)EEPROMData.currentWPM);
   } else {
-    tft.print("Straight Key");
+    strcpy(buff, "Straight Key");
   }
+  WidgetText(WIDGET_WPM, FIELD_OFFSET_X, WPM_Y, 15, RA8875_GREEN, RA8875_BLACK, buff);
 }
 
 
@@ -1084,14 +1343,12 @@ void UpdateNoiseField()
 
   tft.setFontScale( (enum RA8875tsize) 0);
 
-  tft.fillRect(FIELD_OFFSET_X, NOISE_REDUCE_Y, 80, tft.getFontHeight(), RA8875_BLACK);
-  tft.setTextColor(RA8875_WHITE);                                 // Noise reduction
-  tft.setCursor(NOISE_REDUCE_X, NOISE_REDUCE_Y);
-  tft.print("Noise:");
-  tft.setTextColor(RA8875_GREEN);
-  tft.setCursor(FIELD_OFFSET_X, NOISE_REDUCE_Y);
-  tft.print(filter[nrOptionSelect]);
-
+  if (!WidgetValid(WIDGET_NR)) {
+    tft.setTextColor(RA8875_WHITE);                               // Noise reduction
+    tft.setCursor(NOISE_REDUCE_X, NOISE_REDUCE_Y);
+    tft.print("Noise:");
+  }
+  WidgetText(WIDGET_NR, FIELD_OFFSET_X, NOISE_REDUCE_Y, 8, RA8875_GREEN, RA8875_BLACK, filter[nrOptionSelect]);
 }
 
 /*****
@@ -1236,6 +1493,7 @@ void DrawInfoWindowFrame()
 *****/
 void RedrawDisplayScreen()
 {
+  DisplayInvalidate();
   tft.fillWindow();
   UpdateIncrementField();
   AGCPrep();
@@ -1276,6 +1534,8 @@ void DrawBandWidthIndicatorBar()  // AFP 10-30-22
 {
   float zoomMultFactor = 0.0;
   float Zoom1Offset    = 0.0;
+  static int oldShiftPosition = 0;
+  int newShiftPosition;
 
   switch (zoomIndex) {
     case 0 :
@@ -1307,22 +1567,24 @@ void DrawBandWidthIndicatorBar()  // AFP 10-30-22
 
   tft.writeTo(L2);
   tft.clearMemory();
+  WidgetForget(WIDGET_CW_SHADE);                                // BandInformation() puts it back
   pixel_per_khz = ((1 << spectrum_zoom) * SPECTRUM_RES * 1000.0 / SR[SampleRate].rate) ;
   filterWidth = (int)(((bands[currentBand].FHiCut - bands[currentBand].FLoCut) / 1000.0) * pixel_per_khz*1.06) ; // AFP 10-30-22
+  newShiftPosition = (int)(PassbandShiftHz() / 1000.0 * pixel_per_khz);                 // Passband shift, 0 except in LSB and USB
   //======================= AFP 09-22-22
 
   switch (bands[currentBand].mode) {
     case DEMOD_LSB :
-      tft.fillRect(centerLine - filterWidth + oldCursorPosition, SPECTRUM_TOP_Y + 20, filterWidth*0.96, SPECTRUM_HEIGHT - 20, RA8875_BLACK);
-      tft.fillRect(centerLine - filterWidth + newCursorPosition, SPECTRUM_TOP_Y + 20, filterWidth, SPECTRUM_HEIGHT - 20, FILTER_WIN);
+      tft.fillRect(centerLine - filterWidth + oldCursorPosition + oldShiftPosition, SPECTRUM_TOP_Y + 20, filterWidth*0.96, SPECTRUM_HEIGHT - 20, RA8875_BLACK);
+      tft.fillRect(centerLine - filterWidth + newCursorPosition + newShiftPosition, SPECTRUM_TOP_Y + 20, filterWidth, SPECTRUM_HEIGHT - 20, FILTER_WIN);
       tft.drawFastVLine(centerLine + oldCursorPosition, SPECTRUM_TOP_Y + 20, h - 10, RA8875_BLACK);         // Yep. Erase old, draw new...
       tft.drawFastVLine(centerLine + newCursorPosition, SPECTRUM_TOP_Y + 20, h - 10, RA8875_CYAN); //AFP 10-20-22
       BandInformation();
       break;
 
     case DEMOD_USB :
-      tft.fillRect(centerLine + oldCursorPosition, SPECTRUM_TOP_Y + 20, filterWidth, SPECTRUM_HEIGHT - 20, RA8875_BLACK); //AFP 03-27-22 Layers
-      tft.fillRect(centerLine + newCursorPosition, SPECTRUM_TOP_Y + 20, filterWidth, SPECTRUM_HEIGHT - 20, FILTER_WIN); //AFP 03-27-22 Layers
+      tft.fillRect(centerLine + oldCursorPosition + oldShiftPosition, SPECTRUM_TOP_Y + 20, filterWidth, SPECTRUM_HEIGHT - 20, RA8875_BLACK); //AFP 03-27-22 Layers
+      tft.fillRect(centerLine + newCursorPosition + newShiftPosition, SPECTRUM_TOP_Y + 20, filterWidth, SPECTRUM_HEIGHT - 20, FILTER_WIN); //AFP 03-27-22 Layers
       tft.drawFastVLine(centerLine + oldCursorPosition, SPECTRUM_TOP_Y + 20, h - 10, RA8875_BLACK); // Yep. Erase old, draw new...//AFP 03-27-22 Layers
       tft.drawFastVLine(centerLine + newCursorPosition , SPECTRUM_TOP_Y + 20, h - 10, RA8875_CYAN); //AFP 03-27-22 Layers
       BandInformation();
@@ -1345,6 +1607,7 @@ void DrawBandWidthIndicatorBar()  // AFP 10-30-22
   }
 
   oldCursorPosition = newCursorPosition;
+  oldShiftPosition = newShiftPosition;
 
   tft.writeTo(L1); //AFP 03-27-22 Layers
 }
@@ -1445,6 +1708,10 @@ void EraseSecondaryMenu()
 *****/
 void ShowTransmitReceiveStatus()
 {
+  if (!WidgetChanged(WIDGET_TR, xrState)) {                     // Called on every pass of loop()
+    return;
+  }
+  DisplaySpiCount(SPI_BYTES_SHAPE + SPI_BYTES_TEXT + 3 * SPI_BYTES_CHAR);
   tft.setFontScale( (enum RA8875tsize) 1);
   tft.setTextColor(RA8875_BLACK);
   if (xrState == TRANSMIT_STATE) {
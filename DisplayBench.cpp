@@ -0,0 +1,190 @@
+#ifndef BEENHERE
+#include "SDT.h"
+#endif
+
+/**********************************************************************************
+  Display benchmark
+
+  The main drawing paths as scenes, each run as DisplayBenchPrepare(), DisplayBenchDraw()
+  and DisplayBenchFinish(), so that only the drawing is between the first two and the last:
+
+    RedrawDisplayScreen()       the whole screen, as after a menu
+    Status, all drawn           every status widget from nothing
+    Status, unchanged           the same calls again, which should send almost nothing
+    Frequency, full             both frequencies drawn whole, as every detent used to
+    Frequency, one step         the digits one tuning step changes
+    Spectrum, full              one ShowSpectrum() frame drawn from a clear plot
+    Spectrum, steady            DISPLAY_BENCH_FRAMES frames, only what changed
+
+  On the radio DisplayBenchmark(), typed 'b' in the Serial Monitor, prints the time each
+  took and the SPI bytes DisplaySpiCount() estimates for it. The DSP task keeps running, and
+  the time it takes out of loop() is in every figure; run it twice before reading much into
+  a few percent. The host build's DisplayTest runs the same scenes, and the menus, on the
+  RA8875 emulator, which counts the bytes on the bus and checks the screen against reference
+  images, see host/README.md.
+
+  Before each spectrum scene DisplayBenchPrepare() waits for the DSP task to publish a
+  frame, so the spectrum figures are drawing only.
+**********************************************************************************/
+
+const char *displayBenchNames[] = { "RedrawDisplayScreen", "Status, all drawn", "Status, unchanged",
+                                    "Frequency, full", "Frequency, one step", "Spectrum, full",
+                                    "Spectrum, steady" };
+const int displayBenchRuns[]    = { 1, 1, 1, 1, 1, 1, DISPLAY_BENCH_FRAMES };
+static long displayBenchFreq;
+
+/*****
+  Purpose: Call every status field the way loop() and tuning do
+
+  Parameter list:
+    void
+
+  Return value;
+    void
+*****/
+void DisplayBenchStatus()
+{
+  ShowFrequency();
+  BandInformation();
+  DisplaydbM();
+  ShowTransmitReceiveStatus();
+  tft.setFontScale( (enum RA8875tsize) 1);
+  UpdateVolumeField();
+  UpdateAGCField();
+  tft.setFontScale( (enum RA8875tsize) 0);
+  UpdateIncrementField();
+  UpdateNotchField();
+  UpdateNoiseField();
+  UpdateZoomField();
+  UpdateCompressionField();
+  UpdateWPMField();
+  UpdateDecoderField();
+}
+
+/*****
+  Purpose: Set up one run of a scene
+
+  Parameter list:
+    int scene               BENCH_REDRAW to BENCH_SPECTRUM_STEADY
+
+  Return value;
+    int                     0 if a spectrum scene cannot run as the DSP task is not running
+*****/
+int DisplayBenchPrepare(int scene)
+{
+  switch (scene) {
+    case BENCH_STATUS_ALL:
+      WidgetsInvalidate();
+      break;
+
+    case BENCH_FREQ_FULL:
+      WidgetForget(WIDGET_FREQ_MAIN);
+      WidgetForget(WIDGET_FREQ_OTHER);
+      break;
+
+    case BENCH_FREQ_STEP:
+      displayBenchFreq = TxRxFreq;                      // Only the display is changed, not the radio
+      TxRxFreq += freqIncrement;
+      break;
+
+    case BENCH_SPECTRUM_FULL:
+    case BENCH_SPECTRUM_STEADY:
+      if (scene == BENCH_SPECTRUM_FULL) {
+        spectrumRedrawAll = 1;
+      }
+      while (spectrumFrameHead == spectrumFrameTail) {
+        if (DSPTaskRunning() == 0) {
+          return 0;
+        }
+#ifdef IQ_REPLAY
+        IQReplayService();
+#endif
+        delayMicroseconds(10);
+      }
+      break;
+  }
+  return 1;
+}
+
+/*****
+  Purpose: The drawing of one run of a scene
+
+  Parameter list:
+    int scene
+
+  Return value;
+    void
+*****/
+void DisplayBenchDraw(int scene)
+{
+  switch (scene) {
+    case BENCH_REDRAW:
+      RedrawDisplayScreen();
+      break;
+
+    case BENCH_STATUS_ALL:
+    case BENCH_STATUS_UNCHANGED:
+      DisplayBenchStatus();
+      break;
+
+    case BENCH_FREQ_FULL:
+    case BENCH_FREQ_STEP:
+      ShowFrequency();
+      break;
+
+    case BENCH_SPECTRUM_FULL:
+    case BENCH_SPECTRUM_STEADY:
+      ShowSpectrum();
+      break;
+  }
+}
+
+/*****
+  Purpose: Undo what one run of a scene changed
+
+  Parameter list:
+    int scene
+
+  Return value;
+    void
+*****/
+void DisplayBenchFinish(int scene)
+{
+  if (scene == BENCH_FREQ_STEP) {
+    TxRxFreq = displayBenchFreq;
+    ShowFrequency();
+  }
+}
+
+/*****
+  Purpose: Time each scene and print the time and estimated SPI bytes of a run to USB serial
+
+  Parameter list:
+    void
+
+  Return value;
+    void
+*****/
+void DisplayBenchmark()
+{
+  uint32_t start, startBytes, us, bytes;
+
+  Serial.println("\nDisplay path                 us      bytes (estimated)");
+  for (int scene = 0; scene < BENCH_SCENES; scene++) {
+    us = 0;
+    bytes = 0;
+    for (int run = 0; run < displayBenchRuns[scene]; run++) {
+      if (DisplayBenchPrepare(scene) == 0) {
+        Serial.println("Spectrum not measured, the DSP task is not running");
+        return;
+      }
+      startBytes = displaySpiBytes;
+      start = micros();
+      DisplayBenchDraw(scene);
+      us += micros() - start;
+      bytes += displaySpiBytes - startBytes;
+      DisplayBenchFinish(scene);
+    }
+    Serial.printf("%-22s %8lu %10lu\n", displayBenchNames[scene], us / displayBenchRuns[scene], bytes / displayBenchRuns[scene]);
+  }
+}
@@ -0,0 +1,166 @@
+#ifndef BEENHERE
+#include "SDT.h"
+#endif
+
+/**********************************************************************************
+  Display command queue
+
+  The DSP task (DSPTimerISR()) must never wait on the RA8875. Every tft call is a blocking
+  SPI transaction, and the bus may already be in the middle of one from loop(). So the DSP
+  functions that have something to show, the CW decoder (lock indicator, decoded text, WPM
+  estimate) and the SAM demodulator (carrier offset), post a small command to displayQueue[]
+  instead. DisplayQueueDrain() carries the commands out from ShowSpectrum(), in loop()
+  context, where a blocking SPI call only delays the display.
+
+  displayQueue[] is a ring with one producer, the DSP task, and one consumer, loop(). The
+  producer fills the slot before it moves displayQueueHead, and the consumer never reads past
+  it, so no lock is needed. A barrier on each side keeps the compiler and the processor from
+  moving the slot accesses past the index that hands them over, as for spectrumFrames[]. Only the DSP task may post. When the ring is full the new command
+  is dropped and counted; the DSP task never waits for room.
+
+  A command with a key other than DISPLAY_KEY_NONE replaces any earlier command with the
+  same key still waiting in the ring. Only the newest carrier offset or lock state is drawn,
+  however many blocks went by since the last frame.
+
+  The Teensy RA8875 library drives the bus with blocking transfers and polls the controller's
+  busy flag between commands, so the drain is not DMA driven. Because it runs in loop(), the
+  audio path never waits for it.
+**********************************************************************************/
+
+struct displayCommand displayQueue[DISPLAY_QUEUE_SIZE];
+volatile uint32_t displayQueueHead = 0;                 // Next slot the DSP task fills
+volatile uint32_t displayQueueTail = 0;                 // Next slot DisplayQueueDrain() reads
+volatile uint32_t displayQueueDropped = 0;
+uint32_t displayQueueDrawn = 0;
+uint32_t displayQueueCoalesced = 0;
+
+/*****
+  Purpose: Add a command to the display queue. DSP task only.
+
+  Parameter list:
+    const struct displayCommand *command
+
+  Return value;
+    int                     1 if queued, 0 if the queue was full and the command dropped
+*****/
+int DisplayQueuePost(const struct displayCommand *command)
+{
+  uint32_t head = displayQueueHead;
+  uint32_t next = (head + 1) % DISPLAY_QUEUE_SIZE;
+
+  if (next == displayQueueTail) {
+    displayQueueDropped++;
+    return 0;
+  }
+  displayQueue[head] = *command;
+  __DSB();                                              // The slot is written before the head moves
+  displayQueueHead = next;
+  return 1;
+}
+
+/*****
+  Purpose: Queue a filled rectangle
+
+  Parameter list:
+    uint8_t key             DISPLAY_KEY_ value, DISPLAY_KEY_NONE if it is never replaced
+    int16_t x, y, w, h
+    uint16_t color
+
+  Return value;
+    int                     1 if queued
+*****/
+int DisplayQueueFillRect(uint8_t key, int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+  struct displayCommand command = { DISPLAY_CMD_FILL_RECT, key, color, x, y, w, h, 0 };
+
+  return DisplayQueuePost(&command);
+}
+
+/*****
+  Purpose: Queue a value for one of the fields drawn by its own function
+
+  Parameter list:
+    uint8_t kind            DISPLAY_CMD_CW_TEXT, DISPLAY_CMD_CW_WPM or DISPLAY_CMD_SAM_OFFSET
+    uint8_t key
+    int32_t value
+
+  Return value;
+    int                     1 if queued
+*****/
+int DisplayQueueValue(uint8_t kind, uint8_t key, int32_t value)
+{
+  struct displayCommand command = { kind, key, 0, 0, 0, 0, 0, value };
+
+  return DisplayQueuePost(&command);
+}
+
+/*****
+  Purpose: Draw everything waiting in the display queue, skipping commands a later one with the
+           same key replaces. Called from ShowSpectrum().
+
+  Parameter list:
+    void
+
+  Return value;
+    int                     commands drawn
+*****/
+int DisplayQueueDrain()
+{
+  int16_t newest[DISPLAY_KEYS];
+  uint32_t head = displayQueueHead;                     // Commands posted meanwhile wait for the next drain
+  uint32_t tail = displayQueueTail;
+  struct displayCommand *command;
+  int drawn = 0;
+
+  if (head == tail) {
+    return 0;
+  }
+  __DSB();                                              // Slots are read only after the head that covers them
+  for (int k = 0; k < DISPLAY_KEYS; k++) {
+    newest[k] = -1;
+  }
+  for (uint32_t i = tail; i != head; i = (i + 1) % DISPLAY_QUEUE_SIZE) {
+    newest[displayQueue[i].key] = i;
+  }
+  for (uint32_t i = tail; i != head; i = (i + 1) % DISPLAY_QUEUE_SIZE) {
+    command = &displayQueue[i];
+    if (command->key != DISPLAY_KEY_NONE && newest[command->key] != (int16_t)i) {
+      displayQueueCoalesced++;
+      continue;
+    }
+    switch (command->kind) {
+      case DISPLAY_CMD_FILL_RECT:
+        tft.fillRect(command->x, command->y, command->w, command->h, command->color);
+        break;
+      case DISPLAY_CMD_CW_TEXT:
+        ShowDecodedText();
+        break;
+      case DISPLAY_CMD_CW_WPM:
+        ShowWPMEstimate(command->value);
+        break;
+      case DISPLAY_CMD_SAM_OFFSET:
+        ShowSAMOffset(command->value);
+        break;
+    }
+    drawn++;
+  }
+  __DSB();                                              // Finished with the slots before the DSP task may reuse them
+  displayQueueTail = head;
+  displayQueueDrawn += drawn;
+  return drawn;
+}
+
+/*****
+  Purpose: Print the display queue counters to USB serial
+
+  Parameter list:
+    void
+
+  Return value;
+    void
+*****/
+void DisplayQueuePrintReport()
+{
+  Serial.printf("Display queue: %lu drawn, %lu replaced by newer, %lu dropped when full\n",
+                displayQueueDrawn, displayQueueCoalesced, displayQueueDropped);
+}
@@ -14,6 +14,7 @@
 void EEPROMRead()
 {
   EEPROM.get(EEPROM_BASE_ADDRESS, EEPROMData);                // Read as one large chunk
+  EEPROMData.versionSettings[sizeof(EEPROMData.versionSettings) - 1] = '\0';  // Erased EEPROM is all 0xFF, with no terminator
 
   strcpy(versionSettings, EEPROMData.versionSettings);
   AGCMode                 = EEPROMData.AGCMode;
@@ -31,6 +31,13 @@ void FilterSetSSB()
         filterWidth = 50;
     }
     last_filter_pos = filter_pos;
+    if (switchFilterSideband == FILTER_SHIFT) {           // Passband shift, one mask bin a click
+      passbandShift -= filter_change * MaskBinHz();
+      FilterBandwidth();
+      DrawBandWidthIndicatorBar();
+      ShowFrequency();
+      return;
+    }
     // =============  AFP 10-27-22
     switch (bands[currentBand].mode) {
       case DEMOD_LSB :
@@ -59,13 +66,11 @@ void FilterSetSSB()
         bands[currentBand].FHiCut = bands[currentBand].FHiCut - filter_change * 50 * ENCODER_FACTOR;
         bands[currentBand].FLoCut = -bands[currentBand].FHiCut;
         FilterBandwidth();
-        InitFilterMask();
         break;
       case DEMOD_SAM : // AFP 11-03-22
         bands[currentBand].FHiCut = bands[currentBand].FHiCut - filter_change * 50 * ENCODER_FACTOR;
         bands[currentBand].FLoCut = -bands[currentBand].FHiCut;
         FilterBandwidth();
-        InitFilterMask();
         break;
     }
     // =============  AFP 10-27-22
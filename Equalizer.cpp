@@ -0,0 +1,249 @@
+#ifndef BEENHERE
+#include "SDT.h"
+#endif
+
+/**********************************************************************************
+  14 band graphic equalizer
+
+  The output is the sum of 14 fourth order 1/3 octave band filters (EQ_Band1Coeffs..
+  EQ_Band14Coeffs), each scaled by its level, with alternating sign so adjacent bands add up
+  flat. The old code filtered the block into 14 buffers, scaled each and added them together.
+  Here the level and sign of each band are folded into the feedforward taps of its first
+  biquad. Each band then runs all of its stages in one loop, with its state in registers, and
+  adds straight into the output. The folded coefficients are rebuilt only when a level in
+  EEPROMData changes.
+
+  Running band by band over the block, rather than all 14 bands for each sample, keeps each
+  band's 8 state values in FPU registers. All 112 would not fit.
+
+  With receiveEQFlag set to EQ_MASK, the receive equalizer is not run on the audio at all.
+  Its magnitude response is built into the filter's taps before InitFilterMask() takes their
+  FFT, so it costs nothing per block. Multiplying the mask itself by the response would not
+  do: that makes a filter longer than the m_NumTaps overlap-save allows for, and the excess
+  wraps round into the output. EqualizerApplyToTaps() instead applies the response on the
+  grid MaskMinimumPhase() uses, MIN_PHASE_OVERSAMPLE times finer than the mask's, and cuts
+  the result back to m_NumTaps with a short taper at each end. The lowest bands are 60 Hz
+  wide, narrower than the filter can resolve at the default 257 taps, so they are smoothed.
+  The equalizer's response has zero phase, so a linear phase filter stays linear phase. With
+  a minimum phase mask selected, MaskMinimumPhase() converts the filter with the equalizer
+  already in it, so the mask is minimum phase as well.
+**********************************************************************************/
+
+#if IIR_ORDER != 8
+#error "Equalize() is unrolled for four biquad stages per band"
+#endif
+
+struct equalizer rxEqualizer;
+struct equalizer txEqualizer;
+
+float32_t *eqBandCoeffs[EQUALIZER_CELL_COUNT] = {
+  EQ_Band1Coeffs, EQ_Band2Coeffs, EQ_Band3Coeffs, EQ_Band4Coeffs, EQ_Band5Coeffs, EQ_Band6Coeffs, EQ_Band7Coeffs,
+  EQ_Band8Coeffs, EQ_Band9Coeffs, EQ_Band10Coeffs, EQ_Band11Coeffs, EQ_Band12Coeffs, EQ_Band13Coeffs, EQ_Band14Coeffs
+};
+
+/*****
+  Purpose: Clear an equalizer's state and force its coefficients to be rebuilt on first use
+
+  Parameter list:
+    struct equalizer *eq
+
+  Return value;
+    void
+*****/
+void InitEqualizer(struct equalizer *eq)
+{
+  memset(eq->state, 0, sizeof(eq->state));
+  for (int b = 0; b < EQUALIZER_CELL_COUNT; b++) {
+    eq->level[b] = -1;
+  }
+}
+
+/*****
+  Purpose: Rebuild the folded band coefficients if any level has changed
+
+  Parameter list:
+    struct equalizer *eq
+    const int *level        EQUALIZER_CELL_COUNT levels, 100 = unity, normally EEPROMData.equalizerRec
+
+  Return value;
+    void
+*****/
+void EqualizerSetLevels(struct equalizer *eq, const int *level)
+{
+  float32_t gain;
+
+  for (int b = 0; b < EQUALIZER_CELL_COUNT; b++) {
+    if (eq->level[b] == level[b]) {
+      continue;
+    }
+    eq->level[b] = level[b];
+    gain = (float32_t)level[b] / 100.0;
+    if ((b & 1) == 0) {                                   // Odd numbered bands are inverted
+      gain = -gain;
+    }
+    memcpy(eq->coeffs[b], eqBandCoeffs[b], sizeof(eq->coeffs[b]));
+    eq->coeffs[b][0] *= gain;                             // b0, b1, b2 of the first stage
+    eq->coeffs[b][1] *= gain;
+    eq->coeffs[b][2] *= gain;
+  }
+}
+
+/*****
+  Purpose: Equalize a block in place
+
+  Parameter list:
+    struct equalizer *eq
+    const int *level        EQUALIZER_CELL_COUNT levels, 100 = unity
+    float32_t *buffer       blockSize samples, in and out
+    uint32_t blockSize
+
+  Return value;
+    void
+*****/
+FASTRUN void Equalize(struct equalizer *eq, const int *level, float32_t *buffer, uint32_t blockSize)
+{
+  uint32_t mark = ScratchMark();
+  float32_t *in = ScratchAlloc(blockSize);
+  float32_t x, y;
+
+  if (in == NULL) {                                       // Scratch arena full, pass the block through
+    return;
+  }
+  EqualizerSetLevels(eq, level);
+  memcpy(in, buffer, blockSize * sizeof(float32_t));
+  memset(buffer, 0, blockSize * sizeof(float32_t));
+
+  for (int b = 0; b < EQUALIZER_CELL_COUNT; b++) {
+    const float32_t *c = eq->coeffs[b];
+    float32_t *state = eq->state[b];
+    float32_t d0 = state[0], d1 = state[1], d2 = state[2], d3 = state[3];
+    float32_t d4 = state[4], d5 = state[5], d6 = state[6], d7 = state[7];
+
+    for (unsigned n = 0; n < blockSize; n++) {            // Transposed direct form II, CMSIS coefficient order
+      x = in[n];
+      y  = c[0] * x + d0;
+      d0 = c[1] * x + c[3] * y + d1;
+      d1 = c[2] * x + c[4] * y;
+      x  = y;
+      y  = c[5] * x + d2;
+      d2 = c[6] * x + c[8] * y + d3;
+      d3 = c[7] * x + c[9] * y;
+      x  = y;
+      y  = c[10] * x + d4;
+      d4 = c[11] * x + c[13] * y + d5;
+      d5 = c[12] * x + c[14] * y;
+      x  = y;
+      y  = c[15] * x + d6;
+      d6 = c[16] * x + c[18] * y + d7;
+      d7 = c[17] * x + c[19] * y;
+      buffer[n] += y;
+    }
+    state[0] = d0; state[1] = d1; state[2] = d2; state[3] = d3;
+    state[4] = d4; state[5] = d5; state[6] = d6; state[7] = d7;
+  }
+  ScratchRelease(mark);
+}
+
+/*****
+  Purpose: Magnitude response of the whole band bank at one frequency, levels and signs included.
+           EqualizerSetLevels() must have been called.
+
+  Parameter list:
+    const struct equalizer *eq
+    float32_t w             radians per sample at the rate the equalizer runs at
+
+  Return value;
+    float32_t               |H(e^jw)|
+*****/
+float32_t EqualizerMagnitude(const struct equalizer *eq, float32_t w)
+{
+  float32_t c1, s1, c2, s2;
+  float32_t sumRe = 0.0, sumIm = 0.0, hRe, hIm, nRe, nIm, dRe, dIm, tRe, den;
+  const float32_t *c;
+
+  c1 = cosf(w);                                           // z^-1 and z^-2 on the unit circle
+  s1 = -sinf(w);
+  c2 = cosf(2.0 * w);
+  s2 = -sinf(2.0 * w);
+  for (int b = 0; b < EQUALIZER_CELL_COUNT; b++) {
+    hRe = 1.0;
+    hIm = 0.0;
+    for (int s = 0; s < IIR_NUMSTAGES; s++) {
+      c = &eq->coeffs[b][s * 5];
+      nRe = c[0] + c[1] * c1 + c[2] * c2;                 // b0 + b1 z^-1 + b2 z^-2
+      nIm = c[1] * s1 + c[2] * s2;
+      dRe = 1.0 - c[3] * c1 - c[4] * c2;                  // 1 - a1 z^-1 - a2 z^-2, CMSIS signs
+      dIm = -c[3] * s1 - c[4] * s2;
+      den = dRe * dRe + dIm * dIm;
+      tRe = (nRe * dRe + nIm * dIm) / den;                // n / d
+      nIm = (nIm * dRe - nRe * dIm) / den;
+      nRe = tRe;
+      tRe = hRe * nRe - hIm * nIm;                        // h *= n / d
+      hIm = hRe * nIm + hIm * nRe;
+      hRe = tRe;
+    }
+    sumRe += hRe;
+    sumIm += hIm;
+  }
+  return sqrtf(sumRe * sumRe + sumIm * sumIm);
+}
+
+/*****
+  Purpose: Build the magnitude response of the equalizer into a filter's taps, in place, without
+           making the filter any longer. Uses minPhaseWork, so it is only called from loop() code.
+
+  Parameter list:
+    struct equalizer *eq
+    const int *level        EQUALIZER_CELL_COUNT levels, 100 = unity
+    float32_t *tapsI        numTaps taps, real parts, normally FIR_Coef_I
+    float32_t *tapsQ        imaginary parts, normally FIR_Coef_Q
+    uint32_t numTaps        m_NumTaps
+
+  Return value;
+    void
+*****/
+void EqualizerApplyToTaps(struct equalizer *eq, const int *level, float32_t *tapsI, float32_t *tapsQ, uint32_t numTaps)
+{
+  uint32_t n = FFT_length * MIN_PHASE_OVERSAMPLE;
+  const arm_cfft_instance_f32 *fft;
+  float32_t *w = minPhaseWork;
+  float32_t mag, taper;
+  uint32_t taperLength = numTaps / 8;
+
+  if (n > MIN_PHASE_FFT_MAX) {
+    n = MIN_PHASE_FFT_MAX;
+  }
+  fft = (n == 4096) ? &arm_cfft_sR_f32_len4096 : ConvolutionFFT(n);
+  EqualizerSetLevels(eq, level);
+
+  for (uint32_t i = 0; i < numTaps; i++) {                // The filter, zero padded onto the fine grid
+    w[2 * i] = tapsI[i];
+    w[2 * i + 1] = tapsQ[i];
+  }
+  memset(&w[2 * numTaps], 0, (n - numTaps) * 2 * sizeof(float32_t));
+  arm_cfft_f32(fft, w, 0, 1);
+
+  for (uint32_t k = 0; k <= n / 2; k++) {                 // |H| is even, bin n - k is at -w
+    mag = EqualizerMagnitude(eq, TWO_PI * (float32_t)k / (float32_t)n);
+    w[2 * k] *= mag;
+    w[2 * k + 1] *= mag;
+    if (k > 0 && k < n / 2) {
+      w[2 * (n - k)] *= mag;
+      w[2 * (n - k) + 1] *= mag;
+    }
+  }
+
+  // Back to taps. The equalizer has zero phase, so the filter is spread both ways about its
+  // center; cut it back to numTaps with a raised cosine over the first and last eighth.
+  arm_cfft_f32(fft, w, 1, 1);
+  for (uint32_t i = 0; i < numTaps; i++) {
+    taper = 1.0;
+    if (i < taperLength) {
+      taper = 0.5 - 0.5 * cosf(PI * (float32_t)(i + 1) / (float32_t)(taperLength + 1));
+    } else if (i >= numTaps - taperLength) {
+      taper = 0.5 - 0.5 * cosf(PI * (float32_t)(numTaps - i) / (float32_t)(taperLength + 1));
+    }
+    tapsI[i] = w[2 * i] * taper;
+    tapsQ[i] = w[2 * i + 1] * taper;
+  }
+}
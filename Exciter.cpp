@@ -56,19 +56,13 @@ void ExciterIQData()
 
     /**********************************************************************************  AFP 12-31-20
               Decimation is the process of downsampling the data stream and LP filtering
-              Decimation is done in two stages to prevent reversal of the spectrum, which occure with each even
-              Decimation.  First select every 4th asmple and then every 2nd sample, yielding 8x downsampling
-              192KHz/8 = 24KHz, with 8xsmaller sample sizes
+              Decimation is done by the same three stage half-band decimator as the receiver,
+              yielding 8x downsampling 192KHz/8 = 24KHz, with 8xsmaller sample sizes
      **********************************************************************************/
 
     // 192KHz effective sample rate here
-    // decimation-by-4 in-place!
-    arm_fir_decimate_f32(&FIR_dec1_EX_I, float_buffer_L_EX, float_buffer_L_EX, BUFFER_SIZE * N_BLOCKS_EX );
-    arm_fir_decimate_f32(&FIR_dec1_EX_Q, float_buffer_R_EX, float_buffer_R_EX, BUFFER_SIZE * N_BLOCKS_EX );
-    // 48KHz effective sample rate here
-    // decimation-by-2 in-place
-    arm_fir_decimate_f32(&FIR_dec2_EX_I, float_buffer_L_EX, float_buffer_L_EX, 512);
-    arm_fir_decimate_f32(&FIR_dec2_EX_Q, float_buffer_R_EX, float_buffer_R_EX, 512);
+    // decimation-by-8 in-place
+    Decimate(&txDecimator, float_buffer_L_EX, float_buffer_R_EX, BUFFER_SIZE * N_BLOCKS_EX);
 
     //============================  Transmit EQ  ========================  AFP 10-02-22
     if (xmitEQFlag == ON ) {
@@ -117,25 +111,18 @@ void ExciterIQData()
               Requires a LPF FIR 48 tap 10KHz and 8KHz
      **********************************************************************************/
     //24KHz effective sample rate here
-    arm_fir_interpolate_f32(&FIR_int1_EX_I, float_buffer_L_EX, float_buffer_LTemp, 256);
-    arm_fir_interpolate_f32(&FIR_int1_EX_Q, float_buffer_R_EX, float_buffer_RTemp, 256);
-
-    // interpolation-by-4,  48KHz effective sample rate here
-    arm_fir_interpolate_f32(&FIR_int2_EX_I, float_buffer_LTemp, float_buffer_L_EX, 512);
-    arm_fir_interpolate_f32(&FIR_int2_EX_Q, float_buffer_RTemp, float_buffer_R_EX, 512);
-    //  192KHz effective sample rate here
-    arm_scale_f32(float_buffer_L_EX, 20, float_buffer_L_EX, 2048); //Scale to compensate for losses in Interpolation
-    arm_scale_f32(float_buffer_R_EX, 20, float_buffer_R_EX, 2048);
+    Interpolate(&txInterpolator, float_buffer_L_EX, float_buffer_R_EX, 256);
+    //  96KHz effective sample rate here, the last stage runs below straight into the audio buffers
 
     /**********************************************************************************  AFP 12-31-20
       CONVERT TO INTEGER AND PLAY AUDIO
+      Gain of 2.5 makes up the old interpolation scaling of 20, less the 8 the interpolator now provides
     **********************************************************************************/
 
     for (unsigned  i = 0; i < N_BLOCKS_EX; i++) {  //N_BLOCKS_EX=16  BUFFER_SIZE=128 16x128=2048
       sp_L2 = Q_out_L_Ex.getBuffer();
       sp_R2 = Q_out_R_Ex.getBuffer();
-      arm_float_to_q15 (&float_buffer_L_EX[BUFFER_SIZE * i], sp_L2, BUFFER_SIZE);
-      arm_float_to_q15 (&float_buffer_R_EX[BUFFER_SIZE * i], sp_R2, BUFFER_SIZE);
+      InterpolateOutput(&txInterpolator, &float_buffer_L_EX[BUFFER_SIZE / 2 * i], &float_buffer_R_EX[BUFFER_SIZE / 2 * i], sp_L2, sp_R2, BUFFER_SIZE / 2, 2.5);
       Q_out_L_Ex.playBuffer(); // play it !
       Q_out_R_Ex.playBuffer(); // play it !
     }
@@ -16,6 +16,7 @@ void ZoomFFTPrep()
 { // take value of spectrum_zoom and initialize IIR lowpass and FIR decimation filters for the right values
 
   tft.fillRect(SPECTRUM_LEFT_X , SPECTRUM_TOP_Y + 1, MAX_WATERFALL_WIDTH , SPECTRUM_HEIGHT - 2,  RA8875_BLACK);
+  spectrumRedrawAll = 1;                                    // ShowSpectrum() must not rely on what it drew before
   float32_t Fstop_Zoom = 0.5 * (float32_t) SR[SampleRate].rate / (1 << spectrum_zoom);
   CalcFIRCoeffs(Fir_Zoom_FFT_Decimate_coeffs, 4, Fstop_Zoom, 60, 0, 0.0, (float32_t)SR[SampleRate].rate);
 
@@ -46,8 +47,13 @@ void ZoomFFTPrep()
 void ZoomFFTExe(uint32_t blockSize)  //AFP changed resolution 03-12-21  Only for spectrum Zoom > 1
 {
   if (updateDisplayFlag == 1) {  //Runs display FFT routine only once for each Audio process FFT.  Cuts number of FFTs by 1/512.
-    float32_t x_buffer[blockSize];                      // can be 4096 [FFT length == 1024] or even 8192 [FFT length == 2048]
-    float32_t y_buffer[blockSize];
+    uint32_t mark = ScratchMark();
+    float32_t *x_buffer = ScratchAlloc(blockSize);      // can be 4096 [FFT length == 1024] or even 8192 [FFT length == 2048]
+    float32_t *y_buffer = ScratchAlloc(blockSize);
+    if (y_buffer == NULL) {                             // Scratch arena full, skip this display update
+      ScratchRelease(mark);
+      return;
+    }
     static float32_t FFT_ring_buffer_x[SPECTRUM_RES*2];
     static float32_t FFT_ring_buffer_y[SPECTRUM_RES*2];
     int sample_no = SPECTRUM_RES;                       // sample_no is 256, in high magnify modes it is smaller!
@@ -81,18 +87,20 @@ void ZoomFFTExe(uint32_t blockSize)  //AFP changed resolution 03-12-21  Only for
     } else {                                                // I have to think about this:
       zoom_display = 0;                                     // when do we want to display a new spectrum?
     }
+    ScratchRelease(mark);
     float32_t multiplier = (float32_t)spectrum_zoom;
     if (spectrum_zoom > SPECTRUM_ZOOM_8) { // && spectrum_zoom < SPECTRUM_ZOOM_1024) {
       multiplier = (float32_t)(1 << spectrum_zoom);
     }
     for (int idx = 0; idx < SPECTRUM_RES; idx++) {
-      buffer_spec_FFT[idx * 2 + 0] =  multiplier * FFT_ring_buffer_x[zoom_sample_ptr] * (0.5 - 0.5 * cos(6.28 * idx / SPECTRUM_RES)); //Hanning Window AFP 03-12-21
-      buffer_spec_FFT[idx * 2 + 1] =  multiplier * FFT_ring_buffer_y[zoom_sample_ptr] * (0.5 - 0.5 * cos(6.28 * idx / SPECTRUM_RES));
+      buffer_spec_FFT[idx * 2 + 0] =  multiplier * FFT_ring_buffer_x[zoom_sample_ptr];
+      buffer_spec_FFT[idx * 2 + 1] =  multiplier * FFT_ring_buffer_y[zoom_sample_ptr];
       zoom_sample_ptr++;
       if (zoom_sample_ptr >= SPECTRUM_RES) {
         zoom_sample_ptr = 0;
       }
     }
+    arm_cmplx_mult_real_f32(buffer_spec_FFT, spectrumWindow, buffer_spec_FFT, SPECTRUM_RES);   // See Window.cpp
     //***************
     // adjust lowpass filter coefficient, so that
     // "spectrum display smoothness" is the same across the different sample rates
@@ -125,9 +133,11 @@ void ZoomFFTExe(uint32_t blockSize)  //AFP changed resolution 03-12-21  Only for
       FFT_spec[x] = LPFcoeff * FFT_spec[x] + onem_LPFcoeff * FFT_spec_old[x];
       FFT_spec_old[x] = FFT_spec[x];
     }
+    SpectrumHoldUpdate(FFT_spec);
+    FastLog10Block(FFT_spec, FFT_spec, displayScale[currentScale].dBScale, SPECTRUM_RES);
 
     for (int16_t x = 0; x < SPECTRUM_RES; x++) {
-      pixelnew[x] = displayScale[currentScale].baseOffset + bands[currentBand].pixel_offset + (int16_t)(displayScale[currentScale].dBScale * log10f_fast(FFT_spec[x]));
+      pixelnew[x] = displayScale[currentScale].baseOffset + bands[currentBand].pixel_offset + (int16_t)FFT_spec[x];
       if (pixelnew[x] > 220) {
         pixelnew[x] = 220;
       }
@@ -144,6 +154,14 @@ void ZoomFFTExe(uint32_t blockSize)  //AFP changed resolution 03-12-21  Only for
 *****/
 void CalcZoom1Magn()
 {
+ int highRes = 0;
+
+ if (spectrumFFTLength > SPECTRUM_RES) {                    // Gathers every block, see HighResSpectrum.cpp
+   highRes = HighResSpectrum(BUFFER_SIZE * N_BLOCKS);
+   if (highRes == 0) {
+     updateDisplayFlag = 0;                                 // Nothing new to show, so no frame this block
+   }
+ }
  if (updateDisplayFlag == 1) {
   float32_t spec_help = 0.0;
   float32_t LPFcoeff = 0.7;
@@ -154,36 +172,44 @@ void CalcZoom1Magn()
     pixelold[i] = pixelnew[i];
   }
 
+  if (highRes) {                                            // Long FFT binned to the pixels
+    for (int16_t x = 0; x < SPECTRUM_RES; x++) {
+      FFT_spec_old[x] = LPFcoeff * FFT_spec[x] + (1.0 - LPFcoeff) * FFT_spec_old[x];
+    }
+  } else if (spectrumAverageDepth > 0) {                    // Averaged over the whole block, see Welch.cpp
+    WelchSpectrum(BUFFER_SIZE * N_BLOCKS);
+  } else {
+    for (int i = 0; i < SPECTRUM_RES; i++) { // interleave real and imaginary input values [real, imag, real, imag . . .]
+      buffer_spec_FFT[i * 2] =      float_buffer_L[i];
+      buffer_spec_FFT[i * 2 + 1] =  float_buffer_R[i];
+    }
+    arm_cmplx_mult_real_f32(buffer_spec_FFT, spectrumWindow, buffer_spec_FFT, SPECTRUM_RES);   // See Window.cpp
+    // perform complex FFT
+    // calculation is performed in-place the FFT_buffer [re, im, re, im, re, im . . .]
+    arm_cfft_f32(spec_FFT, buffer_spec_FFT, 0, 1);
 
-  for (int i = 0; i < SPECTRUM_RES; i++) { // interleave real and imaginary input values [real, imag, real, imag . . .]
-    buffer_spec_FFT[i * 2] =      float_buffer_L[i] * (0.5 - 0.5 * cos(6.28 * i / SPECTRUM_RES)); //Hanning
-    buffer_spec_FFT[i * 2 + 1] =  float_buffer_R[i] * (0.5 - 0.5 * cos(6.28 * i / SPECTRUM_RES));
-  }
-  // perform complex FFT
-  // calculation is performed in-place the FFT_buffer [re, im, re, im, re, im . . .]
-  arm_cfft_f32(spec_FFT, buffer_spec_FFT, 0, 1);
-
-  // calculate magnitudes and put into FFT_spec
-  // we do not need to calculate magnitudes with square roots, it would seem to be sufficient to
-  // calculate mag = I*I + Q*Q, because we are doing a log10-transformation later anyway
-  // and simultaneously put them into the right order
-  // 38.50%, saves 0.05% of processor power and 1kbyte RAM ;-)
+    // calculate magnitudes and put into FFT_spec
+    // we do not need to calculate magnitudes with square roots, it would seem to be sufficient to
+    // calculate mag = I*I + Q*Q, because we are doing a log10-transformation later anyway
+    // and simultaneously put them into the right order
+    // 38.50%, saves 0.05% of processor power and 1kbyte RAM ;-)
 
-  for (int i = 0; i < SPECTRUM_RES/2; i++) {
+    for (int i = 0; i < SPECTRUM_RES/2; i++) {
       FFT_spec[i + SPECTRUM_RES/2] = (buffer_spec_FFT[i * 2] * buffer_spec_FFT[i * 2] + buffer_spec_FFT[i * 2 + 1] * buffer_spec_FFT[i * 2 + 1]);
       FFT_spec[i]                  = (buffer_spec_FFT[(i + SPECTRUM_RES/2) * 2] * buffer_spec_FFT[(i + SPECTRUM_RES/2)  * 2] + buffer_spec_FFT[(i + SPECTRUM_RES/2)  * 2 + 1] * buffer_spec_FFT[(i + SPECTRUM_RES/2)  * 2 + 1]);
     }
-  // apply low pass filter and scale the magnitude values and convert to int for spectrum display
+    // apply low pass filter and scale the magnitude values and convert to int for spectrum display
 
-  for (int16_t x = 0; x < SPECTRUM_RES; x++) {
-    spec_help = LPFcoeff * FFT_spec[x] + (1.0 - LPFcoeff) * FFT_spec_old[x];
-    FFT_spec_old[x] = spec_help;
+    for (int16_t x = 0; x < SPECTRUM_RES; x++) {
+      spec_help = LPFcoeff * FFT_spec[x] + (1.0 - LPFcoeff) * FFT_spec_old[x];
+      FFT_spec_old[x] = spec_help;
+    }
+  }
+  SpectrumHoldUpdate(FFT_spec);
+  FastLog10Block(FFT_spec, FFT_spec, displayScale[currentScale].dBScale, SPECTRUM_RES);
 
-#ifdef USE_LOG10FAST
-    pixelnew[x] = displayScale[currentScale].baseOffset + bands[currentBand].pixel_offset + (int16_t) (displayScale[currentScale].dBScale * log10f_fast(FFT_spec[x]));
-#else
-    pixelnew[x] = displayScale[currentScale].baseOffset + bands[currentBand].pixel_offset + (int16_t) (displayScale[currentScale].dBScale * log10f(spec_help));
-#endif
+  for (int16_t x = 0; x < SPECTRUM_RES; x++) {
+    pixelnew[x] = displayScale[currentScale].baseOffset + bands[currentBand].pixel_offset + (int16_t)FFT_spec[x];
   }
  }
 } // end calc_256_magn
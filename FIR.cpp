@@ -173,110 +173,6 @@ float32_t CW_Filter_Coeffs[40] = {
 };
 //=== end CW Filter ===
 
-//=================== Excite Coefficients ============
-//48 Tap Kaiser 192KHz 8HKZ Fc filters Dec and Interpolation
-
-float32_t coeffs192K_10K_LPF_FIR[48] = {
-  -9.489855110236549150E-6,
-  162.0562443716462440E-6,
-  336.4923361276530040E-6,
-  670.1825668306562420E-6,
-  0.001118525968862066,
-  0.001579147826767285,
-  0.001852971855408917,
-  0.001654834862116168,
-  672.0062171704363440E-6,
-  -0.001330388414656256,
-  -0.004370672204695505,
-  -0.008116214105266742,
-  -0.011801558382590140,
-  -0.014244430060197440,
-  -0.013991286573630231,
-  -0.009591314629104829,
-  55.15979573749079630E-6,
-  0.015330868054737832,
-  0.035648433279783398,
-  0.059353733010970522,
-  0.083890755684744231,
-  0.106176326681328731,
-  0.123138113118064343,
-  0.132306356993624447,
-  0.132306356993624447,
-  0.123138113118064343,
-  0.106176326681328731,
-  0.083890755684744231,
-  0.059353733010970522,
-  0.035648433279783398,
-  0.015330868054737832,
-  55.15979573749079630E-6,
-  -0.009591314629104829,
-  -0.013991286573630231,
-  -0.014244430060197440,
-  -0.011801558382590140,
-  -0.008116214105266742,
-  -0.004370672204695505,
-  -0.001330388414656256,
-  672.0062171704363440E-6,
-  0.001654834862116168,
-  0.001852971855408917,
-  0.001579147826767285,
-  0.001118525968862066,
-  670.1825668306562420E-6,
-  336.4923361276530040E-6,
-  162.0562443716462440E-6,
-  -9.489855110236549150E-6
-};
-float32_t coeffs48K_8K_LPF_FIR[48] = {
-  42.07251256297374200E-6,
-  -140.7585461814297220E-6,
-  -474.6573692370658360E-6,
-  -910.1877217000583190E-6,
-  -0.001002380560950271,
-  -214.0330069096950180E-6,
-  0.001476493526486391,
-  0.003032917910844886,
-  0.002651184249675911,
-  -799.0261189923908200E-6,
-  -0.006003327154821903,
-  -0.008881895242516839,
-  -0.005014510701112499,
-  0.006071336723217765,
-  0.018084892184059984,
-  0.020179984097194015,
-  0.004666151232929589,
-  -0.024269532666953794,
-  -0.047977714295749374,
-  -0.041374408930560248,
-  0.011283003090050767,
-  0.102653022828769605,
-  0.201046155814701449,
-  0.264813622122047398,
-  0.264813622122047398,
-  0.201046155814701449,
-  0.102653022828769605,
-  0.011283003090050767,
-  -0.041374408930560248,
-  -0.047977714295749374,
-  -0.024269532666953794,
-  0.004666151232929589,
-  0.020179984097194015,
-  0.018084892184059984,
-  0.006071336723217765,
-  -0.005014510701112499,
-  -0.008881895242516839,
-  -0.006003327154821903,
-  -799.0261189923908200E-6,
-  0.002651184249675911,
-  0.003032917910844886,
-  0.001476493526486391,
-  -214.0330069096950180E-6,
-  -0.001002380560950271,
-  -910.1877217000583190E-6,
-  -474.6573692370658360E-6,
-  -140.7585461814297220E-6,
-  42.07251256297374200E-6
-};
-
 //4 pole Butterworth IIR biQuad filters for EQ  Band 1 thru 14
 float32_t EQ_Band1Coeffs[20] = {      //  fc=198.425 BW=60.4, 4 pole Gaussian 1/3 octave
   -0.010740354324803263, 0.000000000000000000, 0.010740354324803263, 1.977760288071182870, -0.980176703912204905,
@@ -1093,41 +989,6 @@ float32_t* mag_coeffs[11] =
 };
 
 
-const float32_t nuttallWindow256[] = {
-  0.0000001, 0.0000073, 0.0000292, 0.0000663, 0.0001192, 0.0001891, 0.0002771, 0.0003851,
-  0.0005147, 0.0006684, 0.0008485, 0.0010580, 0.0012998, 0.0015775, 0.0018947, 0.0022554,
-  0.0026639, 0.0031248, 0.0036429, 0.0042235, 0.0048719, 0.0055940, 0.0063956, 0.0072832,
-  0.0082631, 0.0093423, 0.0105278, 0.0118269, 0.0132470, 0.0147960, 0.0164817, 0.0183122,
-  0.0202960, 0.0224414, 0.0247569, 0.0272514, 0.0299336, 0.0328123, 0.0358966, 0.0391953,
-  0.0427173, 0.0464717, 0.0504671, 0.0547124, 0.0592163, 0.0639871, 0.0690332, 0.0743626,
-  0.0799832, 0.0859024, 0.0921274, 0.0986651, 0.1055218, 0.1127036, 0.1202159, 0.1280637,
-  0.1362515, 0.1447831, 0.1536618, 0.1628900, 0.1724698, 0.1824023, 0.1926880, 0.2033264,
-  0.2143164, 0.2256560, 0.2373424, 0.2493718, 0.2617397, 0.2744405, 0.2874677, 0.3008139,
-  0.3144707, 0.3284289, 0.3426782, 0.3572073, 0.3720040, 0.3870552, 0.4023469, 0.4178639,
-  0.4335904, 0.4495095, 0.4656036, 0.4818541, 0.4982416, 0.5147460, 0.5313464, 0.5480212,
-  0.5647480, 0.5815041, 0.5982659, 0.6150094, 0.6317101, 0.6483431, 0.6648832, 0.6813048,
-  0.6975821, 0.7136890, 0.7295995, 0.7452874, 0.7607267, 0.7758911, 0.7907549, 0.8052924,
-  0.8194782, 0.8332872, 0.8466949, 0.8596772, 0.8722106, 0.8842721, 0.8958396, 0.9068915,
-  0.9174074, 0.9273674, 0.9367527, 0.9455454, 0.9537289, 0.9612875, 0.9682065, 0.9744726,
-  0.9800736, 0.9849988, 0.9892383, 0.9927841, 0.9956291, 0.9977678, 0.9991959, 0.9999106,
-  0.9999106, 0.9991959, 0.9977678, 0.9956291, 0.9927841, 0.9892383, 0.9849988, 0.9800736,
-  0.9744726, 0.9682065, 0.9612875, 0.9537289, 0.9455454, 0.9367527, 0.9273674, 0.9174074,
-  0.9068915, 0.8958396, 0.8842721, 0.8722106, 0.8596772, 0.8466949, 0.8332872, 0.8194782,
-  0.8052924, 0.7907549, 0.7758911, 0.7607267, 0.7452874, 0.7295995, 0.7136890, 0.6975821,
-  0.6813048, 0.6648832, 0.6483431, 0.6317101, 0.6150094, 0.5982659, 0.5815041, 0.5647480,
-  0.5480212, 0.5313464, 0.5147460, 0.4982416, 0.4818541, 0.4656036, 0.4495095, 0.4335904,
-  0.4178639, 0.4023469, 0.3870552, 0.3720040, 0.3572073, 0.3426782, 0.3284289, 0.3144707,
-  0.3008139, 0.2874677, 0.2744405, 0.2617397, 0.2493718, 0.2373424, 0.2256560, 0.2143164,
-  0.2033264, 0.1926880, 0.1824023, 0.1724698, 0.1628900, 0.1536618, 0.1447831, 0.1362515,
-  0.1280637, 0.1202159, 0.1127036, 0.1055218, 0.0986651, 0.0921274, 0.0859024, 0.0799832,
-  0.0743626, 0.0690332, 0.0639871, 0.0592163, 0.0547124, 0.0504671, 0.0464717, 0.0427173,
-  0.0391953, 0.0358966, 0.0328123, 0.0299336, 0.0272514, 0.0247569, 0.0224414, 0.0202960,
-  0.0183122, 0.0164817, 0.0147960, 0.0132470, 0.0118269, 0.0105278, 0.0093423, 0.0082631,
-  0.0072832, 0.0063956, 0.0055940, 0.0048719, 0.0042235, 0.0036429, 0.0031248, 0.0026639,
-  0.0022554, 0.0018947, 0.0015775, 0.0012998, 0.0010580, 0.0008485, 0.0006684, 0.0005147,
-  0.0003851, 0.0002771, 0.0001891, 0.0001192, 0.0000663, 0.0000292, 0.0000073, 0.0000001
-};
-
 /*****
   Purpose: void calc_FIR_coeffs
     // pointer to coefficients variable, no. of coefficients to calculate, frequency where it happens, stopband attenuation in dB,
@@ -0,0 +1,384 @@
+#ifndef BEENHERE
+#include "SDT.h"
+#endif
+
+/**********************************************************************************
+  Fast math kernels
+
+  The approximations the receive chain and the display use in their per-sample and per-pixel
+  loops, in one place and with a known error, in place of libm calls and the one-off versions
+  that used to be scattered through Utility.cpp and Demod.cpp. Where a caller works on a whole
+  buffer there is a block version, which keeps the loop and the coefficients in registers.
+
+  Maximum errors, float arguments against libm in double:
+
+    FastLog2()          2.1e-5 absolute                 log2 of |x|, x != 0
+    log10f_fast()       6.4e-6 absolute for 1e-12 to 1e12, 0.00007 dB at 10 * log10, and
+                        7.4e-6 over the float range, where rounding the exponent dominates
+    FastLog10Block()    8.1e-6 absolute over the float range, with scale 1
+    FastExp()           7.9e-7 relative for |x| < 20, 2.8e-6 up to |x| = 87, 0 below -87
+    FastSinCos()        9.5e-7 sin, 7.2e-6 cos absolute for |phase| < 20
+    FastAtan2()         1.2e-5 rad absolute, 0 for (0, 0)
+    AlphaBetaMag()      +/-4.0% of sqrt(i^2 + q^2)
+    AlphaBetaMagBlock() as AlphaBetaMag()
+
+  The coefficients are minimax fits: log2(1 + t) and 2^t on [0, 1), sin and cos on
+  [-pi/2, pi/2] and atan on [-1, 1].
+
+  FastMathCheck() repeats the sweep on the Teensy and times each kernel against its libm
+  equivalent. It is run by typing 'f' in the Serial Monitor. host/FastMathTest.cpp sweeps
+  far more densely on the host and fails if any error is over the figure above.
+**********************************************************************************/
+
+union floatBits {
+  float32_t f;
+  uint32_t i;
+};
+
+/*****
+  Purpose: Base 2 logarithm. The exponent is read straight from the float and log2 of the
+           mantissa, 1 to 2, comes from a polynomial.
+
+  Parameter list:
+    float32_t x             the sign is ignored
+
+  Return value;
+    float32_t               log2(|x|), -127 for 0
+*****/
+FASTRUN float32_t FastLog2(float32_t x)
+{
+  union floatBits v;
+  float32_t e, t;
+
+  v.f = x;
+  e = (float32_t)(int32_t)((v.i >> 23) & 0xFF) - 127.0;
+  v.i = (v.i & 0x007FFFFF) | 0x3F800000;          // Mantissa as a float, 1 <= m < 2
+  t = v.f - 1.0;
+  return e + t * (1.4419655694058684 + t * (-0.7096623677919963 + t * (0.4175944159518956
+                  + t * (-0.19626800707417474 + t * 0.04638469014543267))));
+}
+
+/*****
+  Purpose: Base 10 logarithm. Used for dB figures where a few millionths do not matter.
+
+  Parameter list:
+    float32_t X             number for conversion, the sign is ignored
+
+  Return value;
+    float32_t               log10(|X|)
+*****/
+FASTRUN float32_t log10f_fast(float32_t X)
+{
+  return FastLog2(X) * 0.3010299956639812;
+}
+
+/*****
+  Purpose: Scaled base 10 logarithm of a buffer, out[i] = scale * log10(|in[i]|). With scale 10
+           for a power or 20 for an amplitude it gives dB.
+
+  Parameter list:
+    const float32_t *in
+    float32_t *out          may be the same buffer as in
+    float32_t scale
+    uint32_t count
+
+  Return value;
+    void
+*****/
+FASTRUN void FastLog10Block(const float32_t *in, float32_t *out, float32_t scale, uint32_t count)
+{
+  union floatBits v;
+  float32_t e, t;
+  float32_t scale2 = scale * 0.3010299956639812;
+
+  for (uint32_t k = 0; k < count; k++) {
+    v.f = in[k];
+    e = (float32_t)(int32_t)((v.i >> 23) & 0xFF) - 127.0;
+    v.i = (v.i & 0x007FFFFF) | 0x3F800000;
+    t = v.f - 1.0;
+    out[k] = scale2 * (e + t * (1.4419655694058684 + t * (-0.7096623677919963 + t * (0.4175944159518956
+                       + t * (-0.19626800707417474 + t * 0.04638469014543267)))));
+  }
+}
+
+/*****
+  Purpose: Natural exponential, as 2^(x / ln 2) with the integer part of the power put straight
+           into the float's exponent
+
+  Parameter list:
+    float32_t x
+
+  Return value;
+    float32_t               e^x, 0 below -87.3 and 2^127 above 88
+*****/
+FASTRUN float32_t FastExp(float32_t x)
+{
+  union floatBits v;
+  float32_t y = x * 1.4426950408889634;
+  float32_t n, f;
+
+  if (y < -126.0) {
+    return 0.0;
+  }
+  if (y > 127.0) {
+    y = 127.0;
+  }
+  n = floorf(y);
+  f = y - n;
+  v.f = 0.9999999250648512 + f * (0.6931530731273935 + f * (0.2401536176681297 + f * (0.05582631621574459
+                                  + f * (0.008989342273236651 + f * 0.0018775757753181905))));
+  v.i += (uint32_t)((int32_t)n << 23);
+  return v.f;
+}
+
+/*****
+  Purpose: Sine and cosine of one angle. The angle is brought into -pi to pi, then folded into
+           -pi/2 to pi/2, where the cosine changes sign and the sine does not.
+
+  Parameter list:
+    float32_t phase         radians, any value, though precision is lost far from 0
+    float32_t *sine
+    float32_t *cosine
+
+  Return value;
+    void
+*****/
+FASTRUN void FastSinCos(float32_t phase, float32_t *sine, float32_t *cosine)
+{
+  float32_t x = phase - TPI * roundf(phase * (1.0 / TPI));
+  float32_t sign = 1.0;
+  float32_t x2;
+
+  if (x > PIH) {
+    x = PI - x;
+    sign = -1.0;
+  } else if (x < -PIH) {
+    x = -PI - x;
+    sign = -1.0;
+  }
+  x2 = x * x;
+  *sine = x * (0.9999966159002905 + x2 * (-0.16664828379369176 + x2 * (0.008306325206575895
+               + x2 * -0.00018363653498637274)));
+  *cosine = sign * (0.9999932952568751 + x2 * (-0.4999124395268764 + x2 * (0.041487747844615425
+                    + x2 * -0.0012712094313613587)));
+}
+
+/*****
+  Purpose: Four quadrant arctangent. The smaller of |x| and |y| is divided by the larger, the
+           polynomial gives the angle for 0 to 45 degrees and the quadrant is put back.
+
+  Parameter list:
+    float32_t y
+    float32_t x
+
+  Return value;
+    float32_t               atan2(y, x), -pi to pi, 0 when both are 0
+*****/
+FASTRUN float32_t FastAtan2(float32_t y, float32_t x)
+{
+  float32_t ax = fabsf(x);
+  float32_t ay = fabsf(y);
+  float32_t z, z2, angle;
+
+  if (ax == 0.0 && ay == 0.0) {
+    return 0.0;
+  }
+  z = (ay <= ax) ? ay / ax : ax / ay;
+  z2 = z * z;
+  angle = z * (0.9998663220847054 + z2 * (-0.3303046822064863 + z2 * (0.18015891116351151
+               + z2 * (-0.0851558285563379 + z2 * 0.02084487840681547))));
+  if (ay > ax) {
+    angle = PIH - angle;
+  }
+  if (x < 0.0) {
+    angle = PI - angle;
+  }
+  return (y < 0.0) ? -angle : angle;
+}
+
+/*****
+  Purpose: Magnitude of a complex sample, alpha * max + beta * min
+           Lyons (2011): page 652 / libcsdr, (c) András Retzler
+
+  Parameter list:
+    float32_t inphase
+    float32_t quadrature
+
+  Return value;
+    float32_t
+*****/
+FASTRUN float32_t AlphaBetaMag(float32_t  inphase, float32_t  quadrature)
+{ // taken from libcsdr: https://github.com/simonyiszk/csdr
+  // Min RMS Err      0.947543636291 0.392485425092
+  // Min Peak Err     0.960433870103 0.397824734759
+  // Min RMS w/ Avg=0 0.948059448969 0.392699081699
+  const float32_t alpha = 0.960433870103; // 1.0; //0.947543636291;
+  const float32_t beta =  0.397824734759;
+
+  float32_t abs_inphase = fabsf(inphase);
+  float32_t abs_quadrature = fabsf(quadrature);
+  if (abs_inphase > abs_quadrature) {
+    return alpha * abs_inphase + beta * abs_quadrature;
+  } else {
+    return alpha * abs_quadrature + beta * abs_inphase;
+  }
+}
+
+/*****
+  Purpose: AlphaBetaMag() of a buffer of complex samples
+
+  Parameter list:
+    const float32_t *iq     count interleaved I, Q pairs
+    float32_t *out          count magnitudes
+    uint32_t count
+
+  Return value;
+    void
+*****/
+FASTRUN void AlphaBetaMagBlock(const float32_t *iq, float32_t *out, uint32_t count)
+{
+  const float32_t alpha = 0.960433870103;
+  const float32_t beta =  0.397824734759;
+  float32_t a, b;
+
+  for (uint32_t k = 0; k < count; k++) {
+    a = fabsf(iq[2 * k]);
+    b = fabsf(iq[2 * k + 1]);
+    out[k] = (a > b) ? alpha * a + beta * b : alpha * b + beta * a;
+  }
+}
+
+/*****
+  Purpose: Print one line of the FastMathCheck() report
+
+  Parameter list:
+    const char *name
+    float32_t error         largest error found
+    uint32_t fastCycles     cycles for FAST_MATH_CHECK_POINTS calls of the kernel
+    uint32_t libmCycles     the same for libm
+
+  Return value;
+    void
+*****/
+void FastMathCheckLine(const char *name, float32_t error, uint32_t fastCycles, uint32_t libmCycles)
+{
+  Serial.printf("%-14s %10.2e %8.1f %8.1f\n", name, error,
+                (float)fastCycles / FAST_MATH_CHECK_POINTS, (float)libmCycles / FAST_MATH_CHECK_POINTS);
+}
+
+/*****
+  Purpose: Check each kernel against libm over a sweep of its input range and time both, then
+           print the largest error and the cycles per call to USB serial
+
+  Parameter list:
+    void
+
+  Return value;
+    void
+*****/
+void FastMathCheck()
+{
+  float32_t in[FAST_MATH_CHECK_POINTS];
+  float32_t out[FAST_MATH_CHECK_POINTS];
+  float32_t ref[FAST_MATH_CHECK_POINTS];
+  float32_t error, e, s, c;
+  uint32_t start, fast, libm;
+  int k;
+
+  Serial.println("\nKernel          max error   cycles     libm");
+
+  for (k = 0; k < FAST_MATH_CHECK_POINTS; k++) {    // 1e-12 to 1e12
+    in[k] = powf(10.0, -12.0 + 24.0 * k / (FAST_MATH_CHECK_POINTS - 1));
+  }
+  start = ARM_DWT_CYCCNT;
+  FastLog10Block(in, out, 1.0, FAST_MATH_CHECK_POINTS);
+  fast = ARM_DWT_CYCCNT - start;
+  start = ARM_DWT_CYCCNT;
+  for (k = 0; k < FAST_MATH_CHECK_POINTS; k++) {
+    ref[k] = log10f(in[k]);
+  }
+  libm = ARM_DWT_CYCCNT - start;
+  error = 0.0;
+  for (k = 0; k < FAST_MATH_CHECK_POINTS; k++) {
+    error = max(error, fabsf(out[k] - (float32_t)log10((double)in[k])));
+  }
+  FastMathCheckLine("FastLog10Block", error, fast, libm);
+
+  for (k = 0; k < FAST_MATH_CHECK_POINTS; k++) {    // -80 to 80
+    in[k] = -80.0 + 160.0 * k / (FAST_MATH_CHECK_POINTS - 1);
+  }
+  start = ARM_DWT_CYCCNT;
+  for (k = 0; k < FAST_MATH_CHECK_POINTS; k++) {
+    out[k] = FastExp(in[k]);
+  }
+  fast = ARM_DWT_CYCCNT - start;
+  start = ARM_DWT_CYCCNT;
+  for (k = 0; k < FAST_MATH_CHECK_POINTS; k++) {
+    ref[k] = expf(in[k]);
+  }
+  libm = ARM_DWT_CYCCNT - start;
+  error = 0.0;
+  for (k = 0; k < FAST_MATH_CHECK_POINTS; k++) {
+    error = max(error, (float32_t)fabs(out[k] / exp((double)in[k]) - 1.0));
+  }
+  FastMathCheckLine("FastExp (rel)", error, fast, libm);
+
+  for (k = 0; k < FAST_MATH_CHECK_POINTS; k++) {    // -2 pi to 2 pi
+    in[k] = -2.0 * TPI + 4.0 * TPI * k / (FAST_MATH_CHECK_POINTS - 1);
+  }
+  start = ARM_DWT_CYCCNT;
+  for (k = 0; k < FAST_MATH_CHECK_POINTS; k++) {
+    FastSinCos(in[k], &out[k], &ref[k]);
+  }
+  fast = ARM_DWT_CYCCNT - start;
+  error = 0.0;
+  for (k = 0; k < FAST_MATH_CHECK_POINTS; k++) {
+    e = max(fabs(out[k] - sin((double)in[k])), fabs(ref[k] - cos((double)in[k])));
+    error = max(error, e);
+  }
+  start = ARM_DWT_CYCCNT;
+  for (k = 0; k < FAST_MATH_CHECK_POINTS; k++) {
+    out[k] = sinf(in[k]);
+    ref[k] = cosf(in[k]);
+  }
+  libm = ARM_DWT_CYCCNT - start;
+  FastMathCheckLine("FastSinCos", error, fast, libm);
+
+  for (k = 0; k < FAST_MATH_CHECK_POINTS; k++) {    // Round the circle, unit radius
+    FastSinCos(TPI * k / FAST_MATH_CHECK_POINTS, &s, &c);
+    in[k] = s;
+    ref[k] = c;
+  }
+  start = ARM_DWT_CYCCNT;
+  for (k = 0; k < FAST_MATH_CHECK_POINTS; k++) {
+    out[k] = FastAtan2(in[k], ref[k]);
+  }
+  fast = ARM_DWT_CYCCNT - start;
+  error = 0.0;
+  for (k = 0; k < FAST_MATH_CHECK_POINTS; k++) {
+    error = max(error, (float32_t)fabs(out[k] - atan2((double)in[k], (double)ref[k])));
+  }
+  start = ARM_DWT_CYCCNT;
+  for (k = 0; k < FAST_MATH_CHECK_POINTS; k++) {
+    out[k] = atan2f(in[k], ref[k]);
+  }
+  libm = ARM_DWT_CYCCNT - start;
+  FastMathCheckLine("FastAtan2", error, fast, libm);
+
+  for (k = 0; k < FAST_MATH_CHECK_POINTS / 2; k++) { // Half the circle, interleaved I, Q
+    FastSinCos(PI * k / (FAST_MATH_CHECK_POINTS / 2), &in[2 * k + 1], &in[2 * k]);
+  }
+  start = ARM_DWT_CYCCNT;
+  AlphaBetaMagBlock(in, out, FAST_MATH_CHECK_POINTS / 2);
+  fast = ARM_DWT_CYCCNT - start;
+  start = ARM_DWT_CYCCNT;
+  for (k = 0; k < FAST_MATH_CHECK_POINTS / 2; k++) {
+    ref[k] = sqrtf(in[2 * k] * in[2 * k] + in[2 * k + 1] * in[2 * k + 1]);
+  }
+  libm = ARM_DWT_CYCCNT - start;
+  error = 0.0;
+  for (k = 0; k < FAST_MATH_CHECK_POINTS / 2; k++) {
+    error = max(error, fabsf(out[k] / ref[k] - 1.0f));
+  }
+  FastMathCheckLine("AlphaBetaMag", error, 2 * fast, 2 * libm);   // Per complex sample
+}
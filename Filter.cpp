@@ -11,53 +11,7 @@
 *****/
 void DoReceiveEQ() //AFP 08-09-22
 {
-  for (int i = 0; i < 14; i++) {
-    recEQ_LevelScale[i] = (float)EEPROMData.equalizerRec[i] / 100.0;
-  }
-  arm_biquad_cascade_df2T_f32(&S1_Rec, float_buffer_L, rec_EQ1_float_buffer_L, 256);
-  arm_biquad_cascade_df2T_f32(&S2_Rec, float_buffer_L, rec_EQ2_float_buffer_L, 256);
-  arm_biquad_cascade_df2T_f32(&S3_Rec, float_buffer_L, rec_EQ3_float_buffer_L, 256);
-  arm_biquad_cascade_df2T_f32(&S4_Rec, float_buffer_L, rec_EQ4_float_buffer_L, 256);
-  arm_biquad_cascade_df2T_f32(&S5_Rec, float_buffer_L, rec_EQ5_float_buffer_L, 256);
-  arm_biquad_cascade_df2T_f32(&S6_Rec, float_buffer_L, rec_EQ6_float_buffer_L, 256);
-  arm_biquad_cascade_df2T_f32(&S7_Rec, float_buffer_L, rec_EQ7_float_buffer_L, 256);
-  arm_biquad_cascade_df2T_f32(&S8_Rec, float_buffer_L, rec_EQ8_float_buffer_L, 256);
-  arm_biquad_cascade_df2T_f32(&S9_Rec, float_buffer_L, rec_EQ9_float_buffer_L, 256);
-  arm_biquad_cascade_df2T_f32(&S10_Rec, float_buffer_L, rec_EQ10_float_buffer_L, 256);
-  arm_biquad_cascade_df2T_f32(&S11_Rec, float_buffer_L, rec_EQ11_float_buffer_L, 256);
-  arm_biquad_cascade_df2T_f32(&S12_Rec, float_buffer_L, rec_EQ12_float_buffer_L, 256);
-  arm_biquad_cascade_df2T_f32(&S13_Rec, float_buffer_L, rec_EQ13_float_buffer_L, 256);
-  arm_biquad_cascade_df2T_f32(&S14_Rec, float_buffer_L, rec_EQ14_float_buffer_L, 256);
-
-  arm_scale_f32(rec_EQ1_float_buffer_L, -recEQ_LevelScale[0], rec_EQ1_float_buffer_L, 256);
-  arm_scale_f32(rec_EQ2_float_buffer_L, recEQ_LevelScale[1], rec_EQ2_float_buffer_L, 256);
-  arm_scale_f32(rec_EQ3_float_buffer_L, -recEQ_LevelScale[2], rec_EQ3_float_buffer_L, 256);
-  arm_scale_f32(rec_EQ4_float_buffer_L, recEQ_LevelScale[3], rec_EQ4_float_buffer_L, 256);
-  arm_scale_f32(rec_EQ5_float_buffer_L, -recEQ_LevelScale[4], rec_EQ5_float_buffer_L, 256);
-  arm_scale_f32(rec_EQ6_float_buffer_L, recEQ_LevelScale[5], rec_EQ6_float_buffer_L, 256);
-  arm_scale_f32(rec_EQ7_float_buffer_L, -recEQ_LevelScale[6], rec_EQ7_float_buffer_L, 256);
-  arm_scale_f32(rec_EQ8_float_buffer_L, recEQ_LevelScale[7], rec_EQ8_float_buffer_L, 256);
-  arm_scale_f32(rec_EQ9_float_buffer_L, -recEQ_LevelScale[8], rec_EQ9_float_buffer_L, 256);
-  arm_scale_f32(rec_EQ10_float_buffer_L, recEQ_LevelScale[9], rec_EQ10_float_buffer_L, 256);
-  arm_scale_f32(rec_EQ11_float_buffer_L, -recEQ_LevelScale[10], rec_EQ11_float_buffer_L, 256);
-  arm_scale_f32(rec_EQ12_float_buffer_L, recEQ_LevelScale[11], rec_EQ12_float_buffer_L, 256);
-  arm_scale_f32(rec_EQ13_float_buffer_L, -recEQ_LevelScale[12], rec_EQ13_float_buffer_L, 256);
-  arm_scale_f32(rec_EQ14_float_buffer_L, recEQ_LevelScale[13], rec_EQ14_float_buffer_L, 256);
-
-  arm_add_f32(rec_EQ1_float_buffer_L , rec_EQ2_float_buffer_L, float_buffer_L , 256 ) ;
-
-  arm_add_f32(float_buffer_L , rec_EQ3_float_buffer_L, float_buffer_L , 256 ) ;
-  arm_add_f32(float_buffer_L , rec_EQ4_float_buffer_L, float_buffer_L , 256 ) ;
-  arm_add_f32(float_buffer_L , rec_EQ5_float_buffer_L, float_buffer_L , 256 ) ;
-  arm_add_f32(float_buffer_L , rec_EQ6_float_buffer_L, float_buffer_L , 256 ) ;
-  arm_add_f32(float_buffer_L , rec_EQ7_float_buffer_L, float_buffer_L , 256 ) ;
-  arm_add_f32(float_buffer_L , rec_EQ8_float_buffer_L, float_buffer_L , 256 ) ;
-  arm_add_f32(float_buffer_L , rec_EQ9_float_buffer_L, float_buffer_L , 256 ) ;
-  arm_add_f32(float_buffer_L , rec_EQ10_float_buffer_L, float_buffer_L , 256 ) ;
-  arm_add_f32(float_buffer_L , rec_EQ11_float_buffer_L, float_buffer_L , 256 ) ;
-  arm_add_f32(float_buffer_L , rec_EQ12_float_buffer_L, float_buffer_L , 256 ) ;
-  arm_add_f32(float_buffer_L , rec_EQ13_float_buffer_L, float_buffer_L , 256 ) ;
-  arm_add_f32(float_buffer_L , rec_EQ14_float_buffer_L, float_buffer_L , 256 ) ;
+  Equalize(&rxEqualizer, EEPROMData.equalizerRec, float_buffer_L, BUF_N_DF);
 }
 
 /*****
@@ -70,53 +24,7 @@ void DoReceiveEQ() //AFP 08-09-22
 *****/
 void DoExciterEQ() //AFP 10-02-22
 {
-  for (int i = 0; i < 14; i++) {
-    xmtEQ_Level[i] = (float)EEPROMData.equalizerXmt[i] / 100.0;
-  }
-  arm_biquad_cascade_df2T_f32(&S1_Xmt,  float_buffer_L_EX, xmt_EQ1_float_buffer_L, 256);
-  arm_biquad_cascade_df2T_f32(&S2_Xmt,  float_buffer_L_EX, xmt_EQ2_float_buffer_L, 256);
-  arm_biquad_cascade_df2T_f32(&S3_Xmt,  float_buffer_L_EX, xmt_EQ3_float_buffer_L, 256);
-  arm_biquad_cascade_df2T_f32(&S4_Xmt,  float_buffer_L_EX, xmt_EQ4_float_buffer_L, 256);
-  arm_biquad_cascade_df2T_f32(&S5_Xmt,  float_buffer_L_EX, xmt_EQ5_float_buffer_L, 256);
-  arm_biquad_cascade_df2T_f32(&S6_Xmt,  float_buffer_L_EX, xmt_EQ6_float_buffer_L, 256);
-  arm_biquad_cascade_df2T_f32(&S7_Xmt,  float_buffer_L_EX, xmt_EQ7_float_buffer_L, 256);
-  arm_biquad_cascade_df2T_f32(&S8_Xmt,  float_buffer_L_EX, xmt_EQ8_float_buffer_L, 256);
-  arm_biquad_cascade_df2T_f32(&S9_Xmt,  float_buffer_L_EX, xmt_EQ9_float_buffer_L, 256);
-  arm_biquad_cascade_df2T_f32(&S10_Xmt, float_buffer_L_EX, xmt_EQ10_float_buffer_L, 256);
-  arm_biquad_cascade_df2T_f32(&S11_Xmt, float_buffer_L_EX, xmt_EQ11_float_buffer_L, 256);
-  arm_biquad_cascade_df2T_f32(&S12_Xmt, float_buffer_L_EX, xmt_EQ12_float_buffer_L, 256);
-  arm_biquad_cascade_df2T_f32(&S13_Xmt, float_buffer_L_EX, xmt_EQ13_float_buffer_L, 256);
-  arm_biquad_cascade_df2T_f32(&S14_Xmt, float_buffer_L_EX, xmt_EQ14_float_buffer_L, 256);
-
-  arm_scale_f32(xmt_EQ1_float_buffer_L,  -xmtEQ_Level[0],  xmt_EQ1_float_buffer_L, 256);
-  arm_scale_f32(xmt_EQ2_float_buffer_L,   xmtEQ_Level[1],  xmt_EQ2_float_buffer_L, 256);
-  arm_scale_f32(xmt_EQ3_float_buffer_L,  -xmtEQ_Level[2],  xmt_EQ3_float_buffer_L, 256);
-  arm_scale_f32(xmt_EQ4_float_buffer_L,   xmtEQ_Level[3],  xmt_EQ4_float_buffer_L, 256);
-  arm_scale_f32(xmt_EQ5_float_buffer_L,  -xmtEQ_Level[4],  xmt_EQ5_float_buffer_L, 256);
-  arm_scale_f32(xmt_EQ6_float_buffer_L,   xmtEQ_Level[5],  xmt_EQ6_float_buffer_L, 256);
-  arm_scale_f32(xmt_EQ7_float_buffer_L,  -xmtEQ_Level[6],  xmt_EQ7_float_buffer_L, 256);
-  arm_scale_f32(xmt_EQ8_float_buffer_L,   xmtEQ_Level[7],  xmt_EQ8_float_buffer_L, 256);
-  arm_scale_f32(xmt_EQ9_float_buffer_L,  -xmtEQ_Level[8],  xmt_EQ9_float_buffer_L, 256);
-  arm_scale_f32(xmt_EQ10_float_buffer_L,  xmtEQ_Level[9],  xmt_EQ10_float_buffer_L, 256);
-  arm_scale_f32(xmt_EQ11_float_buffer_L, -xmtEQ_Level[10], xmt_EQ11_float_buffer_L, 256);
-  arm_scale_f32(xmt_EQ12_float_buffer_L,  xmtEQ_Level[11], xmt_EQ12_float_buffer_L, 256);
-  arm_scale_f32(xmt_EQ13_float_buffer_L, -xmtEQ_Level[12], xmt_EQ13_float_buffer_L, 256);
-  arm_scale_f32(xmt_EQ14_float_buffer_L,  xmtEQ_Level[13], xmt_EQ14_float_buffer_L, 256);
-
-  arm_add_f32(xmt_EQ1_float_buffer_L , xmt_EQ2_float_buffer_L, float_buffer_L_EX , 256 ) ;
-
-  arm_add_f32(float_buffer_L_EX , xmt_EQ3_float_buffer_L,  float_buffer_L_EX , 256 ) ;
-  arm_add_f32(float_buffer_L_EX , xmt_EQ4_float_buffer_L,  float_buffer_L_EX , 256 ) ;
-  arm_add_f32(float_buffer_L_EX , xmt_EQ5_float_buffer_L,  float_buffer_L_EX , 256 ) ;
-  arm_add_f32(float_buffer_L_EX , xmt_EQ6_float_buffer_L,  float_buffer_L_EX , 256 ) ;
-  arm_add_f32(float_buffer_L_EX , xmt_EQ7_float_buffer_L,  float_buffer_L_EX , 256 ) ;
-  arm_add_f32(float_buffer_L_EX , xmt_EQ8_float_buffer_L,  float_buffer_L_EX , 256 ) ;
-  arm_add_f32(float_buffer_L_EX , xmt_EQ9_float_buffer_L,  float_buffer_L_EX , 256 ) ;
-  arm_add_f32(float_buffer_L_EX , xmt_EQ10_float_buffer_L, float_buffer_L_EX , 256 ) ;
-  arm_add_f32(float_buffer_L_EX , xmt_EQ11_float_buffer_L, float_buffer_L_EX , 256 ) ;
-  arm_add_f32(float_buffer_L_EX , xmt_EQ12_float_buffer_L, float_buffer_L_EX , 256 ) ;
-  arm_add_f32(float_buffer_L_EX , xmt_EQ13_float_buffer_L, float_buffer_L_EX , 256 ) ;
-  arm_add_f32(float_buffer_L_EX , xmt_EQ14_float_buffer_L, float_buffer_L_EX , 256 ) ;
+  Equalize(&txEqualizer, EEPROMData.equalizerXmt, float_buffer_L_EX, 256);
 }
 
 /*****
@@ -127,10 +35,21 @@ void DoExciterEQ() //AFP 10-02-22
 *****/
 void FilterBandwidth()
 {
-  AudioNoInterrupts();
+  float32_t *mask;
 
-  CalcCplxFIRCoeffs(FIR_Coef_I, FIR_Coef_Q, m_NumTaps, (float32_t)bands[currentBand].FLoCut, (float32_t)bands[currentBand].FHiCut, (float)SR[SampleRate].rate / DF);
-  InitFilterMask();
+  // A cached mask, or one built in a slot the DSP task is not using, so it can keep running
+  ControlPassbandShift();
+  mask = MaskCacheLookup(bands[currentBand].FLoCut, bands[currentBand].FHiCut, SR[SampleRate].rate);
+  if (PassbandShiftHz() != 0.0) {
+    mask = MaskShift(mask, PassbandShiftHz());
+  }
+  DSPNoInterrupts();
+  if (mask != filterMask) {
+    pendingMask = mask;                       // ProcessIQData() fades over to it on the next block
+  } else {
+    pendingMask = NULL;
+  }
+  DSPInterrupts();
 
   // also adjust IIR AM filter
   //int filter_BW_highest = bands[currentBand].FHiCut;
@@ -147,46 +66,101 @@ void FilterBandwidth()
   SetDecIntFilters();
   ShowBandwidth();
 //BandInformation();
-  MyDelay(1L);
-  AudioInterrupts();
 } // end filter_bandwidth
 
 /*****
-  Purpose: InitFilterMask()
+  Purpose: InitFilterMask(), from the coefficients in FIR_Coef_I and FIR_Coef_Q. With
+           receiveEQFlag at EQ_MASK the receive equalizer is built into those first.
 
   Parameter list:
-    void
+    float32_t *mask         FFT_length complex bins, normally a MaskCache.cpp slot
 
   Return value;
     void
 *****/
-void InitFilterMask()
+void InitFilterMask(float32_t *mask)
 {
 
   /****************************************************************************************
      Calculate the FFT of the FIR filter coefficients once to produce the FIR filter mask
   ****************************************************************************************/
-  // the FIR has exactly m_NumTaps and a maximum of (FFT_length / 2) + 1 taps = coefficients, so we have to add (FFT_length / 2) -1 zeros before the FFT
+  // the FIR has exactly m_NumTaps = FFT_length - fftHop + 1 taps = coefficients, so we have to add fftHop - 1 zeros before the FFT
   // in order to produce a FFT_length point input buffer for the FFT
   // copy coefficients into real values of first part of buffer, rest is zero
 
+  if (receiveEQFlag == EQ_MASK) {                // The receive equalizer goes into the taps, see Equalizer.cpp
+    EqualizerApplyToTaps(&rxEqualizer, EEPROMData.equalizerRec, FIR_Coef_I, FIR_Coef_Q, m_NumTaps);
+  }
   for (unsigned i = 0; i < m_NumTaps; i++) {
     // try out a window function to eliminate ringing of the filter at the stop frequency
     //             sd.FFT_Samples[i] = (float32_t)((0.53836 - (0.46164 * arm_cos_f32(PI*2 * (float32_t)i / (float32_t)(FFT_IQ_BUFF_LEN-1)))) * sd.FFT_Samples[i]);
-    FIR_filter_mask[i * 2] = FIR_Coef_I [i];
-    FIR_filter_mask[i * 2 + 1] = FIR_Coef_Q [i];
+    mask[i * 2] = FIR_Coef_I [i];
+    mask[i * 2 + 1] = FIR_Coef_Q [i];
   }
 
-  for (unsigned i = FFT_length + 1; i < FFT_length * 2; i++) {
-    FIR_filter_mask[i] = 0.0;
+  for (unsigned i = m_NumTaps * 2; i < FFT_length * 2; i++) {
+    mask[i] = 0.0;
   }
 
-  // FFT of FIR_filter_mask
+  // FFT of the mask
   // perform FFT (in-place), needs only to be done once (or every time the filter coeffs change)
-  arm_cfft_f32(maskS, FIR_filter_mask, 0, 1);
+  arm_cfft_f32(maskS, mask, 0, 1);
 
 } // end init_filter_mask
 
+/*****
+  Purpose: Keep passbandShift within IF_SHIFT_MAX and stop it moving an SSB passband across zero,
+           where it would let in the other sideband. Only LSB and USB can be shifted.
+
+  Parameter list:
+    void
+
+  Return value;
+    void
+*****/
+void ControlPassbandShift()
+{
+  if (passbandShift > IF_SHIFT_MAX) {
+    passbandShift = IF_SHIFT_MAX;
+  } else if (passbandShift < -IF_SHIFT_MAX) {
+    passbandShift = -IF_SHIFT_MAX;
+  }
+  switch (bands[currentBand].mode) {
+    case DEMOD_USB:
+      if (passbandShift < -bands[currentBand].FLoCut) {
+        passbandShift = -bands[currentBand].FLoCut;
+      }
+      break;
+    case DEMOD_LSB:
+      if (passbandShift < bands[currentBand].FHiCut) {
+        passbandShift = bands[currentBand].FHiCut;
+      }
+      break;
+  }
+}
+
+/*****
+  Purpose: The passband shift as a move of the filter mask. passbandShift raises the audio pitch of
+           the passband, which is up in frequency for USB and down for LSB.
+
+  Parameter list:
+    void
+
+  Return value;
+    float32_t               Hz, 0 in the modes that are not shifted
+*****/
+float32_t PassbandShiftHz()
+{
+  switch (bands[currentBand].mode) {
+    case DEMOD_USB:
+      return passbandShift;
+    case DEMOD_LSB:
+      return -passbandShift;
+    default:
+      return 0.0;
+  }
+}
+
 /*****
   Purpose: void control_filter_f()
   Parameter list:
@@ -241,10 +215,92 @@ void SetDecIntFilters()
   if (LP_F_help > 10000) {
     LP_F_help = 10000;
   }
-  CalcFIRCoeffs(FIR_dec1_coeffs, n_dec1_taps, (float32_t)(LP_F_help), n_att, 0, 0.0, (float32_t)(SR[SampleRate].rate));
-  CalcFIRCoeffs(FIR_dec2_coeffs, n_dec2_taps, (float32_t)(LP_F_help), n_att, 0, 0.0, (float32_t)(SR[SampleRate].rate / DF1));
-
-  CalcFIRCoeffs(FIR_int1_coeffs, 48, (float32_t)(LP_F_help), n_att, 0, 0.0, (float32_t)(SR[SampleRate].rate / DF1));
-  CalcFIRCoeffs(FIR_int2_coeffs, 32, (float32_t)(LP_F_help), n_att, 0, 0.0, (float32_t)SR[SampleRate].rate);
+  // The decimator and interpolator passbands are fixed, see Decimate.cpp and Interpolate.cpp
   bin_BW = 1.0 / (DF * FFT_length) * (float32_t)SR[SampleRate].rate;
 }
+
+/*****
+  Purpose: The CMSIS complex FFT for an overlap-save length
+
+  Parameter list:
+    uint32_t length         FFT_length
+
+  Return value;
+    const arm_cfft_instance_f32 *   NULL if length is not one SetConvolution() accepts
+*****/
+const arm_cfft_instance_f32 *ConvolutionFFT(uint32_t length)
+{
+  switch (length) {
+    case 256:
+      return &arm_cfft_sR_f32_len256;
+    case 512:
+      return &arm_cfft_sR_f32_len512;
+    case 1024:
+      return &arm_cfft_sR_f32_len1024;
+    case 2048:
+      return &arm_cfft_sR_f32_len2048;
+  }
+  return NULL;
+}
+
+/*****
+  Purpose: Change the FFT length and hop of the overlap-save receive filter. The block handed to
+           the demodulators stays BUF_N_DF samples; ProcessIQData() runs BUF_N_DF / hop FFTs per
+           block. A longer FFT gives a longer filter, so steeper skirts, and a shorter hop gives
+           less delay through the filter for more FFTs per block.
+
+  Parameter list:
+    uint32_t length         FFT_length, 256 to FFT_LENGTH_MAX
+    uint32_t hop            new samples per FFT, at most length / 2 and a divisor of BUF_N_DF
+
+  Return value;
+    int                     1 if the filter was changed, 0 if the combination is not supported
+*****/
+int SetConvolution(uint32_t length, uint32_t hop)
+{
+  return SetReceiveChain(N_BLOCKS, length, hop);
+}
+
+/*****
+  Purpose: Change the receive block size and the overlap-save filter together, so the DSP task
+           never sees a hop that does not fit the block. Used by the low-latency path, see
+           Latency.cpp.
+
+  Parameter list:
+    uint32_t blocks         audio library blocks of BUFFER_SIZE gathered per ProcessIQData() call,
+                            4 to N_B
+    uint32_t length         FFT_length, 256 to FFT_LENGTH_MAX
+    uint32_t hop            new samples per FFT, at most length / 2 and a divisor of the
+                            decimated block
+
+  Return value;
+    int                     1 if the chain was changed, 0 if the combination is not supported
+*****/
+int SetReceiveChain(uint32_t blocks, uint32_t length, uint32_t hop)
+{
+  const arm_cfft_instance_f32 *fft = ConvolutionFFT(length);
+  uint32_t decimated = BUFFER_SIZE * blocks / (uint32_t)DF;
+
+  if (blocks < 4 || blocks > N_B || fft == NULL || length > FFT_LENGTH_MAX || hop == 0 || hop > length / 2 || decimated % hop != 0) {
+    return 0;
+  }
+  if (blocks == N_BLOCKS && length == FFT_length && hop == fftHop) {
+    return 1;
+  }
+  DSPNoInterrupts();                          // The masks are rebuilt for the new length, so no audio for a moment
+  N_BLOCKS = blocks;
+  BUF_N_DF = decimated;
+  if (length != FFT_length || hop != fftHop) {
+    FFT_length = length;
+    fftHop = hop;
+    m_NumTaps = length - hop + 1;
+    S = fft;
+    iS = fft;
+    maskS = fft;
+    first_block = 1;                          // Clear the overlap history
+    MaskCacheInit();
+  }
+  DSPInterrupts();
+  SetDecIntFilters();
+  return 1;
+}
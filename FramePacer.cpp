@@ -0,0 +1,189 @@
+#ifndef BEENHERE
+#include "SDT.h"
+#endif
+
+/**********************************************************************************
+  Display frame pacer
+
+  The DSP task used to make display data, the panadapter and audio spectrum FFTs, on every
+  block the spectrumFrames[] ring had room for, so the frame rate was however fast
+  ShowSpectrum() happened to draw. The rate is now set: spectrumTargetFPS frames a second for
+  the panadapter, and waterfallTargetFPS lines a second for the waterfall.
+
+  The pacer keeps time by the samples the DSP task has processed, so it needs no timer and
+  runs at the same rate whatever loop() is doing. At the start of each block
+  SpectrumFrameDue() decides whether the block is to make a frame, which sets
+  updateDisplayFlag, and only then are the display FFTs computed. The high resolution display
+  may need more samples before it has a spectrum; the frame stays due until it is made. When
+  a frame is made PacerFrameMade() takes its time off and decides whether it also adds a
+  waterfall line, which ShowSpectrum() finds in the frame. The waterfall can therefore run
+  slower than the panadapter but not faster.
+
+  A frame that is due while the display still has the ring full waits for it. If a whole
+  frame period goes by first, the frame is counted as skipped and the next one is due. The
+  profile report shows the rates reached, the skipped frames and the time ShowSpectrum()
+  takes to draw a frame.
+
+  A target of 0 is "Max" in the Spectrum Set menu: a frame whenever the display has room, as
+  before, and a waterfall line with every frame. At a lower rate the display FFTs and the
+  drawing take less of the processor, which leaves room for heavier noise reduction.
+**********************************************************************************/
+
+int spectrumTargetFPS = SPECTRUM_FPS_DEFAULT;           // Panadapter frames a second, 0 for as fast as they are drawn
+int waterfallTargetFPS = WATERFALL_FPS_DEFAULT;         // Waterfall lines a second, 0 for one every frame
+uint32_t pacerSpectrumSamples = 0;                      // Samples since the last frame, DSP task only
+uint32_t pacerWaterfallSamples = 0;                     // Samples since the last waterfall line, DSP task only
+volatile uint32_t pacerFramesMade = 0;
+volatile uint32_t pacerFramesSkipped = 0;
+uint32_t pacerFramesDrawn = 0;
+uint32_t pacerWaterfallLines = 0;
+uint32_t pacerDrawMicrosSum = 0;
+uint32_t pacerDrawMicrosMax = 0;
+uint32_t pacerResetMillis = 0;
+
+/*****
+  Purpose: Decide whether this block is to make a display frame. Called by the DSP task at the
+           start of each block.
+
+  Parameter list:
+    uint32_t blockSamples   samples in the block, at SR[SampleRate].rate
+
+  Return value;
+    int                     1 if the display data are to be computed in this block
+*****/
+int SpectrumFrameDue(uint32_t blockSamples)
+{
+  uint32_t period;
+
+  if (pacerWaterfallSamples < SR[SampleRate].rate) {     // No further once a second behind
+    pacerWaterfallSamples += blockSamples;
+  }
+  if (spectrumTargetFPS <= 0) {
+    return SpectrumFrameFree();
+  }
+  period = SR[SampleRate].rate / spectrumTargetFPS;
+  pacerSpectrumSamples += blockSamples;
+  if (pacerSpectrumSamples < period) {
+    return 0;
+  }
+  if (pacerSpectrumSamples >= 2 * period) {              // A whole period late, give this one up
+    pacerFramesSkipped++;
+    pacerSpectrumSamples -= period;
+  }
+  return SpectrumFrameFree();
+}
+
+/*****
+  Purpose: Count a frame the DSP task made and take its period off. Called from
+           SpectrumFramePublish().
+
+  Parameter list:
+    void
+
+  Return value;
+    int                     1 if the frame adds a waterfall line
+*****/
+int PacerFrameMade()
+{
+  uint32_t period;
+
+  pacerFramesMade++;
+  if (spectrumTargetFPS > 0) {
+    period = SR[SampleRate].rate / spectrumTargetFPS;
+    pacerSpectrumSamples = (pacerSpectrumSamples >= period) ? pacerSpectrumSamples - period : 0;
+  }
+  if (waterfallTargetFPS <= 0) {
+    return 1;
+  }
+  period = SR[SampleRate].rate / waterfallTargetFPS;
+  if (pacerWaterfallSamples < period) {
+    return 0;
+  }
+  pacerWaterfallSamples -= period;
+  if (pacerWaterfallSamples >= period) {                 // Faster than the panadapter, start again
+    pacerWaterfallSamples = 0;
+  }
+  return 1;
+}
+
+/*****
+  Purpose: Add a frame ShowSpectrum() drew to the statistics
+
+  Parameter list:
+    uint32_t drawMicros     time from getting the frame to the end of drawing it
+    int waterfallLine       1 if it added a waterfall line
+
+  Return value;
+    void
+*****/
+void PacerFrameDrawn(uint32_t drawMicros, int waterfallLine)
+{
+  pacerFramesDrawn++;
+  pacerWaterfallLines += waterfallLine;
+  pacerDrawMicrosSum += drawMicros;
+  pacerDrawMicrosMax = max(pacerDrawMicrosMax, drawMicros);
+}
+
+/*****
+  Purpose: Set the panadapter and waterfall rates
+
+  Parameter list:
+    int spectrumFPS         panadapter frames a second, 0 for as fast as they are drawn
+    int waterfallFPS        waterfall lines a second, 0 for one every frame
+
+  Return value;
+    void
+*****/
+void SetFrameRates(int spectrumFPS, int waterfallFPS)
+{
+  DSPNoInterrupts();
+  spectrumTargetFPS = max(spectrumFPS, 0);
+  waterfallTargetFPS = max(waterfallFPS, 0);
+  pacerSpectrumSamples = 0;
+  pacerWaterfallSamples = 0;
+  DSPInterrupts();
+}
+
+/*****
+  Purpose: Clear the frame statistics. Called from ProfileReset().
+
+  Parameter list:
+    void
+
+  Return value;
+    void
+*****/
+void PacerReset()
+{
+  pacerFramesMade = 0;
+  pacerFramesSkipped = 0;
+  pacerFramesDrawn = 0;
+  pacerWaterfallLines = 0;
+  pacerDrawMicrosSum = 0;
+  pacerDrawMicrosMax = 0;
+  pacerResetMillis = millis();
+}
+
+/*****
+  Purpose: Print the frame rates and draw times to USB serial
+
+  Parameter list:
+    void
+
+  Return value;
+    void
+*****/
+void PacerPrintReport()
+{
+  float32_t seconds = (millis() - pacerResetMillis) / 1000.0;
+
+  if (seconds <= 0.0) {
+    return;
+  }
+  Serial.printf("Display frames: target %d/s, %.1f/s drawn, %lu made, %lu skipped; waterfall target %d/s, %.1f lines/s\n",
+                spectrumTargetFPS, pacerFramesDrawn / seconds, pacerFramesMade, pacerFramesSkipped,
+                waterfallTargetFPS, pacerWaterfallLines / seconds);
+  if (pacerFramesDrawn > 0) {
+    Serial.printf("Frame draw time: %lu us mean, %lu us max\n", pacerDrawMicrosSum / pacerFramesDrawn, pacerDrawMicrosMax);
+  }
+}
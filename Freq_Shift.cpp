@@ -37,45 +37,23 @@ void FreqShift1()
     float_buffer_L[i + 3] = hh1;
     float_buffer_R[i + 3] = hh2;
   }
-  for (unsigned i = 0; i < BUFFER_SIZE * N_BLOCKS; i ++) {
-    float_buffer_L_3[i] = float_buffer_L[i];
-    float_buffer_R_3[i] = float_buffer_R[i];
-  }
   // this is for -Fs/4 [moves receive frequency to the right in the spectrumdisplay]
 }
 
 /*****
-  Purpose: Shift Receive frequency by an arbitray amount
+  Purpose: Display side of fine tuning. The fine tune encoder interrupt moves NCOFreq; this updates
+           TxRxFreq, the frequency readout and the bandwidth bar to match. Polled from ShowSpectrum()
+           because FreqShift2() runs in the DSP task and must not draw.
 
   Parameter list:
     void
 
   Return value;
     void
-    Notes:  Routine includes checks to ensure the frequency selection stays within the bounds of the
-    displayed spectrum
-    Also included a variable frequency step, depending on how fast the encoder id turned.  Step varies from 50Hz/step to 10KHz/step
-
-    freq_conv2()
-
-    FREQUENCY CONVERSION USING A SOFTWARE QUADRATURE OSCILLATOR (NCO)
-
-    THIS VERSION calculates the COS AND SIN WAVE on the fly AND IS SLOW
-
-    MAJOR ADVANTAGE: frequency conversion can be done for any frequency !
-
-    large parts of the code taken from the mcHF code by Clint, KA7OEI, thank you!
-      see here for more info on quadrature oscillators:
-    Wheatley, M. (2011): CuteSDR Technical Manual Ver. 1.01. - http://sourceforge.net/projects/cutesdr/
-    Lyons, R.G. (2011): Understanding Digital Processing. – Pearson, 3rd edition.
-    Requires 4 complex multiplies and two adds per data point within the time domain buffer.  Applied after the data
-    stream is sent to the Zoom FFT , but befor decimation.
 *****/
-void FreqShift2()
+void UpdateFineTuneDisplay()
 {
-  uint i;
   long currentFreqAOld;
-  int sideToneShift = 0;
 
   if (fineTuneEncoderMove != 0L) {
     SetFreq();           //AFP 10-04-22
@@ -102,6 +80,82 @@ void FreqShift2()
     DrawBandWidthIndicatorBar();
    
   }
+}
+
+/*****
+  Purpose: Fill the sine table used by the FreqShift2() oscillator. The table holds NCO_TABLE_SIZE
+           points of one cycle plus a quarter cycle, so cosine is read a quarter table further on,
+           plus one guard point for the interpolation. The old oscillator and mixer gain is folded
+           into the table.
+
+  Parameter list:
+    void
+
+  Return value;
+    void
+*****/
+void InitNCOTable()
+{
+  for (int k = 0; k < NCO_TABLE_SIZE + NCO_TABLE_SIZE / 4 + 1; k++) {
+    ncoSinTable[k] = NCO_AMPLITUDE * sin(TWO_PI * k / NCO_TABLE_SIZE);
+  }
+}
+
+/*****
+  Purpose: Sine and cosine of an oscillator phase by linear interpolation in ncoSinTable[]
+
+  Parameter list:
+    uint32_t phase          2^32 = one cycle
+    float32_t *sinValue
+    float32_t *cosValue
+
+  Return value;
+    void
+*****/
+static inline void NCOLookup(uint32_t phase, float32_t *sinValue, float32_t *cosValue)
+{
+  const float32_t *s = &ncoSinTable[phase >> NCO_FRAC_BITS];
+  float32_t frac = (float32_t)(phase & ((1UL << NCO_FRAC_BITS) - 1)) * (float32_t)(1.0 / (1UL << NCO_FRAC_BITS));
+
+  *sinValue = s[0] + frac * (s[1] - s[0]);
+  *cosValue = s[NCO_TABLE_SIZE / 4] + frac * (s[NCO_TABLE_SIZE / 4 + 1] - s[NCO_TABLE_SIZE / 4]);
+}
+
+/*****
+  Purpose: Shift Receive frequency by an arbitray amount
+
+  Parameter list:
+    void
+
+  Return value;
+    void
+    Notes:  Routine includes checks to ensure the frequency selection stays within the bounds of the
+    displayed spectrum
+    Also included a variable frequency step, depending on how fast the encoder id turned.  Step varies from 50Hz/step to 10KHz/step
+
+    freq_conv2()
+
+    FREQUENCY CONVERSION USING A NUMERICALLY CONTROLLED OSCILLATOR (NCO)
+
+    The oscillator is a 32 bit phase accumulator addressing a 1024 point sine table with linear
+    interpolation, so the frequency is exact to 192000 / 2^32 Hz and the amplitude never drifts.
+    This replaces the recursive double precision oscillator with per sample amplitude correction
+    taken from the mcHF code by Clint, KA7OEI. The mixer works on 4 samples per pass so the table
+    lookups and multiplies of neighbouring samples can be interleaved by the FPU.
+      see here for more info on quadrature oscillators:
+    Wheatley, M. (2011): CuteSDR Technical Manual Ver. 1.01. - http://sourceforge.net/projects/cutesdr/
+    Lyons, R.G. (2011): Understanding Digital Processing. – Pearson, 3rd edition.
+    Applied after the data stream is sent to the Zoom FFT , but befor decimation.
+    The encoder and display handling that used to be here is in UpdateFineTuneDisplay().
+*****/
+FASTRUN void FreqShift2()
+{
+  int sideToneShift = 0;
+  int32_t ncoInc;
+  uint32_t phase;
+  float32_t s0, c0, s1, c1, s2, c2, s3, c3;
+  float32_t i0, q0, i1, q1, i2, q2, i3, q3;
+
   if (xmtMode == SSB_MODE ) {
     sideToneShift = 0;
   } else {
@@ -115,24 +169,34 @@ void FreqShift2()
       }
     }
   }
-  NCO_INC = 2.0 * PI * (NCOFreq + sideToneShift) / 192000.0; //192000 SPS is the actual sample rate used in the Receive ADC
-
-  OSC_COS = cos (NCO_INC);
-  OSC_SIN = sin (NCO_INC);
-
-  for (i = 0; i < BUFFER_SIZE * N_BLOCKS; i++) {
-    // generate local oscillator on-the-fly:  This takes a lot of processor time!
-    Osc_Q = (Osc_Vect_Q * OSC_COS) - (Osc_Vect_I * OSC_SIN);  // Q channel of oscillator
-    Osc_I = (Osc_Vect_I * OSC_COS) + (Osc_Vect_Q * OSC_SIN);  // I channel of oscillator
-    Osc_Gain = 1.95 - ((Osc_Vect_Q * Osc_Vect_Q) + (Osc_Vect_I * Osc_Vect_I));  // Amplitude control of oscillator
-
-    // rotate vectors while maintaining constant oscillator amplitude
-    Osc_Vect_Q = Osc_Gain * Osc_Q;
-    Osc_Vect_I = Osc_Gain * Osc_I;
-    //
-    // do actual frequency conversion
-    float freqAdjFactor = 1.1;
-    float_buffer_L[i] = (float_buffer_L_3[i] * freqAdjFactor * Osc_Q) + (float_buffer_R_3[i] * freqAdjFactor * Osc_I); // multiply I/Q data by sine/cosine data to do translation
-    float_buffer_R[i] = (float_buffer_R_3[i] * freqAdjFactor * Osc_Q) - (float_buffer_L_3[i] * freqAdjFactor * Osc_I);
+  ncoInc = (int32_t)((NCOFreq + sideToneShift) * (4294967296.0 / 192000.0)); //192000 SPS is the actual sample rate used in the Receive ADC
+
+  phase = ncoPhase;
+  for (unsigned i = 0; i < BUFFER_SIZE * N_BLOCKS; i += 4) {
+    NCOLookup(phase, &s0, &c0);
+    NCOLookup(phase + ncoInc, &s1, &c1);
+    NCOLookup(phase + 2 * ncoInc, &s2, &c2);
+    NCOLookup(phase + 3 * ncoInc, &s3, &c3);
+    phase += 4 * ncoInc;
+
+    i0 = float_buffer_L[i];                     // In place, each group of four is read before it is written
+    q0 = float_buffer_R[i];
+    i1 = float_buffer_L[i + 1];
+    q1 = float_buffer_R[i + 1];
+    i2 = float_buffer_L[i + 2];
+    q2 = float_buffer_R[i + 2];
+    i3 = float_buffer_L[i + 3];
+    q3 = float_buffer_R[i + 3];
+
+    // multiply I/Q data by the oscillator, I = cos, Q = -sin, to do translation
+    float_buffer_L[i]     = q0 * c0 - i0 * s0;
+    float_buffer_R[i]     = -(q0 * s0 + i0 * c0);
+    float_buffer_L[i + 1] = q1 * c1 - i1 * s1;
+    float_buffer_R[i + 1] = -(q1 * s1 + i1 * c1);
+    float_buffer_L[i + 2] = q2 * c2 - i2 * s2;
+    float_buffer_R[i + 2] = -(q2 * s2 + i2 * c2);
+    float_buffer_L[i + 3] = q3 * c3 - i3 * s3;
+    float_buffer_R[i + 3] = -(q3 * s3 + i3 * c3);
   }
+  ncoPhase = phase;
 }
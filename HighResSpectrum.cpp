@@ -0,0 +1,126 @@
+#ifndef BEENHERE
+#include "SDT.h"
+#endif
+
+/**********************************************************************************
+  High resolution panadapter
+
+  At zoom 1 the panadapter is a SPECTRUM_RES point FFT, 375 Hz per pixel at 192 kHz. Narrower
+  bins used to need the zoom path, with its IIR and decimating FIR. Instead, with
+  spectrumFFTLength set to 2048 or 4096, HighResSpectrum() gathers that many samples, over one
+  or two blocks (four or eight in the low-latency path), and makes one long FFT of them. Each
+  display pixel then takes the largest, or the mean, of the spectrumFFTLength / SPECTRUM_RES
+  bins under it. hiResPixelBin[] holds the first FFT bin of every pixel, with the swap of the
+  negative and positive halves already in it.
+
+  Max binning keeps a narrow carrier at its full height wherever it falls in the pixel, so it
+  suits finding weak CW signals; mean binning gives a steadier noise floor. The powers are
+  scaled so a carrier reads the same as at SPECTRUM_RES, while the noise in each bin falls by
+  3 dB for every doubling of the length, which is what brings weak signals out of it.
+
+  Samples are gathered on every block, whether or not the display has room for a frame, so the
+  FFT input is contiguous. A spectrum is finished only every spectrumFFTLength samples, so with
+  4096 the display runs at half its usual frame rate; CalcZoom1Magn() clears updateDisplayFlag
+  on the blocks in between, so they publish no frame. If the display is still busy, or no frame
+  is due, when the buffer fills, the buffer waits for it and the samples meanwhile are dropped. The zoom path
+  is unchanged and still used for narrow spans.
+**********************************************************************************/
+
+uint32_t spectrumFFTLength = SPECTRUM_RES;              // SPECTRUM_RES, HIRES_FFT_2048 or HIRES_FFT_4096
+int spectrumBinning = BINNING_MAX;
+uint32_t hiResFill = 0;                                 // Samples gathered towards the next FFT
+DMAMEM float32_t hiResBuffer[HIRES_FFT_MAX * 2] __attribute__((aligned(4)));
+DMAMEM float32_t hiResWindow[HIRES_FFT_MAX];
+uint16_t hiResPixelBin[SPECTRUM_RES];
+
+/*****
+  Purpose: Build the window for the current length and the pixel to bin index
+
+  Parameter list:
+    void
+
+  Return value;
+    void
+*****/
+void HighResWindowBuild()
+{
+  uint32_t binsPerPixel = spectrumFFTLength / SPECTRUM_RES;
+
+  if (spectrumFFTLength <= SPECTRUM_RES) {
+    return;
+  }
+  WindowBuild(hiResWindow, spectrumFFTLength, spectrumWindowType);
+  for (int x = 0; x < SPECTRUM_RES; x++) {              // Pixel 0 is the most negative frequency
+    hiResPixelBin[x] = (x * binsPerPixel + spectrumFFTLength / 2) % spectrumFFTLength;
+  }
+}
+
+/*****
+  Purpose: Select the panadapter FFT length at zoom 1
+
+  Parameter list:
+    uint32_t length         SPECTRUM_RES for the normal display, HIRES_FFT_2048 or HIRES_FFT_4096
+
+  Return value;
+    void
+*****/
+void SetSpectrumResolution(uint32_t length)
+{
+  if (length != HIRES_FFT_2048 && length != HIRES_FFT_4096) {
+    length = SPECTRUM_RES;
+  }
+  DSPNoInterrupts();                                    // The DSP task must not see half a table
+  spectrumFFTLength = length;
+  hiResFill = 0;
+  HighResWindowBuild();
+  DSPInterrupts();
+}
+
+/*****
+  Purpose: Add the block to the high resolution FFT input and, once there are spectrumFFTLength
+           samples and the display has room for a frame, work out the binned powers
+
+  Parameter list:
+    uint32_t blockSize      samples in float_buffer_L and float_buffer_R
+
+  Return value;
+    int                     1 if FFT_spec holds a new spectrum in display order, 0 if more
+                            samples are needed
+*****/
+int HighResSpectrum(uint32_t blockSize)
+{
+  uint32_t count = min(blockSize, spectrumFFTLength - hiResFill);
+  uint32_t binsPerPixel = spectrumFFTLength / SPECTRUM_RES;
+  float32_t ratio = (float32_t)SPECTRUM_RES / (float32_t)spectrumFFTLength;
+  float32_t scale = ratio * ratio;                      // Carrier level as at SPECTRUM_RES
+  float32_t *bin;
+  float32_t power, value;
+
+  for (uint32_t i = 0; i < count; i++) {
+    hiResBuffer[(hiResFill + i) * 2] = float_buffer_L[i];
+    hiResBuffer[(hiResFill + i) * 2 + 1] = float_buffer_R[i];
+  }
+  hiResFill += count;
+  if (hiResFill < spectrumFFTLength || updateDisplayFlag == 0) {
+    return 0;
+  }
+  hiResFill = 0;
+
+  arm_cmplx_mult_real_f32(hiResBuffer, hiResWindow, hiResBuffer, spectrumFFTLength);
+  arm_cfft_f32(spectrumFFTLength == HIRES_FFT_4096 ? &arm_cfft_sR_f32_len4096 : &arm_cfft_sR_f32_len2048,
+               hiResBuffer, 0, 1);
+
+  if (spectrumBinning == BINNING_MEAN) {
+    scale /= (float32_t)binsPerPixel;
+  }
+  for (int x = 0; x < SPECTRUM_RES; x++) {
+    bin = &hiResBuffer[hiResPixelBin[x] * 2];
+    value = 0.0;
+    for (uint32_t k = 0; k < binsPerPixel; k++) {
+      power = bin[2 * k] * bin[2 * k] + bin[2 * k + 1] * bin[2 * k + 1];
+      value = (spectrumBinning == BINNING_MEAN) ? value + power : max(value, power);
+    }
+    FFT_spec[x] = scale * value;
+  }
+  return 1;
+}
@@ -0,0 +1,291 @@
+#ifndef BEENHERE
+#include "SDT.h"
+#endif
+
+/**********************************************************************************
+  Recorded IQ replay for the receive chain.
+
+  With IQ_REPLAY defined in SDT.h, ProcessIQData() still paces itself on the Q_in_L/Q_in_R
+  queues so timing is the same as on the air, but the samples it processes come from
+  IQ_REPLAY_FILE on the SD card instead of the codec. The audio sent to the codec during the
+  first pass through the file is also written to IQ_RECORD_FILE, so the same recording can be
+  run before and after a DSP change and the two WAV files compared on a PC.
+
+  The DSP task runs in an interrupt and must not touch the SD card: a read can take
+  milliseconds, and SdFat is not reentrant, so the DSP task interrupting the bearing map or
+  any other loop() user of the card would corrupt its state. All file access is therefore in
+  IQReplayService(), called from loop() and from the loops that wait for the DSP task. It
+  keeps the replay ring filled from the file and empties the record ring into it, in
+  IQ_REPLAY_SD_FRAMES chunks. The DSP task only copies frames out of one ring and into the
+  other. Each ring has one writer, which alone moves its head, and one reader, which alone
+  moves its tail; both counts run freely and are taken modulo IQ_REPLAY_RING_FRAMES.
+
+  If loop() falls behind, in a menu say, and the replay ring does not hold a whole block, the
+  block is skipped and counted in iqReplayUnderruns. Nothing is recorded for it, so the
+  recorded audio is still one unbroken pass through the file.
+**********************************************************************************/
+#ifdef IQ_REPLAY
+
+File iqReplayFile;
+File iqRecordFile;
+uint32_t iqReplayDataStart;                       // File offset of the first sample frame
+uint32_t iqReplayDataBytes;                       // Size of the data chunk
+uint32_t iqReplayPosition;                        // Bytes into the data chunk of the next read
+uint32_t iqReplayPassFrames;                      // Audio frames recorded, one pass in whole BUFFER_SIZE blocks
+uint32_t iqRecordDataBytes;
+int iqReplayActive = 0;
+volatile int iqRecordActive = 0;
+volatile uint32_t iqReplayHead = 0;               // Frames put in the replay ring, loop() only
+volatile uint32_t iqReplayTail = 0;               // Frames taken out, DSP task only
+volatile uint32_t iqRecordHead = 0;               // Frames put in the record ring, DSP task only
+volatile uint32_t iqRecordTail = 0;               // Frames written to the file, loop() only
+volatile uint32_t iqReplayUnderruns = 0;          // Blocks skipped because the replay ring ran dry
+volatile uint32_t iqRecordOverruns = 0;           // Frames lost because the record ring was full
+DMAMEM int16_t iqReplayRing[2 * IQ_REPLAY_RING_FRAMES];
+DMAMEM int16_t iqRecordRing[2 * IQ_REPLAY_RING_FRAMES];
+DMAMEM int16_t iqReplayBuffer[2 * 2048];        // Interleaved I/Q frames for one ProcessIQData() block, BUFFER_SIZE * N_BLOCKS
+
+/*****
+  Purpose: Write a canonical 44 byte PCM WAV header
+
+  Parameter list:
+    File &f               the file to write to
+    uint32_t dataBytes    size of the data chunk
+
+  Return value;
+    void
+*****/
+void WriteWAVHeader(File &f, uint32_t dataBytes)
+{
+  uint8_t header[44];
+  uint32_t val;
+  uint16_t val16;
+
+  memcpy(header, "RIFF", 4);
+  val = dataBytes + 36;
+  memcpy(&header[4], &val, 4);
+  memcpy(&header[8], "WAVEfmt ", 8);
+  val = 16;                                       // PCM fmt chunk size
+  memcpy(&header[16], &val, 4);
+  val16 = 1;                                      // PCM
+  memcpy(&header[20], &val16, 2);
+  val16 = 2;                                      // Stereo
+  memcpy(&header[22], &val16, 2);
+  val = (uint32_t)SR[SampleRate].rate;
+  memcpy(&header[24], &val, 4);
+  val = (uint32_t)SR[SampleRate].rate * 4;        // Byte rate
+  memcpy(&header[28], &val, 4);
+  val16 = 4;                                      // Block align
+  memcpy(&header[32], &val16, 2);
+  val16 = 16;                                     // Bits per sample
+  memcpy(&header[34], &val16, 2);
+  memcpy(&header[36], "data", 4);
+  memcpy(&header[40], &dataBytes, 4);
+  f.seek(0);
+  f.write(header, 44);
+}
+
+/*****
+  Purpose: Open the IQ replay file, check its format and create the audio record file
+
+  Parameter list:
+    void
+
+  Return value;
+    int             1 if replay is active, 0 otherwise
+*****/
+int InitIQReplay()
+{
+  char chunkID[5] = { 0 };
+  uint32_t chunkSize;
+  uint32_t sampleRate = 0;
+  uint16_t channels = 0;
+  uint16_t bitsPerSample = 0;
+
+  iqReplayActive = 0;
+  iqRecordActive = 0;
+  if (sdCardPresent == 0) {
+    return 0;
+  }
+  iqReplayFile = SD.open(IQ_REPLAY_FILE, FILE_READ);
+  if (!iqReplayFile) {
+#ifdef DEBUG
+    Serial.printf("IQ replay: %s not found\n", IQ_REPLAY_FILE);
+#endif
+    return 0;
+  }
+  iqReplayFile.read(chunkID, 4);
+  if (strcmp(chunkID, "RIFF") != 0) {
+    iqReplayFile.close();
+    return 0;
+  }
+  iqReplayFile.seek(12);                          // Skip RIFF size and "WAVE"
+  while (iqReplayFile.read(chunkID, 4) == 4) {    // Walk the chunk list for "fmt " and "data"
+    iqReplayFile.read(&chunkSize, 4);
+    if (strcmp(chunkID, "fmt ") == 0) {
+      iqReplayFile.seek(iqReplayFile.position() + 2);   // Audio format
+      iqReplayFile.read(&channels, 2);
+      iqReplayFile.read(&sampleRate, 4);
+      iqReplayFile.seek(iqReplayFile.position() + 6);   // Byte rate, block align
+      iqReplayFile.read(&bitsPerSample, 2);
+      iqReplayFile.seek(iqReplayFile.position() + chunkSize - 16);
+    } else if (strcmp(chunkID, "data") == 0) {
+      iqReplayDataStart = iqReplayFile.position();
+      iqReplayDataBytes = chunkSize;
+      break;
+    } else {
+      iqReplayFile.seek(iqReplayFile.position() + chunkSize + (chunkSize & 1));
+    }
+  }
+  if (channels != 2 || bitsPerSample != 16 || iqReplayDataBytes < sizeof(iqReplayBuffer)) {
+#ifdef DEBUG
+    Serial.printf("IQ replay: %s must be 16-bit stereo, got %d channels, %d bits\n", IQ_REPLAY_FILE, channels, bitsPerSample);
+#endif
+    iqReplayFile.close();
+    return 0;
+  }
+#ifdef DEBUG
+  if (sampleRate != (uint32_t)SR[SampleRate].rate) {
+    Serial.printf("IQ replay: file rate %lu, receive chain runs at %lu\n", sampleRate, (uint32_t)SR[SampleRate].rate);
+  }
+#endif
+  iqReplayFile.seek(iqReplayDataStart);
+  iqReplayPosition = 0;
+  iqReplayPassFrames = iqReplayDataBytes / 4 / BUFFER_SIZE * BUFFER_SIZE;
+  iqReplayHead = iqReplayTail = 0;
+  iqRecordHead = iqRecordTail = 0;
+  iqReplayUnderruns = 0;
+  iqRecordOverruns = 0;
+
+  SD.remove(IQ_RECORD_FILE);
+  iqRecordFile = SD.open(IQ_RECORD_FILE, FILE_WRITE);
+  if (iqRecordFile) {
+    iqRecordDataBytes = 0;
+    WriteWAVHeader(iqRecordFile, 0);              // Sizes are patched when the pass is complete
+    iqRecordActive = 1;
+  }
+  iqReplayActive = 1;
+  IQReplayService();                              // Fill the ring before the DSP task starts
+  return 1;
+}
+
+/*****
+  Purpose: Move samples between the SD card and the replay and record rings. Called from
+           loop() and from the loops that wait for the DSP task, never from the DSP task.
+
+  Parameter list:
+    void
+
+  Return value;
+    void
+*****/
+void IQReplayService()
+{
+  uint32_t index, frames, queued;
+
+  if (iqReplayActive == 0) {
+    return;
+  }
+  // Top up the replay ring, wrapping to the start of the data chunk at the end of the file
+  while (IQ_REPLAY_RING_FRAMES - (iqReplayHead - iqReplayTail) >= IQ_REPLAY_SD_FRAMES) {
+    index = iqReplayHead % IQ_REPLAY_RING_FRAMES;
+    frames = min((uint32_t)IQ_REPLAY_SD_FRAMES, (iqReplayDataBytes - iqReplayPosition) / 4);
+    frames = min(frames, IQ_REPLAY_RING_FRAMES - index);
+    if (frames == 0) {
+      iqReplayFile.seek(iqReplayDataStart);
+      iqReplayPosition = 0;
+      continue;
+    }
+    iqReplayFile.read(&iqReplayRing[2 * index], frames * 4);
+    iqReplayPosition += frames * 4;
+    __DSB();                                      // Samples are in the ring before the head moves
+    iqReplayHead = iqReplayHead + frames;
+  }
+
+  // Write out the audio the DSP task has recorded, and finish the WAV file after one pass
+  while (iqRecordActive) {
+    queued = iqRecordHead - iqRecordTail;
+    index = iqRecordTail % IQ_REPLAY_RING_FRAMES;
+    frames = min(queued, IQ_REPLAY_RING_FRAMES - index);
+    frames = min(frames, (uint32_t)IQ_REPLAY_SD_FRAMES);
+    if (frames < IQ_REPLAY_SD_FRAMES && iqRecordDataBytes / 4 + queued < iqReplayPassFrames) {
+      break;                                      // Wait for a whole chunk unless it is the last
+    }
+    if (frames > 0) {
+      iqRecordFile.write(&iqRecordRing[2 * index], frames * 4);
+      iqRecordDataBytes += frames * 4;
+      iqRecordTail = iqRecordTail + frames;
+    }
+    if (iqRecordDataBytes / 4 >= iqReplayPassFrames) {
+      WriteWAVHeader(iqRecordFile, iqRecordDataBytes);
+      iqRecordFile.close();
+      iqRecordActive = 0;
+#ifdef DEBUG
+      Serial.printf("IQ replay: %lu bytes of audio written to %s, %lu blocks skipped, %lu frames lost\n",
+                    iqRecordDataBytes, IQ_RECORD_FILE, iqReplayUnderruns, iqRecordOverruns);
+#endif
+    }
+  }
+}
+
+/*****
+  Purpose: Take the next receive block of frames out of the replay ring. Called by the DSP task.
+
+  Parameter list:
+    uint32_t blocksize      number of frames, BUFFER_SIZE * N_BLOCKS
+
+  Return value;
+    int16_t *               interleaved I/Q frames for IngestIQBlock(), NULL if no file is open
+                            or loop() has not filled the ring with a whole block
+*****/
+int16_t *IQReplayRead(uint32_t blocksize)
+{
+  uint32_t index = iqReplayTail % IQ_REPLAY_RING_FRAMES;
+  uint32_t first = min(blocksize, IQ_REPLAY_RING_FRAMES - index);
+
+  if (iqReplayActive == 0) {
+    return NULL;
+  }
+  if (iqReplayHead - iqReplayTail < blocksize) {
+    iqReplayUnderruns++;
+    return NULL;
+  }
+  memcpy(iqReplayBuffer, &iqReplayRing[2 * index], first * 4);
+  memcpy(&iqReplayBuffer[2 * first], iqReplayRing, (blocksize - first) * 4);
+  __DSB();                                        // Copied out before loop() may refill the space
+  iqReplayTail = iqReplayTail + blocksize;
+  return iqReplayBuffer;
+}
+
+/*****
+  Purpose: Put one block of codec audio in the record ring. Called by the DSP task.
+
+  Parameter list:
+    int16_t *L_buffer       left audio, as sent to Q_out_L
+    int16_t *R_buffer       right audio, as sent to Q_out_R
+    uint32_t blocksize      number of samples, at most BUFFER_SIZE
+
+  Return value;
+    void
+*****/
+void IQReplayWriteAudio(int16_t *L_buffer, int16_t *R_buffer, uint32_t blocksize)
+{
+  uint32_t index;
+
+  if (iqRecordActive == 0 || iqRecordHead >= iqReplayPassFrames) {
+    return;
+  }
+  if (IQ_REPLAY_RING_FRAMES - (iqRecordHead - iqRecordTail) < blocksize) {
+    iqRecordOverruns += blocksize;
+    return;
+  }
+  for (unsigned i = 0; i < blocksize; i++) {
+    index = (iqRecordHead + i) % IQ_REPLAY_RING_FRAMES;
+    iqRecordRing[2 * index]     = L_buffer[i];
+    iqRecordRing[2 * index + 1] = R_buffer[i];
+  }
+  __DSB();                                        // Audio is in the ring before the head moves
+  iqRecordHead = iqRecordHead + blocksize;
+}
+
+#endif
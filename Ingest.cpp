@@ -0,0 +1,66 @@
+#ifndef BEENHERE
+#include "SDT.h"
+#endif
+
+/**********************************************************************************
+  Receive ingest
+
+  Each 128-sample block is converted from q15, scaled and DC-blocked in one pass as it is
+  pulled from Q_in_L/Q_in_R. The old chain ran arm_q15_to_float(), two arm_scale_f32() calls
+  and the s1_Receive2 biquad as separate passes over all 2048 samples of each channel.
+
+  Everything up to the IQ correction is linear, so rfGainAllBands, bands[].RFgain, the manual IQ
+  amplitude correction and the q15 scale collapse into one factor per channel, applied before
+  the biquad. The DC blocker uses the HP_DC_Filter_Coeffs2 section with a separate state for I
+  and Q; s1_Receive2 shared one state between both channels.
+**********************************************************************************/
+
+float32_t dcBlockStateI[2];
+float32_t dcBlockStateQ[2];
+
+/*****
+  Purpose: Convert one I/Q block to float, apply the channel gains and the DC blocking high pass
+
+  Parameter list:
+    const int16_t *I_in     q15 samples
+    const int16_t *Q_in
+    uint32_t stride         1 for queue buffers, 2 for interleaved frames
+    float32_t *I_out        blockSize samples, normally inside float_buffer_L
+    float32_t *Q_out
+    uint32_t blockSize
+    float32_t gainI         combined gain, 1.0 = same scale as arm_q15_to_float()
+    float32_t gainQ
+
+  Return value;
+    void
+*****/
+FASTRUN void IngestIQBlock(const int16_t *I_in, const int16_t *Q_in, uint32_t stride, float32_t *I_out, float32_t *Q_out, uint32_t blockSize, float32_t gainI, float32_t gainQ)
+{
+  const float32_t b0 = HP_DC_Filter_Coeffs2[0];
+  const float32_t b1 = HP_DC_Filter_Coeffs2[1];
+  const float32_t b2 = HP_DC_Filter_Coeffs2[2];
+  const float32_t a1 = HP_DC_Filter_Coeffs2[3];         // CMSIS sign convention, already negated
+  const float32_t a2 = HP_DC_Filter_Coeffs2[4];
+  float32_t dI1 = dcBlockStateI[0], dI2 = dcBlockStateI[1];
+  float32_t dQ1 = dcBlockStateQ[0], dQ2 = dcBlockStateQ[1];
+  float32_t xI, xQ, yI, yQ;
+
+  gainI *= (float32_t)(1.0 / 32768.0);
+  gainQ *= (float32_t)(1.0 / 32768.0);
+  for (unsigned i = 0; i < blockSize; i++) {
+    xI = gainI * (float32_t)I_in[i * stride];            // I and Q interleaved so the FPU can overlap them
+    xQ = gainQ * (float32_t)Q_in[i * stride];
+    yI = b0 * xI + dI1;
+    yQ = b0 * xQ + dQ1;
+    dI1 = b1 * xI + a1 * yI + dI2;
+    dQ1 = b1 * xQ + a1 * yQ + dQ2;
+    dI2 = b2 * xI + a2 * yI;
+    dQ2 = b2 * xQ + a2 * yQ;
+    I_out[i] = yI;
+    Q_out[i] = yQ;
+  }
+  dcBlockStateI[0] = dI1;
+  dcBlockStateI[1] = dI2;
+  dcBlockStateQ[0] = dQ1;
+  dcBlockStateQ[1] = dQ2;
+}
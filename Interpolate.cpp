@@ -0,0 +1,182 @@
+#ifndef BEENHERE
+#include "SDT.h"
+#endif
+
+/**********************************************************************************
+  Complex half-band interpolator
+
+  The mirror image of Decimate.cpp: takes the 24 kHz I/Q stream back up to 192 kHz in three
+  half-band stages of 2, using the same stage design. In a half-band interpolator every other
+  output is just a copy of an input sample, and the outputs between them cost (numTaps + 1) / 4
+  multiplies per channel. The gain of 2 each stage needs to make up for the inserted zeros is
+  built into the stage, so there is no scaling pass afterwards.
+
+  The last stage is run by InterpolateOutput() straight into the int16_t audio queue buffers,
+  with the volume or drive gain and the q15 conversion folded into its coefficients, so the
+  192 kHz signal never exists as float.
+**********************************************************************************/
+
+struct interpolator rxInterpolator;
+struct interpolator txInterpolator;
+
+/*****
+  Purpose: Set up a three stage interpolate-by-8 chain. Stage 0 runs first, at the lowest rate.
+
+  Parameter list:
+    struct interpolator *interp
+    float32_t *work         interleaved scratch, 2 * (2048 + DEC_MAX_TAPS) floats, may be shared with a decimator
+    float32_t att           stopband attenuation, dB
+    float32_t passband      widest signal to keep, Hz
+    float32_t rate          output sample rate, Hz
+
+  Return value;
+    void
+*****/
+void InitInterpolator(struct interpolator *interp, float32_t *work, float32_t att, float32_t passband, float32_t rate)
+{
+  interp->work = work;
+  for (int i = DEC_STAGES - 1; i >= 0; i--) {
+    InitHalfBandStage(&interp->stage[i], HalfBandTaps(att, passband, rate), att);
+#ifdef DEBUG
+    Serial.printf("Interpolator stage %d: %d taps at %.0f Hz\n", i + 1, interp->stage[i].numTaps, rate);
+#endif
+    rate /= 2.0;
+  }
+}
+
+/*****
+  Purpose: Copy an I/Q block, interleaved, behind the stage history. An interpolator stage keeps
+           the last 2 * sideTaps - 1 inputs.
+
+  Parameter list:
+    struct halfBandStage *stage
+    float32_t *work
+    float32_t *I_in
+    float32_t *Q_in
+    uint32_t blockSize
+
+  Return value;
+    int                     history size in floats
+*****/
+int HalfBandInterpolateLoad(struct halfBandStage *stage, float32_t *work, float32_t *I_in, float32_t *Q_in, uint32_t blockSize)
+{
+  int historySize = 2 * (2 * ((stage->numTaps + 1) / 4) - 1);
+  float32_t *in = &work[historySize];
+
+  memcpy(work, stage->history, historySize * sizeof(float32_t));
+  for (unsigned i = 0; i < blockSize; i++) {
+    in[2 * i]     = I_in[i];
+    in[2 * i + 1] = Q_in[i];
+  }
+  memcpy(stage->history, &work[2 * blockSize], historySize * sizeof(float32_t));
+  return historySize;
+}
+
+/*****
+  Purpose: Run one half-band interpolation stage. For each input there is one output that is the
+           input sample itself, delayed, and one between it and the next computed from the side
+           taps. Output may overwrite input.
+
+  Parameter list:
+    struct halfBandStage *stage
+    float32_t *work         interleaved scratch
+    float32_t *I_in         blockSize samples
+    float32_t *Q_in
+    float32_t *I_out        2 * blockSize samples
+    float32_t *Q_out
+    uint32_t blockSize
+
+  Return value;
+    void
+*****/
+FASTRUN void HalfBandInterpolate(struct halfBandStage *stage, float32_t *work, float32_t *I_in, float32_t *Q_in, float32_t *I_out, float32_t *Q_out, uint32_t blockSize)
+{
+  int sideTaps = (stage->numTaps + 1) / 4;
+  float32_t h[(DEC_MAX_TAPS + 1) / 4];
+  float32_t accI, accQ;
+
+  for (int k = 0; k < sideTaps; k++) {
+    h[k] = 2.0 * stage->coeffs[k];                       // Make up for the inserted zeros
+  }
+  HalfBandInterpolateLoad(stage, work, I_in, Q_in, blockSize);
+
+  for (unsigned m = 0; m < blockSize; m++) {
+    const float32_t *x = &work[2 * (m + sideTaps - 1)];   // Input sample just before the new output
+    accI = 0.0;
+    accQ = 0.0;
+    for (int k = 0; k < sideTaps; k++) {
+      accI += h[k] * (x[-2 * k] + x[2 * k + 2]);
+      accQ += h[k] * (x[1 - 2 * k] + x[2 * k + 3]);
+    }
+    I_out[2 * m]     = x[0];
+    Q_out[2 * m]     = x[1];
+    I_out[2 * m + 1] = accI;
+    Q_out[2 * m + 1] = accQ;
+  }
+}
+
+/*****
+  Purpose: Run the first stages of an interpolator, in place
+
+  Parameter list:
+    struct interpolator *interp
+    float32_t *I_buffer     blockSize samples in, blockSize * 4 out
+    float32_t *Q_buffer
+    uint32_t blockSize
+
+  Return value;
+    void
+*****/
+FASTRUN void Interpolate(struct interpolator *interp, float32_t *I_buffer, float32_t *Q_buffer, uint32_t blockSize)
+{
+  for (int i = 0; i < DEC_STAGES - 1; i++) {
+    HalfBandInterpolate(&interp->stage[i], interp->work, I_buffer, Q_buffer, I_buffer, Q_buffer, blockSize);
+    blockSize *= 2;
+  }
+}
+
+/*****
+  Purpose: Run the last interpolator stage straight into q15 audio buffers. The gain and the q15
+           scale are folded into the taps, and the result is saturated the same way as
+           arm_float_to_q15().
+
+  Parameter list:
+    struct interpolator *interp
+    float32_t *I_in         blockSize samples from Interpolate()
+    float32_t *Q_in
+    int16_t *I_out          2 * blockSize samples, normally from AudioPlayQueue::getBuffer()
+    int16_t *Q_out
+    uint32_t blockSize
+    float32_t gain          volume or drive, 1.0 = unity
+
+  Return value;
+    void
+*****/
+FASTRUN void InterpolateOutput(struct interpolator *interp, float32_t *I_in, float32_t *Q_in, int16_t *I_out, int16_t *Q_out, uint32_t blockSize, float32_t gain)
+{
+  struct halfBandStage *stage = &interp->stage[DEC_STAGES - 1];
+  float32_t *work = interp->work;
+  int sideTaps = (stage->numTaps + 1) / 4;
+  float32_t h[(DEC_MAX_TAPS + 1) / 4];
+  float32_t center = gain * 32768.0;
+  float32_t accI, accQ;
+
+  for (int k = 0; k < sideTaps; k++) {
+    h[k] = 2.0 * center * stage->coeffs[k];
+  }
+  HalfBandInterpolateLoad(stage, work, I_in, Q_in, blockSize);
+
+  for (unsigned m = 0; m < blockSize; m++) {
+    const float32_t *x = &work[2 * (m + sideTaps - 1)];
+    accI = 0.0;
+    accQ = 0.0;
+    for (int k = 0; k < sideTaps; k++) {
+      accI += h[k] * (x[-2 * k] + x[2 * k + 2]);
+      accQ += h[k] * (x[1 - 2 * k] + x[2 * k + 3]);
+    }
+    I_out[2 * m]     = __SSAT((int32_t)(center * x[0]), 16);
+    Q_out[2 * m]     = __SSAT((int32_t)(center * x[1]), 16);
+    I_out[2 * m + 1] = __SSAT((int32_t)accI, 16);
+    Q_out[2 * m + 1] = __SSAT((int32_t)accQ, 16);
+  }
+}
@@ -0,0 +1,164 @@
+#ifndef BEENHERE
+#include "SDT.h"
+#endif
+
+/**********************************************************************************
+  Low-latency receive path
+
+  Most of the delay between a signal at the antenna and the audio comes from gathering
+  N_BLOCKS audio library blocks (2048 samples, 10.7 ms at 192 kHz) before ProcessIQData()
+  starts, and from the group delay of the FFT filter, half its m_NumTaps at 24 kHz unless a
+  minimum phase mask is selected (see MaskCache.cpp). For CW that is heard as lag behind the
+  other station's keying.
+
+  In the low-latency path ProcessIQData() gathers LOW_LATENCY_BLOCKS blocks (512 samples, the
+  least CalcZoom1Magn() can make a spectrum from) and the FFT filter runs at
+  LOW_LATENCY_FFT_LENGTH with a hop of the whole 64 sample decimated block. That filter has
+  fewer taps, so its skirts are wider, which the CW audio filters after it make up for. The CW
+  decoder still sees 256 samples at a time, see DoCWReceiveProcessing(). NR, the automatic
+  notch and the noise blanker work on 256 sample frames and are bypassed.
+
+  lowLatencyMode[] holds, for each band, LOW_LATENCY_OFF, LOW_LATENCY_CW (only while the radio
+  is in CW_RECEIVE) or LOW_LATENCY_ON. LowLatencyUpdate() is polled from loop() and switches
+  the chain when the wanted state changes. The FFT length and hop chosen in RF Options are put
+  back when it switches off.
+
+  Audio already queued for output at the old block size would stay ahead of the new blocks for
+  good, since the queue only drains when it runs dry. So after switching in, the output of
+  LATENCY_FLUSH_BLOCKS blocks is held back to let it empty.
+
+  ReceiveLatencyMs() adds up the delay from the block size, the DSP task timer and the measured
+  ProcessIQData() time, the decimator, FFT filter and interpolator group delays and the audio
+  library's own buffering. It is printed with the profiler report.
+**********************************************************************************/
+
+uint8_t lowLatencyMode[NUMBER_OF_BANDS];        // LOW_LATENCY_OFF, LOW_LATENCY_CW or LOW_LATENCY_ON
+int lowLatencyActive = 0;
+volatile uint32_t latencyFlushBlocks = 0;       // Blocks whose output ProcessIQData() holds back
+uint32_t normalFFTLength = FFT_LENGTH;          // The FFT filter to go back to
+uint32_t normalFFTHop = FFT_LENGTH / 2;
+
+/*****
+  Purpose: Should the low-latency path be running for the current band and state?
+
+  Parameter list:
+    void
+
+  Return value;
+    int                     1 if it should
+*****/
+int LowLatencyWanted()
+{
+  switch (lowLatencyMode[currentBand]) {
+    case LOW_LATENCY_ON:
+      return 1;
+    case LOW_LATENCY_CW:
+      return (T41State == CW_RECEIVE);
+  }
+  return 0;
+}
+
+/*****
+  Purpose: Switch the receive chain in or out of the low-latency path when the band, the mode or
+           the band's setting changes. Called from loop().
+
+  Parameter list:
+    void
+
+  Return value;
+    void
+*****/
+void LowLatencyUpdate()
+{
+  int wanted = LowLatencyWanted();
+
+  if (wanted == lowLatencyActive) {
+    return;
+  }
+  if (wanted) {
+    normalFFTLength = FFT_length;
+    normalFFTHop = fftHop;
+    if (SetReceiveChain(LOW_LATENCY_BLOCKS, LOW_LATENCY_FFT_LENGTH, BUFFER_SIZE * LOW_LATENCY_BLOCKS / DF) == 0) {
+      return;
+    }
+    latencyFlushBlocks = LATENCY_FLUSH_BLOCKS;
+  } else {
+    SetReceiveChain(N_B, normalFFTLength, normalFFTHop);
+  }
+  lowLatencyActive = wanted;
+  FilterBandwidth();                            // Applies the passband shift to the new masks
+}
+
+/*****
+  Purpose: Group delay of a decimator or interpolator stage chain. Stage i of a decimator
+           runs at rate / 2^i; stage i of an interpolator produces rate / 2^(DEC_STAGES - 1 - i).
+
+  Parameter list:
+    const struct halfBandStage *stage   DEC_STAGES stages
+    float32_t rate          decimator input or interpolator output rate, Hz
+    int interpolator        1 if the stages are an interpolator's
+
+  Return value;
+    float32_t               seconds
+*****/
+float32_t HalfBandChainDelay(const struct halfBandStage *stage, float32_t rate, int interpolator)
+{
+  float32_t delay = 0.0;
+  float32_t stageRate;
+
+  for (int i = 0; i < DEC_STAGES; i++) {
+    stageRate = rate / (float32_t)(1 << (interpolator ? DEC_STAGES - 1 - i : i));
+    delay += 0.5 * (float32_t)(stage[i].numTaps - 1) / stageRate;
+  }
+  return delay;
+}
+
+/*****
+  Purpose: Estimate the delay from the antenna to the audio output through the receive chain
+
+  Parameter list:
+    float32_t *parts        if not NULL, LATENCY_PART_COUNT values in ms: gather, DSP, filters
+                            and audio library
+
+  Return value;
+    float32_t               ms
+*****/
+float32_t ReceiveLatencyMs(float32_t *parts)
+{
+  float32_t rate = (float32_t)SR[SampleRate].rate;
+  float32_t gather, dsp, filters, audio;
+
+  // ProcessIQData() starts once more than N_BLOCKS blocks are queued, when the DSP timer next fires
+  gather = (float32_t)((N_BLOCKS + 1) * BUFFER_SIZE) / rate + 0.5e-6 * DSP_TIMER_PERIOD;
+  dsp = ProfileStageMicros(PROF_TOTAL) * 1.0e-6;
+  filters = HalfBandChainDelay(rxDecimator.stage, rate, 0)
+            + MaskDelaySamples(filterMask) / (rate / DF)   // Less than half of m_NumTaps with a minimum phase mask
+            + HalfBandChainDelay(rxInterpolator.stage, rate, 1);
+  audio = 2.0 * BUFFER_SIZE / rate;             // One block each in the input and output DMA
+
+  if (parts != NULL) {
+    parts[0] = gather * 1000.0;
+    parts[1] = dsp * 1000.0;
+    parts[2] = filters * 1000.0;
+    parts[3] = audio * 1000.0;
+  }
+  return (gather + dsp + filters + audio) * 1000.0;
+}
+
+/*****
+  Purpose: Print the receive latency estimate to USB serial
+
+  Parameter list:
+    void
+
+  Return value;
+    void
+*****/
+void LatencyPrintReport()
+{
+  float32_t parts[LATENCY_PART_COUNT];
+  float32_t total = ReceiveLatencyMs(parts);
+
+  Serial.printf("Receive latency: %.1f ms (gather %.1f, DSP %.1f, filters %.1f, audio %.1f), %s path, FFT %lu hop %lu\n",
+                total, parts[0], parts[1], parts[2], parts[3], lowLatencyActive ? "low-latency" : "normal", FFT_length, fftHop);
+}
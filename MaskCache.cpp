@@ -0,0 +1,419 @@
+#ifndef BEENHERE
+#include "SDT.h"
+#endif
+
+/**********************************************************************************
+  Filter mask cache
+
+  The receive filter runs as a multiply by a frequency domain mask in ProcessIQData(). A new
+  mask means designing m_NumTaps complex FIR coefficients with CalcCplxFIRCoeffs() and taking a
+  512 point FFT of them. FilterBandwidth() used to do that on every click of the filter encoder,
+  often twice, with the audio and DSP interrupts off the whole time.
+
+  Masks are kept here in up to MASK_CACHE_SLOTS slots in OCRAM, carved out of maskCachePool at
+  2 * FFT_length floats each, so there are fewer of them with the longer FFTs. They are keyed by
+  the cutoffs, the sample rate
+  and, when the receive equalizer is folded into the mask, a signature of the EQ levels. The mode
+  is not part of the key: the mask depends only on the passband, and ControlFilterF() already
+  ties the cutoffs to the mode. filterMask points at the slot in use, so selecting a mask that is
+  already cached is a pointer swap. A miss is built into the least recently used slot, which is
+  never the one in use, so it is done with the DSP still running.
+
+  MaskCacheInit() fills the cache at boot, and again whenever SetConvolution() changes the FFT
+  length or hop, with each band's passband and its mirror image on the other sideband.
+
+  FilterBandwidth() does not switch filterMask itself but leaves the new mask in pendingMask.
+  Each overlap-save block is independent of the last, so switching masks between blocks leaves
+  nothing inconsistent, but the output jumps from one filter's delay and phase to the other's
+  and that clicks. So the block that picks up pendingMask is run through both masks.
+  MaskFadeBegin() runs the old mask and MaskFadeEnd() cross-fades the two outputs over the
+  block. The extra multiply, inverse FFT and fade are charged to PROF_MASK_SWITCH.
+
+  The passband shift (IF shift) does not redesign the filter either. MaskShift() moves the
+  cached mask along the frequency axis into one of three shiftedMasks[] buffers, again never
+  one the DSP is using. A shift of whole bins is a circular copy. Anything else goes back to the
+  taps with an inverse FFT, applies a phase ramp and transforms again. With the receive EQ in
+  the mask, the EQ curve moves with the passband.
+
+  CalcCplxFIRCoeffs() designs linear phase filters, which delay everything by half the tap
+  count, 5.3 ms with the default 257 taps. For CW and QSK a minimum phase mask can be selected
+  instead, per demodulation mode with CW counted as its own, in maskPhase[]. MaskMinimumPhase()
+  converts the linear phase mask by the cepstral (homomorphic) method: the log magnitude is
+  taken on a grid MIN_PHASE_OVERSAMPLE times finer, to keep the cepstrum from aliasing, its
+  cepstrum is folded onto positive time, and the exponential of that gives the spectrum of the
+  causal filter with the same magnitude response. The result is cut back to m_NumTaps, with a
+  short taper, so overlap-save still sees a filter of the length it allows for. The phase is
+  part of the cache key, so both kinds of mask can be cached at once.
+**********************************************************************************/
+
+struct maskCacheKey {
+  int loCut;
+  int hiCut;
+  uint32_t rate;                                // SR[SampleRate].rate, before decimation
+  uint32_t eqSignature;                         // 0 unless receiveEQFlag is EQ_MASK
+  int phase;                                    // MASK_PHASE_LINEAR or MASK_PHASE_MINIMUM
+  uint32_t lastUsed;                            // 0 = empty
+};
+
+float32_t DMAMEM maskCachePool[MASK_CACHE_FLOATS] __attribute__((aligned(32)));
+struct maskCacheKey maskCacheKeys[MASK_CACHE_SLOTS];
+int maskCacheSlots = MASK_CACHE_SLOTS;          // As many as fit at the current FFT_length
+uint32_t maskCacheClock = 0;
+uint32_t maskCacheHits = 0;
+uint32_t maskCacheMisses = 0;
+float32_t * volatile filterMask = maskCachePool;    // Mask used by ProcessIQData(), which moves pendingMask here
+float32_t * volatile pendingMask = NULL;            // Mask to fade to on the next block, set under DSPNoInterrupts()
+float32_t DMAMEM shiftedMasks[3][FFT_LENGTH_MAX * 2] __attribute__((aligned(32)));
+float32_t DMAMEM minPhaseWork[MIN_PHASE_FFT_MAX * 2] __attribute__((aligned(32)));
+int maskPhase[MASK_PHASE_MODES];                 // By MaskPhaseIndex(), all MASK_PHASE_LINEAR at boot
+
+/*****
+  Purpose: Signature of the receive EQ levels if they are built into the mask
+
+  Parameter list:
+    void
+
+  Return value;
+    uint32_t                0 if the equalizer is not in the mask
+*****/
+uint32_t MaskCacheEQSignature()
+{
+  uint32_t hash = 2166136261UL;                 // FNV-1a
+
+  if (receiveEQFlag != EQ_MASK) {
+    return 0;
+  }
+  for (int i = 0; i < EQUALIZER_CELL_COUNT; i++) {
+    hash = (hash ^ (uint32_t)EEPROMData.equalizerRec[i]) * 16777619UL;
+  }
+  return hash | 1;
+}
+
+/*****
+  Purpose: Which maskPhase[] entry applies: the demodulation mode, or MASK_PHASE_CW in CW
+
+  Parameter list:
+    void
+
+  Return value;
+    int                     0 to MASK_PHASE_MODES - 1
+*****/
+int MaskPhaseIndex()
+{
+  if (xmtMode == CW_MODE) {
+    return MASK_PHASE_CW;
+  }
+  return bands[currentBand].mode;
+}
+
+/*****
+  Purpose: Find the mask for a passband, building it if it is not cached
+
+  Parameter list:
+    int loCut               Hz, as in bands[].FLoCut
+    int hiCut               Hz, as in bands[].FHiCut
+    uint32_t rate           sample rate before decimation
+
+  Return value;
+    float32_t *             FFT_length complex bins
+*****/
+float32_t *MaskCacheLookup(int loCut, int hiCut, uint32_t rate)
+{
+  uint32_t eqSignature = MaskCacheEQSignature();
+  int phase = maskPhase[MaskPhaseIndex()];
+  int victim = -1;
+  float32_t *slot, *inUse, *inUseNext;
+
+  DSPNoInterrupts();                            // Both at once, the DSP task may move pendingMask to filterMask between two reads
+  inUse = filterMask;
+  inUseNext = pendingMask;
+  DSPInterrupts();
+
+  maskCacheClock++;
+  for (int i = 0; i < maskCacheSlots; i++) {
+    struct maskCacheKey *key = &maskCacheKeys[i];
+    slot = &maskCachePool[i * 2 * FFT_length];
+    if (key->lastUsed && key->loCut == loCut && key->hiCut == hiCut && key->rate == rate && key->eqSignature == eqSignature && key->phase == phase) {
+      key->lastUsed = maskCacheClock;
+      maskCacheHits++;
+      return slot;
+    }
+    if (slot == inUse || slot == inUseNext) {          // The DSP is using it, or will be after the next block
+      continue;
+    }
+    if (victim < 0 || key->lastUsed < maskCacheKeys[victim].lastUsed) {
+      victim = i;
+    }
+  }
+
+  maskCacheMisses++;
+  CalcCplxFIRCoeffs(FIR_Coef_I, FIR_Coef_Q, m_NumTaps, (float32_t)loCut, (float32_t)hiCut, (float)rate / DF);
+  slot = &maskCachePool[victim * 2 * FFT_length];
+  InitFilterMask(slot);
+  if (phase == MASK_PHASE_MINIMUM) {
+    MaskMinimumPhase(slot);
+  }
+  maskCacheKeys[victim].loCut = loCut;
+  maskCacheKeys[victim].hiCut = hiCut;
+  maskCacheKeys[victim].rate = rate;
+  maskCacheKeys[victim].eqSignature = eqSignature;
+  maskCacheKeys[victim].phase = phase;
+  maskCacheKeys[victim].lastUsed = maskCacheClock;
+  return slot;
+}
+
+/*****
+  Purpose: Empty the cache, build the masks for every band's passband and its opposite sideband,
+           and select the current band's mask. Called from setup() once maskS and the receive
+           equalizer are initialized, and by SetConvolution() with the DSP task stopped.
+
+  Parameter list:
+    void
+
+  Return value;
+    void
+*****/
+void MaskCacheInit()
+{
+  memset(maskCacheKeys, 0, sizeof(maskCacheKeys));
+  maskCacheSlots = MASK_CACHE_FLOATS / (2 * FFT_length);
+  if (maskCacheSlots > MASK_CACHE_SLOTS) {
+    maskCacheSlots = MASK_CACHE_SLOTS;
+  }
+  maskCacheClock = 0;
+  filterMask = NULL;
+  pendingMask = NULL;
+
+  for (int i = 0; i < NUMBER_OF_BANDS; i++) {
+    MaskCacheLookup(bands[i].FLoCut, bands[i].FHiCut, SR[SampleRate].rate);
+    MaskCacheLookup(-bands[i].FHiCut, -bands[i].FLoCut, SR[SampleRate].rate);
+  }
+  filterMask = MaskCacheLookup(bands[currentBand].FLoCut, bands[currentBand].FHiCut, SR[SampleRate].rate);
+  maskCacheHits = 0;
+  maskCacheMisses = 0;
+}
+
+/*****
+  Purpose: If a new mask is pending, filter the block with the old one as well and make the new
+           one current. Called from ProcessIQData() after the forward FFT, inside a scratch scope
+           that lasts until MaskFadeEnd().
+
+  Parameter list:
+    float32_t *spectrum     FFT_length complex bins of the input block
+
+  Return value;
+    float32_t *             the block filtered by the old mask, back in the time domain, or NULL
+                            if no mask is pending
+*****/
+FASTRUN float32_t *MaskFadeBegin(float32_t *spectrum)
+{
+  float32_t *oldOutput;
+
+  if (pendingMask == NULL) {
+    return NULL;
+  }
+  oldOutput = ScratchAlloc(FFT_length * 2);
+  if (oldOutput != NULL) {                      // Without scratch space the switch is just not faded
+    arm_cmplx_mult_cmplx_f32(spectrum, filterMask, oldOutput, FFT_length);
+    arm_cfft_f32(iS, oldOutput, 1, 1);
+  }
+  filterMask = pendingMask;
+  pendingMask = NULL;
+  return oldOutput;
+}
+
+/*****
+  Purpose: Cross-fade the valid fftHop samples at the end of an overlap-save window from the old
+           mask's output to the new mask's, with a raised cosine
+
+  Parameter list:
+    const float32_t *oldOutput  from MaskFadeBegin()
+    float32_t *newOutput        FFT_buffer, after the inverse FFT
+
+  Return value;
+    void
+*****/
+FASTRUN void MaskFadeEnd(const float32_t *oldOutput, float32_t *newOutput)
+{
+  uint32_t samples = fftHop;
+  float32_t w;
+
+  oldOutput += 2 * (FFT_length - fftHop);       // The first FFT_length - fftHop are wrapped around
+  newOutput += 2 * (FFT_length - fftHop);
+  for (uint32_t i = 0; i < samples; i++) {
+    w = 0.5 - 0.5 * arm_cos_f32(PI * ((float32_t)i + 0.5) / (float32_t)samples);
+    newOutput[2 * i]     = oldOutput[2 * i] + w * (newOutput[2 * i] - oldOutput[2 * i]);
+    newOutput[2 * i + 1] = oldOutput[2 * i + 1] + w * (newOutput[2 * i + 1] - oldOutput[2 * i + 1]);
+  }
+}
+
+/*****
+  Purpose: Width of one mask bin
+
+  Parameter list:
+    void
+
+  Return value;
+    float32_t               Hz
+*****/
+float32_t MaskBinHz()
+{
+  return (float32_t)SR[SampleRate].rate / DF / (float32_t)FFT_length;
+}
+
+/*****
+  Purpose: Move a mask along the frequency axis
+
+  Parameter list:
+    float32_t *base         mask from MaskCacheLookup()
+    float32_t shiftHz       positive moves the passband up, from PassbandShiftHz()
+
+  Return value;
+    float32_t *             the shifted mask, in a buffer the DSP task is not using
+*****/
+float32_t *MaskShift(float32_t *base, float32_t shiftHz)
+{
+  float32_t bins = shiftHz / MaskBinHz();
+  int whole = (int)roundf(bins);
+  float32_t *out = shiftedMasks[0];
+  float32_t *inUse, *inUseNext;
+  float32_t phase, c, s, re;
+
+  DSPNoInterrupts();
+  inUse = filterMask;
+  inUseNext = pendingMask;
+  DSPInterrupts();
+  for (int i = 0; i < 3; i++) {
+    if (shiftedMasks[i] != inUse && shiftedMasks[i] != inUseNext) {
+      out = shiftedMasks[i];
+      break;
+    }
+  }
+
+  if (fabsf(bins - whole) < 0.01) {             // Whole bins, out[k] = base[k - whole]
+    whole = ((whole % (int)FFT_length) + FFT_length) % FFT_length;
+    memcpy(&out[2 * whole], base, (FFT_length - whole) * 2 * sizeof(float32_t));
+    memcpy(out, &base[2 * (FFT_length - whole)], whole * 2 * sizeof(float32_t));
+    return out;
+  }
+
+  memcpy(out, base, FFT_length * 2 * sizeof(float32_t));
+  arm_cfft_f32(maskS, out, 1, 1);               // Back to the taps
+  for (unsigned n = 0; n < FFT_length; n++) {   // Times exp(j 2 pi bins n / N) moves the spectrum up by bins
+    phase = TWO_PI * bins * (float32_t)n / (float32_t)FFT_length;
+    c = cosf(phase);
+    s = sinf(phase);
+    re = out[2 * n] * c - out[2 * n + 1] * s;
+    out[2 * n + 1] = out[2 * n] * s + out[2 * n + 1] * c;
+    out[2 * n] = re;
+  }
+  arm_cfft_f32(maskS, out, 0, 1);
+  return out;
+}
+
+/*****
+  Purpose: Convert a linear phase mask, in place, to the minimum phase mask with the same
+           magnitude response. Uses minPhaseWork, so it is only called from loop() code.
+
+  Parameter list:
+    float32_t *mask         FFT_length complex bins from InitFilterMask()
+
+  Return value;
+    void
+*****/
+void MaskMinimumPhase(float32_t *mask)
+{
+  uint32_t n = FFT_length * MIN_PHASE_OVERSAMPLE;
+  const arm_cfft_instance_f32 *fft;
+  float32_t *w = minPhaseWork;
+  float32_t peak = 0.0;
+  float32_t floorLevel, mag, e, phase, taper;
+  uint32_t taperStart;
+
+  if (n > MIN_PHASE_FFT_MAX) {
+    n = MIN_PHASE_FFT_MAX;
+  }
+  fft = (n == 4096) ? &arm_cfft_sR_f32_len4096 : ConvolutionFFT(n);
+
+  // Taps of the linear phase filter, receive EQ included, zero padded onto the fine grid
+  memcpy(w, mask, FFT_length * 2 * sizeof(float32_t));
+  arm_cfft_f32(maskS, w, 1, 1);
+  memset(&w[2 * m_NumTaps], 0, (n - m_NumTaps) * 2 * sizeof(float32_t));
+  arm_cfft_f32(fft, w, 0, 1);
+
+  // Log magnitude, floored so the stopband nulls do not go to -infinity
+  for (uint32_t k = 0; k < n; k++) {
+    mag = w[2 * k] * w[2 * k] + w[2 * k + 1] * w[2 * k + 1];
+    if (mag > peak) {
+      peak = mag;
+    }
+  }
+  floorLevel = peak * MIN_PHASE_FLOOR * MIN_PHASE_FLOOR;
+  for (uint32_t k = 0; k < n; k++) {
+    mag = w[2 * k] * w[2 * k] + w[2 * k + 1] * w[2 * k + 1];
+    w[2 * k] = 0.5 * logf(mag > floorLevel ? mag : floorLevel);    // log |H|
+    w[2 * k + 1] = 0.0;
+  }
+
+  // Cepstrum, folded so that only n >= 0 is left: twice the positive quefrencies, none of the negative
+  arm_cfft_f32(fft, w, 1, 1);
+  for (uint32_t k = 1; k < n / 2; k++) {
+    w[2 * k] *= 2.0;
+    w[2 * k + 1] *= 2.0;
+  }
+  memset(&w[n + 2], 0, (n - 2) * sizeof(float32_t));
+  arm_cfft_f32(fft, w, 0, 1);
+
+  // H = exp(log |H| + j phase)
+  for (uint32_t k = 0; k < n; k++) {
+    e = expf(w[2 * k]);
+    phase = w[2 * k + 1];
+    w[2 * k] = e * cosf(phase);
+    w[2 * k + 1] = e * sinf(phase);
+  }
+
+  // Back to taps, cut to the m_NumTaps overlap-save allows with a raised cosine over the last eighth
+  arm_cfft_f32(fft, w, 1, 1);
+  taperStart = m_NumTaps - m_NumTaps / 8;
+  for (uint32_t i = 0; i < m_NumTaps; i++) {
+    taper = 1.0;
+    if (i >= taperStart) {
+      taper = 0.5 + 0.5 * cosf(PI * (float32_t)(i - taperStart + 1) / (float32_t)(m_NumTaps - taperStart + 1));
+    }
+    mask[2 * i] = w[2 * i] * taper;
+    mask[2 * i + 1] = w[2 * i + 1] * taper;
+  }
+  for (uint32_t i = 2 * m_NumTaps; i < 2 * FFT_length; i++) {
+    mask[i] = 0.0;
+  }
+  arm_cfft_f32(maskS, mask, 0, 1);
+}
+
+/*****
+  Purpose: Delay through a mask, as the energy centroid of its taps. That is exactly half the tap
+           count less one for a linear phase mask, and much less for a minimum phase one.
+           Uses minPhaseWork, so it is only called from loop() code.
+
+  Parameter list:
+    const float32_t *mask   FFT_length complex bins
+
+  Return value;
+    float32_t               samples at the decimated rate
+*****/
+float32_t MaskDelaySamples(const float32_t *mask)
+{
+  float32_t *w = minPhaseWork;
+  float32_t energy = 0.0, moment = 0.0, p;
+
+  memcpy(w, mask, FFT_length * 2 * sizeof(float32_t));
+  arm_cfft_f32(maskS, w, 1, 1);
+  for (uint32_t i = 0; i < FFT_length; i++) {
+    p = w[2 * i] * w[2 * i] + w[2 * i + 1] * w[2 * i + 1];
+    energy += p;
+    moment += p * (float32_t)i;
+  }
+  if (energy == 0.0) {
+    return 0.0;
+  }
+  return moment / energy;
+}
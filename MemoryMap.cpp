@@ -0,0 +1,128 @@
+#ifndef BEENHERE
+#include "SDT.h"
+#endif
+
+/**********************************************************************************
+  Memory map report
+
+  The Teensy 4.1 has 512K of RAM1, split in 32K banks between ITCM for code and DTCM for data,
+  and 512K of RAM2 (OCRAM) that is reached through the 32K data cache. DTCM is single cycle and
+  holds all globals unless they are marked otherwise, with the stack growing down from its top.
+  The placement policy is:
+
+    DTCM              per-sample filter and NCO state, the receive working buffers, FFT buffers
+    OCRAM (DMAMEM)    buffers touched once a block or less, transmit and calibration buffers
+    flash (PROGMEM)   constant tables that are not read per sample
+
+  memoryMap[] in SDTVer042.ino lists the large arrays with the region each is meant to be in.
+  The DTCM ones are totalled at compile time against DTCM_DSP_BUDGET. At boot MemoryMapCheck()
+  compares the DTCM left for the stack with DTCM_HEADROOM_MIN, and 'm' in the Serial Monitor
+  prints where everything actually landed.
+**********************************************************************************/
+
+extern unsigned long _stext;                      // Teensy 4 linker symbols
+extern unsigned long _etext;
+extern unsigned long _sdata;
+extern unsigned long _ebss;
+extern unsigned long _estack;
+extern unsigned long _heap_start;
+extern unsigned long _heap_end;
+extern unsigned long _itcm_block_count;           // Its address is the count
+
+#define MEM_ADDRESS(p)              ((uint32_t)(uintptr_t)(p))    // 32 bits on the Teensy
+
+const char *memoryRegionNames[] = { "ITCM", "DTCM", "OCRAM", "flash", "EXTMEM" };
+
+/*****
+  Purpose: Which memory region an address is in
+
+  Parameter list:
+    const void *address
+
+  Return value;
+    int                     MEM_ region
+*****/
+int MemoryRegion(const void *address)
+{
+  uint32_t a = MEM_ADDRESS(address);
+
+  if (a < 0x00080000) {
+    return MEM_ITCM;
+  }
+  if (a >= 0x20000000 && a < 0x20080000) {
+    return MEM_DTCM;
+  }
+  if (a >= 0x20200000 && a < 0x20280000) {
+    return MEM_OCRAM;
+  }
+  if (a >= 0x60000000 && a < 0x70000000) {
+    return MEM_FLASH;
+  }
+  return MEM_EXTMEM;
+}
+
+/*****
+  Purpose: Print every memoryMap[] array with its size and region, the totals per region and how
+           RAM1 and RAM2 are used, to USB serial
+
+  Parameter list:
+    void
+
+  Return value;
+    void
+*****/
+void MemoryMapReport()
+{
+  uint32_t total[MEM_REGION_COUNT];
+  uint32_t itcmSize = MEM_ADDRESS(&_itcm_block_count) * 32768;
+  int region;
+
+  memset(total, 0, sizeof(total));
+  Serial.println("\nArray                             bytes  region  address");
+  for (int i = 0; i < memoryMapCount; i++) {
+    region = MemoryRegion(memoryMap[i].address);
+    total[region] += memoryMap[i].size;
+    Serial.printf("%-30s %8lu  %-6s  0x%08lX", memoryMap[i].name, memoryMap[i].size, memoryRegionNames[region], MEM_ADDRESS(memoryMap[i].address));
+    if (region != memoryMap[i].region) {
+      Serial.printf("  should be %s", memoryRegionNames[memoryMap[i].region]);
+    }
+    Serial.println();
+  }
+  for (int i = 0; i < MEM_REGION_COUNT; i++) {
+    if (total[i]) {
+      Serial.printf("Listed arrays in %-6s %8lu\n", memoryRegionNames[i], total[i]);
+    }
+  }
+  Serial.printf("RAM1: %lu of %lu bytes ITCM used by code, %lu bytes DTCM data, %lu left for the stack\n",
+                MEM_ADDRESS(&_etext) - MEM_ADDRESS(&_stext), itcmSize,
+                MEM_ADDRESS(&_ebss) - MEM_ADDRESS(&_sdata), MEM_ADDRESS(&_estack) - MEM_ADDRESS(&_ebss));
+  Serial.printf("RAM2: %lu bytes DMAMEM, %lu left for the heap\n",
+                MEM_ADDRESS(&_heap_start) - 0x20200000, MEM_ADDRESS(&_heap_end) - MEM_ADDRESS(&_heap_start));
+}
+
+/*****
+  Purpose: Check that enough DTCM is left for the stack and that every memoryMap[] array is in
+           the region it is meant to be in. Problems are reported on USB serial.
+
+  Parameter list:
+    void
+
+  Return value;
+    int                     1 if all is well, 0 otherwise
+*****/
+int MemoryMapCheck()
+{
+  uint32_t headroom = MEM_ADDRESS(&_estack) - MEM_ADDRESS(&_ebss);
+  int misplaced = 0;
+
+  for (int i = 0; i < memoryMapCount; i++) {
+    if (MemoryRegion(memoryMap[i].address) != memoryMap[i].region) {
+      misplaced++;
+    }
+  }
+  if (headroom < DTCM_HEADROOM_MIN || misplaced) {
+    Serial.printf("Memory map: %lu bytes of DTCM left for the stack (minimum %d), %d arrays misplaced\n", headroom, DTCM_HEADROOM_MIN, misplaced);
+    return 0;
+  }
+  return 1;
+}
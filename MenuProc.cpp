@@ -258,7 +258,8 @@ void SetSidetoneVolume()
   ShowSpectrumdBScale();
 }
 /*****
-  Purpose: Show the list of scales for the spectrum divisions
+  Purpose: Show the list of scales for the spectrum divisions, and the panadapter window,
+           averaging, hold traces and resolution
 
   Parameter list:
     void
@@ -268,13 +269,76 @@ void SetSidetoneVolume()
 *****/
 int SpectrumOptions()
 {
-  const char *spectrumChoices[] = {"20 dB/unit", "10 dB/unit", "5 dB/unit", "2 dB/unit", "1 dB/unit", "Cancel"};
+  const char *spectrumChoices[] = {"20 dB/unit", "10 dB/unit", "5 dB/unit", "2 dB/unit", "1 dB/unit", "Window", "Averaging", "Hold", "Resolution",
+                                   "Frame rate", "Waterfall rate", "Cancel"};
+  const char *windowChoices[] = {windowNames[WINDOW_HANN], windowNames[WINDOW_BLACKMAN_HARRIS],
+                                 windowNames[WINDOW_NUTTALL], windowNames[WINDOW_FLAT_TOP], "Cancel"};
+  const char *averageChoices[] = {"Off", "1 frame", "2 frames", "4 frames", "8 frames", "16 frames", "Cancel"};
+  const int averageDepths[] = {0, 1, 2, 4, 8, 16};
+  const char *holdChoices[] = {"Off", "Peak", "Minimum", "Peak and min", "Clear", "Cancel"};
+  const char *resolutionChoices[] = {"512 bins", "2048 max", "2048 mean", "4096 max", "4096 mean", "Cancel"};
+  const uint32_t resolutionLengths[] = {SPECTRUM_RES, HIRES_FFT_2048, HIRES_FFT_2048, HIRES_FFT_4096, HIRES_FFT_4096};
+  const int resolutionBinning[] = {BINNING_MAX, BINNING_MAX, BINNING_MEAN, BINNING_MAX, BINNING_MEAN};
+  const char *frameRateChoices[] = {"Max", "30 fps", "20 fps", "10 fps", "5 fps", "Cancel"};
+  const int frameRates[] = {0, 30, 20, 10, 5};
+  const char *waterfallRateChoices[] = {"Every frame", "20 lines/s", "10 lines/s", "5 lines/s", "2 lines/s", "Cancel"};
+  const int waterfallRates[] = {0, 20, 10, 5, 2};
   int spectrumSet = 1;
+  int windowSet;
+  int averageSet;
+  int holdSet;
+  int resolutionSet;
+  int rateSet;
 
-  spectrumSet = SubmenuSelect(spectrumChoices, 6, spectrumSet);
+  spectrumSet = SubmenuSelect(spectrumChoices, 12, spectrumSet);
   if (strcmp(spectrumChoices[spectrumSet], "Cancel") == 0) {
     return currentScale;                                        // Nope.
   }
+  if (strcmp(spectrumChoices[spectrumSet], "Window") == 0) {    // See Window.cpp
+    windowSet = SubmenuSelect(windowChoices, WINDOW_TYPES + 1, spectrumWindowType);
+    if (windowSet >= 0 && windowSet < WINDOW_TYPES) {
+      SetSpectrumWindow(windowSet);
+    }
+    return currentScale;
+  }
+  if (strcmp(spectrumChoices[spectrumSet], "Averaging") == 0) { // Welch average of the whole block, see Welch.cpp
+    averageSet = SubmenuSelect(averageChoices, 7, 0);
+    if (averageSet >= 0 && averageSet < 6) {
+      spectrumAverageDepth = averageDepths[averageSet];
+    }
+    return currentScale;
+  }
+  if (strcmp(spectrumChoices[spectrumSet], "Hold") == 0) {
+    holdSet = SubmenuSelect(holdChoices, 6, spectrumHoldMode);
+    if (holdSet >= 0 && holdSet < 4) {                          // Off, peak, minimum or both are the bits
+      spectrumHoldMode = holdSet;
+    } else if (holdSet == 4) {
+      spectrumHoldReset = 1;
+    }
+    return currentScale;
+  }
+  if (strcmp(spectrumChoices[spectrumSet], "Resolution") == 0) { // Long FFT at zoom 1, see HighResSpectrum.cpp
+    resolutionSet = SubmenuSelect(resolutionChoices, 6, 0);
+    if (resolutionSet >= 0 && resolutionSet < 5) {
+      spectrumBinning = resolutionBinning[resolutionSet];
+      SetSpectrumResolution(resolutionLengths[resolutionSet]);
+    }
+    return currentScale;
+  }
+  if (strcmp(spectrumChoices[spectrumSet], "Frame rate") == 0) { // Panadapter frames a second, see FramePacer.cpp
+    rateSet = SubmenuSelect(frameRateChoices, 6, 0);
+    if (rateSet >= 0 && rateSet < 5) {
+      SetFrameRates(frameRates[rateSet], waterfallTargetFPS);
+    }
+    return currentScale;
+  }
+  if (strcmp(spectrumChoices[spectrumSet], "Waterfall rate") == 0) {
+    rateSet = SubmenuSelect(waterfallRateChoices, 6, 0);
+    if (rateSet >= 0 && rateSet < 5) {
+      SetFrameRates(spectrumTargetFPS, waterfallRates[rateSet]);
+    }
+    return currentScale;
+  }
   currentScale = spectrumSet;                                   // Yep...
   EEPROMData.currentScale = currentScale;
   EEPROM.put(0, EEPROMData);
@@ -364,6 +428,7 @@ void ProcessEqualizerChoices( int EQType, char *title)
   tft.writeTo(L2);
   tft.clearMemory();
   tft.writeTo(L1);
+  DisplayInvalidate();
   tft.fillWindow(RA8875_BLACK);
 
   tft.fillRect(xOrigin - 50, yOrigin - 25, wide + 50, high + 50, RA8875_BLACK); // Clear data area
@@ -483,10 +548,11 @@ void ProcessEqualizerChoices( int EQType, char *title)
 *****/
 int EqualizerRecOptions()
 {
-  const char *RecEQChoices[]   = {"On", "Off", "EQSet", "Cancel"};   // Add code practice oscillator
+  const char *RecEQChoices[]   = {"On", "Off", "In Mask", "EQSet", "Cancel"};   // Add code practice oscillator
   int EQChoice = 0;
+  int oldEQFlag = receiveEQFlag;
 
-  EQChoice = SubmenuSelect(RecEQChoices, 4, 0);
+  EQChoice = SubmenuSelect(RecEQChoices, 5, 0);
 
   switch (EQChoice) {
     case 0:
@@ -496,15 +562,21 @@ int EqualizerRecOptions()
       receiveEQFlag = OFF;
       break;
     case 2:
+      receiveEQFlag = EQ_MASK;                    // Equalizer built into the filter mask
+      break;
+    case 3:
       for (int iFreq = 0; iFreq < EQUALIZER_CELL_COUNT; iFreq++) {
       }
       ProcessEqualizerChoices( 0, (char *)"Receive Equalizer");
       //EEPROMWrite();
       RedrawDisplayScreen();
       break;
-    case 3:
+    case 4:
       break;
   }
+  if (receiveEQFlag == EQ_MASK || oldEQFlag == EQ_MASK) {    // Rebuild the mask with or without the equalizer
+    FilterBandwidth();
+  }
   return 0;
 
 }
@@ -650,11 +722,19 @@ int MicOptions() // AFP 09-22-22 All new
 *****/
 int RFOptions()
 {
-  const char *rfOptions[] = {"Power level", "Gain", "Cancel"};
+  const char *rfOptions[] = {"Power level", "Gain", "FFT filter", "Low latency", "Filter phase", "Cancel"};
+  const char *latencyOptions[] = {"Off", "CW receive", "Always", "Cancel"};
+  const char *phaseOptions[] = {"Linear", "Minimum", "Cancel"};
+  const char *fftOptions[] = {"256 hop 128", "512 hop 256", "512 hop 128", "1024 hop 256", "2048 hop 256", "Cancel"};
+  const uint32_t fftLengths[] = {256, 512, 512, 1024, 2048};
+  const uint32_t fftHops[]    = {128, 256, 128, 256, 256};
   int rfSet = 0;
+  int fftSet;
+  int latencySet;
+  int phaseSet;
   int returnValue = 0;
 
-  rfSet = SubmenuSelect(rfOptions, 3, rfSet);
+  rfSet = SubmenuSelect(rfOptions, 6, rfSet);
 
   switch (rfSet) {
     case 0:                                 // AFP 10-21-22
@@ -682,6 +762,34 @@ int RFOptions()
       EEPROM.put(0, EEPROMData);
       returnValue = rfGainAllBands;
       break;
+
+    case 2:                                 // FFT length and hop of the receive filter, see SetConvolution()
+      fftSet = SubmenuSelect(fftOptions, 6, 1);
+      if (fftSet >= 0 && fftSet < 5) {
+        if (lowLatencyActive) {             // Used when the low-latency path switches off
+          normalFFTLength = fftLengths[fftSet];
+          normalFFTHop = fftHops[fftSet];
+        } else {
+          SetConvolution(fftLengths[fftSet], fftHops[fftSet]);
+          FilterBandwidth();                // Applies the passband shift to the new masks
+        }
+      }
+      break;
+
+    case 3:                                 // Low-latency receive path for this band, see Latency.cpp
+      latencySet = SubmenuSelect(latencyOptions, 4, lowLatencyMode[currentBand]);
+      if (latencySet >= 0 && latencySet < 3) {
+        lowLatencyMode[currentBand] = latencySet;   // LowLatencyUpdate() switches the chain from loop()
+      }
+      break;
+
+    case 4:                                 // Linear or minimum phase filter mask for this mode, or for CW
+      phaseSet = SubmenuSelect(phaseOptions, 3, maskPhase[MaskPhaseIndex()]);
+      if (phaseSet == MASK_PHASE_LINEAR || phaseSet == MASK_PHASE_MINIMUM) {
+        maskPhase[MaskPhaseIndex()] = phaseSet;
+        FilterBandwidth();                  // Picks up, or builds, the mask with the new phase
+      }
+      break;
   }
   return returnValue;
 }
@@ -804,6 +912,8 @@ int VFOSelect()
 
   tft.fillRect(FREQUENCY_X_SPLIT, FREQUENCY_Y - 12, VFOB_PIXEL_LENGTH, FREQUENCY_PIXEL_HI, RA8875_BLACK); // delete old digit
   tft.fillRect(FREQUENCY_X,       FREQUENCY_Y - 12, VFOA_PIXEL_LENGTH, FREQUENCY_PIXEL_HI, RA8875_BLACK); // delete old digit  tft.setFontScale( (enum RA8875tsize) 0);
+  WidgetForget(WIDGET_FREQ_MAIN);
+  WidgetForget(WIDGET_FREQ_OTHER);
   ShowFrequency();
   DrawFrequencyBarValue();
   return activeVFO;
@@ -2,6 +2,8 @@
 #include "SDT.h"
 #endif
 
+DMAMEM float32_t nrHannWindow[NR_FFT_L];               // Kim1_NR()'s window, built by SpectralNoiseReductionInit()
+
 /*****
   Purpose: Present the noise reduction options
 
@@ -123,8 +125,7 @@ void Kim1_NR()
       }
       // perform windowing on 256 real samples in the NR_FFT_buffer
       for (int idx = 0; idx < NR_FFT_L; idx++)  {                               // Hann window
-        float32_t temp_sample = 0.5 * (float32_t)(1.0 - (cosf(PI * 2.0 * (float32_t)idx / (float32_t)((NR_FFT_L) - 1))));
-        NR_FFT_buffer[idx * 2] *= temp_sample;
+        NR_FFT_buffer[idx * 2] *= nrHannWindow[idx];
       }
 
 
@@ -433,7 +434,7 @@ void SpectralNoiseReduction()
 
     if (NR_first_time_2 == 3) {
       for (int bindx = 0; bindx < NR_FFT_L / 2; bindx++) { // 1. Step of NR - calculate the SNR's
-        ph1y[bindx] = 1.0 / (1.0 + pfac * expf(xih1r * NR_X[bindx][0] / xt[bindx]));
+        ph1y[bindx] = 1.0 / (1.0 + pfac * FastExp(xih1r * NR_X[bindx][0] / xt[bindx]));
         pslp[bindx] = ap * pslp[bindx] + (1.0 - ap) * ph1y[bindx];
 
         if (pslp[bindx] > psthr) {
@@ -636,7 +637,7 @@ void InitLMSNoiseReduction()
 
 }
 /*****
-  Purpose:
+  Purpose: Start the spectral noise reduction state again and build Kim1_NR()'s window
   Parameter list:
     void
   Return value;
@@ -644,6 +645,9 @@ void InitLMSNoiseReduction()
 *****/
 void SpectralNoiseReductionInit()
 {
+  for (int idx = 0; idx < NR_FFT_L; idx++) {                                  // Hann window, once rather than per frame
+    nrHannWindow[idx] = 0.5 * (float32_t)(1.0 - (cosf(PI * 2.0 * (float32_t)idx / (float32_t)((NR_FFT_L) - 1))));
+  }
   for (int bindx = 0; bindx < NR_FFT_L / 2; bindx++)
   {
     NR_last_sample_buffer_L[bindx] = 0.1;
@@ -34,77 +34,61 @@ void ProcessIQData()
   float32_t audioMaxSquared;
   uint32_t AudioMaxIndex;
   float rfGainValue;
+  float32_t gainI, gainQ;
+  int iqCorrect;
+  uint32_t fadeMark;
+  float32_t *fadeBuffer;
+  uint32_t hist = FFT_length - fftHop;          // Samples of overlap in each FFT
+  uint32_t subBlocks = BUF_N_DF / fftHop;       // FFTs per block
+  float32_t spectrumScale;
+  float32_t *spectrumDb;
 
   // are there at least N_BLOCKS buffers in each channel available ?
   if ( (uint32_t) Q_in_L.available() > N_BLOCKS + 0 && (uint32_t) Q_in_R.available() > N_BLOCKS + 0 ) {
     usec = 0;
+    ProfileBlockStart();
+    updateDisplayFlag = SpectrumFrameDue(BUFFER_SIZE * N_BLOCKS);   // Only compute display data when a frame is due, see FramePacer.cpp
+
+    /**********************************************************************************  AFP 12-31-20
+        The RF gain for all bands, the RFgain value defined in bands[currentBand] and the manual
+        IQ amplitude correction are collapsed into one gain per channel, which IngestIQBlock()
+        applies while converting to float and removing the DC offset with the HP_DC_Filter_Coeffs2
+        biquad. Float_buffer samples are standardized from > -1.0 to < 1.0 before the gains.
+    **********************************************************************************/
+    rfGainValue = pow(10, (float)rfGainAllBands / 20);  //AFP 09-27-22
+    gainQ = rfGainValue * bands[currentBand].RFgain;    //AFP 09-23-22
+    gainI = gainQ;
+    // Manual IQ amplitude correction
+    // to be honest: we only correct the amplitude of the I channel ;-)
+    iqCorrect = (bands[currentBandA].mode == DEMOD_LSB || bands[currentBandA].mode == DEMOD_USB || bands[currentBand].mode == DEMOD_AM || bands[currentBand].mode == DEMOD_SAM);
+    if (iqCorrect) {
+      gainI *= -IQAmpCorrectionFactor[currentBandA];    //AFP 04-14-22
+    }
+
     // get audio samples from the audio  buffers and convert them to float
-    // read in 32 blocks á 128 samples in I and Q
+    // read in 16 blocks á 128 samples in I and Q
     for (unsigned i = 0; i < N_BLOCKS; i++) {
       sp_L1 = Q_in_R.readBuffer();
       sp_R1 = Q_in_L.readBuffer();
-
-
-      /**********************************************************************************  AFP 12-31-20
-          Using arm_Math library, convert to float one buffer_size.
-          Float_buffer samples are now standardized from > -1.0 to < 1.0
-      **********************************************************************************/
-      arm_q15_to_float (sp_L1, &float_buffer_L[BUFFER_SIZE * i], BUFFER_SIZE); // convert int_buffer to float 32bit
-      arm_q15_to_float (sp_R1, &float_buffer_R[BUFFER_SIZE * i], BUFFER_SIZE); // convert int_buffer to float 32bit
+#ifndef IQ_REPLAY
+      IngestIQBlock(sp_L1, sp_R1, 1, &float_buffer_L[BUFFER_SIZE * i], &float_buffer_R[BUFFER_SIZE * i], BUFFER_SIZE, gainI, gainQ);
+#endif
       Q_in_L.freeBuffer();
       Q_in_R.freeBuffer();
     }
-    if (keyPressedOn == 1) { ////AFP 09-01-22
+#ifdef IQ_REPLAY
+    int16_t *replay = IQReplayRead(BUFFER_SIZE * N_BLOCKS);    // Live blocks only pace the chain; samples come from loop() through the replay ring
+    if (replay == NULL) {                                      // No file, or loop() fell behind: skip the block, see IQReplay.cpp
+      ProfileBlockAbandon();
       return;
     }
-    // Set frequency here only to minimize interruption to signal stream during tuning
-    if (centerTuneFlag == 1) { //AFP 10-04-22
-      DrawBandWidthIndicatorBar();
-      ShowFrequency();
-      SetFreq();            //AFP 10-04-22
-     // BandInformation();
-    }                       //AFP 10-04-22
-    centerTuneFlag = 0;     //AFP 10-04-22
-
-
-    /*******************************
-            Set RFGain - for all bands
-    */
-    rfGainValue = pow(10, (float)rfGainAllBands / 20);
-    arm_scale_f32 (float_buffer_L, rfGainValue, float_buffer_L, BUFFER_SIZE * N_BLOCKS); //AFP 09-27-22
-    arm_scale_f32 (float_buffer_R, rfGainValue, float_buffer_R, BUFFER_SIZE * N_BLOCKS); //AFP 09-27-22
-    /**********************************************************************************  AFP 12-31-20
-        Remove DC offset to reduce centeral spike.  First read the Mean value of
-        left and right channels.  Then fill L and R correction arrays with those Means
-        and subtract the Means from the float L and R buffer data arrays.  Again use Arm_Math functions
-        to manipulate the arrays.  Arrays are all BUFFER_SIZE * N_BLOCKS long
-    **********************************************************************************/
-    //
-    //================
-
-    /*arm_mean_f32(float_buffer_L, BUFFER_SIZE * N_BLOCKS, &sample_meanL);
-    arm_mean_f32(float_buffer_R, BUFFER_SIZE * N_BLOCKS, &sample_meanR);
-
-    for (uint32_t j = 0; j < BUFFER_SIZE * N_BLOCKS  ; j++) {
-      L_BufferOffset [j] = -sample_meanL;
-      R_BufferOffset [j] = -sample_meanR;
+    IngestIQBlock(replay, replay + 1, 2, float_buffer_L, float_buffer_R, BUFFER_SIZE * N_BLOCKS, gainI, gainQ);
+#endif
+    ProfileStage(PROF_INGEST);
+    if (keyPressedOn == 1) { ////AFP 09-01-22
+      ProfileBlockAbandon();
+      return;
     }
-    arm_add_f32(float_buffer_L , L_BufferOffset, float_buffer_L2 , BUFFER_SIZE * N_BLOCKS ) ;
-    arm_add_f32(float_buffer_R , R_BufferOffset, float_buffer_R2 , BUFFER_SIZE * N_BLOCKS ) ;
-
-    arm_biquad_cascade_df2T_f32(&s1_Receive, float_buffer_L, float_buffer_L, 2048); //AFP 09-23-22
-    arm_biquad_cascade_df2T_f32(&s1_Receive, float_buffer_R, float_buffer_R, 2048); //AFP 09-23-22*/
-        arm_biquad_cascade_df2T_f32(&s1_Receive2, float_buffer_L, float_buffer_L, 2048); //AFP 11-03-22
-    arm_biquad_cascade_df2T_f32(&s1_Receive2, float_buffer_R, float_buffer_R, 2048); //AFP 11-03-22
-    
-
-    //===========================
-
-    /**********************************************************************************  AFP 12-31-20
-        Scale the data buffers by the RFgain value defined in bands[currentBand] structure
-    **********************************************************************************/
-    arm_scale_f32 (float_buffer_L, bands[currentBand].RFgain, float_buffer_L, BUFFER_SIZE * N_BLOCKS); //AFP 09-23-22
-    arm_scale_f32 (float_buffer_R, bands[currentBand].RFgain, float_buffer_R, BUFFER_SIZE * N_BLOCKS); //AFP 09-23-22
 
     /**********************************************************************************  AFP 12-31-20
       Clear Buffers
@@ -115,12 +99,12 @@ void ProcessIQData()
       **********************************************************************************/
     if (Q_in_L.available() > 25) {
       Q_in_L.clear();
-      n_clear++; // just for debugging to check how often this occurs
+      audioQueueOverflows++;                    // Audio was dropped; shown in the profiler report
       AudioInterrupts();
     }
     if (Q_in_R.available() > 25) {
       Q_in_R.clear();
-      n_clear++; // just for debugging to check how often this occurs
+      audioQueueOverflows++;
       AudioInterrupts();
     }
     /**********************************************************************************  AFP 12-31-20
@@ -131,19 +115,12 @@ void ProcessIQData()
       IQ amplitude and phase correction
     ***********************************************************************************************/
 
-    // Manual IQ amplitude correction
-    // to be honest: we only correct the amplitude of the I channel ;-)
-    if (bands[currentBandA].mode == DEMOD_LSB || bands[currentBand].mode == DEMOD_AM || bands[currentBand].mode == DEMOD_SAM) {
-      arm_scale_f32 (float_buffer_L, -IQAmpCorrectionFactor[currentBandA], float_buffer_L, BUFFER_SIZE * N_BLOCKS); //AFP 04-14-22
+    // The amplitude correction was applied by IngestIQBlock()
+    // IQ phase correction
+    if (iqCorrect) {
       IQPhaseCorrection(float_buffer_L, float_buffer_R, IQPhaseCorrectionFactor[currentBandA], BUFFER_SIZE * N_BLOCKS);
-    } else {
-      if (bands[currentBandA].mode == DEMOD_USB || bands[currentBand].mode == DEMOD_AM || bands[currentBand].mode == DEMOD_SAM) {
-        arm_scale_f32 (float_buffer_L, -IQAmpCorrectionFactor[currentBandA], float_buffer_L, BUFFER_SIZE * N_BLOCKS); //AFP 04-14-22
-        IQPhaseCorrection(float_buffer_L, float_buffer_R, IQPhaseCorrectionFactor[currentBandA], BUFFER_SIZE * N_BLOCKS);
-      }
     }
-    // IQ phase correction
-
+    ProfileStage(PROF_IQ_CORRECTION);
 
     /**********************************************************************************  AFP 12-31-20
         Perform a 256 point FFT for the spectrum display on the basis of the first 256 complex values
@@ -156,9 +133,11 @@ void ProcessIQData()
     if (spectrum_zoom == SPECTRUM_ZOOM_1) { // && display_S_meter_or_spectrum_state == 1)
       zoom_display = 1;
       CalcZoom1Magn();  //AFP Moved to display function
+      ProfileStage(PROF_ZOOM_FFT);
     }
     display_S_meter_or_spectrum_state++;
     if ( keyPressedOn == 1) { ////AFP 09-01-22
+      ProfileBlockAbandon();
       return;
     }
 
@@ -175,6 +154,7 @@ void ProcessIQData()
            xnew(1) =  - ximag(1) + jxreal(1)
     **********************************************************************************/
     FreqShift1();
+    ProfileStage(PROF_FREQ_SHIFT1);
 
     /**********************************************************************************  AFP 12-31-20
         SPECTRUM_ZOOM_2 and larger here after frequency conversion!
@@ -188,6 +168,7 @@ void ProcessIQData()
       //AFP  Used to process Zoom>1 for display
       ZoomFFTExe(BUFFER_SIZE * N_BLOCKS); // there seems to be a BUG here, because the blocksize has to be adjusted according to magnification,
       // does not work for magnifications > 8
+      ProfileStage(PROF_ZOOM_FFT);
     }
 
     if (zoom_display) {
@@ -200,10 +181,7 @@ void ProcessIQData()
         S-Meter & dBm-display ?? not usually called
      **********************************************************************************/
     //============================== AFP 10-22-22  Begin new
-    if (calibrateFlag == 1) {
-      CalibrateOptions(IQChoice);
-    }
-
+    //  CalibrateOptions() is now polled from ShowSpectrum(), it reads encoders and draws on the display
     //============================== AFP 10-21-22  End new
 
 
@@ -223,24 +201,20 @@ void ProcessIQData()
      *************************************************************************************************/
 
     FreqShift2();  //AFP 12-14-21
+    ProfileStage(PROF_FREQ_SHIFT2);
     /**********************************************************************************  AFP 12-31-20
         Decimation
-        Resample (Decimate) the shifted time signal, first by 4, then by 2.  Each time the
-        signal is decimated by an even number, the spectrum is reversed.  Resampling twice
-        returns the spectrum to the correct orientation.
+        Resample (Decimate) the shifted time signal by 8, I and Q together, in three half-band
+        stages (see Decimate.cpp).
         Signal has now been shifted to base band, leaving aliases at higher frequencies,
-        which are removed at each decimation step using the Arm combined decimate/filter function.
+        which are removed at each decimation step.
         If the statring sample rate is 192K SPS after the combined decimation, the sample rate is
         now 192K/8 = 24K SPS.  The array size is also reduced by 8, making FFT calculations much faster.
         The effective bandwidth (up to Nyquist frequency) is 12KHz.
      **********************************************************************************/
-    // decimation-by-4 in-place!
-    arm_fir_decimate_f32(&FIR_dec1_I, float_buffer_L, float_buffer_L, BUFFER_SIZE * N_BLOCKS);
-    arm_fir_decimate_f32(&FIR_dec1_Q, float_buffer_R, float_buffer_R, BUFFER_SIZE * N_BLOCKS);
-
-    // decimation-by-2 in-place
-    arm_fir_decimate_f32(&FIR_dec2_I, float_buffer_L, float_buffer_L, BUFFER_SIZE * N_BLOCKS / (uint32_t)DF1);
-    arm_fir_decimate_f32(&FIR_dec2_Q, float_buffer_R, float_buffer_R, BUFFER_SIZE * N_BLOCKS / (uint32_t)DF1);
+    // decimation-by-8 in-place
+    Decimate(&rxDecimator, float_buffer_L, float_buffer_R, BUFFER_SIZE * N_BLOCKS);
+    ProfileStage(PROF_DECIMATE);
 
 
     // =================  AFP 10-21-22 Level Adjust ===========
@@ -252,8 +226,8 @@ void ProcessIQData()
       freqKHzFcut = (float32_t)bands[currentBandA].FHiCut * 0.001;
     }
     volScaleFactor = 7.0874 * pow(freqKHzFcut, -1.232);
-    arm_scale_f32(float_buffer_L, volScaleFactor, float_buffer_L, FFT_length / 2);
-    arm_scale_f32(float_buffer_R, volScaleFactor, float_buffer_R, FFT_length / 2);
+    arm_scale_f32(float_buffer_L, volScaleFactor, float_buffer_L, BUF_N_DF);
+    arm_scale_f32(float_buffer_R, volScaleFactor, float_buffer_R, BUF_N_DF);
 
     //=================  AFP 10-21-22  =================
     /**********************************************************************************  AFP 12-31-20
@@ -263,100 +237,135 @@ void ProcessIQData()
          "Fast FIR Filtering using the FFT", pages 688 - 694.
          Method used here: overlap-and-save.
 
+        Each FFT holds the last FFT_length - fftHop samples (the history, in last_sample_buffer_L/R)
+        followed by fftHop new ones. The filter has FFT_length - fftHop + 1 taps, so the first
+        FFT_length - fftHop outputs are wrapped around and the last fftHop are kept. With the
+        default 512 point FFT and a hop of 256 that is the usual half-and-half overlap-save and one
+        FFT per block; a shorter hop or a longer FFT takes BUF_N_DF / fftHop FFTs to make the block.
+        Everything is done in place in FFT_buffer and the kept samples go to convOutput.
+
         First, Create Complex time signal for CFFT routine.
-        Fill first block with Zeros
+        Fill the history with Zeros for the very first FFT
         Then interleave RE and IM parts to create signal for FFT
      **********************************************************************************/
-    // Prepare the audio signal buffers:
-
-    //------------------------------ ONLY FOR the VERY FIRST FFT: fill first samples with zeros
+    //------------------------------ ONLY FOR the VERY FIRST FFT: the history is zeros
 
-    if (first_block) { // fill real & imaginaries with zeros for the first BLOCKSIZE samples
-      for (unsigned i = 0; i < BUFFER_SIZE * N_BLOCKS / (uint32_t)(DF / 2.0); i++) {
-        FFT_buffer[i] = 0.0;
+    if (first_block) {
+      for (unsigned i = 0; i < hist; i++) {
+        last_sample_buffer_L[i] = 0.0;
+        last_sample_buffer_R[i] = 0.0;
       }
       first_block = 0;
-    } else  // All other FFTs
+    }
 
-      //------------------------------ fill FFT_buffer with last events audio samples for all other FFT instances
-      for (unsigned i = 0; i < BUFFER_SIZE * N_BLOCKS / (uint32_t)(DF); i++) {
+    for (unsigned sub = 0; sub < subBlocks; sub++) {
+      //------------------------------ fill FFT_buffer with the history, then the recent audio samples (left channel: re, right channel: im)
+      for (unsigned i = 0; i < hist; i++) {
         FFT_buffer[i * 2] = last_sample_buffer_L[i]; // real
         FFT_buffer[i * 2 + 1] = last_sample_buffer_R[i]; // imaginary
       }
+      for (unsigned i = 0; i < fftHop; i++) {
+        FFT_buffer[(hist + i) * 2] = float_buffer_L[sub * fftHop + i]; // real
+        FFT_buffer[(hist + i) * 2 + 1] = float_buffer_R[sub * fftHop + i]; // imaginary
+      }
+      for (unsigned i = 0; i < hist; i++) {   // the last hist samples are the history for next time!
+        last_sample_buffer_L[i] = FFT_buffer[(fftHop + i) * 2];
+        last_sample_buffer_R[i] = FFT_buffer[(fftHop + i) * 2 + 1];
+      }
 
-    for (unsigned i = 0; i < BUFFER_SIZE * N_BLOCKS / (uint32_t)(DF); i++) {   // copy recent samples to last_sample_buffer for next time!
-      last_sample_buffer_L [i] = float_buffer_L[i];
-      last_sample_buffer_R [i] = float_buffer_R[i];
-    }
-
-    //------------------------------ now fill recent audio samples into FFT_buffer (left channel: re, right channel: im)
-    for (unsigned i = 0; i < BUFFER_SIZE * N_BLOCKS / (uint32_t)(DF); i++) {
-      FFT_buffer[FFT_length + i * 2] = float_buffer_L[i]; // real
-      FFT_buffer[FFT_length + i * 2 + 1] = float_buffer_R[i]; // imaginary
-    }
-
-    /**********************************************************************************  AFP 12-31-20
-       Perform complex FFT on the audio time signals
-       calculation is performed in-place the FFT_buffer [re, im, re, im, re, im . . .]
-     **********************************************************************************/
-    arm_cfft_f32(S, FFT_buffer, 0, 1);
-
-    /**********************************************************************************  AFP 12-31-20
-      Continuing FFT Convolution
-          Next, prepare the filter mask (done in the Filter.cpp file).  Only need to do this once for each filter setting.
-          Allows efficient real-time variable LP and HP audio filters, without the overhead of time-domain convolution filtering.
+      /**********************************************************************************  AFP 12-31-20
+         Perform complex FFT on the audio time signals
+         calculation is performed in-place the FFT_buffer [re, im, re, im, re, im . . .]
+       **********************************************************************************/
+      arm_cfft_f32(S, FFT_buffer, 0, 1);
+      ProfileStage(PROF_FORWARD_FFT);
 
-          After the Filter mask in the frequency domain is created, complex multiply  filter mask with the frequency domain audio data.
-          Filter mask previously calculated in setup Array of filter mask coefficients:
-          FIR_filter_mask[]
-     **********************************************************************************/
+      /**********************************************************************************  AFP 12-31-20
+        Continuing FFT Convolution
+            Next, prepare the filter mask (done in the Filter.cpp file).  Only need to do this once for each filter setting.
+            Allows efficient real-time variable LP and HP audio filters, without the overhead of time-domain convolution filtering.
+
+            After the Filter mask in the frequency domain is created, complex multiply  filter mask with the frequency domain audio data.
+            Filter mask previously calculated in setup Array of filter mask coefficients:
+            filterMask, see MaskCache.cpp. When the bandwidth has just changed this block is also
+            run through the old mask and the output is cross-faded from one to the other.
+       **********************************************************************************/
 
-    arm_cmplx_mult_cmplx_f32 (FFT_buffer, FIR_filter_mask, iFFT_buffer, FFT_length);
-    if (updateDisplayFlag == 1) {
-      for (int k = 0; k < 1024; k++) {
-        audioSpectBuffer[1024 - k] = (iFFT_buffer[k] * iFFT_buffer[k]);
+      fadeMark = ScratchMark();
+      fadeBuffer = NULL;
+      if (pendingMask != NULL) {
+        fadeBuffer = MaskFadeBegin(FFT_buffer);
+        ProfileStage(PROF_MASK_SWITCH);
       }
-      for (int k = 0; k < 256; k++) {
-        if (bands[currentBandA].mode == 0  || bands[currentBand].mode == DEMOD_AM || bands[currentBand].mode == DEMOD_SAM) {  //AFP 10-26-22
-          //audioYPixel[k] = 20+  map((int)displayScale[currentScale].dBScale * log10f((audioSpectBuffer[1024 - k] + audioSpectBuffer[1024 - k + 1] + audioSpectBuffer[1024 - k + 2]) / 3), 0, 100, 0, 120);
-          audioYPixel[k] = 50 +  map(15 * log10f((audioSpectBuffer[1024 - k] + audioSpectBuffer[1024 - k + 1] + audioSpectBuffer[1024 - k + 2]) / 3), 0, 100, 0, 120);
+      arm_cmplx_mult_cmplx_f32 (FFT_buffer, filterMask, FFT_buffer, FFT_length);
+      ProfileStage(PROF_MASK_MULTIPLY);
+      if (updateDisplayFlag == 1 && sub == subBlocks - 1) {
+        // The audio spectrum display is laid out for FFT_LENGTH bins, pick those out of FFT_length
+        spectrumScale = (float32_t)FFT_LENGTH / (float32_t)FFT_length;
+        spectrumScale *= spectrumScale;
+        for (int k = 0; k < 1024; k++) {
+          uint32_t j = 2 * (((k >> 1) * FFT_length) / FFT_LENGTH) + (k & 1);
+          audioSpectBuffer[1024 - k] = spectrumScale * (FFT_buffer[j] * FFT_buffer[j]);
+        }
+        spectrumDb = ScratchAlloc(256);                 // Released with the fade buffer
+        if (spectrumDb != NULL) {
+          if (bands[currentBandA].mode == 0  || bands[currentBand].mode == DEMOD_AM || bands[currentBand].mode == DEMOD_SAM) {  //AFP 10-26-22
+            for (int k = 0; k < 256; k++) {
+              spectrumDb[k] = (audioSpectBuffer[1024 - k] + audioSpectBuffer[1024 - k + 1] + audioSpectBuffer[1024 - k + 2]) / 3;
+            }
+          } else if (bands[currentBandA].mode == 1) {//AFP 10-26-22
+            for (int k = 0; k < 256; k++) {
+              spectrumDb[k] = (audioSpectBuffer[k] + audioSpectBuffer[k + 1] + audioSpectBuffer[k + 2]) / 3;
+            }
+          } else {
+            spectrumDb = NULL;
+          }
         }
-        else if (bands[currentBandA].mode == 1) {//AFP 10-26-22
-          //audioYPixel[k] = 20+   map((int)displayScale[currentScale].dBScale * log10f((audioSpectBuffer[k] + audioSpectBuffer[k + 1] + audioSpectBuffer[k + 2]) / 3), 0, 100, 0, 120);
-          audioYPixel[k] = 50 +   map(15 * log10f((audioSpectBuffer[k] + audioSpectBuffer[k + 1] + audioSpectBuffer[k + 2]) / 3), 0, 100, 0, 120);
+        if (spectrumDb != NULL) {
+          FastLog10Block(spectrumDb, spectrumDb, 15.0, 256);
+          for (int k = 0; k < 256; k++) {
+            audioYPixel[k] = 50 + map(spectrumDb[k], 0, 100, 0, 120);
+            if (audioYPixel[k] < 0)
+              audioYPixel[k] = 0;
+          }
         }
-        if (audioYPixel[k] < 0)
-          audioYPixel[k] = 0;
+        arm_max_f32 (audioSpectBuffer, 1024, &audioMaxSquared, &AudioMaxIndex);  // AFP 09-18-22 Max value of squared abin magnitued in audio
+        audioMaxSquaredAve = .5 * audioMaxSquared + .5 * audioMaxSquaredAve;  //AFP 09-18-22Running averaged values
+        ProfileStage(PROF_AUDIO_SPECTRUM);
       }
-      arm_max_f32 (audioSpectBuffer, 1024, &audioMaxSquared, &AudioMaxIndex);  // AFP 09-18-22 Max value of squared abin magnitued in audio
-      audioMaxSquaredAve = .5 * audioMaxSquared + .5 * audioMaxSquaredAve;  //AFP 09-18-22Running averaged values
-      DisplaydbM();
-    }
 
-    /**********************************************************************************
-          Additional Convolution Processes:
-              // filter by just deleting bins - principle of Linrad
-      only works properly when we have the right window function!
-
-        (automatic) notch filter = Tone killer --> the name is stolen from SNR ;-)
-        first test, we set a notch filter at 1kHz
-        which bin is that?
-        positive & negative frequency -1kHz and +1kHz --> delete 2 bins
-        we are not deleting one bin, but five bins for the test
-        1024 bins in 12ksps = 11.71Hz per bin
-        SR[SampleRate].rate / 8.0 / 1024 = bin BW
-        1000Hz / 11.71Hz = bin 85.333
+      /**********************************************************************************
+            Additional Convolution Processes:
+                // filter by just deleting bins - principle of Linrad
+        only works properly when we have the right window function!
 
-     **********************************************************************************/
+          (automatic) notch filter = Tone killer --> the name is stolen from SNR ;-)
+          first test, we set a notch filter at 1kHz
+          which bin is that?
+          positive & negative frequency -1kHz and +1kHz --> delete 2 bins
+          we are not deleting one bin, but five bins for the test
+          1024 bins in 12ksps = 11.71Hz per bin
+          SR[SampleRate].rate / 8.0 / 1024 = bin BW
+          1000Hz / 11.71Hz = bin 85.333
 
-    /**********************************************************************************  AFP 12-31-20
-      After the frequency domain filter mask and other processes are complete, do a
-      complex inverse FFT to return to the time domain
-        (if sample rate = 192kHz, we are in 24ksps now, because we decimated by 8)
-        perform iFFT (in-place)  IFFT is selected by the IFFT flag=1 in the Arm CFFT function.
-     **********************************************************************************/
+       **********************************************************************************/
+
+      /**********************************************************************************  AFP 12-31-20
+        After the frequency domain filter mask and other processes are complete, do a
+        complex inverse FFT to return to the time domain
+          (if sample rate = 192kHz, we are in 24ksps now, because we decimated by 8)
+          perform iFFT (in-place)  IFFT is selected by the IFFT flag=1 in the Arm CFFT function.
+       **********************************************************************************/
 
-    arm_cfft_f32(iS, iFFT_buffer, 1, 1);
+      arm_cfft_f32(iS, FFT_buffer, 1, 1);
+      ProfileStage(PROF_INVERSE_FFT);
+      if (fadeBuffer != NULL) {
+        MaskFadeEnd(fadeBuffer, FFT_buffer);
+        ProfileStage(PROF_MASK_SWITCH);
+      }
+      ScratchRelease(fadeMark);
+      arm_copy_f32(&FFT_buffer[hist * 2], &convOutput[sub * fftHop * 2], fftHop * 2);
+    }
 
     // Adjust for level alteration because of filters
 
@@ -364,9 +373,10 @@ void ProcessIQData()
         AGC - automatic gain control
 
         we´re back in time domain
-        AGC acts upon I & Q before demodulation on the decimated audio data in iFFT_buffer
+        AGC acts upon I & Q before demodulation on the decimated audio data in convOutput
      **********************************************************************************/
     AGC();  //AGC function works with time domain I and Q data buffers created in the last step
+    ProfileStage(PROF_AGC);
 
     //============================  Demod  ========================
 
@@ -379,48 +389,47 @@ void ProcessIQData()
 
     switch (bands[currentBandA].mode) {
       case DEMOD_LSB :
-        for (unsigned i = 0; i < FFT_length / 2; i++) {
+        for (unsigned i = 0; i < BUF_N_DF; i++) {
           //if (bands[currentBand].mode == DEMOD_USB || bands[currentBand].mode == DEMOD_LSB ) {  // for SSB copy real part in both outputs
-          float_buffer_L[i] = iFFT_buffer[FFT_length + (i * 2)];
+          float_buffer_L[i] = convOutput[(i * 2)];
 
           float_buffer_R[i] = float_buffer_L[i];
           //}
         }
         break;
       case DEMOD_USB :
-        for (unsigned i = 0; i < FFT_length / 2; i++) {
+        for (unsigned i = 0; i < BUF_N_DF; i++) {
           // if (bands[currentBand].mode == DEMOD_USB || bands[currentBand].mode == DEMOD_LSB ) {  // for SSB copy real part in both outputs
-          float_buffer_L[i] = iFFT_buffer[FFT_length + (i * 2)];
+          float_buffer_L[i] = convOutput[(i * 2)];
 
           float_buffer_R[i] = float_buffer_L[i];
-          audiotmp = AlphaBetaMag(iFFT_buffer[FFT_length + (i * 2)], iFFT_buffer[FFT_length + (i * 2) + 1]);
           //}
         }
 
         break;
       case DEMOD_AM :
-        for (unsigned i = 0; i < FFT_length / 2; i++) {     // Magnitude estimation Lyons (2011): page 652 / libcsdr
-          audiotmp = AlphaBetaMag(iFFT_buffer[FFT_length + (i * 2)], iFFT_buffer[FFT_length + (i * 2) + 1]);
+        AlphaBetaMagBlock(convOutput, float_buffer_R, BUF_N_DF);   // Magnitude estimation Lyons (2011): page 652 / libcsdr
+        for (unsigned i = 0; i < BUF_N_DF; i++) {
           // DC removal filter -----------------------
-          w = audiotmp + wold * 0.99f; // Response to below 200Hz AFP 10-30-22
+          w = float_buffer_R[i] + wold * 0.99f; // Response to below 200Hz AFP 10-30-22
           float_buffer_L[i] = w - wold;
           wold = w;
         }
-        arm_biquad_cascade_df1_f32 (&biquad_lowpass1, float_buffer_L, float_buffer_R, FFT_length / 2);
-        arm_copy_f32(float_buffer_R, float_buffer_L, FFT_length / 2);
+        arm_biquad_cascade_df1_f32 (&biquad_lowpass1, float_buffer_L, float_buffer_R, BUF_N_DF);
+        arm_copy_f32(float_buffer_R, float_buffer_L, BUF_N_DF);
 
         //===  Alternate AM detection - not quite as good as AlphaBetaMag AFP 10-30-22 ===
-        /*   for (unsigned i = 0; i < FFT_length / 2; i++) { //
-             audiotmp = sqrtf(iFFT_buffer[FFT_length + (i * 2)] * iFFT_buffer[FFT_length + (i * 2)]
-                              + iFFT_buffer[FFT_length + (i * 2) + 1] * iFFT_buffer[FFT_length + (i * 2) + 1]);
+        /*   for (unsigned i = 0; i < BUF_N_DF; i++) { //
+             audiotmp = sqrtf(convOutput[(i * 2)] * convOutput[(i * 2)]
+                              + convOutput[(i * 2) + 1] * convOutput[(i * 2) + 1]);
              // DC removal filter -------
              w = audiotmp + wold * 0.9999f; // yes, I want a superb bass response ;-)
              float_buffer_L[i] = w - wold;
 
              wold = w;
            }
-           arm_biquad_cascade_df1_f32 (&biquad_lowpass1, float_buffer_L, float_buffer_R, FFT_length / 2);
-           arm_copy_f32(float_buffer_R, float_buffer_L, FFT_length / 2);*/
+           arm_biquad_cascade_df1_f32 (&biquad_lowpass1, float_buffer_L, float_buffer_R, BUF_N_DF);
+           arm_copy_f32(float_buffer_R, float_buffer_L, BUF_N_DF);*/
         //  ===========================
         break;
         case DEMOD_SAM : //AFP 11-03-22
@@ -428,12 +437,14 @@ void ProcessIQData()
         break;
         
     }
+    ProfileStage(PROF_DEMOD);
     // == AFP 10-30-22
 
     //============================  Receive EQ  ========================  AFP 08-08-22
     if (receiveEQFlag == ON ) {
       DoReceiveEQ();
-      arm_copy_f32(float_buffer_L, float_buffer_R, FFT_length / 2);
+      arm_copy_f32(float_buffer_L, float_buffer_R, BUF_N_DF);
+      ProfileStage(PROF_EQ);
     }
     //============================ End Receive EQ
 
@@ -445,13 +456,15 @@ void ProcessIQData()
       Spectral NR
       LMS variable leak NR
     **********************************************************************************/
-    switch (NR_Index) {
+    // NR, the automatic notch and the noise blanker work on 256 sample frames and are bypassed
+    // in the low-latency path, see Latency.cpp
+    switch (lowLatencyActive ? 0 : NR_Index) {
       case 0:                               // NR Off
         break;
       case 1:                               // Kim NR
         Kim1_NR();
-        arm_scale_f32 (float_buffer_L, 30, float_buffer_L, FFT_length / 2);
-        arm_scale_f32 (float_buffer_R, 30, float_buffer_R, FFT_length / 2);
+        arm_scale_f32 (float_buffer_L, 30, float_buffer_L, BUF_N_DF);
+        arm_scale_f32 (float_buffer_R, 30, float_buffer_R, BUF_N_DF);
         break;
       case 2:                               // Spectral NR
         SpectralNoiseReduction();
@@ -459,17 +472,17 @@ void ProcessIQData()
       case 3:                               // LMS NR
         ANR_notch = 0;
         Xanr();
-        arm_scale_f32 (float_buffer_L, 1.5, float_buffer_L, FFT_length / 2);
-        arm_scale_f32 (float_buffer_R, 2, float_buffer_R, FFT_length / 2);
+        arm_scale_f32 (float_buffer_L, 1.5, float_buffer_L, BUF_N_DF);
+        arm_scale_f32 (float_buffer_R, 2, float_buffer_R, BUF_N_DF);
         break;
 
     }
     //==================  End NR ============================
     // ===========================Automatic Notch ==================
-    if (ANR_notchOn == 1) {
+    if (ANR_notchOn == 1 && lowLatencyActive == 0) {
       ANR_notch = 1;
       Xanr();
-      arm_copy_f32(float_buffer_R, float_buffer_L, FFT_length / 2);  //AFP 10-21-22
+      arm_copy_f32(float_buffer_R, float_buffer_L, BUF_N_DF);  //AFP 10-21-22
     }
     // ====================End notch =================================
     /**********************************************************************************
@@ -478,11 +491,12 @@ void ProcessIQData()
     **********************************************************************************/
 
     //=============================================================
-    if (NB_on != 0) {
+    if (NB_on != 0 && lowLatencyActive == 0) {
      
      NoiseBlanker(float_buffer_L, float_buffer_R);
-      arm_copy_f32(float_buffer_R, float_buffer_L, FFT_length / 2);
+      arm_copy_f32(float_buffer_R, float_buffer_L, BUF_N_DF);
     }
+    ProfileStage(PROF_NR);    // NR, automatic notch and noise blanker
  
 
     if (T41State == CW_RECEIVE) {
@@ -492,85 +506,199 @@ void ProcessIQData()
       if (CWFilterIndex != 5) {
         switch (CWFilterIndex) {
           case 0:  // 0.84 KHz
-            arm_biquad_cascade_df2T_f32(&S1_CW_AudioFilter1, float_buffer_L, float_buffer_L_AudioCW, 256);//AFP 10-18-22
-            arm_copy_f32(float_buffer_L_AudioCW, float_buffer_L, FFT_length / 2);                         //AFP 10-18-22
-            arm_copy_f32(float_buffer_L_AudioCW, float_buffer_R, FFT_length / 2);
+            arm_biquad_cascade_df2T_f32(&S1_CW_AudioFilter1, float_buffer_L, float_buffer_L_AudioCW, BUF_N_DF);//AFP 10-18-22
+            arm_copy_f32(float_buffer_L_AudioCW, float_buffer_L, BUF_N_DF);                         //AFP 10-18-22
+            arm_copy_f32(float_buffer_L_AudioCW, float_buffer_R, BUF_N_DF);
             break;
           case 1: // 1.0 KHz
-            arm_biquad_cascade_df2T_f32(&S1_CW_AudioFilter2, float_buffer_L, float_buffer_L_AudioCW, 256);//AFP 10-18-22
-            arm_copy_f32(float_buffer_L_AudioCW, float_buffer_L, FFT_length / 2);                         //AFP 10-18-22
-            arm_copy_f32(float_buffer_L_AudioCW, float_buffer_R, FFT_length / 2);
+            arm_biquad_cascade_df2T_f32(&S1_CW_AudioFilter2, float_buffer_L, float_buffer_L_AudioCW, BUF_N_DF);//AFP 10-18-22
+            arm_copy_f32(float_buffer_L_AudioCW, float_buffer_L, BUF_N_DF);                         //AFP 10-18-22
+            arm_copy_f32(float_buffer_L_AudioCW, float_buffer_R, BUF_N_DF);
             break;
           case 2: // 1.3 KHz
-            arm_biquad_cascade_df2T_f32(&S1_CW_AudioFilter3, float_buffer_L, float_buffer_L_AudioCW, 256);//AFP 10-18-22
-            arm_copy_f32(float_buffer_L_AudioCW, float_buffer_L, FFT_length / 2);                         //AFP 10-18-22
-            arm_copy_f32(float_buffer_L_AudioCW, float_buffer_R, FFT_length / 2);
+            arm_biquad_cascade_df2T_f32(&S1_CW_AudioFilter3, float_buffer_L, float_buffer_L_AudioCW, BUF_N_DF);//AFP 10-18-22
+            arm_copy_f32(float_buffer_L_AudioCW, float_buffer_L, BUF_N_DF);                         //AFP 10-18-22
+            arm_copy_f32(float_buffer_L_AudioCW, float_buffer_R, BUF_N_DF);
             break;
           case 3: // 1.8 KHz
-            arm_biquad_cascade_df2T_f32(&S1_CW_AudioFilter4, float_buffer_L, float_buffer_L_AudioCW, 256);//AFP 10-18-22
-            arm_copy_f32(float_buffer_L_AudioCW, float_buffer_L, FFT_length / 2);                         //AFP 10-18-22
-            arm_copy_f32(float_buffer_L_AudioCW, float_buffer_R, FFT_length / 2);
+            arm_biquad_cascade_df2T_f32(&S1_CW_AudioFilter4, float_buffer_L, float_buffer_L_AudioCW, BUF_N_DF);//AFP 10-18-22
+            arm_copy_f32(float_buffer_L_AudioCW, float_buffer_L, BUF_N_DF);                         //AFP 10-18-22
+            arm_copy_f32(float_buffer_L_AudioCW, float_buffer_R, BUF_N_DF);
             break;
           case 4:  // 2.0 KHz
-            arm_biquad_cascade_df2T_f32(&S1_CW_AudioFilter5, float_buffer_L, float_buffer_L_AudioCW, 256);//AFP 10-18-22
-            arm_copy_f32(float_buffer_L_AudioCW, float_buffer_L, FFT_length / 2);                         //AFP 10-18-22
-            arm_copy_f32(float_buffer_L_AudioCW, float_buffer_R, FFT_length / 2);
+            arm_biquad_cascade_df2T_f32(&S1_CW_AudioFilter5, float_buffer_L, float_buffer_L_AudioCW, BUF_N_DF);//AFP 10-18-22
+            arm_copy_f32(float_buffer_L_AudioCW, float_buffer_L, BUF_N_DF);                         //AFP 10-18-22
+            arm_copy_f32(float_buffer_L_AudioCW, float_buffer_R, BUF_N_DF);
             break;
           case 5:  //Off
             break;
         }
       }
-
-
+      ProfileStage(PROF_CW);
     }
     //=========================  AFP 10-18-22 ===================
 
 
     // ======================================Interpolation  ================
-
-    arm_fir_interpolate_f32(&FIR_int1_I, float_buffer_L, iFFT_buffer, BUFFER_SIZE * N_BLOCKS / (uint32_t)(DF));   // Interpolatikon
-    arm_fir_interpolate_f32(&FIR_int1_Q, float_buffer_R, FFT_buffer, BUFFER_SIZE * N_BLOCKS / (uint32_t)(DF));
-
-    // interpolation-by-4
-    arm_fir_interpolate_f32(&FIR_int2_I, iFFT_buffer, float_buffer_L, BUFFER_SIZE * N_BLOCKS / (uint32_t)(DF1));
-    arm_fir_interpolate_f32(&FIR_int2_Q, FFT_buffer, float_buffer_R, BUFFER_SIZE * N_BLOCKS / (uint32_t)(DF1));
+    // 24 KHz to 96 KHz, the last stage runs below straight into the audio buffers
+    Interpolate(&rxInterpolator, float_buffer_L, float_buffer_R, BUFFER_SIZE * N_BLOCKS / (uint32_t)(DF));
+    ProfileStage(PROF_INTERPOLATE);
 
     /**********************************************************************************  AFP 12-31-20
       Digital Volume Control
     **********************************************************************************/
-
-
-
+    float32_t volumeGain = 1.0;
     if (mute == 1) {
-      arm_scale_f32(float_buffer_L, 0.0, float_buffer_L, BUFFER_SIZE * N_BLOCKS);
-      arm_scale_f32(float_buffer_R, 0.0, float_buffer_R, BUFFER_SIZE * N_BLOCKS);
+      volumeGain = 0.0;
     } else if (mute == 0) {
-      arm_scale_f32(float_buffer_L, DF * VolumeToAmplification(audioVolume), float_buffer_L, BUFFER_SIZE * N_BLOCKS);
-      arm_scale_f32(float_buffer_R, DF * VolumeToAmplification(audioVolume), float_buffer_R, BUFFER_SIZE * N_BLOCKS);
+      volumeGain = VolumeToAmplification(audioVolume);
     }
     /**********************************************************************************  AFP 12-31-20
       CONVERT TO INTEGER AND PLAY AUDIO
+      Interpolate to 192 KHz with the volume and q15 conversion folded into the filter
     **********************************************************************************/
 
     for (unsigned  i = 0; i < N_BLOCKS; i++) {
       sp_L1 = Q_out_L.getBuffer();
       sp_R1 = Q_out_R.getBuffer();
-      arm_float_to_q15 (&float_buffer_L[BUFFER_SIZE * i], sp_L1, BUFFER_SIZE);
-      arm_float_to_q15 (&float_buffer_R[BUFFER_SIZE * i], sp_R1, BUFFER_SIZE);
-      Q_out_L.playBuffer(); // play it !
-      Q_out_R.playBuffer(); // play it !
+      InterpolateOutput(&rxInterpolator, &float_buffer_L[BUFFER_SIZE / 2 * i], &float_buffer_R[BUFFER_SIZE / 2 * i], sp_L1, sp_R1, BUFFER_SIZE / 2, volumeGain);
+#ifdef IQ_REPLAY
+      IQReplayWriteAudio(sp_L1, sp_R1, BUFFER_SIZE);
+#endif
+      if (latencyFlushBlocks == 0) {  // Held back after a switch to the low-latency path until the queue runs dry
+        Q_out_L.playBuffer(); // play it !
+        Q_out_R.playBuffer(); // play it !
+      }
     }
+    if (latencyFlushBlocks > 0) {
+      latencyFlushBlocks--;
+    }
+    ProfileStage(PROF_FLOAT_TO_Q15);
 
     if (auto_codec_gain == 1) {
       Codec_gain();
     }
     elapsed_micros_sum = elapsed_micros_sum + usec;
     elapsed_micros_idx_t++;
+    if (updateDisplayFlag == 1) {
+      SpectrumFramePublish();                   // Hand this block's display data to ShowSpectrum()
+    }
+    ProfileBlockEnd();
   } // end of if(audio blocks available)
-  if (ms_500.check() == 1)                                  // For clock updates AFP 10-26-22
-  {
-    //wait_flag = 0;
-    DisplayClock();
+}
+
+/*****
+  Purpose: Interval timer interrupt that runs the receive DSP chain. It runs at the lowest interrupt
+           priority, so it preempts loop(), the display and any menu, but not the audio library,
+           the encoders or USB. Audio therefore keeps flowing whatever the UI is doing.
+           Functions that change DSP state from loop() bracket the change with DSPNoInterrupts()
+           and DSPInterrupts(), the same way they use AudioNoInterrupts(). Those count dspTaskHold
+           up and down rather than masking IRQ_PIT, which every IntervalTimer shares, so a tick
+           that lands inside one, however deeply nested, is skipped and the block is picked up
+           on the next. loop() never runs while the ISR does, so the count cannot change under a
+           block in progress.
+
+  Parameter List:
+    void
+
+  Return value:
+    void
+*****/
+void DSPTimerISR()
+{
+  if (dspTaskHold == 0 && DSPTaskRunning() == 1) {
+    ProcessIQData();
   }
-    
+}
+
+/*****
+  Purpose: Is the DSP task processing receive audio? ShowSpectrum() only waits for a frame when it is.
+
+  Parameter List:
+    void
+
+  Return value:
+    int               1 if DSPTimerISR() is calling ProcessIQData(), 0 otherwise
+*****/
+int DSPTaskRunning()
+{
+  if (dspTaskEnabled == 0 || xrState != RECEIVE_STATE) {
+    return 0;
+  }
+  return (T41State == SSB_RECEIVE || T41State == CW_RECEIVE);
+}
+
+/*****
+  Purpose: Is there a free slot in the spectrum handoff ring? Called by the DSP task.
+
+  Parameter List:
+    void
+
+  Return value:
+    int               1 if the next frame can be written, 0 if the display is behind
+*****/
+int SpectrumFrameFree()
+{
+  return ((spectrumFrameHead + 1) % SPECTRUM_FRAME_COUNT) != spectrumFrameTail;
+}
+
+/*****
+  Purpose: Copy the display data computed in this block into the head slot and publish it.
+           Single producer (DSP task), single consumer (ShowSpectrum()), so no lock is needed:
+           the slot is filled before the head index moves, and the consumer never touches the
+           slot at the head.
+
+  Parameter List:
+    void
+
+  Return value:
+    void
+*****/
+void SpectrumFramePublish()
+{
+  struct spectrumFrame *frame = &spectrumFrames[spectrumFrameHead];
+
+  memcpy(frame->pixelnew, pixelnew, sizeof(frame->pixelnew));
+  for (int k = 0; k < AUDIO_SPECTRUM_PIXELS; k++) {
+    frame->audioYPixel[k] = audioYPixel[k];
+  }
+  frame->holdMode = spectrumHoldMode;
+  frame->waterfallLine = PacerFrameMade();
+  if (spectrumHoldMode) {
+    memcpy(frame->pixelPeak, pixelPeak, sizeof(frame->pixelPeak));
+    memcpy(frame->pixelMin, pixelMin, sizeof(frame->pixelMin));
+  }
+  __DSB();                                      // Frame contents are written before the index
+  spectrumFrameHead = (spectrumFrameHead + 1) % SPECTRUM_FRAME_COUNT;
+}
+
+/*****
+  Purpose: Oldest frame the display has not drawn yet. Called by ShowSpectrum().
+
+  Parameter List:
+    void
+
+  Return value:
+    struct spectrumFrame *    the frame, or NULL if the DSP has not produced a new one
+*****/
+struct spectrumFrame *SpectrumFrameGet()
+{
+  if (spectrumFrameTail == spectrumFrameHead) {
+    return NULL;
+  }
+  return &spectrumFrames[spectrumFrameTail];
+}
+
+/*****
+  Purpose: Give the frame from SpectrumFrameGet() back to the DSP task
+
+  Parameter List:
+    void
+
+  Return value:
+    void
+*****/
+void SpectrumFrameRelease()
+{
+  spectrumFrameTail = (spectrumFrameTail + 1) % SPECTRUM_FRAME_COUNT;
 }
@@ -18,6 +18,7 @@ void DoReceiveCalibrate() {
   float correctionIncrement = 0.01; //AFP 2-7-23
   int corrChange = 0;
 
+  dspTaskEnabled = 0;                     // ProcessIQData2() runs the receive chain while calibrating
   //IQChoice = 0;  // AFP 02-09-23
   calFreqShift = -24000;
   tft.setFontScale( (enum RA8875tsize) 0);
@@ -124,6 +125,7 @@ void DoReceiveCalibrate() {
       }
     }
   }
+  dspTaskEnabled = 1;
   calOnFlag = 0;
 
   return;
@@ -148,6 +150,7 @@ void DoXmitCalibrate() {
   int corrChange = 0;
   int val;
 
+  dspTaskEnabled = 0;
   //IQEXChoice = 0;
 
   tft.setFontScale( (enum RA8875tsize) 0);
@@ -254,6 +257,7 @@ void DoXmitCalibrate() {
       }
     }
   }
+  dspTaskEnabled = 1;
   calOnFlag = 0;
   return;
   centerTuneFlag = 1;
@@ -321,18 +325,8 @@ void ProcessIQData2()
     }
   }
   //24KHz effective sample rate here
-  arm_fir_interpolate_f32(&FIR_int1_EX_I, float_buffer_L_EX, float_buffer_LTemp, 256);
-  arm_fir_interpolate_f32(&FIR_int1_EX_Q, float_buffer_R_EX, float_buffer_RTemp, 256);
-
-  // interpolation-by-4,  48KHz effective sample rate here
-  arm_fir_interpolate_f32(&FIR_int2_EX_I, float_buffer_LTemp, float_buffer_L_EX, 512);
-  arm_fir_interpolate_f32(&FIR_int2_EX_Q, float_buffer_RTemp, float_buffer_R_EX, 512);
-
-
-
-  //  192KHz effective sample rate here
-  //arm_scale_f32(float_buffer_L_EX, 10, float_buffer_L_EX, 2048); //Scale to compensate for losses in Interpolation
-  //arm_scale_f32(float_buffer_R_EX, 10, float_buffer_R_EX, 2048);
+  Interpolate(&txInterpolator, float_buffer_L_EX, float_buffer_R_EX, 256);
+  //  96KHz effective sample rate here, the last stage runs below straight into the audio buffers
 
 
   // are there at least N_BLOCKS buffers in each channel available ?
@@ -341,8 +335,8 @@ void ProcessIQData2()
     for (unsigned  i = 0; i < N_BLOCKS_EX; i++) {  //N_BLOCKS_EX=16  BUFFER_SIZE=128 16x128=2048
       sp_L2 = Q_out_L_Ex.getBuffer();
       sp_R2 = Q_out_R_Ex.getBuffer();
-      arm_float_to_q15 (&float_buffer_L_EX[BUFFER_SIZE * i], sp_L2, BUFFER_SIZE);
-      arm_float_to_q15 (&float_buffer_R_EX[BUFFER_SIZE * i], sp_R2, BUFFER_SIZE);
+      // Gain of 1/8 keeps the unscaled level of the old interpolators, which the calibration was set up with
+      InterpolateOutput(&txInterpolator, &float_buffer_L_EX[BUFFER_SIZE / 2 * i], &float_buffer_R_EX[BUFFER_SIZE / 2 * i], sp_L2, sp_R2, BUFFER_SIZE / 2, 0.125);
       Q_out_L_Ex.playBuffer(); // play it !
       Q_out_R_Ex.playBuffer(); // play it !
     }
@@ -434,6 +428,9 @@ void ShowSpectrum2()  //AFP 2-10-23
   float refAmplitude = 0.0;
 
   //=========== // AFP 2-11-23
+  if (waterfallScrollTop != 0) {                                      // This one moves the waterfall with the BTE
+    WaterfallScrollReset();
+  }
   tft.drawFastVLine(centerLine, SPECTRUM_TOP_Y, h, RA8875_GREEN);     // Draws centerline on spectrum display
 
 
@@ -0,0 +1,389 @@
+#ifndef BEENHERE
+#include "SDT.h"
+#endif
+
+/**********************************************************************************
+  Per-stage cycle profiler for ProcessIQData()
+
+  Each stage of the receive chain is timed with the Cortex-M7 DWT cycle counter.
+  ProfileBlockStart() starts a block, ProfileStage() charges the cycles since the last mark to a
+  stage and restarts the measurement, so consecutive calls time consecutive stages with one
+  counter read each. ProfileMark() restarts the measurement without charging anything, and
+  ProfileBlockEnd() adds the block to the statistics. A block cut short when the key goes down
+  is dropped with ProfileBlockAbandon(). For every stage we keep the count, sum, min, max and a histogram with 4 bins per octave,
+  from which the 99th percentile is read to within about 12%.
+
+  The report is sent over USB serial when 'p' is typed in the Serial Monitor. 'r' resets the
+  statistics and 'd' toggles the temperature/load line at the bottom of the screen.
+**********************************************************************************/
+
+const char *profileStageNames[] = {
+  "Ingest", "IQ correct", "Zoom FFT", "FreqShift1", "FreqShift2",
+  "Decimate", "Fwd CFFT", "Mask mult", "Mask switch", "Audio spec", "Inv CFFT", "AGC", "Demod",
+  "EQ", "NR", "CW", "Interpolate", "Interp>q15", "Total"
+};
+
+uint32_t profileMarkCycles;
+uint32_t profileBlockStartCycles;
+uint32_t profileStagesUsed;                       // Bit per stage charged in the current block
+uint32_t profileBlockCycles[PROF_STAGE_COUNT];
+uint32_t profileCount[PROF_STAGE_COUNT];
+uint32_t profileMin[PROF_STAGE_COUNT];
+uint32_t profileMax[PROF_STAGE_COUNT];
+uint64_t profileSum[PROF_STAGE_COUNT];
+DMAMEM uint32_t profileHistogram[PROF_STAGE_COUNT][PROFILE_BIN_COUNT];
+
+/*****
+  Purpose: Map a cycle count to a histogram bin. Values below 4 get their own bin, above that
+           each octave is split into 4 equal bins.
+
+  Parameter list:
+    uint32_t cycles
+
+  Return value;
+    int             bin index, 0 to PROFILE_BIN_COUNT - 1
+*****/
+FASTRUN int ProfileBin(uint32_t cycles)
+{
+  int octave;
+
+  if (cycles < 4) {
+    return cycles;
+  }
+  octave = 31 - __builtin_clz(cycles);
+  return (octave - 1) * 4 + ((cycles >> (octave - 2)) & 3);
+}
+
+/*****
+  Purpose: Lowest cycle count that falls in a histogram bin
+
+  Parameter list:
+    int bin
+
+  Return value;
+    uint32_t
+*****/
+uint32_t ProfileBinEdge(int bin)
+{
+  if (bin < 4) {
+    return bin;
+  }
+  return (uint32_t)(4 + (bin & 3)) << (bin / 4 - 1);
+}
+
+/*****
+  Purpose: Enable the DWT cycle counter and clear the statistics. Called once from setup().
+
+  Parameter list:
+    void
+
+  Return value;
+    void
+*****/
+void ProfileInit()
+{
+  ARM_DEMCR |= ARM_DEMCR_TRCENA;
+  ARM_DWT_CTRL |= ARM_DWT_CTRL_CYCCNTENA;
+  ProfileReset();
+}
+
+/*****
+  Purpose: Clear all stage statistics
+
+  Parameter list:
+    void
+
+  Return value;
+    void
+*****/
+void ProfileReset()
+{
+  for (int i = 0; i < PROF_STAGE_COUNT; i++) {
+    profileCount[i] = 0;
+    profileMin[i]   = 0xFFFFFFFF;
+    profileMax[i]   = 0;
+    profileSum[i]   = 0;
+  }
+  memset(profileHistogram, 0, sizeof(profileHistogram));
+  scratchHighWater = 0;
+  scratchFailures = 0;
+  maskCacheHits = 0;
+  maskCacheMisses = 0;
+  PacerReset();
+}
+
+/*****
+  Purpose: Restart timing after code that should not be charged to the next stage, such as
+           display updates made from inside ProcessIQData()
+
+  Parameter list:
+    void
+
+  Return value;
+    void
+*****/
+FASTRUN void ProfileMark()
+{
+  profileMarkCycles = ARM_DWT_CYCCNT;
+}
+
+/*****
+  Purpose: Add one sample to a stage's statistics
+
+  Parameter list:
+    int stage
+    uint32_t cycles
+
+  Return value;
+    void
+*****/
+FASTRUN void ProfileRecord(int stage, uint32_t cycles)
+{
+  profileCount[stage]++;
+  profileSum[stage] += cycles;
+  if (cycles < profileMin[stage]) {
+    profileMin[stage] = cycles;
+  }
+  if (cycles > profileMax[stage]) {
+    profileMax[stage] = cycles;
+  }
+  profileHistogram[stage][ProfileBin(cycles)]++;
+}
+
+/*****
+  Purpose: Charge the cycles since the last mark to a stage and start timing the next one. A stage
+           may be charged more than once in a block; the block total is what gets recorded.
+
+  Parameter list:
+    int stage         one of the PROF_ symbolic constants
+
+  Return value;
+    void
+*****/
+FASTRUN void ProfileStage(int stage)
+{
+  uint32_t now = ARM_DWT_CYCCNT;
+
+  profileBlockCycles[stage] += now - profileMarkCycles;
+  profileStagesUsed |= 1UL << stage;
+  profileMarkCycles = now;
+}
+
+/*****
+  Purpose: Start timing a new block
+
+  Parameter list:
+    void
+
+  Return value;
+    void
+*****/
+FASTRUN void ProfileBlockStart()
+{
+  profileBlockStartCycles = profileMarkCycles = ARM_DWT_CYCCNT;
+}
+
+/*****
+  Purpose: Record the stages that ran in this block, and the whole block as PROF_TOTAL
+
+  Parameter list:
+    void
+
+  Return value;
+    void
+*****/
+FASTRUN void ProfileBlockEnd()
+{
+  ProfileRecord(PROF_TOTAL, ARM_DWT_CYCCNT - profileBlockStartCycles);
+  for (int i = 0; i < PROF_TOTAL; i++) {
+    if (profileStagesUsed & (1UL << i)) {
+      ProfileRecord(i, profileBlockCycles[i]);
+      profileBlockCycles[i] = 0;
+    }
+  }
+  profileStagesUsed = 0;
+}
+
+/*****
+  Purpose: Drop a block that ProcessIQData() left part way, when the key went down. Its stages
+           would otherwise be added to the next block's and count as one long block.
+
+  Parameter list:
+    void
+
+  Return value;
+    void
+*****/
+FASTRUN void ProfileBlockAbandon()
+{
+  for (int i = 0; i < PROF_TOTAL; i++) {
+    profileBlockCycles[i] = 0;
+  }
+  profileStagesUsed = 0;
+}
+
+/*****
+  Purpose: Cycle count below which 99% of a stage's samples fall
+
+  Parameter list:
+    int stage
+
+  Return value;
+    uint32_t          cycles, middle of the histogram bin holding the 99th percentile
+*****/
+uint32_t ProfilePercentile99(int stage)
+{
+  uint32_t target = profileCount[stage] - profileCount[stage] / 100;
+  uint32_t running = 0;
+
+  for (int bin = 0; bin < PROFILE_BIN_COUNT; bin++) {
+    running += profileHistogram[stage][bin];
+    if (running >= target) {
+      if (bin == PROFILE_BIN_COUNT - 1) {
+        return profileMax[stage];
+      }
+      return (ProfileBinEdge(bin) + ProfileBinEdge(bin + 1)) / 2;
+    }
+  }
+  return profileMax[stage];
+}
+
+/*****
+  Purpose: Mean load of one stage as a percentage of the time available for a block
+
+  Parameter list:
+    int stage
+
+  Return value;
+    float
+*****/
+float ProfileStageLoad(int stage)
+{
+  float blockCycles = (float)F_CPU_ACTUAL * BUFFER_SIZE * N_BLOCKS / SR[SampleRate].rate;
+
+  if (profileCount[stage] == 0) {
+    return 0.0;
+  }
+  return (float)profileSum[stage] / profileCount[stage] / blockCycles * 100.0;
+}
+
+/*****
+  Purpose: Mean time of one stage
+
+  Parameter list:
+    int stage
+
+  Return value;
+    float             microseconds, 0 if the stage has not run
+*****/
+float ProfileStageMicros(int stage)
+{
+  if (profileCount[stage] == 0) {
+    return 0.0;
+  }
+  return (float)profileSum[stage] / profileCount[stage] / ((float)F_CPU_ACTUAL / 1000000.0);
+}
+
+/*****
+  Purpose: Stage with the largest mean time, not counting the total
+
+  Parameter list:
+    void
+
+  Return value;
+    int               PROF_ stage index
+*****/
+int ProfileHeaviestStage()
+{
+  int heaviest = 0;
+
+  for (int i = 1; i < PROF_TOTAL; i++) {
+    if (ProfileStageLoad(i) > ProfileStageLoad(heaviest)) {
+      heaviest = i;
+    }
+  }
+  return heaviest;
+}
+
+/*****
+  Purpose: Print the stage statistics to USB serial. Times are in microseconds.
+
+  Parameter list:
+    void
+
+  Return value;
+    void
+*****/
+void ProfilePrintReport()
+{
+  float cyclesPerMicro = (float)F_CPU_ACTUAL / 1000000.0;
+
+  Serial.printf("\nProcessIQData() stage times (us), %lu MHz, block = %lu samples\n", F_CPU_ACTUAL / 1000000, BUFFER_SIZE * N_BLOCKS);
+  Serial.println("Stage           count      min     mean      p99      max   load%");
+  for (int i = 0; i < PROF_STAGE_COUNT; i++) {
+    if (profileCount[i] == 0) {
+      Serial.printf("%-12s %8d\n", profileStageNames[i], 0);
+      continue;
+    }
+    Serial.printf("%-12s %8lu %8.1f %8.1f %8.1f %8.1f %7.2f\n", profileStageNames[i], profileCount[i],
+                  profileMin[i] / cyclesPerMicro,
+                  (float)profileSum[i] / profileCount[i] / cyclesPerMicro,
+                  ProfilePercentile99(i) / cyclesPerMicro,
+                  profileMax[i] / cyclesPerMicro,
+                  ProfileStageLoad(i));
+  }
+  Serial.printf("Audio queue overflows: %lu\n", audioQueueOverflows);
+  Serial.printf("Scratch arena: %lu of %d bytes high water, %lu failed allocations\n",
+                scratchHighWater * sizeof(float32_t), (int)(SCRATCH_ARENA_SIZE * sizeof(float32_t)), scratchFailures);
+  Serial.printf("Filter mask cache: %lu hits, %lu misses\n", maskCacheHits, maskCacheMisses);
+  LatencyPrintReport();
+  DisplayQueuePrintReport();
+  PacerPrintReport();
+  Serial.printf("Display SPI: %lu bytes/s (estimated)\n", displaySpiBytesPerSecond);
+}
+
+/*****
+  Purpose: Handle single character profiler commands from the Serial Monitor. Called from loop().
+             p   print the stage report
+             r   reset the statistics
+             d   toggle the on-screen temperature and load line
+             m   print the memory map
+             f   check the fast math kernels against libm
+             b   time the display drawing paths
+
+  Parameter list:
+    void
+
+  Return value;
+    void
+*****/
+void ProfileSerialCommand()
+{
+  if (Serial.available() == 0) {
+    return;
+  }
+  switch (Serial.read()) {
+    case 'p':
+      ProfilePrintReport();
+      break;
+    case 'r':
+      ProfileReset();
+      Serial.println("Profiler reset");
+      break;
+    case 'd':
+      profileDisplayFlag = !profileDisplayFlag;
+      if (profileDisplayFlag == 0) {
+        tft.fillRect(TEMP_X_OFFSET, TEMP_Y_OFFSET, MAX_WATERFALL_WIDTH, tft.getFontHeight(), RA8875_BLACK);
+      }
+      break;
+    case 'm':
+      MemoryMapReport();
+      break;
+    case 'f':
+      FastMathCheck();
+      break;
+    case 'b':
+      DisplayBenchmark();
+      break;
+  }
+}
@@ -81,6 +81,153 @@
 //#define DEBUG7
 //#define DEBUG8
 //#define DEBUG9
+
+//#define IQ_REPLAY                                 // Uncomment to feed the receive chain from a recorded IQ WAV file on the SD card
+#define IQ_REPLAY_FILE              "IQREPLAY.WAV"  // 192 kS/s, 16-bit stereo, left = I, right = Q
+#define IQ_RECORD_FILE              "AUDIOOUT.WAV"  // Demodulated audio from one pass through IQ_REPLAY_FILE
+#define IQ_REPLAY_RING_FRAMES       8192            // Frames between loop() and the DSP task each way, 4 blocks or 43 ms
+#define IQ_REPLAY_SD_FRAMES         512             // Frames per SD read or write, 2 KB
+
+//================================ ProcessIQData() stage profiler ================
+#define PROF_INGEST                 0               // Stage indexes for ProfileStage(). q15 to float, gains and DC biquad
+#define PROF_IQ_CORRECTION          1
+#define PROF_ZOOM_FFT               2
+#define PROF_FREQ_SHIFT1            3
+#define PROF_FREQ_SHIFT2            4
+#define PROF_DECIMATE               5
+#define PROF_FORWARD_FFT            6
+#define PROF_MASK_MULTIPLY          7
+#define PROF_MASK_SWITCH            8               // Second mask, inverse FFT and cross-fade after a bandwidth change
+#define PROF_AUDIO_SPECTRUM         9
+#define PROF_INVERSE_FFT            10
+#define PROF_AGC                    11
+#define PROF_DEMOD                  12
+#define PROF_EQ                     13
+#define PROF_NR                     14
+#define PROF_CW                     15
+#define PROF_INTERPOLATE            16
+#define PROF_FLOAT_TO_Q15           17              // Last interpolator stage, straight to q15
+#define PROF_TOTAL                  18              // Whole ProcessIQData() block
+#define PROF_STAGE_COUNT            19
+#define PROFILE_BIN_COUNT           124             // 4 log bins per octave of cycle count
+
+//================================ Receive DSP task ================
+#define DSP_TIMER_PERIOD            1000            // Microseconds between checks for a full receive block
+#define DSP_TIMER_PRIORITY          255             // Lowest, so the audio library, encoders and USB all preempt the DSP
+#define SPECTRUM_FRAME_COUNT        3               // Spectrum handoff ring: one being drawn, one ready, one free
+#define AUDIO_SPECTRUM_PIXELS       256
+// Hold off the DSP task while loop() changes its state. All four PIT channels, so every
+// IntervalTimer, share one IRQ_PIT, and masking it would stop any other IntervalTimer as well.
+// DSPTimerISR() skips its tick while dspTaskHold is not 0 instead, and polls again a
+// millisecond later. The hold counts, so that a function which takes it, such as
+// MaskCacheLookup(), can be called from one that already has it, such as SetReceiveChain(),
+// without ending the outer hold. Only loop() changes the count. The barriers keep the compiler
+// from moving the guarded accesses outside the hold.
+#define DSPNoInterrupts()           do { dspTaskHold++; __asm__ volatile("" ::: "memory"); } while (0)
+#define DSPInterrupts()             do { __asm__ volatile("" ::: "memory"); dspTaskHold--; } while (0)
+
+//================================ Low-latency receive path, see Latency.cpp ================
+#define LOW_LATENCY_OFF             0               // lowLatencyMode[] values
+#define LOW_LATENCY_CW              1               // Only in CW_RECEIVE
+#define LOW_LATENCY_ON              2
+#define LOW_LATENCY_BLOCKS          4               // Audio blocks per ProcessIQData() call, 512 samples
+#define LOW_LATENCY_FFT_LENGTH      256             // Hop is the whole 64 sample decimated block, 193 taps
+#define LATENCY_FLUSH_BLOCKS        (N_B / LOW_LATENCY_BLOCKS)         // Output held back after switching in, one normal block
+#define LATENCY_PART_COUNT          4               // Gather, DSP, filters, audio library
+
+//================================ Memory placement, see MemoryMap.cpp ================
+#define MEM_ITCM                    0               // Regions for memoryMap[] entries
+#define MEM_DTCM                    1               // RAM1 data, the default: per-sample state and receive working buffers
+#define MEM_OCRAM                   2               // RAM2, DMAMEM: buffers touched once a block or less
+#define MEM_FLASH                   3               // PROGMEM: constant tables not read per sample
+#define MEM_EXTMEM                  4
+#define MEM_REGION_COUNT            5
+#define DTCM_DSP_BUDGET             (112 * 1024)    // Compile-time limit on the memoryMap[] arrays meant for DTCM
+#define DTCM_HEADROOM_MIN           (32 * 1024)     // RAM1 left for the stack below which setup() complains
+#define SCRATCH_ARENA_SIZE          (19 * 256)      // Floats, 19K; Scratch.cpp checks the deepest use fits
+#define MASK_CACHE_SLOTS            8               // Filter masks kept in OCRAM, see MaskCache.cpp
+#define MASK_CACHE_FLOATS           (16 * 1024)     // Pool the slots are carved from, 2 * FFT_length floats each
+#define MASK_PHASE_LINEAR           0               // maskPhase[] values
+#define MASK_PHASE_MINIMUM          1
+#define MASK_PHASE_CW               (DEMOD_MAX + 1) // maskPhase[] index in CW, the others are by demodulation mode
+#define MASK_PHASE_MODES            (DEMOD_MAX + 2)
+#define MIN_PHASE_OVERSAMPLE        4               // Cepstrum grid, times FFT_length
+#define MIN_PHASE_FFT_MAX           4096
+#define MIN_PHASE_FLOOR             1.0e-5          // -100 dB, floor on the magnitude before the log
+#define FAST_MATH_CHECK_POINTS      256             // Sweep length of FastMathCheck()
+#define WINDOW_HANN                 0               // Panadapter windows, see Window.cpp
+#define WINDOW_BLACKMAN_HARRIS      1
+#define WINDOW_NUTTALL              2
+#define WINDOW_FLAT_TOP             3
+#define WINDOW_TYPES                4
+#define WINDOW_TERMS                5               // Cosine terms of the longest window
+#define SPECTRUM_HOLD_PEAK          1               // spectrumHoldMode bits
+#define SPECTRUM_HOLD_MIN           2
+#define HIRES_FFT_2048              2048            // spectrumFFTLength values above SPECTRUM_RES, see HighResSpectrum.cpp
+#define HIRES_FFT_4096              4096
+#define HIRES_FFT_MAX               4096
+#define BINNING_MAX                 0               // spectrumBinning values
+#define BINNING_MEAN                1
+#define TRACE_UNKNOWN               -1              // traceTop[] and audioShown[] when the screen is not known
+#define SPECTRUM_REFRESH_FRAMES     64              // ShowSpectrum() redraws everything this often
+#define WATERFALL_SCROLL_ROWS       (MAX_WATERFALL_ROWS - 1)    // Rows in the waterfall scroll window
+#define DISPLAY_QUEUE_SIZE          32              // Display command ring, see DisplayQueue.cpp
+#define DISPLAY_CMD_FILL_RECT       0               // displayCommand kinds
+#define DISPLAY_CMD_CW_TEXT         1
+#define DISPLAY_CMD_CW_WPM          2
+#define DISPLAY_CMD_SAM_OFFSET      3
+#define DISPLAY_KEY_NONE            0               // displayCommand keys, a newer command replaces an older one with the same key
+#define DISPLAY_KEY_CW_LOCK         1
+#define DISPLAY_KEY_CW_TEXT         2
+#define DISPLAY_KEY_CW_WPM          3
+#define DISPLAY_KEY_SAM_OFFSET      4
+#define DISPLAY_KEYS                5
+#define WIDGET_FREQ_MAIN            0               // widgets[] index, see Widgets.cpp
+#define WIDGET_FREQ_OTHER           1
+#define WIDGET_VFO                  2
+#define WIDGET_CENTER_LABEL         3
+#define WIDGET_CENTER_FREQ          4
+#define WIDGET_BAND                 5
+#define WIDGET_MODE                 6
+#define WIDGET_CW_SHADE             7
+#define WIDGET_DEMOD                8
+#define WIDGET_POWER                9
+#define WIDGET_TR                   10
+#define WIDGET_SMETER               11
+#define WIDGET_DBM                  12
+#define WIDGET_DBM_UNIT             13
+#define WIDGET_VOLUME               14
+#define WIDGET_AGC                  15
+#define WIDGET_INCREMENT            16
+#define WIDGET_FT_INCREMENT         17
+#define WIDGET_NOTCH                18
+#define WIDGET_ZOOM                 19
+#define WIDGET_COMPRESSION          20
+#define WIDGET_NR                   21
+#define WIDGET_WPM                  22
+#define WIDGET_DECODER              23
+#define WIDGET_COUNT                24
+#define WIDGET_TEXT_MAX             16              // Longest widget text field
+#define FREQUENCY_CHARS             10              // FormatFrequency() text
+#define WIDGET_RUN_GAP              3               // Changed characters this close are printed as one run
+#define SPI_BYTES_REGISTER          4               // Estimated RA8875 SPI cost: one register write, command and data
+#define SPI_BYTES_SHAPE             (12 * SPI_BYTES_REGISTER)   // Coordinates, color and start of a line or rectangle
+#define SPI_BYTES_PIXEL             (6 * SPI_BYTES_REGISTER)    // Cursor, color and memory write of one pixel
+#define SPI_BYTES_TEXT              (10 * SPI_BYTES_REGISTER)   // Cursor, color and text mode of a print
+#define SPI_BYTES_CHAR              2               // Each character printed in a ROM font
+#define SPI_BYTES_ROW_PIXEL         2               // Each pixel of a block write
+#define DISPLAY_BENCH_FRAMES        32              // Steady spectrum frames DisplayBenchmark() averages
+#define BENCH_REDRAW                0               // DisplayBench.cpp scenes
+#define BENCH_STATUS_ALL            1
+#define BENCH_STATUS_UNCHANGED      2
+#define BENCH_FREQ_FULL             3
+#define BENCH_FREQ_STEP             4
+#define BENCH_SPECTRUM_FULL         5
+#define BENCH_SPECTRUM_STEADY       6
+#define BENCH_SCENES                7
+#define SPECTRUM_FPS_DEFAULT        20              // Panadapter frames a second, see FramePacer.cpp
+#define WATERFALL_FPS_DEFAULT       0               // Waterfall lines a second, 0 for one every frame
+#define MEMORY_MAP_ENTRY(array, region)   { #array, &(array), sizeof(array), region }
 #define NUMBER_OF_ELEMENTS(x) (sizeof(x)/sizeof(x[0]))  // Typeless way to find number of elements
 #define NEW_SI5351_FREQ_MULT    1UL
 
@@ -251,14 +398,14 @@
 #define EQUALIZER_CELL_COUNT  14
 #define AUDIO_CELL_COUNT      8
 
-#define USE_LOG10FAST
 //#define USE_W7PUA
 #define MP3
 #define TEMPMON_ROOMTEMP 25.0f
 #define ENCODER_DELAY             100L        // Menu options scroll too fast!
 
 //--------------------- decoding stuff
-#define FFT_LENGTH                512
+#define FFT_LENGTH                512         // FFT_length at boot
+#define FFT_LENGTH_MAX            2048        // Largest FFT_length SetConvolution() accepts, sizes the convolution buffers
 #define NOISE_SAMPLE_SIZE         500
 #define SD_MULTIPLIER             3
 #define NOISE_MULTIPLIER          0.5         // Signal must be this many time greater than the noise floor
@@ -657,7 +804,6 @@ extern float32_t HP_DC_Filter_Coeffs2[];  // AFP 11-02-22
 #define DISPLAY_S_METER_DBM         0
 #define DISPLAY_S_METER_DBMHZ       1
 #define NB_FFT_SIZE                 FFT_LENGTH/2
-#define TABLE_SIZE_64               64
 #define EEPROM_BASE_ADDRESS         0U
 
 
@@ -670,9 +816,7 @@ extern float32_t sinBuffer[];    //AFP 02-02-22
 extern float32_t sinBuffer2[];
 extern float32_t sinBuffer3[];
 extern float32_t sinBuffer4[];
-extern float32_t float_Corr_Buffer[];   //AFP 02-02-22
 extern float32_t aveCorrResult;   //AFP 02-02-22
-extern float32_t magFFTResults[];
 extern long tempSigTime;
 extern int audioTemp;
 extern int audioTempPrevious;
@@ -698,12 +842,12 @@ extern uint32_t corrResultIndexL;  //AFP 02-02-22
 extern float32_t aveCorrResult;   //AFP 02-02-22
 extern float32_t aveCorrResultR;   //AFP 02-06-22
 extern float32_t aveCorrResultL;   //AFP 02-06-22
-extern float32_t float_Corr_BufferR[];   //AFP 02-06-22
-extern float32_t float_Corr_BufferL[];   //AFP 02-06-22
 extern float32_t combinedCoeff;//AFP 02-06-22
 extern int CWCoeffLevelOld;
 extern float CWLevelTimer;
 extern float CWLevelTimerOld;
+extern int cwLockState;
+extern int cwLockPosted;
 extern float32_t combinedCoeff2;
 extern float32_t combinedCoeff2Old;
 extern float ticMarkTimer;
@@ -773,18 +917,17 @@ extern long last_filter_pos;
 
 #define IIR_ORDER 8
 #define IIR_NUMSTAGES (IIR_ORDER / 2)
+#define EQ_MASK                     2               // receiveEQFlag besides ON and OFF: receive EQ folded into the filter mask
+#define FILTER_SHIFT                2               // switchFilterSideband besides 0 and 1: the filter encoder shifts the passband
+#define IF_SHIFT_MAX                2000            // Hz either way, see MaskShift()
 
 extern arm_biquad_cascade_df2T_instance_f32   s1_Receive ;  //AFP 09-23-22
-extern arm_biquad_cascade_df2T_instance_f32   s1_Receive2 ;  //AFP 11-02-22
-extern float32_t HP_DC_Butter_state2[2];                     //AFP 11-04-22
+extern float32_t dcBlockStateI[];
+extern float32_t dcBlockStateQ[];
 extern float32_t HP_DC_Butter_state[6];                     //AFP 09-23-22
 
-extern float32_t coeffs192K_10K_LPF_FIR[];
-
-extern float32_t coeffs48K_8K_LPF_FIR[];
 extern const uint32_t N_B_EX;
 extern float32_t recEQ_Level[];
-extern float32_t recEQ_LevelScale[];
 
 extern float32_t EQ_Band1Coeffs[];
 extern float32_t EQ_Band2Coeffs[];
@@ -803,35 +946,7 @@ extern float32_t EQ_Band14Coeffs[];
 
 
 //Setup for EQ filters
-extern float32_t rec_EQ_Band1_state[] ;
-extern float32_t rec_EQ_Band2_state[] ;
-extern float32_t rec_EQ_Band3_state[] ;
-extern float32_t rec_EQ_Band4_state[] ;
-extern float32_t rec_EQ_Band5_state[] ;
-extern float32_t rec_EQ_Band6_state[] ;
-extern float32_t rec_EQ_Band7_state[] ;
-extern float32_t rec_EQ_Band8_state[] ;
-extern float32_t rec_EQ_Band9_state[] ;
-extern float32_t rec_EQ_Band10_state[] ;
-extern float32_t rec_EQ_Band11_state[] ;
-extern float32_t rec_EQ_Band12_state[] ;
-extern float32_t rec_EQ_Band13_state[] ;
-extern float32_t rec_EQ_Band14_state[] ;
-
-extern float32_t rec_EQ1_float_buffer_L[];
-extern float32_t rec_EQ2_float_buffer_L[];
-extern float32_t rec_EQ3_float_buffer_L[];
-extern float32_t rec_EQ4_float_buffer_L[];
-extern float32_t rec_EQ5_float_buffer_L[];
-extern float32_t rec_EQ6_float_buffer_L[];
-extern float32_t rec_EQ7_float_buffer_L[];
-extern float32_t rec_EQ8_float_buffer_L[];
-extern float32_t rec_EQ9_float_buffer_L[];
-extern float32_t rec_EQ10_float_buffer_L[];
-extern float32_t rec_EQ11_float_buffer_L[];
-extern float32_t rec_EQ12_float_buffer_L[];
-extern float32_t rec_EQ13_float_buffer_L[];
-extern float32_t rec_EQ14_float_buffer_L[];
+
 
 extern float32_t FIR_Hilbert_coeffs90[];
 extern float32_t FIR_Hilbert_coeffs0[];
@@ -885,53 +1000,11 @@ extern float EQBand13Scale;
 extern float EQBand14Scale;
 
 //EQ filter instances
-extern arm_biquad_cascade_df2T_instance_f32 S1_Rec ;
-extern arm_biquad_cascade_df2T_instance_f32 S2_Rec ;
-extern arm_biquad_cascade_df2T_instance_f32 S3_Rec ;
-extern arm_biquad_cascade_df2T_instance_f32 S4_Rec ;
-extern arm_biquad_cascade_df2T_instance_f32 S5_Rec ;
-extern arm_biquad_cascade_df2T_instance_f32 S6_Rec ;
-extern arm_biquad_cascade_df2T_instance_f32 S7_Rec ;
-extern arm_biquad_cascade_df2T_instance_f32 S8_Rec ;
-extern arm_biquad_cascade_df2T_instance_f32 S9_Rec ;
-extern arm_biquad_cascade_df2T_instance_f32 S10_Rec ;
-extern arm_biquad_cascade_df2T_instance_f32 S11_Rec ;
-extern arm_biquad_cascade_df2T_instance_f32 S12_Rec ;
-extern arm_biquad_cascade_df2T_instance_f32 S13_Rec ;
-extern arm_biquad_cascade_df2T_instance_f32 S14_Rec ;
 
 // ================= start  AFP 10-02-22 ===========
-extern arm_biquad_cascade_df2T_instance_f32 S1_Xmt ;
-extern arm_biquad_cascade_df2T_instance_f32 S2_Xmt ;
-extern arm_biquad_cascade_df2T_instance_f32 S3_Xmt ;
-extern arm_biquad_cascade_df2T_instance_f32 S4_Xmt ;
-extern arm_biquad_cascade_df2T_instance_f32 S5_Xmt ;
-extern arm_biquad_cascade_df2T_instance_f32 S6_Xmt ;
-extern arm_biquad_cascade_df2T_instance_f32 S7_Xmt ;
-extern arm_biquad_cascade_df2T_instance_f32 S8_Xmt ;
-extern arm_biquad_cascade_df2T_instance_f32 S9_Xmt ;
-extern arm_biquad_cascade_df2T_instance_f32 S10_Xmt ;
-extern arm_biquad_cascade_df2T_instance_f32 S11_Xmt ;
-extern arm_biquad_cascade_df2T_instance_f32 S12_Xmt ;
-extern arm_biquad_cascade_df2T_instance_f32 S13_Xmt ;
-extern arm_biquad_cascade_df2T_instance_f32 S14_Xmt ;
 
 extern float32_t xmtEQ_Level[];
 
-extern float32_t xmt_EQ1_float_buffer_L [];
-extern float32_t xmt_EQ2_float_buffer_L [];
-extern float32_t xmt_EQ3_float_buffer_L[];
-extern float32_t xmt_EQ4_float_buffer_L [];
-extern float32_t xmt_EQ5_float_buffer_L [];
-extern float32_t xmt_EQ6_float_buffer_L [];
-extern float32_t xmt_EQ7_float_buffer_L [];
-extern float32_t xmt_EQ8_float_buffer_L [];
-extern float32_t xmt_EQ9_float_buffer_L [];
-extern float32_t xmt_EQ10_float_buffer_L [];
-extern float32_t xmt_EQ11_float_buffer_L [];
-extern float32_t xmt_EQ12_float_buffer_L [];
-extern float32_t xmt_EQ13_float_buffer_L [];
-extern float32_t xmt_EQ14_float_buffer_L [];
 
 // ================= end  AFP 10-02-22 ===========
 
@@ -990,37 +1063,13 @@ extern float32_t FIR_CW_DecodeL_state [];  //AFP 10-25-22
 extern float32_t FIR_CW_DecodeR_state [];  //AFP 10-25-22
 
 
-extern arm_fir_decimate_instance_f32 FIR_dec1_EX_I;
-extern arm_fir_decimate_instance_f32 FIR_dec1_EX_Q;
-extern arm_fir_decimate_instance_f32 FIR_dec2_EX_I;
-extern arm_fir_decimate_instance_f32 FIR_dec2_EX_Q;
 
-extern arm_fir_interpolate_instance_f32 FIR_int1_EX_I;
-extern arm_fir_interpolate_instance_f32 FIR_int1_EX_Q;
-extern arm_fir_interpolate_instance_f32 FIR_int2_EX_I;
-extern arm_fir_interpolate_instance_f32 FIR_int2_EX_Q;
 
 
-extern float32_t FIR_dec1_EX_I_state[];    //48 + (uint16_t) BUFFER_SIZE * (uint32_t) N_B - 1
-extern float32_t FIR_dec1_EX_Q_state[];
-//extern float32_t  FIR_dec2_EX_coeffs[];    //n_dec1_taps
 
-extern float32_t  FIR_dec2_EX_I_state[];     //DEC2STATESIZE
-//extern float32_t  FIR_dec2_EX_coeffs[];
-extern float32_t  FIR_dec2_EX_Q_state[];
-
-extern float32_t  FIR_int2_EX_I_state[];
-extern float32_t  FIR_int2_EX_Q_state[];
-extern float32_t  FIR_int1_EX_coeffs[];
-extern float32_t  FIR_int2_EX_coeffs[];
-
-extern float32_t  FIR_int1_EX_I_state[];
-extern float32_t  FIR_int1_EX_Q_state[];
 
 extern float32_t  float_buffer_L_EX[];
 extern float32_t  float_buffer_R_EX[];
-extern float32_t  float_buffer_LTemp[];
-extern float32_t  float_buffer_RTemp[];
 
 void ExciterIQData();
 
@@ -1034,14 +1083,12 @@ extern long NCOFreq ; // AFP 04-16-22
 //extern double stepFT2;
 extern unsigned long stepFT;
 extern unsigned long stepFT2;
-extern float32_t NCO_INC ;  // AFP 04-16-22
-extern double OSC_COS;
-extern double  OSC_SIN;
-extern double  Osc_Vect_Q;
-extern double  Osc_Vect_I ;
-extern double  Osc_Gain ;
-extern double  Osc_Q ;
-extern double  Osc_I;
+#define NCO_TABLE_BITS              10            // FreqShift2() sine table, 1024 points, spurs below -100 dBc
+#define NCO_TABLE_SIZE              (1 << NCO_TABLE_BITS)
+#define NCO_FRAC_BITS               (32 - NCO_TABLE_BITS)
+#define NCO_AMPLITUDE               1.0722        // 1.1 * sqrt(0.95), the gain of the old recursive oscillator and mixer
+extern uint32_t ncoPhase;
+extern float32_t ncoSinTable[];
 extern float32_t i_temp;
 extern float32_t q_temp;
 //extern float32_t Osc2_Q_buffer [BUFFER_SIZE* N_BLOCKS];
@@ -1216,16 +1263,8 @@ extern arm_biquad_casd_df1_inst_f32 biquad_lowpass1;
 extern arm_biquad_casd_df1_inst_f32 IIR_biquad_Zoom_FFT_I;
 extern arm_biquad_casd_df1_inst_f32 IIR_biquad_Zoom_FFT_Q;
 
-extern arm_fir_decimate_instance_f32 FIR_dec1_I;
-extern arm_fir_decimate_instance_f32 FIR_dec1_Q;
-extern arm_fir_decimate_instance_f32 FIR_dec2_I;
-extern arm_fir_decimate_instance_f32 FIR_dec2_Q;
 extern arm_fir_decimate_instance_f32 Fir_Zoom_FFT_Decimate_I;
 extern arm_fir_decimate_instance_f32 Fir_Zoom_FFT_Decimate_Q;
-extern arm_fir_interpolate_instance_f32 FIR_int1_I;
-extern arm_fir_interpolate_instance_f32 FIR_int1_Q;
-extern arm_fir_interpolate_instance_f32 FIR_int2_I;
-extern arm_fir_interpolate_instance_f32 FIR_int2_Q;
 extern arm_lms_norm_instance_f32 LMS_Norm_instance;
 extern arm_lms_instance_f32      LMS_instance;
 extern elapsedMicros usec;
@@ -1246,6 +1285,133 @@ struct band {
 };
 extern struct band bands[];
 
+struct spectrumFrame {                    // One display refresh worth of DSP output, see SpectrumFramePublish()
+  int16_t pixelnew[SPECTRUM_RES];         // Panadapter, this frame
+  int16_t audioYPixel[AUDIO_SPECTRUM_PIXELS];
+  int16_t pixelPeak[SPECTRUM_RES];        // Hold traces, see Welch.cpp
+  int16_t pixelMin[SPECTRUM_RES];
+  int holdMode;                           // spectrumHoldMode when the frame was made
+  int waterfallLine;                      // 1 if the frame adds a waterfall line, see FramePacer.cpp
+};
+extern struct spectrumFrame spectrumFrames[];
+extern volatile uint32_t spectrumFrameHead;
+extern volatile uint32_t spectrumFrameTail;
+
+struct displayCommand {                   // One queued draw, see DisplayQueue.cpp
+  uint8_t kind;                           // DISPLAY_CMD_ value
+  uint8_t key;                            // DISPLAY_KEY_ value
+  uint16_t color;
+  int16_t x, y, w, h;
+  int32_t value;                          // For the field kinds
+};
+extern struct displayCommand displayQueue[DISPLAY_QUEUE_SIZE];
+extern volatile uint32_t displayQueueHead;
+extern volatile uint32_t displayQueueTail;
+extern volatile uint32_t displayQueueDropped;
+extern uint32_t displayQueueDrawn;
+extern uint32_t displayQueueCoalesced;
+
+struct statusWidget {                     // What one status field shows, see Widgets.cpp
+  int32_t value;                          // WidgetChanged() value or WidgetBar() length
+  int16_t x, y;
+  uint16_t color;
+  uint16_t background;                    // WidgetText() only
+  uint8_t valid;                          // 0 when the screen is not known
+  char text[WIDGET_TEXT_MAX];             // Text fields, padded with spaces
+};
+extern struct statusWidget widgets[WIDGET_COUNT];
+extern uint32_t displaySpiBytes;
+extern uint32_t displaySpiBytesPerSecond;
+extern const char *displayBenchNames[];
+extern const int displayBenchRuns[];
+extern int spectrumTargetFPS;
+extern int waterfallTargetFPS;
+extern volatile uint32_t pacerFramesMade;
+extern volatile uint32_t pacerFramesSkipped;
+extern uint32_t pacerFramesDrawn;
+
+struct memoryMapEntry {                   // One large array for the memory report
+  const char *name;
+  const void *address;
+  uint32_t size;
+  int region;                             // Where it is meant to be, MEM_
+};
+extern const struct memoryMapEntry memoryMap[];
+extern float32_t scratchArena[SCRATCH_ARENA_SIZE];
+extern uint32_t scratchHighWater;
+extern uint32_t scratchFailures;
+extern float32_t maskCachePool[MASK_CACHE_FLOATS];
+extern uint32_t maskCacheHits;
+extern uint32_t maskCacheMisses;
+extern float32_t * volatile filterMask;
+extern float32_t * volatile pendingMask;
+extern float32_t shiftedMasks[3][FFT_LENGTH_MAX * 2];
+extern float32_t minPhaseWork[MIN_PHASE_FFT_MAX * 2];
+extern const char *windowNames[];
+extern const float32_t windowCoefficients[WINDOW_TYPES][WINDOW_TERMS];
+extern int spectrumWindowType;
+extern float32_t spectrumWindow[SPECTRUM_RES];
+extern int spectrumAverageDepth;
+extern int spectrumHoldMode;
+extern volatile int spectrumHoldReset;
+extern float32_t spectrumPeak[SPECTRUM_RES];
+extern float32_t spectrumMinimum[SPECTRUM_RES];
+extern int16_t pixelPeak[SPECTRUM_RES];
+extern int16_t pixelMin[SPECTRUM_RES];
+extern uint32_t spectrumFFTLength;
+extern int spectrumBinning;
+extern uint32_t hiResFill;
+extern float32_t hiResBuffer[HIRES_FFT_MAX * 2];
+extern float32_t hiResWindow[HIRES_FFT_MAX];
+extern uint16_t hiResPixelBin[SPECTRUM_RES];
+extern volatile int spectrumRedrawAll;
+extern int16_t traceTop[MAX_WATERFALL_WIDTH];
+extern int16_t traceBottom[MAX_WATERFALL_WIDTH];
+extern int16_t audioShown[AUDIO_SPECTRUM_PIXELS];
+extern int waterfallScrollTop;
+extern int maskPhase[MASK_PHASE_MODES];
+extern uint8_t lowLatencyMode[NUMBER_OF_BANDS];
+extern int lowLatencyActive;
+extern volatile uint32_t latencyFlushBlocks;
+extern uint32_t normalFFTLength;
+extern uint32_t normalFFTHop;
+extern const int memoryMapCount;
+
+constexpr uint32_t MemoryMapBytes(const struct memoryMapEntry *map, int count, int region)   // Compile-time total for one region
+{
+  return (count == 0) ? 0 : ((map->region == region) ? map->size : 0) + MemoryMapBytes(map + 1, count - 1, region);
+}
+
+#define DEC_STAGES                  3             // Half-band stages, 192 kHz to 24 kHz
+#define DEC_MAX_TAPS                63
+struct halfBandStage {                    // See Decimate.cpp
+  int numTaps;                            // 4k + 3
+  float32_t coeffs[(DEC_MAX_TAPS + 1) / 4];   // Nonzero side taps, nearest the center first
+  float32_t history[2 * (DEC_MAX_TAPS - 1)];  // Last numTaps - 1 inputs, interleaved I/Q
+};
+struct decimator {
+  struct halfBandStage stage[DEC_STAGES];
+  float32_t *work;                        // Interleaved I/Q scratch, 2 * (2048 + DEC_MAX_TAPS)
+};
+struct interpolator {                     // See Interpolate.cpp
+  struct halfBandStage stage[DEC_STAGES];
+  float32_t *work;
+};
+extern struct decimator rxDecimator;
+extern struct decimator txDecimator;
+extern struct interpolator rxInterpolator;
+extern struct interpolator txInterpolator;
+extern float32_t rxResampleWork[2 * (2048 + DEC_MAX_TAPS)];
+extern float32_t txResampleWork[2 * (2048 + DEC_MAX_TAPS)];
+
+struct equalizer {                        // See Equalizer.cpp
+  float32_t coeffs[EQUALIZER_CELL_COUNT][IIR_NUMSTAGES * 5];  // Band biquads, level and sign folded into the first stage
+  float32_t state[EQUALIZER_CELL_COUNT][IIR_NUMSTAGES * 2];
+  int level[EQUALIZER_CELL_COUNT];        // Levels the coefficients were built for
+};
+extern struct equalizer rxEqualizer;
+extern struct equalizer txEqualizer;
+
 typedef struct DEMOD_Descriptor
 { const uint8_t DEMOD_n;
   const char* const text;
@@ -1293,7 +1459,7 @@ extern bool timeflag;
 extern bool volumeChangeFlag;
 
 extern char *bigMorseCodeTree;
-extern char decodeBuffer[];
+extern char decodeBuffer[MAX_DECODE_CHARS + 1];
 extern char keyboardBuffer[];
 extern const char *labels[];
 extern char letterTable[];
@@ -1394,8 +1560,6 @@ extern int16_t fineEncoderRead;
 
 extern int16_t  pixelnew[];
 extern int16_t  pixelold[];
-extern int16_t  pixelnew2[];    //AFP
-extern int16_t  pixelold2[];
 
 extern int16_t notch_L[];
 extern int16_t notch_R[];
@@ -1540,6 +1704,8 @@ extern int out_index;
 extern int paddleDah;
 extern int paddleDit;
 extern int pmode;
+extern int profileDisplayFlag;
+extern const char *profileStageNames[];
 extern int pos_centre_f;
 extern int pos_x_frequency;
 extern int pos_y_smeter;
@@ -1552,6 +1718,7 @@ extern int spectrumNoiseFloor;
 extern int splitOn;
 extern int stepFTOld;
 extern int switchFilterSideband;    //AFP 1-28-21
+extern float32_t passbandShift;
 extern int switchThreshholds[];
 extern int syncEEPROM;
 extern int termCursorXpos;
@@ -1566,9 +1733,6 @@ extern int zoomIndex;
 
 extern int updateDisplayFlag;
 
-extern const int DEC2STATESIZE;
-extern const int INT1_STATE_SIZE;
-extern const int INT2_STATE_SIZE;
 extern const int myInput;
 extern const int pos_x_smeter;
 extern const int waterfallBottom;
@@ -1611,6 +1775,7 @@ extern uint32_t n_para;
 extern uint32_t NR_X_pointer;
 extern uint32_t NR_E_pointer;
 extern uint32_t m_NumTaps;
+extern uint32_t fftHop;
 extern uint32_t roomCount;   /*!< The value of TEMPMON_TEMPSENSE0[TEMP_VALUE] at the hot temperature.*/
 extern uint32_t s_hotTemp;    /*!< The value of TEMPMON_TEMPSENSE0[TEMP_VALUE] at room temperature .*/
 extern uint32_t s_hotCount;   /*!< The value of TEMPMON_TEMPSENSE0[TEMP_VALUE] at the hot temperature.*/
@@ -1642,7 +1807,10 @@ extern long currentWPM;
 extern long incrementValues[];
 extern long lastFrequencies[][2];
 extern long notchCenterBin;
-extern long int n_clear;
+extern volatile uint32_t audioQueueOverflows;
+extern volatile int dspTaskEnabled;
+extern volatile int dspTaskHold;
+extern IntervalTimer dspTimer;
 extern long startTime;
 extern long signalElapsedTime;
 extern long spaceSpan;
@@ -1664,10 +1832,6 @@ extern uint64_t output12khz;
 extern unsigned long long Clk2SetFreq;             // AFP 09-27-22
 extern unsigned long long Clk1SetFreq;             // AFP 09-27-22
 
-float32_t arm_atan2_f32(float32_t y, float32_t x);
-float ApproxAtan(float z);
-float ApproxAtan2(float y, float x);
-
 extern float dcfRefLevel;
 extern float DD4WH_RF_gain;
 extern float s_hotT_ROOM;     /*!< The value of s_hotTemp minus room temperature(25¡æ).*/
@@ -1771,34 +1935,13 @@ extern float32_t FFT_spec_old[];
 extern float32_t fil_out;
 extern float32_t /*DMAMEM*/ FIR_Coef_I[];
 extern float32_t /*DMAMEM*/ FIR_Coef_Q[];
-extern float32_t /*DMAMEM*/ FIR_dec1_I_state[];
-extern float32_t /*DMAMEM*/ FIR_dec2_I_state[];
-extern float32_t /*DMAMEM*/ FIR_dec2_coeffs[];
-extern float32_t /*DMAMEM*/ FIR_dec2_I_state[];
-extern float32_t /*DMAMEM*/ FIR_dec2_Q_state[];
-extern float32_t /*DMAMEM*/ FIR_int2_I_state[];
-extern float32_t /*DMAMEM*/ FIR_int2_Q_state[];
-extern float32_t /*DMAMEM*/ FIR_int1_coeffs[];
-extern float32_t /*DMAMEM*/ FIR_int2_coeffs[];
-extern float32_t /*DMAMEM*/ FIR_dec1_Q_state[];
-extern float32_t /*DMAMEM*/ FIR_dec1_coeffs[];
-extern float32_t /*DMAMEM*/ FIR_dec2_coeffs[];
-extern float32_t /*DMAMEM*/ FIR_filter_mask[];
-extern float32_t /*DMAMEM*/ FIR_int1_I_state[];
-extern float32_t /*DMAMEM*/ FIR_int1_Q_state[];
-extern float32_t /*DMAMEM*/ FIR_int2_I_state[];
-extern float32_t /*DMAMEM*/ FIR_int2_Q_state[];
 extern float32_t /*DMAMEM*/ Fir_Zoom_FFT_Decimate_I_state[];
 extern float32_t /*DMAMEM*/ Fir_Zoom_FFT_Decimate_Q_state[];
 extern float32_t /*DMAMEM*/ Fir_Zoom_FFT_Decimate_coeffs[];
 extern float32_t fixed_gain;
 extern float32_t float_buffer_L[];
 extern float32_t float_buffer_R[];
-extern float32_t float_buffer_L_CW[]; //AFP 09-01-22
-extern float32_t float_buffer_R_CW[]; //AFP 09-01-22
 extern float32_t float_buffer_R_AudioCW[]; //AFP 10-18-22
-extern float32_t float_buffer_L2[];
-extern float32_t float_buffer_R2[];
 extern float32_t float_buffer_R_AudioCW[]; //AFP 10-18-22
 extern float32_t float_buffer_L_AudioCW[]; //AFP 10-18-22
 
@@ -1812,7 +1955,6 @@ extern float32_t hang_level;
 extern float32_t hangtime;
 extern float32_t hh1;
 extern float32_t hh2;
-extern float32_t /*DMAMEM*/ iFFT_buffer[];
 extern float32_t I_old;
 extern float32_t I_sum;
 extern float32_t IIR_biquad_Zoom_FFT_I_state[];
@@ -1838,7 +1980,6 @@ extern float32_t K_est_mult;
 extern float32_t last_dc_level;
 extern float32_t /*DMAMEM*/ last_sample_buffer_L[];
 extern float32_t /*DMAMEM*/ last_sample_buffer_R[];
-extern float32_t L_BufferOffset[];
 extern float32_t LPFcoeff;
 extern float32_t LMS_errsig1[];
 extern float32_t LMS_NormCoeff_f32[];
@@ -1904,6 +2045,7 @@ extern float32_t NR_SNR_prio[];
 extern float32_t NR_SNR_post[];
 extern float32_t NR_SNR_post_pos;
 extern float32_t NR_Hk_old[];
+extern float32_t nrHannWindow[NR_FFT_L];
 extern float32_t NR_VAD;
 extern float32_t NR_VAD_thresh;
 extern float32_t NR_long_tone[][2];
@@ -1932,7 +2074,6 @@ extern float32_t powerOutCW[];          // Sets the drive to PA AFP 10-21-22
 extern float32_t powerOutSSB[];         //AFP 10-21-22
 extern float32_t Q_old;
 extern float32_t Q_sum;
-extern float32_t R_BufferOffset[];
 extern float32_t ring[];
 extern float32_t ring_max;
 extern float32_t SAM_carrier;              // AFP 11-02-22
@@ -1988,15 +2129,11 @@ extern float xExpand;//AFP
 extern float x;
 
 extern const float displayscale;
-extern const float32_t nuttallWindow256[];
 extern const float32_t sqrtHann[];
 
 extern float32_t FFT_buffer [] __attribute__ ((aligned (4)));
+extern float32_t convOutput[];
 
-extern float32_t float_buffer_L_3[];
-extern float32_t float_buffer_R_3[];
-
-extern const float32_t atanTable[];
 extern const float32_t DF1;           // decimation factor
 extern const float32_t DF2;           // decimation factor
 extern const float32_t DF;            // decimation factor
@@ -2019,6 +2156,8 @@ void AGC();
 int  AGCOptions();
 void AGCPrep();
 float32_t AlphaBetaMag(float32_t  inphase, float32_t  quadrature);
+void AlphaBetaMagBlock(const float32_t *iq, float32_t *out, uint32_t count);
+int  AudioBarDraw(int x1, int bar);
 void AltNoiseBlanking(float* insamp, int Nsam, float* E);
 void AMDemodAM();
 void AMDecodeSAM(); // AFP 11-03-22
@@ -2055,14 +2194,30 @@ void ClearEEPROM();
 void Codec_gain();
 uint16_t Color565(uint8_t r, uint8_t g, uint8_t b);
 void ControlFilterF();
+void ControlPassbandShift();
+const arm_cfft_instance_f32 *ConvolutionFFT(uint32_t length);
 void CopyEEPROM();
 int  CWOptions();
 void CW_DecodeLevelDisplay();
 void CW_ExciterIQData();  // AFP 08-18-22
 void Dah();
+void Decimate(struct decimator *dec, float32_t *I_buffer, float32_t *Q_buffer, uint32_t blockSize);
 void DecodeIQ();
 void DisplayClock();
+int  DisplayQueueDrain();
+int  DisplayQueueFillRect(uint8_t key, int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+int  DisplayQueuePost(const struct displayCommand *command);
+void DisplayQueuePrintReport();
+int  DisplayQueueValue(uint8_t kind, uint8_t key, int32_t value);
 void DisplaydbM();
+void DisplayBenchDraw(int scene);
+void DisplayBenchFinish(int scene);
+void DisplayBenchmark();
+int  DisplayBenchPrepare(int scene);
+void DisplayBenchStatus();
+void DisplayInvalidate();
+void DisplaySpiCount(uint32_t bytes);
+void DisplaySpiTick();
 void DisplayDitLength();
 void Dit();
 void DoCWDecoding(int audioValue);
@@ -2086,6 +2241,12 @@ void DrawNormalLetter(int row, int horizontalSpacer, int whichLetterIndex, int k
 void DrawSMeterContainer();
 void DrawSpectrumBandwidthInfo();
 void DrawSpectrumDisplayContainer();
+void Equalize(struct equalizer *eq, const int *level, float32_t *buffer, uint32_t blockSize);
+void EqualizerApplyToTaps(struct equalizer *eq, const int *level, float32_t *tapsI, float32_t *tapsQ, uint32_t numTaps);
+float32_t EqualizerMagnitude(const struct equalizer *eq, float32_t w);
+void EqualizerSetLevels(struct equalizer *eq, const int *level);
+int  DSPTaskRunning();
+void DSPTimerISR();
 void DrawAudioSpectContainer();
 
 int  EEPROMOptions();
@@ -2109,6 +2270,14 @@ void EraseSecondaryMenu();
 void EraseSpectrumDisplayContainer();
 void ExecuteButtonPress(int val);
 
+float32_t FastAtan2(float32_t y, float32_t x);
+float32_t FastExp(float32_t x);
+void FastLog10Block(const float32_t *in, float32_t *out, float32_t scale, uint32_t count);
+float32_t FastLog2(float32_t x);
+void FastMathCheck();
+void FastMathCheckLine(const char *name, float32_t error, uint32_t fastCycles, uint32_t libmCycles);
+void FastSinCos(float32_t phase, float32_t *sine, float32_t *cosine);
+
 void FilterBandwidth();
 void FilterOverlay();
 void FilterSetSSB();
@@ -2124,15 +2293,34 @@ int  GetEncoderValue(int minValue, int maxValue, int startValue, int increment,
 float GetEncoderValueLive(float minValue, float maxValue, float startValue, float increment, char prompt[]);//AFP 10-22-22
 void GetFavoriteFrequency();
 
+void HalfBandDecimate(struct halfBandStage *stage, float32_t *work, float32_t *I_in, float32_t *Q_in, float32_t *I_out, float32_t *Q_out, uint32_t blockSize);
+void HalfBandInterpolate(struct halfBandStage *stage, float32_t *work, float32_t *I_in, float32_t *Q_in, float32_t *I_out, float32_t *Q_out, uint32_t blockSize);
+int  HalfBandInterpolateLoad(struct halfBandStage *stage, float32_t *work, float32_t *I_in, float32_t *Q_in, uint32_t blockSize);
+float32_t HalfBandChainDelay(const struct halfBandStage *stage, float32_t rate, int interpolator);
+int  HalfBandTaps(float32_t att, float32_t passband, float32_t rate);
+int  HighResSpectrum(uint32_t blockSize);
+void HighResWindowBuild();
 double HaversineDistance(double hLat, double hLon, double dxLat, double dxLon);
 
 int  InitializeSDCard();
+void IngestIQBlock(const int16_t *I_in, const int16_t *Q_in, uint32_t stride, float32_t *I_out, float32_t *Q_out, uint32_t blockSize, float32_t gainI, float32_t gainQ);
+void InitEqualizer(struct equalizer *eq);
+void InitDecimator(struct decimator *dec, float32_t *work, float32_t att, float32_t passband, float32_t rate);
+void InitHalfBandStage(struct halfBandStage *stage, int numTaps, float32_t att);
 void InitializeDataArrays();
-void InitFilterMask();
+void InitInterpolator(struct interpolator *interp, float32_t *work, float32_t att, float32_t passband, float32_t rate);
+void InitFilterMask(float32_t *mask);
 void InitLMSNoiseReduction();
+void InitNCOTable();
+int  InitIQReplay();
 void initTempMon(uint16_t freq, uint32_t lowAlarmTemp, uint32_t highAlarmTemp, uint32_t panicAlarmTemp);
 int  IQOptions();
+void Interpolate(struct interpolator *interp, float32_t *I_buffer, float32_t *Q_buffer, uint32_t blockSize);
+void InterpolateOutput(struct interpolator *interp, float32_t *I_in, float32_t *Q_in, int16_t *I_out, int16_t *Q_out, uint32_t blockSize, float32_t gain);
 void IQPhaseCorrection(float32_t *I_buffer, float32_t *Q_buffer, float32_t factor, uint32_t blocksize);
+int16_t *IQReplayRead(uint32_t blocksize);
+void IQReplayService();
+void IQReplayWriteAudio(int16_t *L_buffer, int16_t *R_buffer, uint32_t blocksize);
 float32_t Izero(float32_t x);
 
 void JackClusteredArrayMax(int32_t *array, int32_t elements, int32_t *maxCount, int32_t *maxIndex, int32_t *firstDit, int32_t spread);
@@ -2142,11 +2330,26 @@ void KeyOn();
 void KeyRingOn();
 void KeyTipOn();
 
+void LatencyPrintReport();
 void LetterSpace();
 void LMSNoiseReduction(int16_t blockSize, float32_t *nrbuffer);
 float32_t log10f_fast(float32_t X);
+void LowLatencyUpdate();
+int  LowLatencyWanted();
 
 void MainTune();
+void MaskCacheInit();
+float32_t *MaskCacheLookup(int loCut, int hiCut, uint32_t rate);
+float32_t MaskBinHz();
+float32_t MaskDelaySamples(const float32_t *mask);
+float32_t *MaskFadeBegin(float32_t *spectrum);
+void MaskMinimumPhase(float32_t *mask);
+int  MaskPhaseIndex();
+float32_t *MaskShift(float32_t *base, float32_t shiftHz);
+void MaskFadeEnd(const float32_t *oldOutput, float32_t *newOutput);
+int  MemoryMapCheck();
+void MemoryMapReport();
+int  MemoryRegion(const void *address);
 int  MicOptions();
 int  ModeOptions();
 void MorseCharacterDisplay(char currentLetter);
@@ -2160,9 +2363,27 @@ int  NROptions();
 
 //int  PostProcessorAudio();
 int  ProcessButtonPress(int valPin);
+float32_t PassbandShiftHz();
+float32_t ReceiveLatencyMs(float32_t *parts);
 void ProcessEqualizerChoices(int EQType, char *title);
 void ProcessIQData();
 void ProcessIQData2();
+void PacerFrameDrawn(uint32_t drawMicros, int waterfallLine);
+int  PacerFrameMade();
+void PacerPrintReport();
+void PacerReset();
+void ProfileBlockAbandon();
+void ProfileBlockEnd();
+void ProfileBlockStart();
+int  ProfileHeaviestStage();
+void ProfileInit();
+void ProfileMark();
+void ProfilePrintReport();
+void ProfileReset();
+void ProfileSerialCommand();
+void ProfileStage(int stage);
+float ProfileStageMicros(int stage);
+float ProfileStageLoad(int stage);
 
 uint16_t read16(File &f);
 uint32_t read32(File &f);
@@ -2187,20 +2408,30 @@ void SDEEPROMDump();
 int  CopySDToEEPROM();
 int  SDEEPROMWriteDefaults();
 int  CopyEEPROMToSD();
+float32_t *ScratchAlloc(uint32_t count);
+uint32_t ScratchMark();
+void ScratchRelease(uint32_t mark);
 void Send(char myChar);
 void SendCode(char code);
 void SelectCWFilter();  // AFP 10-18-22
 extern "C" uint32_t set_arm_clock(uint32_t frequency);
 void SetBand();
 void SetBandRelay(int state);
+int  SetConvolution(uint32_t length, uint32_t hop);
+int  SetReceiveChain(uint32_t blocks, uint32_t length, uint32_t hop);
 void SetDecIntFilters();
 void SetDitLength(int wpm);
 void SetFavoriteFrequency();
+void SetFrameRates(int spectrumFPS, int waterfallFPS);
 void SetFreq();
 int  SetI2SFreq(int freq);
 void SetIIRCoeffs(float32_t f0, float32_t Q, float32_t sample_rate, uint8_t filter_type);
 void SetKeyType();
 void SetSidetoneVolume();
+void SetSpectrumResolution(uint32_t length);
+void SetSpectrumWindow(int type);
+void SpectrumHoldDraw(const struct spectrumFrame *frame, int x1, int clearTop, int clearBottom, int traceTop, int traceBottom);
+void SpectrumHoldUpdate(const float32_t *spectrum);
 long SetTransmitDelay();
 void SetupMode(int sideBand);
 void SetupMyCompressors(boolean use_HP_filter, float knee_dBFS, float comp_ratio, float attack_sec, float release_sec); //AFP 11-01-22 in DSP.cpp
@@ -2219,25 +2450,35 @@ extern "C"
   void sincosf(float err, float *s, float *c);
   void sincos(double err, double *s, double *c);
 }
+void ShowDecodedText();
 void ShowFrequency();
 void ShowMenu(const char *menu[], int where);
 void ShowName();
 void ShowNotch();
+void ShowSAMOffset(int32_t offsetTenths);
 void ShowSpectrum();
 void ShowSpectrum2();
 void ShowSpectrumdBScale();
 void ShowTempAndLoad();
 void ShowTransmitReceiveStatus();
+void ShowWPMEstimate(long wpm);
 void BandInformation();
 float32_t sign(float32_t x);
 void sineTone(long freqSideTone);
 void SpectralNoiseReduction(void);
 void SpectralNoiseReductionInit();
+struct spectrumFrame *SpectrumFrameGet();
+int  SpectrumFrameDue(uint32_t blockSamples);
+int  SpectrumFrameFree();
+void SpectrumFramePublish();
+void SpectrumFrameRelease();
+void SpectrumRunDraw(const struct spectrumFrame *frame, int start, int end, int drawTrace);
 void Splash();
 void SubFineTune();
 int  SubmenuSelect(const char *options[], int numberOfChoices, int defaultStart);
 
 void T4_rtc_set(unsigned long t);
+void TraceRows(const int16_t *pixelnew, int x1, int16_t *top, int16_t *bottom);
 float TGetTemp();
 
 int  Unused1();                            // Placeholders for array of pointers to function
@@ -2245,8 +2486,10 @@ int  Unused2();
 int  Unused3();
 void UpdateAGCField();
 void UpdateCompressionField();
+void UpdateDecodeDisplay();
 void UpdateDecoderField();
 void UpdateEEPROMVersionNumber();
+void UpdateFineTuneDisplay();
 void UpdateIncrementField();
 void UpdateNoiseField();
 void UpdateNotchField();
@@ -2264,6 +2507,21 @@ void WordSpace();
 void writeClippedRect(int x, int y, int cx, int cy, uint16_t *pixels, bool waitForWRC);
 inline void writeRect(int x, int y, int cx, int cy, uint16_t *pixels);
 
+void WaterfallAddLine(uint16_t *line);
+void WaterfallScrollInit();
+void WaterfallScrollReset();
+void WelchSpectrum(uint32_t blockSize);
+void WidgetBar(int id, int x, int y, int maxLength, int height, int length, uint16_t color);
+int  WidgetChanged(int id, int32_t value);
+void WidgetFontText(int id, int x, int y, int chars, const GFXfont *font, int eraseTop, int eraseHeight, uint16_t color, const char *text);
+void WidgetForget(int id);
+int  WidgetNextRun(const char *shown, const char *field, int chars, int *start, int *end);
+void WidgetPad(char *field, const char *text, int chars);
+int  WidgetText(int id, int x, int y, int chars, uint16_t color, uint16_t background, const char *text);
+int  WidgetValid(int id);
+void WidgetsInvalidate();
+void WindowBuild(float32_t *window, uint32_t length, int type);
+
 void Xanr();
 int  Xmit_IQ_Cal(); //AFP 09-21-22
 
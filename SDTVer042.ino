@@ -297,6 +297,7 @@ int switchThreshholds[] = { 921, 867, 818,
                             124, 64, 5 };
 
 uint32_t FFT_length = FFT_LENGTH;
+uint32_t fftHop = FFT_LENGTH / 2;                 // New samples per overlap-save FFT, see SetConvolution()
 
 extern "C" uint32_t set_arm_clock(uint32_t frequency);
 
@@ -430,112 +431,16 @@ SPISettings settingsA(70000000UL, MSBFIRST, SPI_MODE1);
 
 const uint32_t N_B_EX = 16;
 //================== Receive EQ Variables================= AFP 08-08-22
-float32_t recEQ_Level[14];
-float32_t recEQ_LevelScale[14];
-//Setup for EQ filters
-float32_t rec_EQ1_float_buffer_L[256];
-float32_t rec_EQ2_float_buffer_L[256];
-float32_t rec_EQ3_float_buffer_L[256];
-float32_t rec_EQ4_float_buffer_L[256];
-float32_t rec_EQ5_float_buffer_L[256];
-float32_t rec_EQ6_float_buffer_L[256];
-float32_t rec_EQ7_float_buffer_L[256];
-float32_t rec_EQ8_float_buffer_L[256];
-float32_t rec_EQ9_float_buffer_L[256];
-float32_t rec_EQ10_float_buffer_L[256];
-float32_t rec_EQ11_float_buffer_L[256];
-float32_t rec_EQ12_float_buffer_L[256];
-float32_t rec_EQ13_float_buffer_L[256];
-float32_t rec_EQ14_float_buffer_L[256];
-
-float32_t xmt_EQ1_float_buffer_L[256];
-float32_t xmt_EQ2_float_buffer_L[256];
-float32_t xmt_EQ3_float_buffer_L[256];
-float32_t xmt_EQ4_float_buffer_L[256];
-float32_t xmt_EQ5_float_buffer_L[256];
-float32_t xmt_EQ6_float_buffer_L[256];
-float32_t xmt_EQ7_float_buffer_L[256];
-float32_t xmt_EQ8_float_buffer_L[256];
-float32_t xmt_EQ9_float_buffer_L[256];
-float32_t xmt_EQ10_float_buffer_L[256];
-float32_t xmt_EQ11_float_buffer_L[256];
-float32_t xmt_EQ12_float_buffer_L[256];
-float32_t xmt_EQ13_float_buffer_L[256];
-float32_t xmt_EQ14_float_buffer_L[256];
-
-float32_t rec_EQ_Band1_state[IIR_NUMSTAGES * 2] = { 0, 0, 0, 0, 0, 0, 0, 0 };  //declare and zero biquad state variables
-float32_t rec_EQ_Band2_state[IIR_NUMSTAGES * 2] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-float32_t rec_EQ_Band3_state[IIR_NUMSTAGES * 2] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-float32_t rec_EQ_Band4_state[IIR_NUMSTAGES * 2] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-float32_t rec_EQ_Band5_state[IIR_NUMSTAGES * 2] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-float32_t rec_EQ_Band6_state[IIR_NUMSTAGES * 2] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-float32_t rec_EQ_Band7_state[IIR_NUMSTAGES * 2] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-float32_t rec_EQ_Band8_state[IIR_NUMSTAGES * 2] = { 0, 0, 0, 0, 0, 0, 0, 0 };  //declare and zero biquad state variables
-float32_t rec_EQ_Band9_state[IIR_NUMSTAGES * 2] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-float32_t rec_EQ_Band10_state[IIR_NUMSTAGES * 2] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-float32_t rec_EQ_Band11_state[IIR_NUMSTAGES * 2] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-float32_t rec_EQ_Band12_state[IIR_NUMSTAGES * 2] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-float32_t rec_EQ_Band13_state[IIR_NUMSTAGES * 2] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-float32_t rec_EQ_Band14_state[IIR_NUMSTAGES * 2] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-
-//EQ filter instances
-arm_biquad_cascade_df2T_instance_f32 S1_Rec = { IIR_NUMSTAGES, rec_EQ_Band1_state, EQ_Band1Coeffs };
-arm_biquad_cascade_df2T_instance_f32 S2_Rec = { IIR_NUMSTAGES, rec_EQ_Band2_state, EQ_Band2Coeffs };
-arm_biquad_cascade_df2T_instance_f32 S3_Rec = { IIR_NUMSTAGES, rec_EQ_Band3_state, EQ_Band3Coeffs };
-arm_biquad_cascade_df2T_instance_f32 S4_Rec = { IIR_NUMSTAGES, rec_EQ_Band4_state, EQ_Band4Coeffs };
-arm_biquad_cascade_df2T_instance_f32 S5_Rec = { IIR_NUMSTAGES, rec_EQ_Band5_state, EQ_Band5Coeffs };
-arm_biquad_cascade_df2T_instance_f32 S6_Rec = { IIR_NUMSTAGES, rec_EQ_Band6_state, EQ_Band6Coeffs };
-arm_biquad_cascade_df2T_instance_f32 S7_Rec = { IIR_NUMSTAGES, rec_EQ_Band7_state, EQ_Band7Coeffs };
-arm_biquad_cascade_df2T_instance_f32 S8_Rec = { IIR_NUMSTAGES, rec_EQ_Band8_state, EQ_Band8Coeffs };
-arm_biquad_cascade_df2T_instance_f32 S9_Rec = { IIR_NUMSTAGES, rec_EQ_Band9_state, EQ_Band9Coeffs };
-arm_biquad_cascade_df2T_instance_f32 S10_Rec = { IIR_NUMSTAGES, rec_EQ_Band10_state, EQ_Band10Coeffs };
-arm_biquad_cascade_df2T_instance_f32 S11_Rec = { IIR_NUMSTAGES, rec_EQ_Band11_state, EQ_Band11Coeffs };
-arm_biquad_cascade_df2T_instance_f32 S12_Rec = { IIR_NUMSTAGES, rec_EQ_Band12_state, EQ_Band12Coeffs };
-arm_biquad_cascade_df2T_instance_f32 S13_Rec = { IIR_NUMSTAGES, rec_EQ_Band13_state, EQ_Band13Coeffs };
-arm_biquad_cascade_df2T_instance_f32 S14_Rec = { IIR_NUMSTAGES, rec_EQ_Band14_state, EQ_Band14Coeffs };
+float32_t recEQ_Level[14];                        // Band filters are in Equalizer.cpp
 
 // ===============================  AFP 10-02-22 ================
 //Setup for Xmit EQ filters
 float32_t xmtEQ_Level[14];
-//EQBuffers
-
-float32_t xmt_EQ_Band1_state[IIR_NUMSTAGES * 2] = { 0, 0, 0, 0, 0, 0, 0, 0 };  //declare and zero biquad state variables
-float32_t xmt_EQ_Band2_state[IIR_NUMSTAGES * 2] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-float32_t xmt_EQ_Band3_state[IIR_NUMSTAGES * 2] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-float32_t xmt_EQ_Band4_state[IIR_NUMSTAGES * 2] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-float32_t xmt_EQ_Band5_state[IIR_NUMSTAGES * 2] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-float32_t xmt_EQ_Band6_state[IIR_NUMSTAGES * 2] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-float32_t xmt_EQ_Band7_state[IIR_NUMSTAGES * 2] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-float32_t xmt_EQ_Band8_state[IIR_NUMSTAGES * 2] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-float32_t xmt_EQ_Band9_state[IIR_NUMSTAGES * 2] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-float32_t xmt_EQ_Band10_state[IIR_NUMSTAGES * 2] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-float32_t xmt_EQ_Band11_state[IIR_NUMSTAGES * 2] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-float32_t xmt_EQ_Band12_state[IIR_NUMSTAGES * 2] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-float32_t xmt_EQ_Band13_state[IIR_NUMSTAGES * 2] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-float32_t xmt_EQ_Band14_state[IIR_NUMSTAGES * 2] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-
-//EQ filter instances
-arm_biquad_cascade_df2T_instance_f32 S1_Xmt = { IIR_NUMSTAGES, xmt_EQ_Band1_state, EQ_Band1Coeffs };
-arm_biquad_cascade_df2T_instance_f32 S2_Xmt = { IIR_NUMSTAGES, xmt_EQ_Band2_state, EQ_Band2Coeffs };
-arm_biquad_cascade_df2T_instance_f32 S3_Xmt = { IIR_NUMSTAGES, xmt_EQ_Band3_state, EQ_Band3Coeffs };
-arm_biquad_cascade_df2T_instance_f32 S4_Xmt = { IIR_NUMSTAGES, xmt_EQ_Band4_state, EQ_Band4Coeffs };
-arm_biquad_cascade_df2T_instance_f32 S5_Xmt = { IIR_NUMSTAGES, xmt_EQ_Band5_state, EQ_Band5Coeffs };
-arm_biquad_cascade_df2T_instance_f32 S6_Xmt = { IIR_NUMSTAGES, xmt_EQ_Band6_state, EQ_Band6Coeffs };
-arm_biquad_cascade_df2T_instance_f32 S7_Xmt = { IIR_NUMSTAGES, xmt_EQ_Band7_state, EQ_Band7Coeffs };
-arm_biquad_cascade_df2T_instance_f32 S8_Xmt = { IIR_NUMSTAGES, xmt_EQ_Band8_state, EQ_Band8Coeffs };
-arm_biquad_cascade_df2T_instance_f32 S9_Xmt = { IIR_NUMSTAGES, xmt_EQ_Band9_state, EQ_Band9Coeffs };
-arm_biquad_cascade_df2T_instance_f32 S10_Xmt = { IIR_NUMSTAGES, xmt_EQ_Band10_state, EQ_Band10Coeffs };
-arm_biquad_cascade_df2T_instance_f32 S11_Xmt = { IIR_NUMSTAGES, xmt_EQ_Band11_state, EQ_Band11Coeffs };
-arm_biquad_cascade_df2T_instance_f32 S12_Xmt = { IIR_NUMSTAGES, xmt_EQ_Band12_state, EQ_Band12Coeffs };
-arm_biquad_cascade_df2T_instance_f32 S13_Xmt = { IIR_NUMSTAGES, xmt_EQ_Band13_state, EQ_Band13Coeffs };
-arm_biquad_cascade_df2T_instance_f32 S14_Xmt = { IIR_NUMSTAGES, xmt_EQ_Band14_state, EQ_Band14Coeffs };
 // ===============================End xmit EQ filter setup  AFP 10-02-22 ================
 
 // HP BiQuad IIR DC filter
 float32_t HP_DC_Butter_state[6] = { 0, 0, 0, 0, 0, 0 };
-float32_t HP_DC_Butter_state2[2] = { 0, 0 };                                                          // AFP 11-04-11
 arm_biquad_cascade_df2T_instance_f32 s1_Receive = { 3, HP_DC_Butter_state, HP_DC_Filter_Coeffs };     //AFP 09-23-22
-arm_biquad_cascade_df2T_instance_f32 s1_Receive2 = { 1, HP_DC_Butter_state2, HP_DC_Filter_Coeffs2 };  //AFP 11-04-22
 //Hilbert FIR Filters
 float32_t FIR_Hilbert_state_L[100 + 256 - 1];
 float32_t FIR_Hilbert_state_R[100 + 256 - 1];
@@ -549,36 +454,10 @@ float32_t FIR_CW_DecodeL_state[64 + 256 - 1];
 float32_t FIR_CW_DecodeR_state[64 + 256 - 1];
 
 //Decimation and Interpolation Filters
-arm_fir_decimate_instance_f32 FIR_dec1_EX_I;
-arm_fir_decimate_instance_f32 FIR_dec1_EX_Q;
-arm_fir_decimate_instance_f32 FIR_dec2_EX_I;
-arm_fir_decimate_instance_f32 FIR_dec2_EX_Q;
-
-arm_fir_interpolate_instance_f32 FIR_int1_EX_I;
-arm_fir_interpolate_instance_f32 FIR_int1_EX_Q;
-arm_fir_interpolate_instance_f32 FIR_int2_EX_I;
-arm_fir_interpolate_instance_f32 FIR_int2_EX_Q;
-
-float32_t DMAMEM FIR_dec1_EX_I_state[2095];
-float32_t DMAMEM FIR_dec1_EX_Q_state[2095];
-
 float32_t audioMaxSquaredAve;
 
-float32_t DMAMEM FIR_dec2_EX_I_state[535];
-float32_t DMAMEM FIR_dec2_EX_Q_state[535];
-
-float32_t DMAMEM FIR_int2_EX_I_state[519];
-float32_t DMAMEM FIR_int2_EX_Q_state[519];
-float32_t DMAMEM FIR_int1_EX_coeffs[48];
-float32_t DMAMEM FIR_int2_EX_coeffs[48];
-
-float32_t DMAMEM FIR_int1_EX_I_state[279];
-float32_t DMAMEM FIR_int1_EX_Q_state[279];
-
 float32_t DMAMEM float_buffer_L_EX[2048];
 float32_t DMAMEM float_buffer_R_EX[2048];
-float32_t DMAMEM float_buffer_LTemp[2048];
-float32_t DMAMEM float_buffer_RTemp[2048];
 //==================== End Excite Variables================================
 
 //======================================== Global structure declarations ===============================================
@@ -634,16 +513,8 @@ arm_biquad_casd_df1_inst_f32 biquad_lowpass1;
 arm_biquad_casd_df1_inst_f32 IIR_biquad_Zoom_FFT_I;
 arm_biquad_casd_df1_inst_f32 IIR_biquad_Zoom_FFT_Q;
 
-arm_fir_decimate_instance_f32 FIR_dec1_I;
-arm_fir_decimate_instance_f32 FIR_dec1_Q;
-arm_fir_decimate_instance_f32 FIR_dec2_I;
-arm_fir_decimate_instance_f32 FIR_dec2_Q;
 arm_fir_decimate_instance_f32 Fir_Zoom_FFT_Decimate_I;
 arm_fir_decimate_instance_f32 Fir_Zoom_FFT_Decimate_Q;
-arm_fir_interpolate_instance_f32 FIR_int1_I;
-arm_fir_interpolate_instance_f32 FIR_int1_Q;
-arm_fir_interpolate_instance_f32 FIR_int2_I;
-arm_fir_interpolate_instance_f32 FIR_int2_Q;
 arm_lms_norm_instance_f32 LMS_Norm_instance;
 arm_lms_instance_f32 LMS_instance;
 
@@ -673,15 +544,8 @@ int stepFTOld = 0;
 unsigned long stepFT = 50UL;
 unsigned long stepFT2 = 50UL;
 
-float32_t NCO_INC;
-
-double OSC_COS;
-double OSC_SIN;
-double Osc_Vect_Q = 1.0;
-double Osc_Vect_I = 0.0;
-double Osc_Gain = 0.0;
-double Osc_Q = 0.0;
-double Osc_I = 0.0;
+uint32_t ncoPhase = 0;                          // FreqShift2() phase accumulator, 2^32 = one cycle
+float32_t ncoSinTable[NCO_TABLE_SIZE + NCO_TABLE_SIZE / 4 + 1];   // Sine plus a quarter cycle for cosine plus one guard point
 float32_t i_temp = 0.0;
 float32_t q_temp = 0.0;
 
@@ -691,18 +555,16 @@ float32_t q_temp = 0.0;
 //================== Global CW Correlation and FFT Variables =================
 float32_t corrResult;
 uint32_t corrResultIndex;
-float32_t cosBuffer2[256];
-float32_t cosBuffer3[256];
-float32_t cosBuffer4[256];
-float32_t sinBuffer[256];
-float32_t sinBuffer2[256];
-float32_t sinBuffer3[256];
-float32_t sinBuffer4[256];
+float32_t DMAMEM cosBuffer2[256];
+float32_t DMAMEM cosBuffer3[256];
+float32_t DMAMEM cosBuffer4[256];
+float32_t DMAMEM sinBuffer[256];
+float32_t DMAMEM sinBuffer2[256];
+float32_t DMAMEM sinBuffer3[256];
+float32_t DMAMEM sinBuffer4[256];
 float32_t aveCorrResult;
 float32_t aveCorrResultR;
 float32_t aveCorrResultL;
-float32_t magFFTResults[256];
-float32_t float_Corr_Buffer[511];
 float32_t corrResultR;
 uint32_t corrResultIndexR;
 float32_t corrResultL;
@@ -713,6 +575,8 @@ float32_t combinedCoeff2Old;
 int CWCoeffLevelOld = 0.0;
 float CWLevelTimer = 0.0;
 float CWLevelTimerOld = 0.0;
+int cwLockState = 0;                            // CW decode lock indicator, DSP task only
+int cwLockPosted = 0;                           // Lock state last sent to the display queue
 float ticMarkTimer = 0.0;
 float ticMarkTimerOld = 0.0;
 // === Compressor patameters AFP 11-01-22
@@ -721,8 +585,6 @@ float gain_dB = 0.0;                            //computed desired gain value in
 boolean use_HP_filter = true;                   //enable the software HP filter to get rid of DC?
 float knee_dBFS, comp_ratio, attack_sec, release_sec;
 // ===========
-float32_t float_Corr_BufferR[511];
-float32_t float_Corr_BufferL[511];
 long tempSigTime = 0;
 
 int audioTemp = 0;
@@ -810,7 +672,7 @@ int ASCIIForPunctuation[] = { 33, 34, 36, 39, 41, 44, 45, 46, 47, 58, 59, 63, 95
 long startTime = 0;
 
 char theversion[10];
-char decodeBuffer[30];    // The buffer for holding the decoded characters
+char decodeBuffer[MAX_DECODE_CHARS + 1];    // The buffer for holding the decoded characters, and its terminator
 char keyboardBuffer[10];  // Set for call prefixes. May be increased later
 
 char *bigMorseCodeTree = (char *)"-EISH5--4--V---3--UF--------?-2--ARL---------.--.WP------J---1--TNDB6--.--X/-----KC------Y------MGZ7----,Q------O-8------9--0----";
@@ -921,8 +783,6 @@ int16_t activeVFO;
 int16_t currentMode;
 int16_t pixelnew[SPECTRUM_RES];
 int16_t pixelold[SPECTRUM_RES];
-int16_t pixelnew2[MAX_WATERFALL_WIDTH + 1];  //AFP
-int16_t pixelold2[MAX_WATERFALL_WIDTH];
 int16_t notch_L[2] = { 156, 180 };
 int16_t fineEncoderRead;
 int16_t notch_R[2] = { 166, 190 };
@@ -1145,6 +1005,11 @@ int out_index = -1;
 int paddleDah = KEYER_DAH_INPUT_RING;
 int paddleDit = KEYER_DIT_INPUT_TIP;
 int pmode = 1;
+#ifdef DEBUG1
+int profileDisplayFlag = 1;                       // Show temperature, load and heaviest DSP stage on screen
+#else
+int profileDisplayFlag = 0;
+#endif
 int pos_centre_f = 64;
 int pos_x_frequency = 12;
 int pos_y_smeter = (spectrum_y - 12);
@@ -1156,6 +1021,7 @@ int smeterLength;
 int spectrumNoiseFloor = SPECTRUM_NOISE_FLOOR;
 int splitOn;
 int switchFilterSideband = 0;
+float32_t passbandShift = 0.0;  // Hz of audio pitch, see ControlPassbandShift()
 
 int syncEEPROM;
 
@@ -1168,12 +1034,16 @@ int zoomIndex = 1;                 //AFP 9-26-22
 int tuneIndex = DEFAULTFREQINDEX;  //AFP 2-10-21
 int wtf;
 int updateDisplayFlag = 1;
+volatile int dspTaskEnabled = 1;                  // Cleared while the calibration screens run their own receive loop
+volatile int dspTaskHold = 0;                     // DSPNoInterrupts() nesting, the DSP task skips its tick while not 0
+volatile uint32_t audioQueueOverflows = 0;        // Times the receive queues backed up and were cleared
+volatile uint32_t spectrumFrameHead = 0;          // Written only by the DSP task
+volatile uint32_t spectrumFrameTail = 0;          // Written only by ShowSpectrum()
+DMAMEM struct spectrumFrame spectrumFrames[SPECTRUM_FRAME_COUNT];
+IntervalTimer dspTimer;
 int xrState = RECEIVE_STATE;;       // Is the T41 in xmit or rec state? 1 = rec, 0 = xmt
 
 const int BW_indicator_y = SPECTRUM_TOP_Y + SPECTRUM_HEIGHT + 2;
-const int DEC2STATESIZE = n_dec2_taps + (BUFFER_SIZE * N_B / (uint32_t)DF1) - 1;
-const int INT1_STATE_SIZE = 24 + BUFFER_SIZE * N_B / (uint32_t)DF - 1;
-const int INT2_STATE_SIZE = 8 + BUFFER_SIZE * N_B / (uint32_t)DF1 - 1;
 const int myInput = AUDIO_INPUT_LINEIN;
 const int pos_x_smeter = 11;
 const int waterfallBottom = spectrum_y + spectrum_height + 4;
@@ -1232,7 +1102,6 @@ long favoriteFrequencies[13];
 
 //long frequencyCorrection;
 long incrementValues[] = { 10, 50, 100, 250, 1000, 10000, 100000, 1000000 };
-long int n_clear;
 long lastFrequencies[NUMBER_OF_BANDS][2];
 long notchPosOld;
 long notchFreq = 1000;
@@ -1327,7 +1196,7 @@ float32_t dbm_old = -145.0;
 float32_t dbmhz = -145.0;
 float32_t decay_mult;
 float32_t display_offset;
-float32_t DMAMEM FFT_buffer[FFT_LENGTH * 2] __attribute__((aligned(4)));
+float32_t FFT_buffer[FFT_LENGTH_MAX * 2] __attribute__((aligned(4)));   // Overlap-save window, transformed, filtered and back in place
 float32_t DMAMEM FFT_spec[1024];
 float32_t DMAMEM FFT_spec_old[1024];
 float32_t dsI;
@@ -1337,34 +1206,15 @@ float32_t fast_backmult;
 float32_t fast_decay_mult;
 
 
-float32_t DMAMEM FIR_Coef_I[(FFT_LENGTH / 2) + 1];
-float32_t DMAMEM FIR_Coef_Q[(FFT_LENGTH / 2) + 1];
-float32_t DMAMEM FIR_dec1_I_state[n_dec1_taps + (uint16_t)BUFFER_SIZE * (uint32_t)N_B - 1];
-float32_t DMAMEM FIR_dec2_I_state[DEC2STATESIZE];
-float32_t DMAMEM FIR_dec2_coeffs[n_dec2_taps];
-float32_t DMAMEM FIR_dec2_Q_state[DEC2STATESIZE];
-float32_t DMAMEM FIR_int2_I_state[INT2_STATE_SIZE];
-float32_t DMAMEM FIR_int2_Q_state[INT2_STATE_SIZE];
-float32_t DMAMEM FIR_int1_coeffs[48];
-float32_t DMAMEM FIR_int2_coeffs[32];
-float32_t DMAMEM FIR_dec1_Q_state[n_dec1_taps + (uint16_t)BUFFER_SIZE * (uint16_t)N_B - 1];
-float32_t DMAMEM FIR_dec1_coeffs[n_dec1_taps];
-float32_t DMAMEM FIR_filter_mask[FFT_LENGTH * 2] __attribute__((aligned(4)));
-float32_t DMAMEM FIR_int1_I_state[INT1_STATE_SIZE];
-float32_t DMAMEM FIR_int1_Q_state[INT1_STATE_SIZE];
+float32_t DMAMEM FIR_Coef_I[FFT_LENGTH_MAX];    // m_NumTaps = FFT_length - fftHop + 1 taps
+float32_t DMAMEM FIR_Coef_Q[FFT_LENGTH_MAX];
 float32_t DMAMEM Fir_Zoom_FFT_Decimate_I_state[4 + BUFFER_SIZE * N_B - 1];
 float32_t DMAMEM Fir_Zoom_FFT_Decimate_Q_state[4 + BUFFER_SIZE * N_B - 1];
 float32_t DMAMEM Fir_Zoom_FFT_Decimate_coeffs[4];
 float32_t fixed_gain = 1.0;
-float32_t DMAMEM float_buffer_L[BUFFER_SIZE * N_B];
-float32_t DMAMEM float_buffer_R[BUFFER_SIZE * N_B];
-float32_t DMAMEM float_buffer_L2[BUFFER_SIZE * N_B];
-float32_t DMAMEM float_buffer_R2[BUFFER_SIZE * N_B];
-float32_t float_buffer_L_3[BUFFER_SIZE * N_B];
-float32_t float_buffer_R_3[BUFFER_SIZE * N_B];
-
-float32_t DMAMEM float_buffer_L_CW[256];       //AFP 09-01-22
-float32_t DMAMEM float_buffer_R_CW[256];       //AFP 09-01-22
+float32_t float_buffer_L[BUFFER_SIZE * N_B];
+float32_t float_buffer_R[BUFFER_SIZE * N_B];
+
 float32_t DMAMEM float_buffer_R_AudioCW[256];  //AFP 10-18-22
 float32_t DMAMEM float_buffer_L_AudioCW[256];  //AFP 10-18-22
 float32_t hang_backaverage;
@@ -1375,7 +1225,7 @@ float32_t hang_level;
 float32_t hangtime;
 float32_t hh1 = 0.0;
 float32_t hh2 = 0.0;
-float32_t DMAMEM iFFT_buffer[FFT_LENGTH * 2 + 1];
+float32_t convOutput[2 * BUFFER_SIZE * N_DEC_B];  // Filtered I/Q block, interleaved, for AGC and demodulation
 float32_t I_old = 0.2;
 float32_t I_sum;
 float32_t IIR_biquad_Zoom_FFT_I_state[IIR_biquad_Zoom_FFT_N_stages * 4];
@@ -1394,9 +1244,8 @@ float32_t K_est = 1.0;
 float32_t K_est_old = 0.0;
 float32_t K_est_mult = 1.0 / K_est;
 float32_t last_dc_level = 0.0f;
-float32_t DMAMEM last_sample_buffer_L[BUFFER_SIZE * N_DEC_B];
-float32_t DMAMEM last_sample_buffer_R[BUFFER_SIZE * N_DEC_B];
-float32_t DMAMEM L_BufferOffset[BUFFER_SIZE * N_B];
+float32_t DMAMEM last_sample_buffer_L[FFT_LENGTH_MAX];    // FFT_length - fftHop samples of overlap
+float32_t DMAMEM last_sample_buffer_R[FFT_LENGTH_MAX];
 float32_t LMS_errsig1[256 + 10];
 float32_t LMS_NormCoeff_f32[MAX_LMS_TAPS + MAX_LMS_DELAY];
 float32_t LMS_nr_delay[512 + MAX_LMS_DELAY];
@@ -1515,7 +1364,6 @@ float32_t CWPowerCalibrationFactor[7] = { 0.019, 0.0190, .0190, .0190, .0190, .0
 float32_t SSBPowerCalibrationFactor[7] = { 0.008, 0.008, 0.008, 0.008, 0.008, 0.008, 0.008 };  //AFP 10-29-22       = 0.008;  //AFP 10-21-22
 float32_t Q_old = 0.2;
 float32_t Q_sum;
-float32_t DMAMEM R_BufferOffset[BUFFER_SIZE * N_B];
 float32_t ring[RB_SIZE * 2];
 float32_t ring_max = 0.0;
 float32_t sidetoneVolume = 0.001;
@@ -1566,7 +1414,7 @@ float temp;
 float xExpand = 1.5;  //
 float x;
 
-const float32_t sqrtHann[256] = {
+const float32_t sqrtHann[256] PROGMEM = {
   0, 0.01231966, 0.024637449, 0.036951499, 0.049259941, 0.061560906,
   0.073852527, 0.086132939, 0.098400278, 0.110652682, 0.122888291, 0.135105247, 0.147301698,
   0.159475791, 0.171625679, 0.183749518, 0.195845467, 0.207911691, 0.219946358, 0.231947641, 0.24391372,
@@ -1853,61 +1701,41 @@ void InitializeDataArrays() {
   memset(FFT_spec_old, 0, SPECTRUM_RES * sizeof(FFT_spec_old[0]));
   memset(pixelnew, 0, SPECTRUM_RES * sizeof(pixelold[0]));
   memset(pixelold, 0, SPECTRUM_RES * sizeof(pixelold[0]));
-  memset(pixelold, 0, SPECTRUM_RES * sizeof(buffer_spec_FFT[0]));
   memset(FFT_spec, 0, SPECTRUM_RES * 2 * sizeof(FFT_spec[0]));
   memset(NR_FFT_buffer, 0, NR_FFT_L * sizeof(NR_FFT_buffer[0]));
-  memset(NR_output_audio_buffer, 0, NR_FFT_L * sizeof(NR_output_audio_buffer[0]));
-  memset(NR_last_iFFT_result, 0, NR_FFT_L * sizeof(NR_last_iFFT_result[0]));
-  memset(NR_last_sample_buffer_L, 0, NR_FFT_L * sizeof(NR_last_sample_buffer_L[0]));
-  memset(NR_last_sample_buffer_R, 0, NR_FFT_L * sizeof(NR_last_sample_buffer_R[0]));
-  memset(NR_M, 0, NR_FFT_L * sizeof(NR_M[0]));
-  memset(NR_lambda, 0, NR_FFT_L * sizeof(NR_lambda[0]));
-  memset(NR_G, 0, NR_FFT_L * sizeof(NR_G[0]));
-  memset(NR_SNR_prio, 0, NR_FFT_L * sizeof(NR_SNR_prio[0]));
-  memset(NR_SNR_post, 0, NR_FFT_L * sizeof(NR_SNR_post[0]));
-  memset(NR_Hk_old, 0, NR_FFT_L * sizeof(NR_Hk_old[0]));
-  memset(NR_X, 0, NR_FFT_L / 2 * 3 * sizeof(NR_X[0]));
-  memset(NR_Nest, 0, NR_FFT_L / 2 * 2 * sizeof(NR_Nest[0]));
-  memset(NR_Gts, 0, NR_FFT_L / 2 * 2 * sizeof(NR_Gts[0]));
-  memset(NR_E, 0, NR_FFT_L / 2 * NR_N_frames * sizeof(NR_E[0]));
+  memset(NR_output_audio_buffer, 0, sizeof(NR_output_audio_buffer));
+  memset(NR_last_iFFT_result, 0, sizeof(NR_last_iFFT_result));
+  memset(NR_last_sample_buffer_L, 0, sizeof(NR_last_sample_buffer_L));
+  memset(NR_last_sample_buffer_R, 0, sizeof(NR_last_sample_buffer_R));
+  memset(NR_M, 0, sizeof(NR_M));
+  memset(NR_lambda, 0, sizeof(NR_lambda));
+  memset(NR_G, 0, sizeof(NR_G));
+  memset(NR_SNR_prio, 0, sizeof(NR_SNR_prio));
+  memset(NR_SNR_post, 0, sizeof(NR_SNR_post));
+  memset(NR_Hk_old, 0, sizeof(NR_Hk_old));
+  memset(NR_X, 0, sizeof(NR_X));
+  memset(NR_Nest, 0, sizeof(NR_Nest));
+  memset(NR_Gts, 0, sizeof(NR_Gts));
+  memset(NR_E, 0, sizeof(NR_E));
   memset(ANR_d, 0, ANR_DLINE_SIZE * sizeof(ANR_d[0]));
   memset(ANR_w, 0, ANR_DLINE_SIZE * sizeof(ANR_w[0]));
   memset(LMS_StateF32, 0, (MAX_LMS_TAPS + MAX_LMS_DELAY) * sizeof(LMS_StateF32[0]));
   memset(LMS_NormCoeff_f32, 0, (MAX_LMS_TAPS + MAX_LMS_DELAY) * sizeof(LMS_NormCoeff_f32[0]));
   memset(LMS_nr_delay, 0, (512 + MAX_LMS_DELAY) * sizeof(LMS_nr_delay[0]));
 
-  CalcCplxFIRCoeffs(FIR_Coef_I, FIR_Coef_Q, m_NumTaps, (float32_t)bands[currentBand].FLoCut, (float32_t)bands[currentBand].FHiCut, (float)SR[SampleRate].rate / DF);
-
   /****************************************************************************************
      init complex FFTs
   ****************************************************************************************/
-  switch (FFT_length) {
-    case 2048:
-      S = &arm_cfft_sR_f32_len2048;
-      iS = &arm_cfft_sR_f32_len2048;
-      maskS = &arm_cfft_sR_f32_len2048;
-      break;
-    case 1024:
-      S = &arm_cfft_sR_f32_len1024;
-      iS = &arm_cfft_sR_f32_len1024;
-      maskS = &arm_cfft_sR_f32_len1024;
-      break;
-    case 512:
-      S = &arm_cfft_sR_f32_len512;
-      iS = &arm_cfft_sR_f32_len512;
-      maskS = &arm_cfft_sR_f32_len512;
-      break;
-  }
+  S = ConvolutionFFT(FFT_length);
+  iS = S;
+  maskS = S;
+
+  InitNCOTable();
 
   spec_FFT = &arm_cfft_sR_f32_len512;  //Changed specification to 512 instance
   NR_FFT = &arm_cfft_sR_f32_len256;
   NR_iFFT = &arm_cfft_sR_f32_len256;
 
-  /****************************************************************************************
-     Calculate the FFT of the FIR filter coefficients once to produce the FIR filter mask
-  ****************************************************************************************/
-  InitFilterMask();
-
   /****************************************************************************************
      Set sample rate
   ****************************************************************************************/
@@ -1941,70 +1769,22 @@ void InitializeDataArrays() {
   /****************************************************************************************
      Initiate decimation and interpolation FIR filters
   ****************************************************************************************/
-  // Decimation filter 1, M1 = DF1
-  //    CalcFIRCoeffs(FIR_dec1_coeffs, 25, (float32_t)5100.0, 80, 0, 0.0, (float32_t)SR[SampleRate].rate);
-  CalcFIRCoeffs(FIR_dec1_coeffs, n_dec1_taps, (float32_t)(n_desired_BW * 1000.0), n_att, 0, 0.0, (float32_t)SR[SampleRate].rate);
-
-  if (arm_fir_decimate_init_f32(&FIR_dec1_I, n_dec1_taps, (uint32_t)DF1, FIR_dec1_coeffs, FIR_dec1_I_state, BUFFER_SIZE * N_BLOCKS)) {
-    while (1)
-      ;
-  }
-
-  if (arm_fir_decimate_init_f32(&FIR_dec1_Q, n_dec1_taps, (uint32_t)DF1, FIR_dec1_coeffs, FIR_dec1_Q_state, BUFFER_SIZE * N_BLOCKS)) {
-    while (1)
-      ;
-  }
-
-  // Decimation filter 2, M2 = DF2
-  CalcFIRCoeffs(FIR_dec2_coeffs, n_dec2_taps, (float32_t)(n_desired_BW * 1000.0), n_att, 0, 0.0, (float32_t)(SR[SampleRate].rate / DF1));
-  if (arm_fir_decimate_init_f32(&FIR_dec2_I, n_dec2_taps, (uint32_t)DF2, FIR_dec2_coeffs, FIR_dec2_I_state, BUFFER_SIZE * N_BLOCKS / (uint32_t)DF1)) {
-    while (1)
-      ;
-  }
-
-  if (arm_fir_decimate_init_f32(&FIR_dec2_Q, n_dec2_taps, (uint32_t)DF2, FIR_dec2_coeffs, FIR_dec2_Q_state, BUFFER_SIZE * N_BLOCKS / (uint32_t)DF1)) {
-    while (1)
-      ;
-  }
+  // Decimation and interpolation by 8 in three half-band stages, passband n_desired_BW
+  InitDecimator(&rxDecimator, rxResampleWork, n_att, n_desired_BW * 1000.0, (float32_t)SR[SampleRate].rate);
+  InitInterpolator(&rxInterpolator, rxResampleWork, n_att, n_desired_BW * 1000.0, (float32_t)SR[SampleRate].rate);
+  InitEqualizer(&rxEqualizer);
 
-  // Interpolation filter 1, L1 = 2
-  // not sure whether I should design with the final sample rate ??
-  // yes, because the interpolation filter is AFTER the upsampling, so it has to be in the target sample rate!
-  //    CalcFIRCoeffs(FIR_int1_coeffs, 8, (float32_t)5000.0, 80, 0, 0.0, 12000);
-  //    CalcFIRCoeffs(FIR_int1_coeffs, 16, (float32_t)(n_desired_BW * 1000.0), n_att, 0, 0.0, SR[SampleRate].rate / 4.0);
-  CalcFIRCoeffs(FIR_int1_coeffs, 48, (float32_t)(n_desired_BW * 1000.0), n_att, 0, 0.0, SR[SampleRate].rate / 4.0);
-  //    if(arm_fir_interpolate_init_f32(&FIR_int1_I, (uint32_t)DF2, 16, FIR_int1_coeffs, FIR_int1_I_state, BUFFER_SIZE * N_BLOCKS / (uint32_t)DF)) {
-  if (arm_fir_interpolate_init_f32(&FIR_int1_I, (uint8_t)DF2, 48, FIR_int1_coeffs, FIR_int1_I_state, BUFFER_SIZE * N_BLOCKS / (uint32_t)DF)) {
-    while (1)
-      ;
-  }
-  //    if(arm_fir_interpolate_init_f32(&FIR_int1_Q, (uint32_t)DF2, 16, FIR_int1_coeffs, FIR_int1_Q_state, BUFFER_SIZE * N_BLOCKS / (uint32_t)DF)) {
-  if (arm_fir_interpolate_init_f32(&FIR_int1_Q, (uint8_t)DF2, 48, FIR_int1_coeffs, FIR_int1_Q_state, BUFFER_SIZE * N_BLOCKS / (uint32_t)DF)) {
-    while (1)
-      ;
-  }
-  // Interpolation filter 2, L2 = 4
-  // not sure whether I should design with the final sample rate ??
-  // yes, because the interpolation filter is AFTER the upsampling, so it has to be in the target sample rate!
-  //    CalcFIRCoeffs(FIR_int2_coeffs, 4, (float32_t)5000.0, 80, 0, 0.0, 24000);
-  //    CalcFIRCoeffs(FIR_int2_coeffs, 16, (float32_t)(n_desired_BW * 1000.0), n_att, 0, 0.0, (float32_t)SR[SampleRate].rate);
-  CalcFIRCoeffs(FIR_int2_coeffs, 32, (float32_t)(n_desired_BW * 1000.0), n_att, 0, 0.0, (float32_t)SR[SampleRate].rate);
-
-  if (arm_fir_interpolate_init_f32(&FIR_int2_I, (uint8_t)DF1, 32, FIR_int2_coeffs, FIR_int2_I_state, BUFFER_SIZE * N_BLOCKS / (uint32_t)DF1)) {
-    while (1)
-      ;
-  }
-  //    if(arm_fir_interpolate_init_f32(&FIR_int2_Q, (uint32_t)DF1, 16, FIR_int2_coeffs, FIR_int2_Q_state, BUFFER_SIZE * N_BLOCKS / (uint32_t)DF1)) {
-  if (arm_fir_interpolate_init_f32(&FIR_int2_Q, (uint8_t)DF1, 32, FIR_int2_coeffs, FIR_int2_Q_state, BUFFER_SIZE * N_BLOCKS / (uint32_t)DF1)) {
-    while (1)
-      ;
-  }
+  /****************************************************************************************
+     Build the FIR filter masks for the band passbands, needs maskS and rxEqualizer
+  ****************************************************************************************/
+  MaskCacheInit();
 
   SetDecIntFilters();  // here, the correct bandwidths are calculated and set accordingly
 
   /****************************************************************************************
      Zoom FFT: Initiate decimation and interpolation FIR filters AND IIR filters
   ****************************************************************************************/
+  SetSpectrumWindow(WINDOW_HANN);
   float32_t Fstop_Zoom = 0.5 * (float32_t)SR[SampleRate].rate / (1 << spectrum_zoom);
 
   CalcFIRCoeffs(Fir_Zoom_FFT_Decimate_coeffs, 4, Fstop_Zoom, 60, 0, 0.0, (float32_t)SR[SampleRate].rate);
@@ -2095,6 +1875,78 @@ void Splash() {
   tft.fillWindow(RA8875_BLACK);
 }
 
+// Large arrays and the region each is meant to be in, for MemoryMapReport(). Hot per-sample state and
+// the receive working buffers stay in DTCM; buffers touched once a block or less are DMAMEM.
+constexpr struct memoryMapEntry memoryMap[] = {       // constexpr so the DTCM total can be checked at compile time
+  MEMORY_MAP_ENTRY(float_buffer_L, MEM_DTCM),
+  MEMORY_MAP_ENTRY(float_buffer_R, MEM_DTCM),
+  MEMORY_MAP_ENTRY(FFT_buffer, MEM_DTCM),
+  MEMORY_MAP_ENTRY(convOutput, MEM_DTCM),
+  MEMORY_MAP_ENTRY(audioSpectBuffer, MEM_DTCM),
+  MEMORY_MAP_ENTRY(ncoSinTable, MEM_DTCM),
+  MEMORY_MAP_ENTRY(FIR_Hilbert_state_L, MEM_DTCM),
+  MEMORY_MAP_ENTRY(FIR_Hilbert_state_R, MEM_DTCM),
+  MEMORY_MAP_ENTRY(FIR_CW_DecodeL_state, MEM_DTCM),
+  MEMORY_MAP_ENTRY(FIR_CW_DecodeR_state, MEM_DTCM),
+  MEMORY_MAP_ENTRY(ring, MEM_DTCM),
+  MEMORY_MAP_ENTRY(LMS_nr_delay, MEM_DTCM),
+  MEMORY_MAP_ENTRY(ANR_d, MEM_DTCM),
+  MEMORY_MAP_ENTRY(ANR_w, MEM_DTCM),
+  MEMORY_MAP_ENTRY(scratchArena, MEM_DTCM),
+  MEMORY_MAP_ENTRY(rxDecimator, MEM_DTCM),
+  MEMORY_MAP_ENTRY(txDecimator, MEM_DTCM),
+  MEMORY_MAP_ENTRY(rxInterpolator, MEM_DTCM),
+  MEMORY_MAP_ENTRY(txInterpolator, MEM_DTCM),
+  MEMORY_MAP_ENTRY(rxEqualizer, MEM_DTCM),
+  MEMORY_MAP_ENTRY(txEqualizer, MEM_DTCM),
+
+  MEMORY_MAP_ENTRY(rxResampleWork, MEM_OCRAM),
+  MEMORY_MAP_ENTRY(txResampleWork, MEM_OCRAM),
+  MEMORY_MAP_ENTRY(float_buffer_L_EX, MEM_OCRAM),
+  MEMORY_MAP_ENTRY(float_buffer_R_EX, MEM_OCRAM),
+  MEMORY_MAP_ENTRY(float_buffer_L_AudioCW, MEM_OCRAM),
+  MEMORY_MAP_ENTRY(float_buffer_R_AudioCW, MEM_OCRAM),
+  MEMORY_MAP_ENTRY(sinBuffer, MEM_OCRAM),
+  MEMORY_MAP_ENTRY(sinBuffer2, MEM_OCRAM),
+  MEMORY_MAP_ENTRY(sinBuffer3, MEM_OCRAM),
+  MEMORY_MAP_ENTRY(sinBuffer4, MEM_OCRAM),
+  MEMORY_MAP_ENTRY(cosBuffer2, MEM_OCRAM),
+  MEMORY_MAP_ENTRY(cosBuffer3, MEM_OCRAM),
+  MEMORY_MAP_ENTRY(cosBuffer4, MEM_OCRAM),
+  MEMORY_MAP_ENTRY(FFT_spec, MEM_OCRAM),
+  MEMORY_MAP_ENTRY(FFT_spec_old, MEM_OCRAM),
+  MEMORY_MAP_ENTRY(buffer_spec_FFT, MEM_OCRAM),
+  MEMORY_MAP_ENTRY(FIR_Coef_I, MEM_OCRAM),
+  MEMORY_MAP_ENTRY(FIR_Coef_Q, MEM_OCRAM),
+  MEMORY_MAP_ENTRY(maskCachePool, MEM_OCRAM),
+  MEMORY_MAP_ENTRY(shiftedMasks, MEM_OCRAM),
+  MEMORY_MAP_ENTRY(minPhaseWork, MEM_OCRAM),
+  MEMORY_MAP_ENTRY(spectrumWindow, MEM_OCRAM),
+  MEMORY_MAP_ENTRY(spectrumPeak, MEM_OCRAM),
+  MEMORY_MAP_ENTRY(spectrumMinimum, MEM_OCRAM),
+  MEMORY_MAP_ENTRY(hiResBuffer, MEM_OCRAM),
+  MEMORY_MAP_ENTRY(hiResWindow, MEM_OCRAM),
+  MEMORY_MAP_ENTRY(Fir_Zoom_FFT_Decimate_I_state, MEM_OCRAM),
+  MEMORY_MAP_ENTRY(Fir_Zoom_FFT_Decimate_Q_state, MEM_OCRAM),
+  MEMORY_MAP_ENTRY(last_sample_buffer_L, MEM_OCRAM),
+  MEMORY_MAP_ENTRY(last_sample_buffer_R, MEM_OCRAM),
+  MEMORY_MAP_ENTRY(abs_ring, MEM_OCRAM),
+  MEMORY_MAP_ENTRY(NR_FFT_buffer, MEM_OCRAM),
+  MEMORY_MAP_ENTRY(NR_output_audio_buffer, MEM_OCRAM),
+  MEMORY_MAP_ENTRY(NR_X, MEM_OCRAM),
+  MEMORY_MAP_ENTRY(NR_E, MEM_OCRAM),
+  MEMORY_MAP_ENTRY(nrHannWindow, MEM_OCRAM),
+  MEMORY_MAP_ENTRY(spectrumFrames, MEM_OCRAM),
+  MEMORY_MAP_ENTRY(gapHistogram, MEM_OCRAM),
+  MEMORY_MAP_ENTRY(signalHistogram, MEM_OCRAM),
+
+  MEMORY_MAP_ENTRY(sqrtHann, MEM_FLASH)
+};
+const int memoryMapCount = NUMBER_OF_ELEMENTS(memoryMap);
+
+static_assert(MemoryMapBytes(memoryMap, NUMBER_OF_ELEMENTS(memoryMap), MEM_DTCM) <= DTCM_DSP_BUDGET,
+              "Arrays meant for DTCM exceed DTCM_DSP_BUDGET; move cold ones to DMAMEM");
+
 //===============================================================================================================================
 //===============================================================================================================================
 //==========================  Setup ================================
@@ -2162,18 +2014,9 @@ void setup() {
   arm_fir_init_f32(&FIR_CW_DecodeL, 64, CW_Filter_Coeffs2, FIR_CW_DecodeL_state, 256);  //AFP 10-25-22
   arm_fir_init_f32(&FIR_CW_DecodeR, 64, CW_Filter_Coeffs2, FIR_CW_DecodeR_state, 256);
 
-  arm_fir_decimate_init_f32(&FIR_dec1_EX_I, 48, 4, coeffs192K_10K_LPF_FIR, FIR_dec1_EX_I_state, 2048);
-  arm_fir_decimate_init_f32(&FIR_dec1_EX_Q, 48, 4, coeffs192K_10K_LPF_FIR, FIR_dec1_EX_Q_state, 2048);
-
-
-  arm_fir_decimate_init_f32(&FIR_dec2_EX_I, 24, 2, coeffs48K_8K_LPF_FIR, FIR_dec2_EX_I_state, 512);
-  arm_fir_decimate_init_f32(&FIR_dec2_EX_Q, 24, 2, coeffs48K_8K_LPF_FIR, FIR_dec2_EX_Q_state, 512);
-
-  arm_fir_interpolate_init_f32(&FIR_int1_EX_I, 2, 48, coeffs48K_8K_LPF_FIR, FIR_int1_EX_I_state, 256);
-  arm_fir_interpolate_init_f32(&FIR_int1_EX_Q, 2, 48, coeffs48K_8K_LPF_FIR, FIR_int1_EX_Q_state, 256);
-
-  arm_fir_interpolate_init_f32(&FIR_int2_EX_I, 4, 32, coeffs192K_10K_LPF_FIR, FIR_int2_EX_I_state, 512);
-  arm_fir_interpolate_init_f32(&FIR_int2_EX_Q, 4, 32, coeffs192K_10K_LPF_FIR, FIR_int2_EX_Q_state, 512);
+  InitDecimator(&txDecimator, txResampleWork, n_att, 8000.0, 192000.0);  // Same 8 kHz passband as the old 48K_8K filter
+  InitInterpolator(&txInterpolator, txResampleWork, n_att, 8000.0, 192000.0);
+  InitEqualizer(&txEqualizer);
 
   //***********************  EQ Gain Settings ************
 
@@ -2208,6 +2051,7 @@ void setup() {
   tft.writeTo(L2);
   tft.clearMemory();
   tft.writeTo(L1);
+  WaterfallScrollInit();
 
   Splash();
   // =============== Into EEPROM section =================
@@ -2294,6 +2138,7 @@ void setup() {
   //TxRxFreq = centerFreq + NCOFreq;
 
   InitializeDataArrays();
+  ProfileInit();
   
   splitOn = 0;  // Split VFO not active
   SetupMode(bands[currentBand].mode);
@@ -2366,6 +2211,15 @@ void setup() {
     MyDelay(2000L);                               // Given them time to read it.
   }  
 #endif
+#ifdef IQ_REPLAY
+  InitIQReplay();                                 // Receive chain runs from IQ_REPLAY_FILE if it is on the card
+#endif
+  if (MemoryMapCheck() == 0) {
+    tft.print("Memory map problem, send 'm' for details.");
+    MyDelay(2000L);
+  }
+  dspTimer.begin(DSPTimerISR, DSP_TIMER_PERIOD);  // Receive audio runs from here on, independent of the display
+  dspTimer.priority(DSP_TIMER_PRIORITY);          // IRQ_PIT is shared: another IntervalTimer at a higher priority raises the DSP task with it
 
 //CrashReport.breadcrumb( 2, 2 );
 }
@@ -2399,6 +2253,7 @@ void  loop()
     pushButtonSwitchIndex = ProcessButtonPress(valPin);  // Winner, winner...chicken dinner!
     ExecuteButtonPress(pushButtonSwitchIndex);
   }
+  LowLatencyUpdate();                                    // Follows the band, the mode and RF Options
  
 
   if (xmtMode == SSB_MODE) {  //SSB Mode
@@ -2643,20 +2498,22 @@ void  loop()
   ShowTransmitReceiveStatus();
 
 
-#ifdef DEBUG1
-  if (elapsed_micros_idx_t > (SR[SampleRate].rate / 960)) {
+  if (profileDisplayFlag == 1 && elapsed_micros_idx_t > (SR[SampleRate].rate / 960)) {
     ShowTempAndLoad();
     // Used to monitor CPU temp and load factors
   }
+  ProfileSerialCommand();                                 // 'p' in the Serial Monitor prints the DSP stage report
+  DisplaySpiTick();
+#ifdef IQ_REPLAY
+  IQReplayService();                                      // All SD access for the replay is here, not in the DSP task
 #endif
 
   if (volumeChangeFlag == true) {
     volumeChangeFlag = false;
     UpdateVolumeField();
   }
-  /* if (ms_500.check() == 1)                                  // For clock updates AFP 10-26-22
-    {
-     //wait_flag = 0;
-     DisplayClock();
-    }*/
+  if (ms_500.check() == 1)                                  // For clock updates AFP 10-26-22
+  {
+    DisplayClock();
+  }
 }
@@ -0,0 +1,100 @@
+#ifndef BEENHERE
+#include "SDT.h"
+#endif
+
+/**********************************************************************************
+  Scratch arena for transient DSP buffers
+
+  Stages that need a work buffer for a few microseconds per block borrow it from one pool
+  instead of owning a global for the life of the program. The arena is a bump allocator used
+  as a stack:
+
+    uint32_t mark = ScratchMark();
+    float32_t *buffer = ScratchAlloc(256);
+    ...
+    ScratchRelease(mark);
+
+  Everything allocated after a mark is given back at once by ScratchRelease(). Scopes must nest,
+  which they do naturally when the DSP timer interrupt runs a block in the middle of a loop()
+  stage: the interrupt allocates above whatever the interrupted code holds and releases it all
+  again before returning, so the arena needs no locking.
+
+  The high-water mark is shown in the profiler report. An allocation that does not fit returns
+  NULL and is counted, and the caller skips its stage for that block.
+
+  The largest user is the block that picks up a new filter mask: MaskFadeBegin() holds
+  2 * FFT_length floats for the old mask's output, and the audio spectrum takes another
+  AUDIO_SPECTRUM_PIXELS inside the same scope. With the FFT_LENGTH_MAX preset that is 4352
+  floats, and the DSP task can interrupt the Welch hold lines in loop() while they hold
+  SPECTRUM_RES. The other scopes of a block come after the fade is released: the CW decoder
+  takes 2 * 256 + 2 * 511 floats, and the receive equalizer one decimated block.
+  ZoomFFTExe() takes 2 * BUFFER_SIZE * N_BLOCKS, 4096 floats at most. N_B is computed from
+  the decimation factors, which are floats, so that one cannot be checked when compiling. It is
+  inside the arena at every preset, and a miss would be counted like any other.
+**********************************************************************************/
+
+static_assert(SCRATCH_ARENA_SIZE >= SPECTRUM_RES + 2 * FFT_LENGTH_MAX + AUDIO_SPECTRUM_PIXELS,
+              "scratch arena too small for the Welch hold lines and the mask cross-fade at FFT_LENGTH_MAX");
+static_assert(SCRATCH_ARENA_SIZE >= SPECTRUM_RES + 2 * 256 + 2 * 511,
+              "scratch arena too small for the Welch hold lines and the CW decoder");
+
+float32_t scratchArena[SCRATCH_ARENA_SIZE];       // DTCM, it holds per-block working data
+uint32_t scratchTop = 0;                          // Next free element
+uint32_t scratchHighWater = 0;
+uint32_t scratchFailures = 0;
+
+/*****
+  Purpose: Start a scratch scope
+
+  Parameter list:
+    void
+
+  Return value;
+    uint32_t                mark to hand to ScratchRelease()
+*****/
+uint32_t ScratchMark()
+{
+  return scratchTop;
+}
+
+/*****
+  Purpose: Borrow a buffer from the scratch arena until the enclosing scope is released. The
+           contents are not cleared.
+
+  Parameter list:
+    uint32_t count          number of float32_t elements
+
+  Return value;
+    float32_t *             the buffer, or NULL if the arena is full
+*****/
+float32_t *ScratchAlloc(uint32_t count)
+{
+  uint32_t top = scratchTop;
+
+  if (top + count > SCRATCH_ARENA_SIZE) {
+    scratchFailures++;
+#ifdef DEBUG
+    Serial.printf("Scratch arena full: %lu + %lu of %d\n", top, count, SCRATCH_ARENA_SIZE);
+#endif
+    return NULL;
+  }
+  scratchTop = top + count;
+  if (scratchTop > scratchHighWater) {
+    scratchHighWater = scratchTop;
+  }
+  return &scratchArena[top];
+}
+
+/*****
+  Purpose: End a scratch scope, giving back everything allocated since the mark
+
+  Parameter list:
+    uint32_t mark           from ScratchMark()
+
+  Return value;
+    void
+*****/
+void ScratchRelease(uint32_t mark)
+{
+  scratchTop = mark;
+}
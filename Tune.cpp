@@ -154,12 +154,16 @@ int DoSplitVFO() {
   tft.setTextColor(RA8875_LIGHT_GREY);
   tft.setCursor(FREQUENCY_X, FREQUENCY_Y + 6);
   tft.print(freqBuffer);  // Show VFO_A
+  WidgetForget(WIDGET_FREQ_MAIN);                           // Drawn here, not by ShowFrequency()
+  WidgetForget(WIDGET_FREQ_OTHER);
 
   tft.useLayers(1);  //mainly used to turn on layers!
   tft.layerEffect(OR);
   tft.writeTo(L2);
   tft.clearMemory();
   tft.writeTo(L1);
+  WaterfallScrollInit();
+  WidgetForget(WIDGET_CW_SHADE);
 
   tft.setFont(&FreeMono9pt7b);
   tft.setTextColor(RA8875_RED);
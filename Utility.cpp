@@ -30,77 +30,6 @@ void sineTone(int numCycles)
 }
 
 
-const float32_t atanTable[68] = {
-  -0.015623728620477f,
-  0.000000000000000f,  // = 0 for in = 0.0
-  0.015623728620477f,
-  0.031239833430268f,
-  0.046840712915970f,
-  0.062418809995957f,
-  0.077966633831542f,
-  0.093476781158590f,
-  0.108941956989866f,
-  0.124354994546761f,
-  0.139708874289164f,
-  0.154996741923941f,
-  0.170211925285474f,
-  0.185347949995695f,
-  0.200398553825879f,
-  0.215357699697738f,
-  0.230219587276844f,
-  0.244978663126864f,
-  0.259629629408258f,
-  0.274167451119659f,
-  0.288587361894077f,
-  0.302884868374971f,
-  0.317055753209147f,
-  0.331096076704132f,
-  0.345002177207105f,
-  0.358770670270572f,
-  0.372398446676754f,
-  0.385882669398074f,
-  0.399220769575253f,
-  0.412410441597387f,
-  0.425449637370042f,
-  0.438336559857958f,
-  0.451069655988523f,
-  0.463647609000806f,
-  0.476069330322761f,
-  0.488333951056406f,
-  0.500440813147294f,
-  0.512389460310738f,
-  0.524179628782913f,
-  0.535811237960464f,
-  0.547284380987437f,
-  0.558599315343562f,
-  0.569756453482978f,
-  0.580756353567670f,
-  0.591599710335111f,
-  0.602287346134964f,
-  0.612820202165241f,
-  0.623199329934066f,
-  0.633425882969145f,
-  0.643501108793284f,
-  0.653426341180762f,
-  0.663202992706093f,
-  0.672832547593763f,
-  0.682316554874748f,
-  0.691656621853200f,
-  0.700854407884450f,
-  0.709911618463525f,
-  0.718829999621625f,
-  0.727611332626511f,
-  0.736257428981428f,
-  0.744770125716075f,
-  0.753151280962194f,
-  0.761402769805578f,
-  0.769526480405658f,
-  0.777524310373348f,
-  0.785398163397448f,  // = pi/4 for in = 1.0
-  0.793149946109655f,
-  0.800781565178043f
-};
-
 /*****
   Purpose: Generate Array with variable sinewave frequency tone
   Parameter list:
@@ -181,36 +110,6 @@ float32_t Izero(float32_t x)
 }  // END Izero
 
 
-/*****
-  Purpose:    Fast algorithm for log10
-              This is a fast approximation to log2()
-              Y = C[0]*F*F*F + C[1]*F*F + C[2]*F + C[3] + E;
-              log10f is exactly log2(x)/log2(10.0f)
-              Math_log10f_fast(x) =(log2f_approx(x)*0.3010299956639812f)
-
-  Parameter list:
-    float32_t X       number for conversion
-
-  Return value;
-    void
-*****/
-float32_t log10f_fast(float32_t X) {
-  float Y, F;
-  int E;
-  F = frexpf(fabsf(X), &E);
-  Y = 1.23149591368684f;
-  Y *= F;
-  Y += -4.11852516267426f;
-  Y *= F;
-  Y += 6.02197014179219f;
-  Y *= F;
-  Y += -3.13396450166353f;
-  Y += E;
-  return (Y * 0.3010299956639812f);
-}
-
-
-
 /*****
   Purpose: void Calculatedbm()
 
@@ -310,138 +209,6 @@ void Calculatedbm()
 }
 
 
-/*****
-  Purpose: Fast approximation to the trigonometric atan2 function for floating-point data.
-
-  Parameter list:
-    x input value           Inputs
-    y input value
-
-  Return value;
-    atan2(y, x) = atan(y/x) as radians.
-*****/
-float32_t arm_atan2_f32(float32_t y, float32_t x)
-{
-  float32_t atan2Val, fract, in;                 /* Temporary variables for input, output */
-  uint32_t index;                                /* Index variable */
-  uint32_t tableSize = (uint32_t) TABLE_SIZE_64; /* Initialise tablesize */
-  float32_t wa, wb, wc, wd;                      /* Cubic interpolation coefficients */
-  float32_t a, b, c, d;                          /* Four nearest output values */
-  float32_t *tablePtr;                           /* Pointer to table */
-  uint8_t flags = 0;                             /* flags providing information about input values:
-                                                    Bit0 = 1 if |x| < |y|
-                                                    Bit1 = 1 if x < 0
-                                                    Bit2 = 1 if y < 0 */
-
-  /* calculate magnitude of input values */
-  if (x < 0.0f) {
-    x = -x;
-    flags |= 0x02;
-  }
-
-  if (y < 0.0f) {
-    y = -y;
-    flags |= 0x04;
-  }
-
-  /* calculate in value for LUT [0 1] */
-  if (x < y) {
-    in = x / y;
-    flags |= 0x01;
-  } else {                /* x >= y */
-    if (x > 0.0f)
-      in = y / x;
-    else                  /* both are 0.0 */
-      in = 0.0;           /* prevent division by 0 */
-  }
-
-  /* Calculation of index of the table */
-  index = (uint32_t) (tableSize * in);
-
-  /* fractional value calculation */
-  fract = ((float32_t) tableSize * in) - (float32_t) index;
-
-  /* Initialise table pointer */
-  tablePtr = (float32_t *) & atanTable[index];
-
-  /* Read four nearest values of output value from the sin table */
-  a = *tablePtr++;
-  b = *tablePtr++;
-  c = *tablePtr++;
-  d = *tablePtr++;
-
-  /* Cubic interpolation process */
-  wa = -(((0.166666667f) * (fract * (fract * fract))) +
-         ((0.3333333333333f) * fract)) + ((0.5f) * (fract * fract));
-  wb = (((0.5f) * (fract * (fract * fract))) -
-        ((fract * fract) + ((0.5f) * fract))) + 1.0f;
-  wc = (-((0.5f) * (fract * (fract * fract))) +
-        ((0.5f) * (fract * fract))) + fract;
-  wd = ((0.166666667f) * (fract * (fract * fract))) -
-       ((0.166666667f) * fract);
-
-  atan2Val = ((a * wa) + (b * wb)) + ((c * wc) + (d * wd));     /* Calculate atan2 value */
-
-  if (flags & 0x01)                                             /* exchanged input values? */
-
-    atan2Val = 1.5707963267949f - atan2Val;                     /* output = pi/2 - output */
-
-  if (flags & 0x02)
-    atan2Val = 3.14159265358979f - atan2Val;                    /* negative x input? Quadrant 2 or 3 */
-
-  if (flags & 0x04)
-    atan2Val = - atan2Val;                                      /* negative y input? Quadrant 3 or 4 */
-
-  return (atan2Val);                                            /* Return the output value */
-}
-
-/*****
-  Purpose:
-  Parameter list:
-    float32_t inphase
-    float32_t quadrature
-
-  Return value;
-    float32_t
-*****/
-float32_t AlphaBetaMag(float32_t  inphase, float32_t  quadrature)   // (c) András Retzler
-{ // taken from libcsdr: https://github.com/simonyiszk/csdr
-  // Min RMS Err      0.947543636291 0.392485425092
-  // Min Peak Err     0.960433870103 0.397824734759
-  // Min RMS w/ Avg=0 0.948059448969 0.392699081699
-  const float32_t alpha = 0.960433870103; // 1.0; //0.947543636291;
-  const float32_t beta =  0.397824734759;
-
-  float32_t abs_inphase = fabs(inphase);
-  float32_t abs_quadrature = fabs(quadrature);
-  if (abs_inphase > abs_quadrature) {
-    return alpha * abs_inphase + beta * abs_quadrature;
-  } else {
-    return alpha * abs_quadrature + beta * abs_inphase;
-  }
-}
-
-
-/*****
-  Purpose: copied from https://www.dsprelated.com/showarticle/1052.php
-           Polynomial approximating arctangenet on the range -1,1.
-           Max error < 0.005 (or 0.29 degrees)
-
-  Parameter list:
-    float z         value to approximate
-
-  Return value;
-    float           atan vakye
-*****/
-float ApproxAtan(float z)
-{
-  const float n1 = 0.97239411f;
-  const float n2 = -0.19194795f;
-  return (n1 + n2 * z * z) * z;
-}
-
-
-
 /*****
   Purpose: function reads the analog value for each matrix switch and stores that value in EEPROM.
            Only called if STORE_SWITCH_VALUES is uncommented.
@@ -467,6 +234,7 @@ void SaveAnalogSwitchValues()
   int minVal;
   int value;
 
+  DisplayInvalidate();
   tft.fillWindow(RA8875_BLACK);
   tft.setFontScale(1);
   tft.setTextColor(RA8875_GREEN);
@@ -0,0 +1,183 @@
+#ifndef BEENHERE
+#include "SDT.h"
+#endif
+
+/**********************************************************************************
+  Averaged panadapter and hold traces
+
+  At zoom 1 CalcZoom1Magn() used to transform only the first SPECTRUM_RES complex samples of each
+  block and smooth the result with a fixed IIR. With averaging on, WelchSpectrum() transforms the
+  whole block instead, as segments of SPECTRUM_RES samples overlapping by half: 7 segments of
+  the 2048 sample block, 3 in the low-latency path. The windowed segment powers are averaged,
+  which is Welch's method, and then averaged over spectrumAverageDepth frames with an
+  exponential average. Averaging n independent spectra narrows the spread of the noise floor by
+  about sqrt(n), so a CW signal a few dB above the noise stands out of it instead of coming and
+  going with it.
+
+  The segments are transformed with the same 512 point arm_cfft_f32() as the single-segment
+  display, the CMSIS radix-8 kernel, so the cost is one windowed FFT per segment and is only paid
+  on the blocks that publish a display frame.
+
+  SpectrumHoldUpdate() keeps a peak-hold and a minimum-hold trace of the displayed spectrum in
+  either display mode. The holds start again when the tuning, zoom or band changes, or when
+  cleared from the Spectrum Set menu. ShowSpectrum() draws them as single pixels over the
+  spectrum through SpectrumHoldDraw(), which redraws a pixel only when it moved or the trace
+  was drawn over it.
+**********************************************************************************/
+
+int spectrumAverageDepth = 0;                         // Frames in the average, 0 for the single-segment display
+int spectrumHoldMode = 0;                             // SPECTRUM_HOLD_PEAK and SPECTRUM_HOLD_MIN bits
+volatile int spectrumHoldReset = 1;                   // Set to start the holds again
+DMAMEM float32_t spectrumPeak[SPECTRUM_RES];
+DMAMEM float32_t spectrumMinimum[SPECTRUM_RES];
+int16_t pixelPeak[SPECTRUM_RES];
+int16_t pixelMin[SPECTRUM_RES];
+
+/*****
+  Purpose: Welch averaged power spectrum of the whole input block. Leaves the new average in
+           FFT_spec_old, for the S-meter, and in FFT_spec in display order.
+
+  Parameter list:
+    uint32_t blockSize      samples in float_buffer_L and float_buffer_R
+
+  Return value;
+    void
+*****/
+void WelchSpectrum(uint32_t blockSize)
+{
+  uint32_t hop = SPECTRUM_RES / 2;
+  uint32_t segments = (blockSize - SPECTRUM_RES) / hop + 1;
+  float32_t alpha = 1.0 / (float32_t)spectrumAverageDepth;
+  float32_t scale = 1.0 / (float32_t)segments;
+  float32_t *I_in, *Q_in;
+
+  arm_fill_f32(0.0, FFT_spec, SPECTRUM_RES);
+  for (uint32_t s = 0; s < segments; s++) {
+    I_in = &float_buffer_L[s * hop];
+    Q_in = &float_buffer_R[s * hop];
+    for (int i = 0; i < SPECTRUM_RES; i++) {
+      buffer_spec_FFT[i * 2] = I_in[i];
+      buffer_spec_FFT[i * 2 + 1] = Q_in[i];
+    }
+    arm_cmplx_mult_real_f32(buffer_spec_FFT, spectrumWindow, buffer_spec_FFT, SPECTRUM_RES);
+    arm_cfft_f32(spec_FFT, buffer_spec_FFT, 0, 1);
+    for (int i = 0; i < SPECTRUM_RES / 2; i++) {      // Negative frequencies to the left
+      FFT_spec[i + SPECTRUM_RES / 2] += buffer_spec_FFT[i * 2] * buffer_spec_FFT[i * 2] + buffer_spec_FFT[i * 2 + 1] * buffer_spec_FFT[i * 2 + 1];
+      FFT_spec[i] += buffer_spec_FFT[(i + SPECTRUM_RES / 2) * 2] * buffer_spec_FFT[(i + SPECTRUM_RES / 2) * 2]
+                     + buffer_spec_FFT[(i + SPECTRUM_RES / 2) * 2 + 1] * buffer_spec_FFT[(i + SPECTRUM_RES / 2) * 2 + 1];
+    }
+  }
+  for (int x = 0; x < SPECTRUM_RES; x++) {
+    FFT_spec_old[x] += alpha * (scale * FFT_spec[x] - FFT_spec_old[x]);
+    FFT_spec[x] = FFT_spec_old[x];
+  }
+}
+
+/*****
+  Purpose: Fold the spectrum about to be displayed into the hold traces and work out their
+           pixels, the same way as pixelnew[]
+
+  Parameter list:
+    const float32_t *spectrum   SPECTRUM_RES powers in display order
+
+  Return value;
+    void
+*****/
+void SpectrumHoldUpdate(const float32_t *spectrum)
+{
+  static long holdCenterFreq = 0;
+  static int32_t holdZoom = -1;
+  static int holdBand = -1;
+  int16_t offset = displayScale[currentScale].baseOffset + bands[currentBand].pixel_offset;
+  uint32_t mark;
+  float32_t *holdDb;
+
+  if (spectrumHoldMode == 0) {
+    spectrumHoldReset = 1;                            // Start afresh when switched on again
+    return;
+  }
+  if (centerFreq != holdCenterFreq || spectrum_zoom != holdZoom || currentBand != holdBand) {
+    spectrumHoldReset = 1;
+    holdCenterFreq = centerFreq;
+    holdZoom = spectrum_zoom;
+    holdBand = currentBand;
+  }
+  if (spectrumHoldReset) {
+    spectrumHoldReset = 0;
+    arm_copy_f32((float32_t *)spectrum, spectrumPeak, SPECTRUM_RES);
+    arm_copy_f32((float32_t *)spectrum, spectrumMinimum, SPECTRUM_RES);
+  }
+  for (int x = 0; x < SPECTRUM_RES; x++) {
+    spectrumPeak[x] = max(spectrumPeak[x], spectrum[x]);
+    spectrumMinimum[x] = min(spectrumMinimum[x], spectrum[x]);
+  }
+
+  mark = ScratchMark();
+  holdDb = ScratchAlloc(SPECTRUM_RES);
+  if (holdDb != NULL) {
+    FastLog10Block(spectrumPeak, holdDb, displayScale[currentScale].dBScale, SPECTRUM_RES);
+    for (int x = 0; x < SPECTRUM_RES; x++) {
+      pixelPeak[x] = min(offset + (int16_t)holdDb[x], 220);
+    }
+    FastLog10Block(spectrumMinimum, holdDb, displayScale[currentScale].dBScale, SPECTRUM_RES);
+    for (int x = 0; x < SPECTRUM_RES; x++) {
+      pixelMin[x] = min(offset + (int16_t)holdDb[x], 220);
+    }
+  }
+  ScratchRelease(mark);
+}
+
+/*****
+  Purpose: Draw one column of the hold traces, erasing what was drawn there before if it moved.
+           Called from ShowSpectrum() after the column's trace, so a hold pixel the trace drew
+           over is put back.
+
+  Parameter list:
+    const struct spectrumFrame *frame
+    int x1                  column
+    int clearTop            rows the trace was erased or drawn over this frame, clearTop >
+    int clearBottom         clearBottom for none
+    int traceTop            rows of the trace now in the column, traceTop > traceBottom for none
+    int traceBottom
+
+  Return value;
+    void
+*****/
+void SpectrumHoldDraw(const struct spectrumFrame *frame, int x1, int clearTop, int clearBottom, int traceTop, int traceBottom)
+{
+  static int16_t peakShown[SPECTRUM_RES];             // Screen y, 0 where nothing is drawn
+  static int16_t minShown[SPECTRUM_RES];
+  int peakY = 0;
+  int minY = 0;
+
+  if (frame->holdMode & SPECTRUM_HOLD_PEAK) {
+    peakY = spectrumNoiseFloor - constrain(frame->pixelPeak[x1], 0, base_y);
+  }
+  if (frame->holdMode & SPECTRUM_HOLD_MIN) {
+    minY = spectrumNoiseFloor - constrain(frame->pixelMin[x1], 0, base_y);
+  }
+  if (peakShown[x1] >= clearTop && peakShown[x1] <= clearBottom) {
+    peakShown[x1] = 0;                                // Already gone
+  }
+  if (minShown[x1] >= clearTop && minShown[x1] <= clearBottom) {
+    minShown[x1] = 0;
+  }
+  if (peakShown[x1] != 0 && peakShown[x1] != peakY) { // Put back what was under it
+    tft.drawPixel(x1, peakShown[x1], (peakShown[x1] >= traceTop && peakShown[x1] <= traceBottom) ? RA8875_YELLOW : RA8875_BLACK);
+    DisplaySpiCount(SPI_BYTES_PIXEL);
+  }
+  if (minShown[x1] != 0 && minShown[x1] != minY) {
+    tft.drawPixel(x1, minShown[x1], (minShown[x1] >= traceTop && minShown[x1] <= traceBottom) ? RA8875_YELLOW : RA8875_BLACK);
+    DisplaySpiCount(SPI_BYTES_PIXEL);
+  }
+  if (peakY != 0 && peakY != peakShown[x1]) {
+    tft.drawPixel(x1, peakY, RA8875_RED);
+    DisplaySpiCount(SPI_BYTES_PIXEL);
+  }
+  if (minY != 0 && minY != minShown[x1]) {
+    tft.drawPixel(x1, minY, RA8875_CYAN);
+    DisplaySpiCount(SPI_BYTES_PIXEL);
+  }
+  peakShown[x1] = peakY;
+  minShown[x1] = minY;
+}
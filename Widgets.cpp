@@ -0,0 +1,339 @@
+#ifndef BEENHERE
+#include "SDT.h"
+#endif
+
+/**********************************************************************************
+  Status widgets and the display SPI estimate
+
+  loop() calls ShowTransmitReceiveStatus() on every pass. ShowFrequency(), BandInformation(),
+  DisplaydbM() and the Update*Field() functions used to erase and reprint their whole field
+  every time they were called, and one tuning detent calls several of them. Each status field
+  is now a widget in widgets[], which keeps what is on the screen:
+
+    WidgetChanged()     for a field drawn by its own code, the value it was last drawn for.
+                        The caller draws only when it returns 1.
+    WidgetText()        a ROM font text field. The text is printed with an opaque background,
+                        so only the characters that differ from what is shown are printed and
+                        nothing is erased first.
+    WidgetFontText()    a text field in one of the fixed-width GFX fonts, the frequency digits.
+                        Only the changed characters are erased and printed, so tuning redraws
+                        the last digit or two instead of the whole frequency.
+    WidgetBar()         a bar, the S-meter, grown or shrunk by the difference.
+
+  A widget that is not valid is drawn whole the next time. WidgetsInvalidate() is called when
+  the screen is cleared, through DisplayInvalidate(), and WidgetForget() when some other code
+  draws over a single field.
+
+  Every RA8875 command is a blocking SPI transaction, so the bytes sent are what the display
+  costs the rest of loop(). The library cannot be hooked to count the bytes it really sends,
+  so DisplaySpiCount() is called by the widgets and the spectrum and waterfall drawing with an
+  estimate from the SPI_BYTES_ cost model: register writes to set up a shape or text, and two
+  bytes for each pixel or character written. DisplaySpiTick() turns the count into
+  displaySpiBytesPerSecond, which the profile report prints.
+**********************************************************************************/
+
+struct statusWidget widgets[WIDGET_COUNT];
+uint32_t displaySpiBytes = 0;                           // Estimated, counting towards the next second
+uint32_t displaySpiBytesPerSecond = 0;
+
+/*****
+  Purpose: Add to the estimate of the bytes sent to the display
+
+  Parameter list:
+    uint32_t bytes          SPI_BYTES_ cost of what was drawn
+
+  Return value;
+    void
+*****/
+void DisplaySpiCount(uint32_t bytes)
+{
+  displaySpiBytes += bytes;
+}
+
+/*****
+  Purpose: Once a second, move the SPI byte count to displaySpiBytesPerSecond. Called from loop().
+
+  Parameter list:
+    void
+
+  Return value;
+    void
+*****/
+void DisplaySpiTick()
+{
+  static elapsedMillis sinceTick;
+
+  if (sinceTick >= 1000) {
+    displaySpiBytesPerSecond = displaySpiBytes * 1000 / (uint32_t)sinceTick;
+    displaySpiBytes = 0;
+    sinceTick = 0;
+  }
+}
+
+/*****
+  Purpose: Forget what one widget shows, so it is drawn whole next time. Called when something
+           else drew over the field.
+
+  Parameter list:
+    int id                  WIDGET_ value
+
+  Return value;
+    void
+*****/
+void WidgetForget(int id)
+{
+  widgets[id].valid = 0;
+}
+
+/*****
+  Purpose: Forget what every widget shows. Called when the screen is cleared.
+
+  Parameter list:
+    void
+
+  Return value;
+    void
+*****/
+void WidgetsInvalidate()
+{
+  for (int id = 0; id < WIDGET_COUNT; id++) {
+    widgets[id].valid = 0;
+  }
+}
+
+/*****
+  Purpose: Tell whether a widget is drawn, for fields with a label drawn only with the widget
+
+  Parameter list:
+    int id                  WIDGET_ value
+
+  Return value;
+    int                     1 if the widget is on the screen
+*****/
+int WidgetValid(int id)
+{
+  return widgets[id].valid;
+}
+
+/*****
+  Purpose: Check a field drawn by its own code against the value it was last drawn for
+
+  Parameter list:
+    int id                  WIDGET_ value
+    int32_t value           everything the field shows, packed into one number
+
+  Return value;
+    int                     1 if the field must be drawn, and the value is taken as drawn
+*****/
+int WidgetChanged(int id, int32_t value)
+{
+  struct statusWidget *widget = &widgets[id];
+
+  if (widget->valid && widget->value == value) {
+    return 0;
+  }
+  widget->value = value;
+  widget->valid = 1;
+  return 1;
+}
+
+/*****
+  Purpose: Copy text into a fixed-width field, padded with spaces
+
+  Parameter list:
+    char *field             chars + 1 bytes
+    const char *text
+    int chars
+
+  Return value;
+    void
+*****/
+void WidgetPad(char *field, const char *text, int chars)
+{
+  int i;
+
+  for (i = 0; i < chars && text[i] != '\0'; i++) {
+    field[i] = text[i];
+  }
+  for (; i < chars; i++) {
+    field[i] = ' ';
+  }
+  field[chars] = '\0';
+}
+
+/*****
+  Purpose: Find the next run of characters that differ between the text shown and the new text.
+           Runs closer than WIDGET_RUN_GAP characters are joined, as one print costs more than a
+           few extra characters.
+
+  Parameter list:
+    const char *shown
+    const char *field       both chars long
+    int chars
+    int *start              in: where to look from, out: first character of the run
+    int *end                one past the last character of the run
+
+  Return value;
+    int                     1 if there is a run
+*****/
+int WidgetNextRun(const char *shown, const char *field, int chars, int *start, int *end)
+{
+  int i = *start;
+  int last;
+
+  while (i < chars && shown[i] == field[i]) {
+    i++;
+  }
+  if (i >= chars) {
+    return 0;
+  }
+  *start = i;
+  last = i;
+  for (; i < chars && i - last <= WIDGET_RUN_GAP; i++) {
+    if (shown[i] != field[i]) {
+      last = i;
+    }
+  }
+  *end = last + 1;
+  return 1;
+}
+
+/*****
+  Purpose: Draw a text field in the current ROM font scale, printing only the characters that
+           changed. The background is opaque, so nothing needs erasing.
+
+  Parameter list:
+    int id                  WIDGET_ value
+    int x, y                top left of the field
+    int chars               field width in characters, at most WIDGET_TEXT_MAX
+    uint16_t color
+    uint16_t background     what the field is drawn on
+    const char *text        padded or cut to chars
+
+  Return value;
+    int                     1 if anything was drawn
+*****/
+int WidgetText(int id, int x, int y, int chars, uint16_t color, uint16_t background, const char *text)
+{
+  struct statusWidget *widget = &widgets[id];
+  char field[WIDGET_TEXT_MAX + 1];
+  char run[WIDGET_TEXT_MAX + 1];
+  int cellWidth = tft.getFontWidth();
+  int start = 0;
+  int end;
+  int drawn = 0;
+
+  WidgetPad(field, text, chars);
+  if (!widget->valid || widget->color != color || widget->background != background || widget->x != x || widget->y != y) {
+    for (int i = 0; i < chars; i++) {
+      widget->text[i] = '\0';                           // Differs from every character
+    }
+  }
+  tft.setTextColor(color, background);
+  while (WidgetNextRun(widget->text, field, chars, &start, &end)) {
+    tft.setCursor(x + start * cellWidth, y);
+    memcpy(run, &field[start], end - start);
+    run[end - start] = '\0';
+    tft.print(run);
+    DisplaySpiCount(SPI_BYTES_TEXT + (end - start) * SPI_BYTES_CHAR);
+    start = end;
+    drawn = 1;
+  }
+  tft.setTextColor(color);                              // Transparent again for the code after us
+  memcpy(widget->text, field, chars);
+  widget->x = x;
+  widget->y = y;
+  widget->color = color;
+  widget->background = background;
+  widget->valid = 1;
+  return drawn;
+}
+
+/*****
+  Purpose: Draw a text field in a fixed-width GFX font, erasing and printing only the characters
+           that changed
+
+  Parameter list:
+    int id                  WIDGET_ value
+    int x, y                cursor of the first character, on the baseline
+    int chars               field width in characters, at most WIDGET_TEXT_MAX
+    const GFXfont *font     a monospaced font
+    int eraseTop            rows cleared under a changed character
+    int eraseHeight
+    uint16_t color
+    const char *text        padded or cut to chars
+
+  Return value;
+    void
+*****/
+void WidgetFontText(int id, int x, int y, int chars, const GFXfont *font, int eraseTop, int eraseHeight, uint16_t color, const char *text)
+{
+  struct statusWidget *widget = &widgets[id];
+  char field[WIDGET_TEXT_MAX + 1];
+  char run[WIDGET_TEXT_MAX + 1];
+  int cellWidth = font->glyph[0].xAdvance;              // The same for every glyph
+  int start = 0;
+  int end;
+
+  WidgetPad(field, text, chars);
+  if (!widget->valid || widget->color != color || widget->x != x || widget->y != y) {
+    for (int i = 0; i < chars; i++) {
+      widget->text[i] = '\0';                           // Differs from every character
+    }
+  }
+  tft.setFont(font);
+  tft.setTextColor(color);
+  while (WidgetNextRun(widget->text, field, chars, &start, &end)) {
+    tft.fillRect(x + start * cellWidth, eraseTop, (end - start) * cellWidth, eraseHeight, RA8875_BLACK);
+    tft.setCursor(x + start * cellWidth, y);
+    memcpy(run, &field[start], end - start);
+    run[end - start] = '\0';
+    tft.print(run);
+    DisplaySpiCount(SPI_BYTES_SHAPE + (end - start) * (SPI_BYTES_SHAPE + cellWidth * font->yAdvance * SPI_BYTES_ROW_PIXEL));
+    start = end;
+  }
+  memcpy(widget->text, field, chars);
+  widget->x = x;
+  widget->y = y;
+  widget->color = color;
+  widget->valid = 1;
+}
+
+/*****
+  Purpose: Draw a horizontal bar, filling or clearing only the difference from its last length
+
+  Parameter list:
+    int id                  WIDGET_ value
+    int x, y                top left
+    int maxLength           full length, the part not in the bar is black
+    int height
+    int length              clamped to 0 ... maxLength
+    uint16_t color
+
+  Return value;
+    void
+*****/
+void WidgetBar(int id, int x, int y, int maxLength, int height, int length, uint16_t color)
+{
+  struct statusWidget *widget = &widgets[id];
+  int shown;
+
+  length = constrain(length, 0, maxLength);
+  if (!widget->valid || widget->color != color) {
+    tft.fillRect(x, y, maxLength, height, RA8875_BLACK);
+    DisplaySpiCount(SPI_BYTES_SHAPE);
+    shown = 0;
+  } else {
+    shown = widget->value;
+  }
+  if (length > shown) {
+    tft.fillRect(x + shown, y, length - shown, height, color);
+    DisplaySpiCount(SPI_BYTES_SHAPE);
+  } else if (length < shown) {
+    tft.fillRect(x + length, y, shown - length, height, RA8875_BLACK);
+    DisplaySpiCount(SPI_BYTES_SHAPE);
+  }
+  widget->value = length;
+  widget->color = color;
+  widget->valid = 1;
+}
@@ -0,0 +1,86 @@
+#ifndef BEENHERE
+#include "SDT.h"
+#endif
+
+/**********************************************************************************
+  Panadapter FFT window
+
+  ZoomFFTExe() and CalcZoom1Magn() used to work out a Hann window with two cos() calls per
+  sample on every spectrum frame. The window is now built once into spectrumWindow[], in OCRAM,
+  when it is chosen, and applied with one arm_cmplx_mult_real_f32() over the interleaved I, Q
+  buffer. The high resolution spectrum has its own, longer, table, see HighResSpectrum.cpp.
+
+  All four windows are cosine sums,
+
+    w[n] = a0 - a1 cos(2 pi n / N) + a2 cos(4 pi n / N) - a3 cos(6 pi n / N) + a4 cos(8 pi n / N)
+
+  in the periodic form used for spectrum analysis. They are scaled to the coherent gain of the
+  Hann window, 0.5, so a carrier reads the same on the display and S-meter whichever is used.
+  The noise floor moves with the window's noise bandwidth.
+
+    Hann                -31 dB sidelobes, narrowest peaks, the default
+    Blackman-Harris     -92 dB sidelobes, for weak signals next to strong ones
+    Nuttall             -93 dB sidelobes, sidelobes falling away faster than Blackman-Harris
+    Flat top            peaks read within 0.01 dB wherever they fall between bins, widest
+
+  The choice is made in the Spectrum Set menu.
+**********************************************************************************/
+
+const char *windowNames[] = {"Hann", "Blackman-Harris", "Nuttall", "Flat top"};
+
+const float32_t windowCoefficients[WINDOW_TYPES][WINDOW_TERMS] = {
+  { 0.5,        0.5,        0.0,         0.0,         0.0 },
+  { 0.35875,    0.48829,    0.14128,     0.01168,     0.0 },
+  { 0.355768,   0.487396,   0.144232,    0.012604,    0.0 },
+  { 0.21557895, 0.41663158, 0.277263158, 0.083578947, 0.006947368 }
+};
+
+int spectrumWindowType = WINDOW_HANN;
+DMAMEM float32_t spectrumWindow[SPECTRUM_RES];
+
+/*****
+  Purpose: Fill a table with a cosine-sum window
+
+  Parameter list:
+    float32_t *window       length floats
+    uint32_t length         window length, the FFT size
+    int type                WINDOW_HANN, WINDOW_BLACKMAN_HARRIS, WINDOW_NUTTALL or WINDOW_FLAT_TOP
+
+  Return value;
+    void
+*****/
+void WindowBuild(float32_t *window, uint32_t length, int type)
+{
+  const float32_t *a = windowCoefficients[type];
+  float32_t gain = 0.5 / a[0];                          // Coherent gain of the Hann window
+  float32_t w, sign;
+
+  for (uint32_t n = 0; n < length; n++) {
+    w = 0.0;
+    sign = 1.0;
+    for (int k = 0; k < WINDOW_TERMS; k++) {
+      w += sign * a[k] * cosf(TPI * (float32_t)(k * n) / (float32_t)length);
+      sign = -sign;
+    }
+    window[n] = gain * w;
+  }
+}
+
+/*****
+  Purpose: Select the panadapter window and build its table
+
+  Parameter list:
+    int type                WINDOW_ value, anything else selects Hann
+
+  Return value;
+    void
+*****/
+void SetSpectrumWindow(int type)
+{
+  if (type < 0 || type >= WINDOW_TYPES) {
+    type = WINDOW_HANN;
+  }
+  spectrumWindowType = type;
+  WindowBuild(spectrumWindow, SPECTRUM_RES, type);    // A frame computed meanwhile is only mis-scaled
+  HighResWindowBuild();
+}
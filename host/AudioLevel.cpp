@@ -0,0 +1,57 @@
+/**********************************************************************************
+  AudioLevel: measure the audio Replay wrote
+
+  Prints the level of the left channel at one frequency, in dB full scale, measured over the
+  second half of the file so that the chain has settled, and fails if it is outside the
+  limits given. A file with clipped samples fails too.
+
+  Usage: AudioLevel in.wav frequencyHz [--min dBFS] [--max dBFS]
+**********************************************************************************/
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Wav.h"
+
+int main(int argc, char **argv)
+{
+  Wav wav;
+  double frequency, level, re = 0.0, im = 0.0;
+  double low = -INFINITY, high = INFINITY;
+  uint32_t start, count, clipped = 0;
+
+  if (argc < 3) {
+    fprintf(stderr, "Usage: AudioLevel in.wav frequencyHz [--min dBFS] [--max dBFS]\n");
+    return 2;
+  }
+  frequency = atof(argv[2]);
+  for (int i = 3; i + 1 < argc; i += 2) {
+    if (strcmp(argv[i], "--min") == 0) {
+      low = atof(argv[i + 1]);
+    } else if (strcmp(argv[i], "--max") == 0) {
+      high = atof(argv[i + 1]);
+    }
+  }
+  if (!WavRead(argv[1], wav) || wav.Frames() < 2) {
+    return 1;
+  }
+  start = wav.Frames() / 2;
+  count = wav.Frames() - start;
+  for (uint32_t i = start; i < wav.Frames(); i++) {
+    int16_t x = wav.samples[i * wav.channels];
+    double phase = 2.0 * M_PI * fmod(frequency * (i - start) / wav.rate, 1.0);
+
+    re += x * cos(phase);
+    im += x * sin(phase);
+  }
+  for (uint32_t i = 0; i < wav.samples.size(); i++) {
+    clipped += (wav.samples[i] == 32767 || wav.samples[i] == -32768);
+  }
+  level = 20.0 * log10(2.0 * hypot(re, im) / count / 32768.0 + 1e-12);
+  printf("%s: %.1f dBFS at %.0f Hz, %u clipped samples\n", argv[1], level, frequency, clipped);
+  if (level < low || level > high || clipped > 0) {
+    fprintf(stderr, "%s: outside %.1f to %.1f dBFS, or clipped\n", argv[1], low, high);
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,456 @@
+/**********************************************************************************
+  DisplayTest: the display code on the RA8875 emulator
+
+  Starts the sketch with a tone 24 kHz above the center coming in, then runs the
+  DisplayBench.cpp scenes and the menus: every top menu as the Up and Down buttons show it,
+  and SubmenuSelect() driven through the switch ladder by a script of button presses, Up
+  then Select. For each it counts the SPI traffic the emulator sees, and it takes three
+  screen images: after RedrawDisplayScreen(), after the steady spectrum frames and with a
+  menu up.
+
+  The counts are checked against the budgets in the reference directory, display_counts.txt,
+  and fail when a scene sends more than 5% over its budget. Some checks need no budget: an
+  unchanged status draws nothing, only setting the font and colors, a tuning step sends less
+  than a whole frequency, and the waterfall scrolls without the BTE. The images are checked against the PNG files there. The
+  layout images must match but for a few pixels; the spectrum image is given 1%, as the
+  plot and waterfall follow the FFT and libm can round differently on another host. Every
+  image is written to the output directory, and when one does not match, a -diff image
+  with the differing pixels in red over the reference.
+
+  -u writes the images and the counts to the reference directory instead, after a change
+  that is meant to change them.
+
+  Usage: DisplayTest [-u] [-v] referencedir outputdir
+**********************************************************************************/
+#include <Arduino.h>
+#include "SDT.h"
+#include "HostSetup.h"
+#include "Png.h"
+#include <math.h>
+#include <string>
+#include <sys/stat.h>
+
+#define TONE_OFFSET           24000.0         // Hz above the center
+#define TONE_AMPLITUDE        8000.0
+#define NOISE_AMPLITUDE       64              // A noise floor for the plot to sit on
+#define BUDGET_MARGIN         1.05
+#define BUDGET_SLACK          64              // Bytes, so tiny scenes are not failed over a register
+#define LAYOUT_TOLERANCE      0.0005          // Of the pixels, the ones that may differ
+#define SPECTRUM_TOLERANCE    0.01
+#define MENU_SCENES           2
+#define SCREEN_PIXELS         (800 * 480)
+#define SETTLE_MICROS         2000000         // loop() is run this long before the scenes
+
+void loop();                                  // SDTVer042.ino
+
+struct sceneCounts {
+  const char *key;                            // Its name in display_counts.txt
+  int runs;
+  RA8875Counters bus;                         // A run
+  uint32_t estimated;                         // DisplaySpiCount() bytes a run
+};
+
+struct buttonStep {
+  uint32_t ms;                                // After the script starts
+  int button;                                 // switchValues[] index, -1 for released
+  int snapshot;                               // 1 to take the menu image first
+};
+
+static const char *sceneKeys[BENCH_SCENES + MENU_SCENES] = {
+  "redraw", "status_all", "status_unchanged", "freq_full", "freq_step", "spectrum_full",
+  "spectrum_steady", "menu_primary", "menu_select"
+};
+
+// SubmenuSelect() reads the ladder every 250 ms or so; each press is caught once
+static const buttonStep buttonScript[] = {
+  { 200, MAIN_MENU_UP, 0 },
+  { 350, -1, 0 },
+  { 700, MENU_OPTION_SELECT, 1 },
+  { 1000, -1, 0 },
+};
+
+static IntervalTimer audioDMA;
+static IntervalTimer buttonTimer;
+static double tonePhase = 0.0;
+static uint32_t noiseSeed = 1;
+static uint64_t buttonStart;
+static size_t buttonNext;
+static std::vector<uint8_t> menuScreen;
+static sceneCounts counts[BENCH_SCENES + MENU_SCENES];
+
+/*****
+  Purpose: One audio library update: a block of the tone in, the audio out thrown away
+
+  Parameter list:
+    void
+
+  Return value;
+    void
+*****/
+static void AudioDMA()
+{
+  int16_t left[AUDIO_BLOCK_SAMPLES];
+  int16_t right[AUDIO_BLOCK_SAMPLES];
+  double step = 2.0 * M_PI * TONE_OFFSET / SR[SampleRate].rate;
+
+  for (int i = 0; i < AUDIO_BLOCK_SAMPLES; i++) {
+    noiseSeed = noiseSeed * 1664525 + 1013904223;             // The same noise on every host
+    right[i] = (int16_t)lrint(TONE_AMPLITUDE * cos(tonePhase)) + (int)(noiseSeed >> 24) % NOISE_AMPLITUDE;   // I
+    left[i] = (int16_t)lrint(TONE_AMPLITUDE * sin(tonePhase)) + (int)(noiseSeed >> 16 & 0xFF) % NOISE_AMPLITUDE;   // Q
+    tonePhase = fmod(tonePhase + step, 2.0 * M_PI);
+  }
+  Q_in_R.HostWrite(right);
+  Q_in_L.HostWrite(left);
+  while (Q_out_L.HostAvailable() > 0 && Q_out_R.HostAvailable() > 0) {
+    Q_out_L.HostRead(left);
+    Q_out_R.HostRead(right);
+  }
+}
+
+/*****
+  Purpose: Press and release the buttons on the ladder as buttonScript[] says
+
+  Parameter list:
+    void
+
+  Return value;
+    void
+*****/
+static void ButtonScript()
+{
+  while (buttonNext < sizeof(buttonScript) / sizeof(buttonScript[0])
+         && HostMicros() - buttonStart >= buttonScript[buttonNext].ms * 1000ULL) {
+    const buttonStep &step = buttonScript[buttonNext++];
+
+    if (step.snapshot) {
+      tft.HostScreen(menuScreen);
+    }
+    HostSetAnalog(BUSY_ANALOG_PIN, step.button < 0 ? 1023 : EEPROMData.switchValues[step.button]);
+  }
+}
+
+/*****
+  Purpose: Reset the counters before a scene
+
+  Parameter list:
+    uint32_t *estimated     set to displaySpiBytes
+
+  Return value;
+    void
+*****/
+static void CountStart(uint32_t *estimated)
+{
+  tft.HostResetCounters();
+  *estimated = displaySpiBytes;
+}
+
+/*****
+  Purpose: Add the counters of a run to a scene's
+
+  Parameter list:
+    sceneCounts &scene
+    uint32_t estimated      displaySpiBytes at the start
+
+  Return value;
+    void
+*****/
+static void CountAdd(sceneCounts &scene, uint32_t estimated)
+{
+  const RA8875Counters &c = tft.HostCounters();
+
+  scene.bus.spiBytes += c.spiBytes;
+  scene.bus.transactions += c.transactions;
+  scene.bus.registerWrites += c.registerWrites;
+  scene.bus.statusReads += c.statusReads;
+  scene.bus.shapes += c.shapes;
+  scene.bus.pixels += c.pixels;
+  scene.bus.characters += c.characters;
+  scene.bus.bteMoves += c.bteMoves;
+  scene.estimated += displaySpiBytes - estimated;
+}
+
+/*****
+  Purpose: Turn a scene's totals into the figures of one run
+
+  Parameter list:
+    sceneCounts &scene
+
+  Return value;
+    void
+*****/
+static void CountPerRun(sceneCounts &scene)
+{
+  int n = scene.runs;
+
+  scene.bus.spiBytes /= n;
+  scene.bus.transactions /= n;
+  scene.bus.registerWrites /= n;
+  scene.bus.statusReads /= n;
+  scene.bus.shapes /= n;
+  scene.bus.pixels /= n;
+  scene.bus.characters /= n;
+  scene.bus.bteMoves /= n;
+  scene.estimated /= n;
+}
+
+/*****
+  Purpose: Check a screen image against its reference, or write the reference
+
+  Parameter list:
+    const std::vector<uint8_t> &screen
+    const char *name        the file is name.png
+    double tolerance        the fraction of the pixels that may differ
+    const std::string &referenceDir, &outputDir
+    int update              1 to write the reference
+
+  Return value;
+    int                     1 if it matches or was written
+*****/
+static int CheckImage(const std::vector<uint8_t> &screen, const char *name, double tolerance,
+                      const std::string &referenceDir, const std::string &outputDir, int update)
+{
+  std::string reference = referenceDir + "/" + name + ".png";
+  std::string actual = outputDir + "/" + name + ".png";
+  std::vector<uint8_t> expected;
+  std::vector<uint8_t> diff;
+  int width, height;
+  int differ = 0;
+
+  if (update) {
+    printf("%-16s written to %s\n", name, reference.c_str());
+    return PngWrite(reference.c_str(), 800, 480, screen);
+  }
+  PngWrite(actual.c_str(), 800, 480, screen);
+  if (PngRead(reference.c_str(), width, height, expected) == 0 || width != 800 || height != 480) {
+    printf("%-16s FAIL, no 800x480 reference\n", name);
+    return 0;
+  }
+  diff.resize(screen.size());
+  for (int i = 0; i < SCREEN_PIXELS; i++) {
+    int same = memcmp(&screen[i * 3], &expected[i * 3], 3) == 0;
+
+    differ += !same;
+    diff[i * 3] = same ? expected[i * 3] / 4 : 255;
+    diff[i * 3 + 1] = same ? expected[i * 3 + 1] / 4 : 0;
+    diff[i * 3 + 2] = same ? expected[i * 3 + 2] / 4 : 0;
+  }
+  if (differ > tolerance * SCREEN_PIXELS) {
+    PngWrite((outputDir + "/" + name + "-diff.png").c_str(), 800, 480, diff);
+    printf("%-16s FAIL, %d pixels differ, %d allowed, see %s\n", name, differ, (int)(tolerance * SCREEN_PIXELS),
+           actual.c_str());
+    return 0;
+  }
+  printf("%-16s matches, %d pixels differ\n", name, differ);
+  return 1;
+}
+
+/*****
+  Purpose: Check the scenes' SPI bytes against the budgets, or write the budgets
+
+  Parameter list:
+    const std::string &path   display_counts.txt
+    int update
+
+  Return value;
+    int                     1 if every scene is within its budget
+*****/
+static int CheckBudgets(const std::string &path, int update)
+{
+  FILE *f;
+  char line[128];
+  char key[32];
+  unsigned long long bytes, transactions, bteMoves;
+  int found = 0;
+  int ok = 1;
+
+  if (update) {
+    f = fopen(path.c_str(), "w");
+    if (f == NULL) {
+      fprintf(stderr, "%s: cannot create\n", path.c_str());
+      return 0;
+    }
+    fprintf(f, "# scene, then SPI bytes, transactions and BTE moves a run; see DisplayTest.cpp\n");
+    for (const sceneCounts &scene : counts) {
+      fprintf(f, "%s %llu %llu %llu\n", scene.key, (unsigned long long)scene.bus.spiBytes,
+              (unsigned long long)scene.bus.transactions, (unsigned long long)scene.bus.bteMoves);
+    }
+    fclose(f);
+    printf("Budgets written to %s\n", path.c_str());
+    return 1;
+  }
+  f = fopen(path.c_str(), "r");
+  if (f == NULL) {
+    printf("FAIL, no budgets in %s\n", path.c_str());
+    return 0;
+  }
+  while (fgets(line, sizeof(line), f) != NULL) {
+    if (line[0] == '#' || sscanf(line, "%31s %llu %llu %llu", key, &bytes, &transactions, &bteMoves) != 4) {
+      continue;
+    }
+    for (const sceneCounts &scene : counts) {
+      if (strcmp(scene.key, key) != 0) {
+        continue;
+      }
+      found++;
+      if (scene.bus.spiBytes > bytes * BUDGET_MARGIN + BUDGET_SLACK || scene.bus.transactions > transactions * BUDGET_MARGIN + BUDGET_SLACK
+          || scene.bus.bteMoves > bteMoves) {
+        printf("%-20s FAIL, %llu bytes, %llu transactions, %llu BTE moves, over the budget of %llu, %llu, %llu\n", key,
+               (unsigned long long)scene.bus.spiBytes, (unsigned long long)scene.bus.transactions,
+               (unsigned long long)scene.bus.bteMoves, bytes, transactions, bteMoves);
+        ok = 0;
+      } else if (scene.bus.spiBytes < bytes * 0.9) {
+        printf("%-20s %llu bytes, under the budget of %llu; -u to lower it\n", key,
+               (unsigned long long)scene.bus.spiBytes, bytes);
+      }
+    }
+  }
+  fclose(f);
+  if (found != BENCH_SCENES + MENU_SCENES) {
+    printf("FAIL, %d of %d scenes in %s\n", found, BENCH_SCENES + MENU_SCENES, path.c_str());
+    return 0;
+  }
+  return ok;
+}
+
+/*****
+  Purpose: Check what should hold whatever the budgets
+
+  Parameter list:
+    void
+
+  Return value;
+    int                     1 if it all does
+*****/
+static int CheckInvariants()
+{
+  int ok = 1;
+
+  if (counts[BENCH_STATUS_UNCHANGED].bus.shapes + counts[BENCH_STATUS_UNCHANGED].bus.pixels
+      + counts[BENCH_STATUS_UNCHANGED].bus.characters != 0) {
+    printf("FAIL, an unchanged status draws\n");
+    ok = 0;
+  }
+  if (counts[BENCH_FREQ_STEP].bus.spiBytes >= counts[BENCH_FREQ_FULL].bus.spiBytes) {
+    printf("FAIL, a tuning step sends as much as drawing the frequencies whole\n");
+    ok = 0;
+  }
+  if (counts[BENCH_SPECTRUM_STEADY].bus.spiBytes >= counts[BENCH_SPECTRUM_FULL].bus.spiBytes) {
+    printf("FAIL, a steady spectrum frame sends as much as a full one\n");
+    ok = 0;
+  }
+  if (counts[BENCH_SPECTRUM_STEADY].bus.bteMoves != 0) {
+    printf("FAIL, the waterfall uses the BTE\n");
+    ok = 0;
+  }
+  return ok;
+}
+
+int main(int argc, char **argv)
+{
+  int update = 0;
+  int verbose = 0;
+  int ok = 1;
+  int i;
+  int selected;
+  uint32_t estimated;
+  uint64_t settleStart;
+  std::vector<uint8_t> screen;
+  std::string referenceDir, outputDir;
+
+  for (i = 1; i < argc && argv[i][0] == '-'; i++) {
+    if (strcmp(argv[i], "-u") == 0) {
+      update = 1;
+    } else if (strcmp(argv[i], "-v") == 0) {
+      verbose = 1;
+    } else {
+      break;
+    }
+  }
+  if (argc - i != 2) {
+    fprintf(stderr, "Usage: DisplayTest [-u] [-v] referencedir outputdir\n");
+    return 2;
+  }
+  referenceDir = argv[i];
+  outputDir = argv[i + 1];
+  mkdir(update ? referenceDir.c_str() : outputDir.c_str(), 0777);
+
+  HostSerialQuiet(!verbose);
+  audioDMA.begin(AudioDMA, 1e6 * AUDIO_BLOCK_SAMPLES / SR[SampleRate].rate);
+  HostSetup();
+  settleStart = HostMicros();
+  while (HostMicros() - settleStart < SETTLE_MICROS) {        // loop() starts the receive state
+    loop();
+  }
+  if (DSPTaskRunning() == 0) {
+    printf("FAIL, the DSP task did not start\n");
+    return 1;
+  }
+
+  for (int scene = 0; scene < BENCH_SCENES; scene++) {
+    counts[scene].key = sceneKeys[scene];
+    counts[scene].runs = displayBenchRuns[scene];
+    for (int run = 0; run < displayBenchRuns[scene]; run++) {
+      if (DisplayBenchPrepare(scene) == 0) {
+        printf("FAIL, the DSP task stopped\n");
+        return 1;
+      }
+      CountStart(&estimated);
+      DisplayBenchDraw(scene);
+      CountAdd(counts[scene], estimated);
+      DisplayBenchFinish(scene);
+    }
+    CountPerRun(counts[scene]);
+    if (scene == BENCH_REDRAW) {
+      tft.HostScreen(screen);
+      ok &= CheckImage(screen, "redraw", LAYOUT_TOLERANCE, referenceDir, outputDir, update);
+    } else if (scene == BENCH_SPECTRUM_STEADY) {
+      tft.HostScreen(screen);
+      ok &= CheckImage(screen, "spectrum", SPECTRUM_TOLERANCE, referenceDir, outputDir, update);
+    }
+  }
+
+  sceneCounts &primary = counts[BENCH_SCENES];
+  sceneCounts &select = counts[BENCH_SCENES + 1];
+  primary.key = sceneKeys[BENCH_SCENES];
+  primary.runs = 0;
+  for (int i = 0; i < TOP_MENU_COUNT; i++) {
+    CountStart(&estimated);
+    ShowMenu(&topMenus[i], PRIMARY_MENU);
+    CountAdd(primary, estimated);
+    primary.runs++;
+  }
+  CountPerRun(primary);
+  ShowMenu(&topMenus[0], PRIMARY_MENU);
+
+  select.key = sceneKeys[BENCH_SCENES + 1];
+  select.runs = 1;
+  buttonStart = HostMicros();
+  buttonNext = 0;
+  buttonTimer.begin(ButtonScript, 1000);
+  CountStart(&estimated);
+  selected = SubmenuSelect(CWFilter, 6, 0);
+  CountAdd(select, estimated);
+  buttonTimer.end();
+  HostSetAnalog(BUSY_ANALOG_PIN, 1023);
+  if (selected != 1) {
+    printf("FAIL, SubmenuSelect() chose %d, not 1, from an Up and a Select\n", selected);
+    ok = 0;
+  }
+  ok &= CheckImage(menuScreen, "menu", LAYOUT_TOLERANCE, referenceDir, outputDir, update);
+  audioDMA.end();
+
+  printf("\n%-20s %4s %9s %7s %6s %6s %7s %6s %4s %9s %10s\n", "Scene, a run", "runs", "bytes", "trans", "regs",
+         "shapes", "pixels", "chars", "BTE", "bus us", "estimated");
+  for (const sceneCounts &scene : counts) {
+    printf("%-20s %4d %9llu %7llu %6llu %6llu %7llu %6llu %4llu %9.0f %10lu\n", scene.key, scene.runs,
+           (unsigned long long)scene.bus.spiBytes, (unsigned long long)scene.bus.transactions,
+           (unsigned long long)scene.bus.registerWrites, (unsigned long long)scene.bus.shapes,
+           (unsigned long long)scene.bus.pixels, (unsigned long long)scene.bus.characters,
+           (unsigned long long)scene.bus.bteMoves, tft.HostBusMicros(scene.bus), (unsigned long)scene.estimated);
+  }
+  printf("\n");
+  ok &= CheckInvariants();
+  ok &= CheckBudgets(referenceDir + "/display_counts.txt", update);
+  printf("%s\n", ok ? "PASS" : "FAIL");
+  return ok ? 0 : 1;
+}
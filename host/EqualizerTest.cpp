@@ -0,0 +1,121 @@
+/**********************************************************************************
+  EqualizerTest: the receive equalizer built into the filter mask
+
+  Builds a passband mask with and without EQ_MASK, with the levels tilted from -6 dB at the
+  lowest band to +6 dB at the highest, and checks that
+    - the filter still fits in m_NumTaps, so overlap-save does not wrap it round,
+    - the mask follows the equalizer's response across the passband,
+    - a linear phase mask stays linear phase, and
+    - a minimum phase mask with the equalizer in it fits as well.
+**********************************************************************************/
+#include <Arduino.h>
+#include "SDT.h"
+#include "HostSetup.h"
+
+#define LO_CUT                      100
+#define HI_CUT                      4500
+
+static int failures = 0;
+static float32_t taps[2 * FFT_LENGTH_MAX];
+static float32_t oldMask[2 * FFT_LENGTH_MAX];
+
+static void Check(const char *name, double value, double limit)
+{
+  int ok = value <= limit;
+
+  printf("%-36s %10.3g  limit %-8.3g %s\n", name, value, limit, ok ? "ok" : "FAIL");
+  failures += !ok;
+}
+
+/*****
+  Purpose: Share of a mask's energy in taps overlap-save has no room for
+
+  Parameter list:
+    const float32_t *mask   FFT_length complex bins
+
+  Return value;
+    double                  energy beyond m_NumTaps over the total
+*****/
+static double EnergyBeyondTaps(const float32_t *mask)
+{
+  double inside = 0.0, outside = 0.0;
+
+  memcpy(taps, mask, 2 * FFT_length * sizeof(float32_t));
+  arm_cfft_f32(maskS, taps, 1, 1);
+  for (uint32_t i = 0; i < FFT_length; i++) {
+    double p = (double)taps[2 * i] * taps[2 * i] + (double)taps[2 * i + 1] * taps[2 * i + 1];
+
+    if (i < m_NumTaps) {
+      inside += p;
+    } else {
+      outside += p;
+    }
+  }
+  return outside / (inside + outside);
+}
+
+static float32_t *Mask(int eq, int phase)
+{
+  receiveEQFlag = eq ? EQ_MASK : OFF;
+  maskPhase[MaskPhaseIndex()] = phase;
+  return MaskCacheLookup(LO_CUT, HI_CUT, SR[SampleRate].rate);
+}
+
+int main()
+{
+  float32_t rate, binHz, delay, *plain, *withEQ, *minimum;
+  double responseError = 0.0, phaseError = 0.0, oldExcess;
+  int levels[EQUALIZER_CELL_COUNT];
+
+  HostSerialQuiet(1);
+  HostSetup();
+  rate = (float32_t)SR[SampleRate].rate / DF;
+  binHz = rate / FFT_length;
+  for (int b = 0; b < EQUALIZER_CELL_COUNT; b++) {
+    levels[b] = lrintf(100.0 * powf(2.0, (b - 6.5) / 6.5));
+  }
+  memcpy(EEPROMData.equalizerRec, levels, sizeof(levels));
+  printf("FFT %lu, %lu taps, %.1f Hz bins\n", (unsigned long)FFT_length, (unsigned long)m_NumTaps, binHz);
+
+  plain = Mask(0, MASK_PHASE_LINEAR);
+  withEQ = Mask(1, MASK_PHASE_LINEAR);
+  Check("EQ mask energy beyond m_NumTaps", EnergyBeyondTaps(withEQ), 1e-6);
+
+  // Response against the plain mask times the equalizer, from 400 Hz, where the filter can
+  // follow the bands, to the upper band edge less the filter's transition
+  delay = (m_NumTaps - 1) / 2.0;
+  for (uint32_t k = (uint32_t)(400.0 / binHz); k < (uint32_t)((HI_CUT - 300.0) / binHz); k++) {
+    float32_t w = TWO_PI * k / FFT_length;
+    float32_t p = hypotf(plain[2 * k], plain[2 * k + 1]);
+    float32_t e = hypotf(withEQ[2 * k], withEQ[2 * k + 1]);
+    float32_t target = EqualizerMagnitude(&rxEqualizer, w);
+    float32_t re = withEQ[2 * k] * cosf(w * delay) - withEQ[2 * k + 1] * sinf(w * delay);
+    float32_t im = withEQ[2 * k] * sinf(w * delay) + withEQ[2 * k + 1] * cosf(w * delay);
+
+    responseError = max(responseError, fabs(20.0 * log10(e / (p * target))));
+    phaseError = max(phaseError, fabs(atan2(im, fabs(re))));             // 0 for linear phase
+  }
+  Check("EQ response error, dB", responseError, 1.0);
+  Check("EQ phase off linear, rad", phaseError, 1e-3);
+
+  minimum = Mask(1, MASK_PHASE_MINIMUM);
+  Check("Minimum phase EQ mask beyond m_NumTaps", EnergyBeyondTaps(minimum), 1e-6);
+
+  // The old way, the mask multiplied by the response, for comparison
+  memcpy(oldMask, plain, 2 * FFT_length * sizeof(float32_t));
+  for (uint32_t k = 0; k < FFT_length; k++) {
+    float32_t w = TWO_PI * (float32_t)((k < FFT_length / 2) ? (int)k : (int)k - (int)FFT_length) / FFT_length;
+    float32_t target = EqualizerMagnitude(&rxEqualizer, w);
+
+    oldMask[2 * k] *= target;
+    oldMask[2 * k + 1] *= target;
+  }
+  oldExcess = EnergyBeyondTaps(oldMask);
+  printf("%-36s %10.3g  (mask times response, before)\n", "Old mask energy beyond m_NumTaps", oldExcess);
+
+  if (failures > 0) {
+    printf("%d FAILED\n", failures);
+    return 1;
+  }
+  return 0;
+}
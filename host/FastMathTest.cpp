@@ -0,0 +1,214 @@
+/**********************************************************************************
+  FastMathTest: the FastMath.cpp kernels against libm
+
+  Sweeps each kernel far more densely than FastMathCheck() can on the radio, against libm in
+  double, and fails if the error is larger than FastMath.cpp says it is. The block versions
+  must give the scalar results. FastMathCheck() is run at the end, so its report still works.
+**********************************************************************************/
+#include <Arduino.h>
+#include "SDT.h"
+
+static int failures = 0;
+
+/*****
+  Purpose: Print one line of the report and count it if the error is over its bound
+
+  Parameter list:
+    const char *name
+    double error            largest error found
+    double bound            as documented in FastMath.cpp
+    const char *where       input that gave the largest error
+
+  Return value;
+    void
+*****/
+static void Report(const char *name, double error, double bound, double where)
+{
+  int ok = error <= bound;
+
+  printf("%-26s %10.2e %10.2e  at %-12.6g %s\n", name, error, bound, where, ok ? "ok" : "FAIL");
+  failures += !ok;
+}
+
+static void Expect(const char *name, int ok)
+{
+  printf("%-26s %s\n", name, ok ? "ok" : "FAIL");
+  failures += !ok;
+}
+
+// Every stride'th positive normal float, 1.2e-38 to 3.4e38
+static float NormalFloat(uint32_t k, uint32_t stride)
+{
+  uint32_t bits = 0x00800000 + k * stride;
+  float f;
+
+  memcpy(&f, &bits, sizeof(f));
+  return f;
+}
+
+static void TestLogs()
+{
+  const uint32_t stride = 97;
+  const uint32_t count = (0x7F800000 - 0x00800000) / stride;
+  float in[1024], out[1024];
+  double log2Error = 0, log10Error = 0, log10NearError = 0, blockError = 0;
+  double log2At = 0, log10At = 0, log10NearAt = 0, blockAt = 0;
+  int blockMatches = 1;
+
+  for (uint32_t k = 0; k < count; k += 1024) {
+    uint32_t n = min(count - k, 1024U);
+
+    for (uint32_t i = 0; i < n; i++) {
+      in[i] = NormalFloat(k + i, stride) * ((i & 1) ? -1.0f : 1.0f);      // The sign is ignored
+    }
+    FastLog10Block(in, out, 1.0, n);
+    for (uint32_t i = 0; i < n; i++) {
+      double x = fabs((double)in[i]);
+      double e2 = fabs(FastLog2(in[i]) - log2(x));
+      double e10 = fabs(log10f_fast(in[i]) - log10(x));
+      double eb = fabs(out[i] - log10(x));
+
+      if (e2 > log2Error) {
+        log2Error = e2;
+        log2At = x;
+      }
+      if (e10 > log10Error) {
+        log10Error = e10;
+        log10At = x;
+      }
+      if (x >= 1e-12 && x <= 1e12 && e10 > log10NearError) {
+        log10NearError = e10;
+        log10NearAt = x;
+      }
+      if (eb > blockError) {
+        blockError = eb;
+        blockAt = x;
+      }
+      blockMatches &= fabsf(out[i] - log10f_fast(in[i])) <= 4e-6f * max(1.0f, fabsf(out[i]));
+    }
+  }
+  Report("FastLog2", log2Error, 2.1e-5, log2At);
+  Report("log10f_fast, 1e-12 to 1e12", log10NearError, 6.4e-6, log10NearAt);
+  Report("log10f_fast", log10Error, 7.4e-6, log10At);
+  Report("FastLog10Block", blockError, 8.1e-6, blockAt);
+  Expect("FastLog10Block = log10f_fast", blockMatches);
+  Expect("FastLog2(0) = -127", FastLog2(0.0) == -127.0);
+}
+
+static void TestExp()
+{
+  double nearError = 0, farError = 0, nearAt = 0, farAt = 0;
+  int underflow = 1;
+
+  for (int k = -870000; k <= 870000; k++) {
+    float x = k * 1e-4f;
+    double e = fabs(FastExp(x) / exp((double)x) - 1.0);
+
+    if (fabsf(x) < 20.0 && e > nearError) {
+      nearError = e;
+      nearAt = x;
+    }
+    if (e > farError) {
+      farError = e;
+      farAt = x;
+    }
+  }
+  for (float x = -87.5; x > -1000.0; x -= 0.25) {
+    underflow &= FastExp(x) == 0.0;
+  }
+  Report("FastExp rel, |x| < 20", nearError, 7.9e-7, nearAt);
+  Report("FastExp rel, |x| <= 87", farError, 2.8e-6, farAt);
+  Expect("FastExp below -87 = 0", underflow);
+}
+
+static void TestSinCos()
+{
+  double sinError = 0, cosError = 0, sinAt = 0, cosAt = 0;
+  float s, c;
+
+  for (int k = -2000000; k <= 2000000; k++) {
+    float phase = k * 1e-5f;
+
+    FastSinCos(phase, &s, &c);
+    if (fabs(s - sin((double)phase)) > sinError) {
+      sinError = fabs(s - sin((double)phase));
+      sinAt = phase;
+    }
+    if (fabs(c - cos((double)phase)) > cosError) {
+      cosError = fabs(c - cos((double)phase));
+      cosAt = phase;
+    }
+  }
+  Report("FastSinCos sin, |x| < 20", sinError, 9.5e-7, sinAt);
+  Report("FastSinCos cos, |x| < 20", cosError, 7.2e-6, cosAt);
+}
+
+static void TestAtan2()
+{
+  const double radii[] = { 1e-6, 1e-3, 1.0, 1e3, 1e6 };
+  double error = 0, at = 0;
+
+  for (double r : radii) {
+    for (int k = 0; k < 1000000; k++) {
+      double angle = -PI + 2.0 * PI * k / 1000000;
+      float y = r * sin(angle);
+      float x = r * cos(angle);
+      double e = fabs(FastAtan2(y, x) - atan2((double)y, (double)x));
+
+      if (e > PI) {                               // -pi and pi are the same angle
+        e = fabs(e - 2.0 * PI);
+      }
+      if (e > error) {
+        error = e;
+        at = angle;
+      }
+    }
+  }
+  Report("FastAtan2", error, 1.2e-5, at);
+  Expect("FastAtan2(0, 0) = 0", FastAtan2(0.0, 0.0) == 0.0);
+}
+
+static void TestMagnitude()
+{
+  const int count = 1000000;
+  static float iq[2 * count], out[count];
+  double error = 0, at = 0;
+  int blockMatches = 1;
+
+  for (int k = 0; k < count; k++) {
+    double angle = 2.0 * PI * k / count;
+    double r = pow(10.0, -6.0 + 12.0 * (k % 1000) / 1000.0);
+
+    iq[2 * k] = r * cos(angle);
+    iq[2 * k + 1] = r * sin(angle);
+  }
+  AlphaBetaMagBlock(iq, out, count);
+  for (int k = 0; k < count; k++) {
+    double m = hypot((double)iq[2 * k], (double)iq[2 * k + 1]);
+    double e = fabs(AlphaBetaMag(iq[2 * k], iq[2 * k + 1]) / m - 1.0);
+
+    if (e > error) {
+      error = e;
+      at = 2.0 * PI * k / count;
+    }
+    blockMatches &= out[k] == AlphaBetaMag(iq[2 * k], iq[2 * k + 1]);
+  }
+  Report("AlphaBetaMag rel", error, 0.040, at);
+  Expect("AlphaBetaMagBlock = AlphaBetaMag", blockMatches);
+}
+
+int main()
+{
+  printf("Kernel                      max error      bound\n");
+  TestLogs();
+  TestExp();
+  TestSinCos();
+  TestAtan2();
+  TestMagnitude();
+  FastMathCheck();                                // The radio's own report, on the host's libm
+  if (failures > 0) {
+    printf("%d FAILED\n", failures);
+    return 1;
+  }
+  return 0;
+}
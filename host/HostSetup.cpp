@@ -0,0 +1,16 @@
+/**********************************************************************************
+  HostSetup: see HostSetup.h
+**********************************************************************************/
+#include <Arduino.h>
+#include "SDT.h"
+#include "HostSetup.h"
+
+void setup();                                     // SDTVer042.ino
+
+void HostSetup()
+{
+  EEPROMSaveDefaults();
+  strcpy(EEPROMData.versionSettings, VERSION);
+  EEPROM.put(0, EEPROMData);
+  setup();
+}
@@ -0,0 +1,14 @@
+/**********************************************************************************
+  HostSetup: start the sketch as a radio that has been set up before
+
+  On an erased EEPROM setup() writes the defaults and then asks for each of the 18 buttons to
+  be pressed, to calibrate the switch ladder, which no host program can answer. HostSetup()
+  first stores the defaults with this version's name, as the radio has them after its first
+  start, so setup() reads them and goes straight on, and the ladder reads as no button down.
+**********************************************************************************/
+#ifndef HOST_SETUP_H
+#define HOST_SETUP_H
+
+void HostSetup();
+
+#endif
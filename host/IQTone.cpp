@@ -0,0 +1,38 @@
+/**********************************************************************************
+  IQTone: write a test I/Q file for Replay
+
+  One complex tone, I = cos and Q = sin, at an offset from the center frequency, in the
+  channel order Replay and IQReplay.cpp read.
+
+  Usage: IQTone out.wav offsetHz seconds [amplitude 0..1, default 0.25]
+**********************************************************************************/
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "Wav.h"
+
+int main(int argc, char **argv)
+{
+  Wav wav;
+  double offset, seconds, amplitude = 0.25;
+  uint32_t frames;
+
+  if (argc < 4 || argc > 5) {
+    fprintf(stderr, "Usage: IQTone out.wav offsetHz seconds [amplitude]\n");
+    return 2;
+  }
+  offset = atof(argv[2]);
+  seconds = atof(argv[3]);
+  if (argc == 5) {
+    amplitude = atof(argv[4]);
+  }
+  frames = (uint32_t)(seconds * wav.rate);
+  wav.samples.resize(2 * frames);
+  for (uint32_t i = 0; i < frames; i++) {
+    double phase = 2.0 * M_PI * fmod(offset * i / wav.rate, 1.0);
+
+    wav.samples[2 * i] = (int16_t)lrint(32767.0 * amplitude * cos(phase));
+    wav.samples[2 * i + 1] = (int16_t)lrint(32767.0 * amplitude * sin(phase));
+  }
+  return WavWrite(argv[1], wav) ? 0 : 1;
+}
@@ -0,0 +1,202 @@
+/**********************************************************************************
+  NCOTest: spurs of the FreqShift1() and FreqShift2() oscillators
+
+  Runs a complex tone through FreqShift1(), the Fs/4 shift, and FreqShift2(), the table NCO,
+  block by block as ProcessIQData() does, at several fine tuning offsets. The output is
+  analysed in double with a Kaiser window, whose sidelobes are far below the levels being
+  measured. The largest bin away from the shifted tone must be under NCO_SPUR_LIMIT, the
+  -100 dBc the table size is chosen for in SDT.h, and the tone must come out at
+  NCO_AMPLITUDE, the gain the old oscillator had.
+**********************************************************************************/
+#include <Arduino.h>
+#include "SDT.h"
+
+#define NCO_SPUR_LIMIT              -100.0          // dBc
+#define ANALYSIS_LENGTH             16384           // Samples, 8 blocks of BUFFER_SIZE * N_BLOCKS
+#define KAISER_BETA                 20.0            // Sidelobes near -150 dB
+#define CARRIER_BINS                12              // Either side of the tone, the window's main lobe
+
+static int failures = 0;
+static double outI[ANALYSIS_LENGTH], outQ[ANALYSIS_LENGTH], window[ANALYSIS_LENGTH];
+static double spectrumRe[ANALYSIS_LENGTH], spectrumIm[ANALYSIS_LENGTH];
+static double windowGain = 0.0;
+
+static double BesselI0(double x)
+{
+  double sum = 1.0, term = 1.0;
+
+  for (int k = 1; k < 50; k++) {
+    term *= (x / (2.0 * k)) * (x / (2.0 * k));
+    sum += term;
+  }
+  return sum;
+}
+
+/*****
+  Purpose: Windowed spectrum of the output, in place radix 2, bin k at k / ANALYSIS_LENGTH cycles
+
+  Parameter list:
+    void
+
+  Return value;
+    void
+*****/
+static void Spectrum()
+{
+  const int n = ANALYSIS_LENGTH;
+
+  for (int i = 0, j = 0; i < n; i++) {
+    if (i < j) {
+      std::swap(spectrumRe[i], spectrumRe[j]);
+      std::swap(spectrumIm[i], spectrumIm[j]);
+    }
+    int bit = n >> 1;
+    for (; j & bit; bit >>= 1) {
+      j ^= bit;
+    }
+    j |= bit;
+  }
+  for (int length = 2; length <= n; length <<= 1) {
+    double angle = -TWO_PI / length;
+
+    for (int start = 0; start < n; start += length) {
+      for (int k = 0; k < length / 2; k++) {
+        double c = cos(angle * k), s = sin(angle * k);
+        double *aRe = &spectrumRe[start + k], *aIm = &spectrumIm[start + k];
+        double *bRe = &spectrumRe[start + k + length / 2], *bIm = &spectrumIm[start + k + length / 2];
+        double tRe = *bRe * c - *bIm * s, tIm = *bRe * s + *bIm * c;
+
+        *bRe = *aRe - tRe;
+        *bIm = *aIm - tIm;
+        *aRe += tRe;
+        *aIm += tIm;
+      }
+    }
+  }
+}
+
+/*****
+  Purpose: Power of the windowed output at one frequency, to find the tone between bins
+
+  Parameter list:
+    double cycles           cycles per sample, -0.5 to 0.5
+
+  Return value;
+    double                  |X|^2, normalised so a full scale tone is 1
+*****/
+static double Power(double cycles)
+{
+  double re = 0.0, im = 0.0;
+
+  for (int n = 0; n < ANALYSIS_LENGTH; n++) {
+    double c = cos(TWO_PI * cycles * n), s = sin(TWO_PI * cycles * n);
+
+    re += window[n] * (outI[n] * c + outQ[n] * s);
+    im += window[n] * (outQ[n] * c - outI[n] * s);
+  }
+  return (re * re + im * im) / (windowGain * windowGain);
+}
+
+/*****
+  Purpose: Shift a tone with both oscillators and measure the result
+
+  Parameter list:
+    double toneHz           input offset from the center, at 192 kS/s
+    long ncoHz              NCOFreq
+
+  Return value;
+    void
+*****/
+static void Measure(double toneHz, long ncoHz)
+{
+  const uint32_t block = BUFFER_SIZE * N_BLOCKS;
+  const double rate = 192000.0;
+  const double amplitude = 0.5;
+  double peak = 0.0, peakAt = 0.0, carrier, spur = 0.0, spurAt = 0.0, gainDb;
+  uint32_t bins = ANALYSIS_LENGTH;
+
+  NCOFreq = ncoHz;
+  ncoPhase = 0;
+  for (uint32_t start = 0; start < ANALYSIS_LENGTH; start += block) {
+    for (uint32_t i = 0; i < block; i++) {
+      double w = TWO_PI * toneHz / rate * (start + i);
+
+      float_buffer_L[i] = amplitude * cos(w);   // I
+      float_buffer_R[i] = amplitude * sin(w);   // Q
+    }
+    FreqShift1();
+    FreqShift2();
+    for (uint32_t i = 0; i < block; i++) {
+      outI[start + i] = float_buffer_L[i];
+      outQ[start + i] = float_buffer_R[i];
+    }
+  }
+
+  for (uint32_t n = 0; n < bins; n++) {
+    spectrumRe[n] = window[n] * outI[n];
+    spectrumIm[n] = window[n] * outQ[n];
+  }
+  Spectrum();
+  for (uint32_t k = 0; k < bins; k++) {         // The tone's bin, then the tone between bins
+    double p = spectrumRe[k] * spectrumRe[k] + spectrumIm[k] * spectrumIm[k];
+
+    if (p > peak) {
+      peak = p;
+      peakAt = (k < bins / 2) ? (double)k / bins : (double)k / bins - 1.0;
+    }
+  }
+  peak = Power(peakAt);
+  for (double step = 0.5 / bins; step > 1e-9; step /= 2.0) {
+    double up = Power(peakAt + step), down = Power(peakAt - step);
+
+    if (up > peak) {
+      peak = up;
+      peakAt += step;
+    } else if (down > peak) {
+      peak = down;
+      peakAt -= step;
+    }
+  }
+  carrier = peak;
+  for (uint32_t k = 0; k < bins; k++) {
+    double f = (k < bins / 2) ? (double)k / bins : (double)k / bins - 1.0;
+    double distance = fabs(f - peakAt) * bins;
+
+    if (distance > CARRIER_BINS && distance < bins - CARRIER_BINS) {
+      double p = (spectrumRe[k] * spectrumRe[k] + spectrumIm[k] * spectrumIm[k]) / (windowGain * windowGain);
+
+      if (p > spur) {
+        spur = p;
+        spurAt = f;
+      }
+    }
+  }
+  spur = 10.0 * log10(spur / carrier);
+  gainDb = 10.0 * log10(carrier) - 20.0 * log10(amplitude * NCO_AMPLITUDE);
+  printf("tone %8.0f Hz, NCO %6ld Hz: out %9.2f Hz, gain %+6.3f dB, largest spur %7.1f dBc at %9.1f Hz %s\n",
+         toneHz, ncoHz, peakAt * rate, gainDb, spur, spurAt * rate,
+         (spur < NCO_SPUR_LIMIT && fabs(gainDb) < 0.01) ? "ok" : "FAIL");
+  failures += !(spur < NCO_SPUR_LIMIT && fabs(gainDb) < 0.01);
+}
+
+int main()
+{
+  for (int n = 0; n < ANALYSIS_LENGTH; n++) {
+    double r = 2.0 * n / (ANALYSIS_LENGTH - 1) - 1.0;
+
+    window[n] = BesselI0(KAISER_BETA * sqrt(1.0 - r * r)) / BesselI0(KAISER_BETA);
+    windowGain += window[n];
+  }
+  InitNCOTable();
+  xmtMode = SSB_MODE;
+  Measure(-37123.0, 1234);
+  Measure(-45000.0, -7777);
+  Measure(-60321.0, 23456);
+  Measure(10007.0, 40000);
+
+  if (failures > 0) {
+    printf("%d FAILED\n", failures);
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,153 @@
+/**********************************************************************************
+  Replay: run the receive chain on Linux
+
+  Reads 192 kS/s stereo I/Q from a WAV file, runs it through the sketch as built for the
+  radio, from setup() and loop() down to ProcessIQData(), and writes the audio the chain sends
+  to the codec to another WAV file. The channels are taken as IQReplay.cpp takes them, so a
+  file made for IQ_REPLAY on the radio replays the same way here.
+
+  The audio library's DMA is an IntervalTimer that runs every AUDIO_BLOCK_SAMPLES frames of
+  the input: it puts a block in Q_in_R and Q_in_L and takes whatever the chain has put in
+  Q_out_L and Q_out_R. The DSP task runs from the sketch's own dspTimer, so the receive
+  chain, the spectrum handoff and the display code all run as they do on the radio, on the
+  simulated clock described in shim/Arduino.h.
+
+  Like the codec, the DMA never stops: it sends silence until the DSP task is running, then
+  the file, then silence again. ShowSpectrum() waits for the DSP task, so loop() would hang
+  if the samples stopped. The output starts with the file and is as long as it; the end of
+  the file comes out after the latency of the chain, with the start of the silence after it.
+
+  Usage: Replay [-m usb|lsb|am|sam] [-v] in.wav out.wav
+**********************************************************************************/
+#include <Arduino.h>
+#include "SDT.h"
+#include "HostSetup.h"
+#include "Wav.h"
+
+void loop();                                      // SDTVer042.ino
+
+static Wav input;
+static Wav output;
+static uint32_t inputFrame = 0;
+static int replayStarted = 0;
+static IntervalTimer audioDMA;
+
+/*****
+  Purpose: One audio library update: a block of I/Q in and the finished audio out
+
+  Parameter list:
+    void
+
+  Return value;
+    void
+*****/
+static void AudioDMA()
+{
+  int16_t left[AUDIO_BLOCK_SAMPLES];
+  int16_t right[AUDIO_BLOCK_SAMPLES];
+
+  if (!replayStarted && DSPTaskRunning() == 1) {
+    replayStarted = 1;
+    Q_out_L.HostClear();                          // The audio so far is from the silence
+    Q_out_R.HostClear();
+  }
+  for (int i = 0; i < AUDIO_BLOCK_SAMPLES; i++) {
+    uint32_t frame = inputFrame + i;
+
+    right[i] = replayStarted && frame < input.Frames() ? input.samples[2 * frame] : 0;      // I, sp_L1 in ProcessIQData()
+    left[i] = replayStarted && frame < input.Frames() ? input.samples[2 * frame + 1] : 0;   // Q
+  }
+  Q_in_R.HostWrite(right);
+  Q_in_L.HostWrite(left);
+  if (replayStarted) {
+    inputFrame += AUDIO_BLOCK_SAMPLES;
+  }
+  while (Q_out_L.HostAvailable() > 0 && Q_out_R.HostAvailable() > 0) {
+    Q_out_L.HostRead(left);
+    Q_out_R.HostRead(right);
+    for (int i = 0; i < AUDIO_BLOCK_SAMPLES && output.Frames() < input.Frames(); i++) {
+      output.samples.push_back(left[i]);
+      output.samples.push_back(right[i]);
+    }
+  }
+}
+
+/*****
+  Purpose: Step the demodulation mode as the Demodulation button does
+
+  Parameter list:
+    int mode                DEMOD_USB, DEMOD_LSB, DEMOD_AM or DEMOD_SAM
+
+  Return value;
+    void
+*****/
+static void SelectMode(int mode)
+{
+  for (int i = 0; i <= DEMOD_MAX && bands[currentBand].mode != mode; i++) {
+    ButtonDemodMode();
+  }
+}
+
+static int Usage()
+{
+  fprintf(stderr, "Usage: Replay [-m usb|lsb|am|sam] [-v] in.wav out.wav\n");
+  return 2;
+}
+
+int main(int argc, char **argv)
+{
+  int mode = -1;
+  int verbose = 0;
+  int i;
+
+  for (i = 1; i < argc && argv[i][0] == '-'; i++) {
+    if (strcmp(argv[i], "-v") == 0) {
+      verbose = 1;
+    } else if (strcmp(argv[i], "-m") == 0 && i + 1 < argc) {
+      i++;
+      if (strcmp(argv[i], "usb") == 0) {
+        mode = DEMOD_USB;
+      } else if (strcmp(argv[i], "lsb") == 0) {
+        mode = DEMOD_LSB;
+      } else if (strcmp(argv[i], "am") == 0) {
+        mode = DEMOD_AM;
+      } else if (strcmp(argv[i], "sam") == 0) {
+        mode = DEMOD_SAM;
+      } else {
+        return Usage();
+      }
+    } else {
+      return Usage();
+    }
+  }
+  if (argc - i != 2) {
+    return Usage();
+  }
+  if (!WavRead(argv[i], input)) {
+    return 1;
+  }
+  if (input.channels != 2) {
+    fprintf(stderr, "%s: I/Q needs 2 channels, not %d\n", argv[i], input.channels);
+    return 1;
+  }
+  if (input.rate != SR[SampleRate].rate) {
+    fprintf(stderr, "%s: %lu S/s, the chain runs at %lu; played at that rate\n", argv[i], (unsigned long)input.rate, (unsigned long)SR[SampleRate].rate);
+  }
+  output.rate = SR[SampleRate].rate;
+  output.channels = 2;
+
+  HostSerialQuiet(!verbose);
+  HostSetup();
+  if (mode >= 0) {
+    SelectMode(mode);
+  }
+  audioDMA.begin(AudioDMA, 1e6 * AUDIO_BLOCK_SAMPLES / SR[SampleRate].rate);
+  while (output.Frames() < input.Frames()) {
+    loop();
+  }
+  audioDMA.end();
+  if (verbose) {
+    ProfilePrintReport();
+  }
+  return WavWrite(argv[i + 1], output) ? 0 : 1;
+}
@@ -0,0 +1,131 @@
+/**********************************************************************************
+  16 bit PCM WAV files for the host programs. The reader takes any chunk layout, as written
+  by Audacity, sox or WriteWAVHeader() on the radio; the writer writes the canonical 44 byte
+  header.
+**********************************************************************************/
+#include "Wav.h"
+#include <stdio.h>
+#include <string.h>
+
+static uint32_t Le32(const uint8_t *p)
+{
+  return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint16_t Le16(const uint8_t *p)
+{
+  return p[0] | (p[1] << 8);
+}
+
+static void Put32(uint8_t *p, uint32_t v)
+{
+  p[0] = v;
+  p[1] = v >> 8;
+  p[2] = v >> 16;
+  p[3] = v >> 24;
+}
+
+static void Put16(uint8_t *p, uint16_t v)
+{
+  p[0] = v;
+  p[1] = v >> 8;
+}
+
+/*****
+  Purpose: Read a 16 bit PCM WAV file
+
+  Parameter list:
+    const char *path        the file
+    Wav &wav                filled in from it
+
+  Return value;
+    int                     1 on success, 0 with a message on stderr
+*****/
+int WavRead(const char *path, Wav &wav)
+{
+  FILE *f = fopen(path, "rb");
+  uint8_t header[12];
+  uint8_t chunk[8];
+  uint8_t fmt[16];
+  int haveFormat = 0;
+
+  if (f == NULL) {
+    fprintf(stderr, "%s: cannot open\n", path);
+    return 0;
+  }
+  if (fread(header, 1, 12, f) != 12 || memcmp(header, "RIFF", 4) != 0 || memcmp(header + 8, "WAVE", 4) != 0) {
+    fprintf(stderr, "%s: not a WAV file\n", path);
+    fclose(f);
+    return 0;
+  }
+  while (fread(chunk, 1, 8, f) == 8) {
+    uint32_t size = Le32(chunk + 4);
+
+    if (memcmp(chunk, "fmt ", 4) == 0 && size >= 16) {
+      if (fread(fmt, 1, 16, f) != 16) {
+        break;
+      }
+      if (Le16(fmt) != 1 || Le16(fmt + 14) != 16) {
+        fprintf(stderr, "%s: only 16 bit PCM is read\n", path);
+        fclose(f);
+        return 0;
+      }
+      wav.channels = Le16(fmt + 2);
+      wav.rate = Le32(fmt + 4);
+      haveFormat = 1;
+      fseek(f, size - 16 + (size & 1), SEEK_CUR);
+    } else if (memcmp(chunk, "data", 4) == 0 && haveFormat) {
+      wav.samples.resize(size / 2);
+      wav.samples.resize(fread(wav.samples.data(), 2, size / 2, f));        // Short if the file was cut off
+      wav.samples.resize(wav.samples.size() / wav.channels * wav.channels);
+      fclose(f);
+      return 1;
+    } else {
+      fseek(f, size + (size & 1), SEEK_CUR);
+    }
+  }
+  fprintf(stderr, "%s: no format or data chunk\n", path);
+  fclose(f);
+  return 0;
+}
+
+/*****
+  Purpose: Write a 16 bit PCM WAV file
+
+  Parameter list:
+    const char *path        the file
+    const Wav &wav          what to write
+
+  Return value;
+    int                     1 on success, 0 with a message on stderr
+*****/
+int WavWrite(const char *path, const Wav &wav)
+{
+  FILE *f = fopen(path, "wb");
+  uint8_t header[44];
+  uint32_t dataBytes = wav.samples.size() * 2;
+  int ok;
+
+  if (f == NULL) {
+    fprintf(stderr, "%s: cannot create\n", path);
+    return 0;
+  }
+  memcpy(header, "RIFF", 4);
+  Put32(header + 4, 36 + dataBytes);
+  memcpy(header + 8, "WAVEfmt ", 8);
+  Put32(header + 16, 16);
+  Put16(header + 20, 1);
+  Put16(header + 22, wav.channels);
+  Put32(header + 24, wav.rate);
+  Put32(header + 28, wav.rate * wav.channels * 2);
+  Put16(header + 32, wav.channels * 2);
+  Put16(header + 34, 16);
+  memcpy(header + 36, "data", 4);
+  Put32(header + 40, dataBytes);
+  ok = fwrite(header, 1, 44, f) == 44 && fwrite(wav.samples.data(), 2, wav.samples.size(), f) == wav.samples.size();
+  ok = (fclose(f) == 0) && ok;
+  if (!ok) {
+    fprintf(stderr, "%s: write failed\n", path);
+  }
+  return ok;
+}
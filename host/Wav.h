@@ -0,0 +1,21 @@
+/**********************************************************************************
+  16 bit PCM WAV files for the host programs
+**********************************************************************************/
+#ifndef HOST_WAV_H
+#define HOST_WAV_H
+
+#include <stdint.h>
+#include <vector>
+
+struct Wav {
+  uint32_t rate = 192000;
+  uint16_t channels = 2;
+  std::vector<int16_t> samples;                   // Interleaved frames
+
+  uint32_t Frames() const { return channels ? samples.size() / channels : 0; }
+};
+
+int WavRead(const char *path, Wav &wav);          // 1 on success, with a message on stderr if not
+int WavWrite(const char *path, const Wav &wav);
+
+#endif
@@ -0,0 +1,30 @@
+/**********************************************************************************
+  Host stand-in for the Adafruit GFX font types
+
+  The sketch only uses the GFXfont and GFXglyph structures, for the fixed-width FreeMono fonts
+  it hands to the RA8875 library. The host fonts in Fonts/ keep their metrics but not their
+  bitmaps, see HostFont.h.
+**********************************************************************************/
+#ifndef HOST_ADAFRUIT_GFX_H
+#define HOST_ADAFRUIT_GFX_H
+
+#include "Arduino.h"
+
+typedef struct {
+  uint16_t bitmapOffset;
+  uint8_t width;
+  uint8_t height;
+  uint8_t xAdvance;
+  int8_t xOffset;
+  int8_t yOffset;
+} GFXglyph;
+
+typedef struct {
+  uint8_t *bitmap;
+  GFXglyph *glyph;
+  uint16_t first;
+  uint16_t last;
+  uint8_t yAdvance;
+} GFXfont;
+
+#endif
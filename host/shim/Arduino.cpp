@@ -0,0 +1,371 @@
+/**********************************************************************************
+  Host stand-in for the Teensy 4.1 core, the parts that are not inline. See Arduino.h.
+**********************************************************************************/
+#include "Arduino.h"
+#include <string>
+
+#define HOST_TIMERS                 4               // PIT channels
+
+static uint64_t hostMicros = 0;
+static IntervalTimer *hostTimers[HOST_TIMERS];
+static int hostInInterrupt = 0;
+static int hostPins[256];
+static int hostAnalog[256];
+static std::string hostSerialInput;
+static int hostSerialQuiet = 0;
+
+volatile uint32_t hostDwtCycles = 0;
+volatile uint32_t hostRegister = 0;
+volatile uint32_t hostTempSense[2] = { 0x4U | (1476U << 8), 0 };   // Finished, 40 C
+usb_serial_class Serial;
+struct digital_pin_bitband_and_config_table_struct digital_pin_to_info_PGM[64];
+static volatile uint32_t hostPinRegisters[64][3];
+
+static struct HostPinTable {
+  HostPinTable()
+  {
+    for (int i = 0; i < 64; i++) {
+      digital_pin_to_info_PGM[i].reg = &hostPinRegisters[i][0];
+      digital_pin_to_info_PGM[i].mux = &hostPinRegisters[i][1];
+      digital_pin_to_info_PGM[i].pad = &hostPinRegisters[i][2];
+    }
+    for (int i = 0; i < 256; i++) {
+      hostAnalog[i] = 1023;                       // Full scale, the switch ladder with no button down
+    }
+  }
+} hostPinTable;
+
+//================================ Simulated time ================
+/*****
+  Purpose: Move the clock on, calling each IntervalTimer at every tick it passes. A timer's
+           function runs with the clock at its tick, and nothing interrupts it.
+
+  Parameter list:
+    uint64_t us             microseconds
+
+  Return value;
+    void
+*****/
+static void HostClock(uint64_t us)
+{
+  uint64_t target = hostMicros + us;
+
+  if (hostInInterrupt) {
+    hostMicros = target;
+    return;
+  }
+  for (;;) {
+    IntervalTimer *due = NULL;
+
+    for (int i = 0; i < HOST_TIMERS; i++) {       // The earliest tick, the lowest channel first
+      if (hostTimers[i] != NULL && hostTimers[i]->next <= (double)target && (due == NULL || hostTimers[i]->next < due->next)) {
+        due = hostTimers[i];
+      }
+    }
+    if (due == NULL) {
+      break;
+    }
+    if ((double)hostMicros < due->next) {
+      hostMicros = (uint64_t)due->next;
+    }
+    due->next += due->period;
+    hostInInterrupt = 1;
+    due->callback();
+    hostInInterrupt = 0;
+  }
+  if (hostMicros < target) {
+    hostMicros = target;
+  }
+}
+
+uint32_t millis()
+{
+  HostClock(1);
+  return (uint32_t)(hostMicros / 1000);
+}
+
+uint32_t micros()
+{
+  HostClock(1);
+  return (uint32_t)hostMicros;
+}
+
+void delay(uint32_t ms)
+{
+  HostClock((uint64_t)ms * 1000);
+}
+
+void delayMicroseconds(uint32_t us)
+{
+  HostClock(us);
+}
+
+void yield()
+{
+}
+
+void HostAdvanceMicros(uint64_t us)
+{
+  HostClock(us);
+}
+
+uint64_t HostMicros()
+{
+  return hostMicros;
+}
+
+uint32_t HostCycleCount()
+{
+  HostClock(1);
+  return (uint32_t)(hostMicros * (F_CPU_ACTUAL / 1000000));
+}
+
+bool IntervalTimer::begin(void (*function)(), float microseconds)
+{
+  end();
+  if (function == NULL || microseconds <= 0.0) {
+    return false;
+  }
+  for (int i = 0; i < HOST_TIMERS; i++) {
+    if (hostTimers[i] == NULL) {
+      callback = function;
+      period = microseconds;
+      next = (double)hostMicros + period;
+      hostTimers[i] = this;
+      return true;
+    }
+  }
+  return false;                                   // All channels in use, as on the Teensy
+}
+
+void IntervalTimer::end()
+{
+  for (int i = 0; i < HOST_TIMERS; i++) {
+    if (hostTimers[i] == this) {
+      hostTimers[i] = NULL;
+    }
+  }
+  callback = NULL;
+}
+
+//================================ Pins ================
+void pinMode(uint8_t pin, uint8_t mode)
+{
+  if (mode == INPUT_PULLUP) {
+    hostPins[pin] = HIGH;
+  }
+}
+
+int digitalRead(uint8_t pin)
+{
+  HostClock(1);
+  return hostPins[pin];
+}
+
+void digitalWrite(uint8_t pin, uint8_t value)
+{
+  hostPins[pin] = value;
+}
+
+int analogRead(uint8_t pin)
+{
+  HostClock(1);
+  return hostAnalog[pin];
+}
+
+void analogWrite(uint8_t, int) {}
+void analogReadResolution(unsigned) {}
+void tone(uint8_t, uint16_t, uint32_t) {}
+void noTone(uint8_t) {}
+void attachInterrupt(uint8_t, void (*)(void), int) {}
+void detachInterrupt(uint8_t) {}
+
+void HostSetPin(uint8_t pin, int value)
+{
+  hostPins[pin] = value;
+}
+
+void HostSetAnalog(uint8_t pin, int value)
+{
+  hostAnalog[pin] = value;
+}
+
+extern "C" uint32_t set_arm_clock(uint32_t frequency)
+{
+  return frequency;
+}
+
+float tempmonGetTemp(void)
+{
+  return 40.0;
+}
+
+//================================ Numbers ================
+long map(long x, long in_min, long in_max, long out_min, long out_max)
+{
+  if (in_max == in_min) {
+    return out_min;
+  }
+  return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+static uint32_t hostRandomState = 1;
+
+long random(long howbig)
+{
+  if (howbig <= 0) {
+    return 0;
+  }
+  hostRandomState = hostRandomState * 1103515245 + 12345;       // Repeatable, unlike rand()
+  return (hostRandomState >> 1) % howbig;
+}
+
+long random(long howsmall, long howbig)
+{
+  if (howsmall >= howbig) {
+    return howsmall;
+  }
+  return random(howbig - howsmall) + howsmall;
+}
+
+void randomSeed(unsigned long seed)
+{
+  hostRandomState = seed ? seed : 1;
+}
+
+char *ultoa(unsigned long value, char *str, int radix)
+{
+  char digits[sizeof(long) * 8 + 1];
+  int n = 0;
+
+  do {
+    int d = value % radix;
+    digits[n++] = d < 10 ? '0' + d : 'a' + d - 10;
+    value /= radix;
+  } while (value);
+  for (int i = 0; i < n; i++) {
+    str[i] = digits[n - 1 - i];
+  }
+  str[n] = '\0';
+  return str;
+}
+
+char *ltoa(long value, char *str, int radix)
+{
+  if (value < 0 && radix == 10) {
+    str[0] = '-';
+    ultoa(-(unsigned long)value, str + 1, radix);
+    return str;
+  }
+  return ultoa((unsigned long)value, str, radix);
+}
+
+char *itoa(int value, char *str, int radix)
+{
+  if (radix != 10) {
+    return ultoa((unsigned)value, str, radix);
+  }
+  return ltoa(value, str, radix);
+}
+
+char *dtostrf(float number, signed char width, unsigned char prec, char *s)
+{
+  sprintf(s, "%*.*f", width, prec, number);
+  return s;
+}
+
+//================================ Print and Serial ================
+size_t Print::write(const uint8_t *buffer, size_t size)
+{
+  size_t n = 0;
+
+  while (size--) {
+    n += write(*buffer++);
+  }
+  return n;
+}
+
+size_t Print::print(long n, int base)
+{
+  char buffer[sizeof(long) * 8 + 2];
+
+  return write(ltoa(n, buffer, base));
+}
+
+size_t Print::print(unsigned long n, int base)
+{
+  char buffer[sizeof(long) * 8 + 2];
+
+  return write(ultoa(n, buffer, base));
+}
+
+size_t Print::print(double n, int digits)
+{
+  char buffer[64];
+
+  snprintf(buffer, sizeof(buffer), "%.*f", digits, n);
+  return write(buffer);
+}
+
+size_t Print::printf(const char *format, ...)
+{
+  char buffer[512];
+  va_list args;
+  int n;
+
+  va_start(args, format);
+  n = vsnprintf(buffer, sizeof(buffer), format, args);
+  va_end(args);
+  if (n < 0) {
+    return 0;
+  }
+  return write((const uint8_t *)buffer, ((size_t)n < sizeof(buffer) ? (size_t)n : sizeof(buffer) - 1));
+}
+
+int usb_serial_class::available()
+{
+  return hostSerialInput.size();
+}
+
+int usb_serial_class::read()
+{
+  int c;
+
+  if (hostSerialInput.empty()) {
+    return -1;
+  }
+  c = (uint8_t)hostSerialInput[0];
+  hostSerialInput.erase(0, 1);
+  return c;
+}
+
+int usb_serial_class::peek()
+{
+  return hostSerialInput.empty() ? -1 : (uint8_t)hostSerialInput[0];
+}
+
+size_t usb_serial_class::write(uint8_t b)
+{
+  if (!hostSerialQuiet) {
+    putchar(b);
+  }
+  return 1;
+}
+
+size_t usb_serial_class::write(const uint8_t *buffer, size_t size)
+{
+  if (!hostSerialQuiet) {
+    fwrite(buffer, 1, size, stdout);
+  }
+  return size;
+}
+
+void HostSerialInput(const char *text)
+{
+  hostSerialInput += text;
+}
+
+void HostSerialQuiet(int quiet)
+{
+  hostSerialQuiet = quiet;
+}
@@ -0,0 +1,252 @@
+/**********************************************************************************
+  Host stand-in for the Teensy 4.1 core
+
+  Just enough of the Arduino and Teensy core for the sketch to compile and run on Linux. Time
+  is simulated: millis() and micros() read a clock that only the host program and delay()
+  move on, plus one microsecond for each call to the clock or a pin, so that busy-wait loops
+  such as MyDelay() still end. Interrupts are IntervalTimers: whenever the clock moves past a
+  timer's next tick its function is called, one at a time and never nested, as if it had
+  interrupted the code that read the clock. Host programs start their own IntervalTimers to
+  stand in for the audio DMA. Pins read as released buttons and registers are plain
+  variables. See host/README.md.
+**********************************************************************************/
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+#include <string>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <time.h>
+
+typedef bool boolean;
+typedef uint8_t byte;
+typedef uint16_t word;
+typedef unsigned long ulong;
+
+#define DMAMEM
+#define FASTRUN
+#define FLASHMEM
+#define PROGMEM
+#define EXTMEM
+#define F(s)                        (s)
+
+#define HIGH                        1
+#define LOW                         0
+#define INPUT                       0
+#define OUTPUT                      1
+#define INPUT_PULLUP                2
+#define INPUT_PULLDOWN              3
+#define CHANGE                      4
+#define FALLING                     2
+#define RISING                      3
+#define DEC                         10
+#define HEX                         16
+#define OCT                         8
+#define BIN                         2
+#define BUILTIN_SDCARD              254
+
+#ifndef PI
+#define PI                          3.1415926535897932384626433832795
+#endif
+#define HALF_PI                     1.5707963267948966192313216916398
+#define TWO_PI                      6.283185307179586476925286766559
+#define DEG_TO_RAD                  0.017453292519943295769236907684886
+#define RAD_TO_DEG                  57.295779513082320876798154814105
+
+#define F_CPU                       600000000
+#define F_CPU_ACTUAL                600000000UL
+
+// As in the Teensy core, min() and max() take mixed types
+#define min(a, b)                   ({ __typeof__(a) _a = (a); __typeof__(b) _b = (b); (_a < _b) ? _a : _b; })
+#define max(a, b)                   ({ __typeof__(a) _a = (a); __typeof__(b) _b = (b); (_a > _b) ? _a : _b; })
+#define constrain(amt, low, high)   ({ __typeof__(amt) _amt = (amt); __typeof__(low) _low = (low); __typeof__(high) _high = (high); (_amt < _low) ? _low : ((_amt > _high) ? _high : _amt); })
+#define sq(x)                       ((x) * (x))
+#define lowByte(w)                  ((uint8_t)((w) & 0xff))
+#define highByte(w)                 ((uint8_t)((w) >> 8))
+#define bitRead(value, bit)         (((value) >> (bit)) & 0x01)
+
+//================================ Simulated time ================
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+void HostAdvanceMicros(uint64_t us);              // Host programs move the clock on
+uint64_t HostMicros();
+
+class elapsedMillis {
+  uint32_t ms;
+public:
+  elapsedMillis() { ms = millis(); }
+  elapsedMillis(uint32_t val) { ms = millis() - val; }
+  operator uint32_t() const { return millis() - ms; }
+  elapsedMillis &operator=(uint32_t val) { ms = millis() - val; return *this; }
+  elapsedMillis &operator-=(uint32_t val) { ms += val; return *this; }
+  elapsedMillis &operator+=(uint32_t val) { ms -= val; return *this; }
+};
+
+class elapsedMicros {
+  uint32_t us;
+public:
+  elapsedMicros() { us = micros(); }
+  elapsedMicros(uint32_t val) { us = micros() - val; }
+  operator uint32_t() const { return micros() - us; }
+  elapsedMicros &operator=(uint32_t val) { us = micros() - val; return *this; }
+  elapsedMicros &operator-=(uint32_t val) { us += val; return *this; }
+  elapsedMicros &operator+=(uint32_t val) { us -= val; return *this; }
+};
+
+//================================ Pins and interrupts ================
+void pinMode(uint8_t pin, uint8_t mode);
+int digitalRead(uint8_t pin);
+void digitalWrite(uint8_t pin, uint8_t value);
+int analogRead(uint8_t pin);
+void analogWrite(uint8_t pin, int value);
+void analogReadResolution(unsigned bits);
+void tone(uint8_t pin, uint16_t frequency, uint32_t duration = 0);
+void noTone(uint8_t pin);
+void attachInterrupt(uint8_t pin, void (*function)(void), int mode);
+void detachInterrupt(uint8_t pin);
+#define digitalPinToInterrupt(p)    (p)
+#define interrupts()
+#define noInterrupts()
+#define __disable_irq()
+#define __enable_irq()
+#define __DSB()                     __asm__ volatile("" ::: "memory")
+#define IRQ_PIT                     122
+#define NVIC_ENABLE_IRQ(n)
+#define NVIC_DISABLE_IRQ(n)
+
+class IntervalTimer {
+public:
+  ~IntervalTimer() { end(); }
+  bool begin(void (*function)(), float microseconds);
+  void end();
+  void priority(uint8_t) {}
+  void update(float microseconds) { period = microseconds; }
+  void (*callback)() = NULL;
+  double period = 0.0;
+  double next = 0.0;                              // Simulated microseconds of the next tick
+};
+
+void HostSetPin(uint8_t pin, int value);          // For host programs, digitalRead() returns this
+void HostSetAnalog(uint8_t pin, int value);       // And analogRead() this
+
+long map(long x, long in_min, long in_max, long out_min, long out_max);
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+
+char *itoa(int value, char *str, int radix);
+char *ltoa(long value, char *str, int radix);
+char *ultoa(unsigned long value, char *str, int radix);
+char *dtostrf(float number, signed char width, unsigned char prec, char *s);
+
+//================================ Registers ================
+extern volatile uint32_t hostDwtCycles;
+extern volatile uint32_t hostRegister;
+#define ARM_DWT_CYCCNT              HostCycleCount()
+#define ARM_DWT_CTRL                hostRegister
+#define ARM_DWT_CTRL_CYCCNTENA      1
+#define ARM_DEMCR                   hostRegister
+#define ARM_DEMCR_TRCENA            1
+uint32_t HostCycleCount();                        // F_CPU_ACTUAL cycles a simulated microsecond
+
+#define CCM_CS1CDR                  hostRegister
+#define CCM_CS2CDR                  hostRegister
+#define CCM_CS1CDR_SAI1_CLK_PRED_MASK 0
+#define CCM_CS1CDR_SAI1_CLK_PODF_MASK 0
+#define CCM_CS2CDR_SAI2_CLK_PRED_MASK 0
+#define CCM_CS2CDR_SAI2_CLK_PODF_MASK 0
+#define CCM_CS1CDR_SAI1_CLK_PRED(n) (n)
+#define CCM_CS1CDR_SAI1_CLK_PODF(n) (n)
+#define CCM_CS2CDR_SAI2_CLK_PRED(n) (n)
+#define CCM_CS2CDR_SAI2_CLK_PODF(n) (n)
+// The temperature monitor reads a steady 40 C from a fuse calibration of 105 C at count 1370
+// and 25 C at count 1500
+extern volatile uint32_t hostTempSense[2];
+#define TEMPMON_TEMPSENSE0          hostTempSense[0]
+#define TEMPMON_TEMPSENSE1          hostTempSense[1]
+#define HW_OCOTP_ANA1               ((1500U << 20) | (1370U << 8) | 105U)
+#define IOMUXC_PAD_DSE(n)           (n)
+#define IOMUXC_PAD_SPEED(n)         (n)
+
+struct digital_pin_bitband_and_config_table_struct {
+  volatile uint32_t *reg;
+  volatile uint32_t *mux;
+  volatile uint32_t *pad;
+  uint32_t mask;
+};
+extern struct digital_pin_bitband_and_config_table_struct digital_pin_to_info_PGM[];
+
+extern "C" uint32_t set_arm_clock(uint32_t frequency);
+float tempmonGetTemp(void);
+
+//================================ Print and Serial ================
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t b) = 0;
+  virtual size_t write(const uint8_t *buffer, size_t size);
+  size_t write(const char *str) { return write((const uint8_t *)str, strlen(str)); }
+  size_t write(const char *buffer, size_t size) { return write((const uint8_t *)buffer, size); }
+  size_t print(const char *s) { return write(s); }
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t print(int n, int base = DEC) { return print((long)n, base); }
+  size_t print(unsigned int n, int base = DEC) { return print((unsigned long)n, base); }
+  size_t print(long n, int base = DEC);
+  size_t print(unsigned long n, int base = DEC);
+  size_t print(long long n, int base = DEC) { return print((long)n, base); }
+  size_t print(unsigned long long n, int base = DEC) { return print((unsigned long)n, base); }
+  size_t print(double n, int digits = 2);
+  size_t println() { return write("\r\n"); }
+  template <typename T> size_t println(T value) { size_t n = print(value); return n + println(); }
+  template <typename T> size_t println(T value, int format) { size_t n = print(value, format); return n + println(); }
+  size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3)));
+};
+
+class usb_serial_class : public Print {
+public:
+  void begin(long) {}
+  void end() {}
+  int available();
+  int read();
+  int peek();
+  void flush() { fflush(stdout); }
+  size_t write(uint8_t b) override;
+  size_t write(const uint8_t *buffer, size_t size) override;
+  using Print::write;
+  operator bool() { return true; }
+};
+extern usb_serial_class Serial;
+void HostSerialInput(const char *text);           // Characters Serial.read() returns next
+void HostSerialQuiet(int quiet);                  // Drop Serial output, for tests
+
+class String {
+  char buffer[64];
+public:
+  String(const char *s = "") { snprintf(buffer, sizeof(buffer), "%s", s); }
+  String(long n) { snprintf(buffer, sizeof(buffer), "%ld", n); }
+  String(int n) { snprintf(buffer, sizeof(buffer), "%d", n); }
+  String(double f, int digits = 2) { snprintf(buffer, sizeof(buffer), "%.*f", digits, f); }
+  const char *c_str() const { return buffer; }
+  unsigned length() const { return strlen(buffer); }
+  long toInt() const { return atol(buffer); }
+  float toFloat() const { return atof(buffer); }
+  void toCharArray(char *buf, unsigned bufsize) const { if (bufsize) snprintf(buf, bufsize, "%s", buffer); }
+  operator const char *() const { return buffer; }
+};
+
+#endif
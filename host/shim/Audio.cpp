@@ -0,0 +1,46 @@
+/**********************************************************************************
+  Host stand-in for the Teensy Audio library queues. See Audio.h.
+**********************************************************************************/
+#include "Audio.h"
+
+int16_t *AudioRecordQueue::readBuffer()
+{
+  if (blocks.empty()) {
+    return NULL;
+  }
+  reading = blocks.front();
+  blocks.pop_front();
+  return reading.data();
+}
+
+void AudioRecordQueue::freeBuffer()
+{
+}
+
+void AudioRecordQueue::HostWrite(const int16_t *block)
+{
+  if (running) {
+    blocks.emplace_back(block, block + AUDIO_BLOCK_SAMPLES);
+  }
+}
+
+int16_t *AudioPlayQueue::getBuffer()
+{
+  writing.assign(AUDIO_BLOCK_SAMPLES, 0);
+  return writing.data();
+}
+
+void AudioPlayQueue::playBuffer()
+{
+  blocks.push_back(writing);
+}
+
+int AudioPlayQueue::HostRead(int16_t *block)
+{
+  if (blocks.empty()) {
+    return 0;
+  }
+  memcpy(block, blocks.front().data(), AUDIO_BLOCK_SAMPLES * sizeof(int16_t));
+  blocks.pop_front();
+  return 1;
+}
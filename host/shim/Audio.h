@@ -0,0 +1,115 @@
+/**********************************************************************************
+  Host stand-in for the Teensy Audio library
+
+  The DSP chain talks to the audio library only through AudioRecordQueue and AudioPlayQueue.
+  Here those are plain FIFOs of AUDIO_BLOCK_SAMPLES blocks: a host program writes I/Q into the
+  record queues with HostWrite() and takes the demodulated audio out of the play queues with
+  HostRead(). The other objects, the codec controls and the patch cords, only keep the
+  settings they are given.
+**********************************************************************************/
+#ifndef HOST_AUDIO_H
+#define HOST_AUDIO_H
+
+#include "Arduino.h"
+#include <deque>
+#include <vector>
+
+#define AUDIO_BLOCK_SAMPLES         128
+#define AUDIO_SAMPLE_RATE_EXACT     44117.64706
+#define AUDIO_SAMPLE_RATE           AUDIO_SAMPLE_RATE_EXACT
+#define AUDIO_INPUT_LINEIN          0
+#define AUDIO_INPUT_MIC             1
+
+#define AudioMemory(n)
+#define AudioNoInterrupts()
+#define AudioInterrupts()
+#define AudioProcessorUsage()       0.0
+#define AudioProcessorUsageMax()    0.0
+#define AudioMemoryUsage()          0
+#define AudioMemoryUsageMax()       0
+
+class AudioStream {
+public:
+  virtual ~AudioStream() {}
+};
+
+class AudioRecordQueue : public AudioStream {
+  std::deque<std::vector<int16_t>> blocks;
+  std::vector<int16_t> reading;
+  int running = 0;
+public:
+  void begin() { running = 1; }
+  void end() { running = 0; }
+  int available() { return blocks.size(); }
+  void clear() { blocks.clear(); }
+  int16_t *readBuffer();
+  void freeBuffer();
+  void HostWrite(const int16_t *block);           // One block of AUDIO_BLOCK_SAMPLES, dropped unless begun
+  int HostRunning() { return running; }
+};
+
+class AudioPlayQueue : public AudioStream {
+  std::deque<std::vector<int16_t>> blocks;
+  std::vector<int16_t> writing;
+public:
+  int16_t *getBuffer();
+  void playBuffer();
+  void setMaxBuffers(uint8_t) {}
+  int HostAvailable() { return blocks.size(); }
+  int HostRead(int16_t *block);                   // 1 and one block of AUDIO_BLOCK_SAMPLES if there is one
+  void HostClear() { blocks.clear(); }
+};
+
+class AudioInputI2SQuad : public AudioStream {};
+class AudioOutputI2SQuad : public AudioStream {};
+class AudioInputI2S : public AudioStream {};
+class AudioOutputI2S : public AudioStream {};
+
+class AudioMixer4 : public AudioStream {
+public:
+  float gains[4] = { 1.0, 1.0, 1.0, 1.0 };
+  void gain(unsigned int channel, float level) { if (channel < 4) gains[channel] = level; }
+};
+
+class AudioAmplifier : public AudioStream {
+public:
+  void gain(float) {}
+};
+
+class AudioSynthWaveformSine : public AudioStream {
+public:
+  void amplitude(float) {}
+  void frequency(float) {}
+};
+
+class AudioConnection {
+public:
+  AudioConnection(AudioStream &, unsigned char, AudioStream &, unsigned char) {}
+  AudioConnection(AudioStream &, AudioStream &) {}
+};
+
+class AudioControlSGTL5000 {
+public:
+  bool enable() { return true; }
+  bool disable() { return true; }
+  void setAddress(uint8_t) {}
+  bool inputSelect(int) { return true; }
+  bool volume(float) { return true; }
+  bool micGain(unsigned int) { return true; }
+  bool lineInLevel(uint8_t) { return true; }
+  bool lineInLevel(uint8_t, uint8_t) { return true; }
+  unsigned short lineOutLevel(uint8_t) { return 0; }
+  unsigned short adcHighPassFilterDisable() { return 0; }
+  unsigned short adcHighPassFilterEnable() { return 0; }
+  unsigned short audioPreProcessorEnable() { return 0; }
+  unsigned short audioPostProcessorEnable() { return 0; }
+  unsigned short autoVolumeControl(uint8_t, uint8_t, uint8_t, float, float, float) { return 0; }
+  unsigned short autoVolumeEnable() { return 0; }
+  unsigned short autoVolumeDisable() { return 0; }
+  bool muteHeadphone() { return true; }
+  bool unmuteHeadphone() { return true; }
+  bool muteLineout() { return true; }
+  bool unmuteLineout() { return true; }
+};
+
+#endif
@@ -0,0 +1,23 @@
+#ifndef HOST_BOUNCE_H
+#define HOST_BOUNCE_H
+
+#include "Arduino.h"
+
+class Bounce {
+  uint8_t pin;
+  int state;
+  int previous;
+public:
+  Bounce(uint8_t pin, unsigned long) : pin(pin), state(HIGH), previous(HIGH) {}
+  int update()
+  {
+    previous = state;
+    state = digitalRead(pin);
+    return state != previous;
+  }
+  int read() { return state; }
+  bool fallingEdge() { return previous == HIGH && state == LOW; }
+  bool risingEdge() { return previous == LOW && state == HIGH; }
+};
+
+#endif
@@ -0,0 +1,29 @@
+#ifndef HOST_EEPROM_H
+#define HOST_EEPROM_H
+
+#include "Arduino.h"
+
+#define E2END                       4283
+
+class EEPROMClass {
+public:
+  uint8_t data[E2END + 1];
+  EEPROMClass() { memset(data, 0xFF, sizeof(data)); }           // Erased
+  uint8_t read(int index) { return data[index]; }
+  void write(int index, uint8_t value) { data[index] = value; }
+  void update(int index, uint8_t value) { data[index] = value; }
+  uint16_t length() { return E2END + 1; }
+  template <typename T> T &get(int index, T &t)
+  {
+    memcpy((void *)&t, &data[index], sizeof(T) <= sizeof(data) - index ? sizeof(T) : sizeof(data) - index);
+    return t;
+  }
+  template <typename T> const T &put(int index, const T &t)
+  {
+    memcpy(&data[index], (const void *)&t, sizeof(T) <= sizeof(data) - index ? sizeof(T) : sizeof(data) - index);
+    return t;
+  }
+};
+extern EEPROMClass EEPROM;
+
+#endif
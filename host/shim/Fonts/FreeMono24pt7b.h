@@ -0,0 +1,3 @@
+#include "HostFont.h"
+
+HOST_GFX_FONT(FreeMono24pt7b, 24, 30, 28, 47);
@@ -0,0 +1,3 @@
+#include "HostFont.h"
+
+HOST_GFX_FONT(FreeMono9pt7b, 8, 12, 11, 18);
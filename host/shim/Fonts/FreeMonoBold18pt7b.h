@@ -0,0 +1,3 @@
+#include "HostFont.h"
+
+HOST_GFX_FONT(FreeMonoBold18pt7b, 18, 23, 21, 35);
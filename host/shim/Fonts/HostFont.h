@@ -0,0 +1,27 @@
+/**********************************************************************************
+  Host versions of the FreeMono GFX fonts
+
+  Each font has the advance, line height and glyph box of the Adafruit original for every
+  printable character, so layout code such as WidgetFontText() sees the same cell sizes. There
+  are no bitmaps: the display emulator draws the characters with its own font, scaled to the
+  glyph box.
+**********************************************************************************/
+#ifndef HOST_FONT_H
+#define HOST_FONT_H
+
+#include "../Adafruit_GFX.h"
+
+#define HOST_GLYPH(w, h, adv, yo)   { 0, w, h, adv, 0, yo }
+#define HOST_GLYPHS8(w, h, adv, yo) HOST_GLYPH(w, h, adv, yo), HOST_GLYPH(w, h, adv, yo), HOST_GLYPH(w, h, adv, yo), HOST_GLYPH(w, h, adv, yo), \
+                                    HOST_GLYPH(w, h, adv, yo), HOST_GLYPH(w, h, adv, yo), HOST_GLYPH(w, h, adv, yo), HOST_GLYPH(w, h, adv, yo)
+#define HOST_GLYPHS95(w, h, adv, yo) HOST_GLYPHS8(w, h, adv, yo), HOST_GLYPHS8(w, h, adv, yo), HOST_GLYPHS8(w, h, adv, yo), HOST_GLYPHS8(w, h, adv, yo), \
+                                    HOST_GLYPHS8(w, h, adv, yo), HOST_GLYPHS8(w, h, adv, yo), HOST_GLYPHS8(w, h, adv, yo), HOST_GLYPHS8(w, h, adv, yo), \
+                                    HOST_GLYPHS8(w, h, adv, yo), HOST_GLYPHS8(w, h, adv, yo), HOST_GLYPHS8(w, h, adv, yo), \
+                                    HOST_GLYPH(w, h, adv, yo), HOST_GLYPH(w, h, adv, yo), HOST_GLYPH(w, h, adv, yo), HOST_GLYPH(w, h, adv, yo), \
+                                    HOST_GLYPH(w, h, adv, yo), HOST_GLYPH(w, h, adv, yo), HOST_GLYPH(w, h, adv, yo)
+
+#define HOST_GFX_FONT(name, width, height, advance, yAdvance) \
+  static GFXglyph name##Glyphs[95] = { HOST_GLYPHS95(width, height, advance, -(height)) }; \
+  static const GFXfont name = { NULL, name##Glyphs, 0x20, 0x7E, yAdvance }
+
+#endif
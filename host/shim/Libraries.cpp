@@ -0,0 +1,65 @@
+/**********************************************************************************
+  Host stand-ins for the library globals, the clock and the Teensy linker symbols
+**********************************************************************************/
+#include "Arduino.h"
+#include "TimeLib.h"
+#include "Wire.h"
+#include "SPI.h"
+#include "EEPROM.h"
+#include "utility/imxrt_hw.h"
+
+TwoWire Wire;
+SPIClass SPI;
+EEPROMClass EEPROM;
+teensy3_clock_class Teensy3Clock;
+
+// MemoryMap.cpp reports the sections from these. On the host the numbers mean nothing.
+unsigned long _stext, _etext, _sdata, _ebss, _estack, _heap_start, _heap_end, _itcm_block_count;
+
+static time_t hostTimeOffset = 1700000000;      // The time at simulated micros() 0
+
+void set_audioClock(int, int32_t, uint32_t, bool)
+{
+}
+
+unsigned long teensy3_clock_class::get()
+{
+  return (unsigned long)(hostTimeOffset + HostMicros() / 1000000);
+}
+
+void teensy3_clock_class::set(unsigned long t)
+{
+  hostTimeOffset = (time_t)t - (time_t)(HostMicros() / 1000000);
+}
+
+void setSyncProvider(getExternalTime)
+{
+}
+
+void setTime(time_t t)
+{
+  Teensy3Clock.set(t);
+}
+
+time_t now()
+{
+  return Teensy3Clock.get();
+}
+
+static struct tm HostTime()
+{
+  time_t t = now();
+  struct tm tm;
+
+  gmtime_r(&t, &tm);
+  return tm;
+}
+
+int hour() { return HostTime().tm_hour; }
+int hourFormat12() { int h = hour() % 12; return h ? h : 12; }
+int minute() { return HostTime().tm_min; }
+int second() { return HostTime().tm_sec; }
+int day() { return HostTime().tm_mday; }
+int month() { return HostTime().tm_mon + 1; }
+int year() { return HostTime().tm_year + 1900; }
+int weekday() { return HostTime().tm_wday + 1; }
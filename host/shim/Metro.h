@@ -0,0 +1,23 @@
+#ifndef HOST_METRO_H
+#define HOST_METRO_H
+
+#include "Arduino.h"
+
+class Metro {
+  unsigned long previous_millis;
+  unsigned long interval_millis;
+public:
+  Metro(unsigned long interval_millis = 1000) : previous_millis(millis()), interval_millis(interval_millis) {}
+  void interval(unsigned long interval) { interval_millis = interval; }
+  void reset() { previous_millis = millis(); }
+  char check()
+  {
+    if (millis() - previous_millis >= interval_millis) {
+      previous_millis = millis();
+      return 1;
+    }
+    return 0;
+  }
+};
+
+#endif
@@ -0,0 +1,38 @@
+/**********************************************************************************
+  Host stand-in for the OpenAudio library objects the transmit path declares
+**********************************************************************************/
+#ifndef HOST_OPENAUDIO_H
+#define HOST_OPENAUDIO_H
+
+#include "Audio.h"
+
+#define AudioMemory_F32(n)
+
+class AudioStream_F32 : public AudioStream {};
+class AudioConvert_I16toF32 : public AudioStream_F32 {};
+class AudioConvert_F32toI16 : public AudioStream_F32 {};
+
+class AudioEffectGain_F32 : public AudioStream_F32 {
+public:
+  void setGain(float) {}
+  void setGain_dB(float) {}
+};
+
+class AudioEffectCompressor_F32 : public AudioStream_F32 {
+public:
+  void setPreGain_dB(float) {}
+  void setThresh_dBFS(float) {}
+  void setCompressionRatio(float) {}
+  void setAttack_sec(float, float) {}
+  void setRelease_sec(float, float) {}
+  void enableHPFilter(bool) {}
+};
+
+class AudioConnection_F32 {
+public:
+  AudioConnection_F32(AudioStream_F32 &, unsigned char, AudioStream_F32 &, unsigned char) {}
+};
+
+class AudioControlSGTL5000_Extended : public AudioControlSGTL5000 {};
+
+#endif
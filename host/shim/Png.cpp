@@ -0,0 +1,216 @@
+/**********************************************************************************
+  8 bit RGB PNG files. The writer filters every row with None and leaves the rest to zlib,
+  which keeps the mostly black screen images small. The reader takes any non-interlaced 8 bit
+  RGB or RGBA file with any filters, so an image from another tool can be used as a reference.
+**********************************************************************************/
+#include "Png.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zlib.h>
+
+static const uint8_t pngSignature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+
+static uint32_t Be32(const uint8_t *p)
+{
+  return ((uint32_t)p[0] << 24) | (p[1] << 16) | (p[2] << 8) | p[3];
+}
+
+static void Put32(uint8_t *p, uint32_t v)
+{
+  p[0] = v >> 24;
+  p[1] = v >> 16;
+  p[2] = v >> 8;
+  p[3] = v;
+}
+
+/*****
+  Purpose: Write one chunk: length, type, data and the CRC of type and data
+
+  Parameter list:
+    FILE *f
+    const char *type        four characters
+    const uint8_t *data
+    uint32_t length
+
+  Return value;
+    int                     1 if it was written
+*****/
+static int PngChunk(FILE *f, const char *type, const uint8_t *data, uint32_t length)
+{
+  uint8_t word[4];
+  uLong crc = crc32(0, (const Bytef *)type, 4);
+
+  if (length > 0) {
+    crc = crc32(crc, data, length);
+  }
+  Put32(word, length);
+  if (fwrite(word, 1, 4, f) != 4 || fwrite(type, 1, 4, f) != 4 || (length > 0 && fwrite(data, 1, length, f) != length)) {
+    return 0;
+  }
+  Put32(word, crc);
+  return fwrite(word, 1, 4, f) == 4;
+}
+
+/*****
+  Purpose: The Paeth predictor of the PNG filters
+
+  Parameter list:
+    int a, b, c             the bytes left, above and above left
+
+  Return value;
+    int                     whichever of them is nearest a + b - c
+*****/
+static int Paeth(int a, int b, int c)
+{
+  int p = a + b - c;
+  int pa = abs(p - a);
+  int pb = abs(p - b);
+  int pc = abs(p - c);
+
+  if (pa <= pb && pa <= pc) {
+    return a;
+  }
+  return pb <= pc ? b : c;
+}
+
+/*****
+  Purpose: Write an 8 bit RGB PNG file
+
+  Parameter list:
+    const char *path        the file
+    int width, height
+    const std::vector<uint8_t> &rgb   width * height pixels, rows top down
+
+  Return value;
+    int                     1 on success, 0 with a message on stderr
+*****/
+int PngWrite(const char *path, int width, int height, const std::vector<uint8_t> &rgb)
+{
+  std::vector<uint8_t> raw((size_t)height * (width * 3 + 1));
+  std::vector<uint8_t> packed;
+  uLongf packedLength;
+  uint8_t header[13] = { 0 };
+  FILE *f;
+  int ok;
+
+  for (int y = 0; y < height; y++) {
+    raw[(size_t)y * (width * 3 + 1)] = 0;                     // Filter None
+    memcpy(&raw[(size_t)y * (width * 3 + 1) + 1], &rgb[(size_t)y * width * 3], width * 3);
+  }
+  packedLength = compressBound(raw.size());
+  packed.resize(packedLength);
+  if (compress2(packed.data(), &packedLength, raw.data(), raw.size(), Z_BEST_COMPRESSION) != Z_OK) {
+    fprintf(stderr, "%s: cannot compress the image\n", path);
+    return 0;
+  }
+  Put32(header, width);
+  Put32(header + 4, height);
+  header[8] = 8;                                              // Bits a sample
+  header[9] = 2;                                              // RGB
+  f = fopen(path, "wb");
+  if (f == NULL) {
+    fprintf(stderr, "%s: cannot create\n", path);
+    return 0;
+  }
+  ok = fwrite(pngSignature, 1, 8, f) == 8
+       && PngChunk(f, "IHDR", header, sizeof(header))
+       && PngChunk(f, "IDAT", packed.data(), packedLength)
+       && PngChunk(f, "IEND", NULL, 0);
+  if (fclose(f) != 0 || !ok) {
+    fprintf(stderr, "%s: write failed\n", path);
+    return 0;
+  }
+  return 1;
+}
+
+/*****
+  Purpose: Read an 8 bit RGB or RGBA PNG file, without its alpha
+
+  Parameter list:
+    const char *path        the file
+    int &width, &height     set from the file
+    std::vector<uint8_t> &rgb   set to width * height pixels, rows top down
+
+  Return value;
+    int                     1 on success, 0 with a message on stderr
+*****/
+int PngRead(const char *path, int &width, int &height, std::vector<uint8_t> &rgb)
+{
+  FILE *f = fopen(path, "rb");
+  std::vector<uint8_t> packed;
+  std::vector<uint8_t> raw;
+  uint8_t signature[8];
+  uint8_t chunk[8];
+  uint8_t header[13] = { 0 };
+  int haveHeader = 0;
+  int channels;
+  size_t stride;
+  uLongf rawLength;
+
+  if (f == NULL) {
+    fprintf(stderr, "%s: cannot open\n", path);
+    return 0;
+  }
+  if (fread(signature, 1, 8, f) != 8 || memcmp(signature, pngSignature, 8) != 0) {
+    fprintf(stderr, "%s: not a PNG file\n", path);
+    fclose(f);
+    return 0;
+  }
+  while (fread(chunk, 1, 8, f) == 8) {
+    uint32_t length = Be32(chunk);
+    size_t at = packed.size();
+
+    if (memcmp(chunk + 4, "IHDR", 4) == 0 && length == 13) {
+      haveHeader = fread(header, 1, 13, f) == 13;
+    } else if (memcmp(chunk + 4, "IDAT", 4) == 0) {
+      packed.resize(at + length);
+      if (fread(&packed[at], 1, length, f) != length) {
+        break;
+      }
+    } else if (memcmp(chunk + 4, "IEND", 4) == 0) {
+      break;
+    } else {
+      fseek(f, length, SEEK_CUR);
+    }
+    fseek(f, 4, SEEK_CUR);                                    // CRC, zlib checks the data
+  }
+  fclose(f);
+  channels = header[9] == 2 ? 3 : header[9] == 6 ? 4 : 0;
+  if (!haveHeader || header[8] != 8 || channels == 0 || header[12] != 0) {
+    fprintf(stderr, "%s: only 8 bit RGB or RGBA, not interlaced, is read\n", path);
+    return 0;
+  }
+  width = Be32(header);
+  height = Be32(header + 4);
+  stride = (size_t)width * channels;
+  rawLength = height * (stride + 1);
+  raw.resize(rawLength);
+  if (uncompress(raw.data(), &rawLength, packed.data(), packed.size()) != Z_OK || rawLength != raw.size()) {
+    fprintf(stderr, "%s: bad image data\n", path);
+    return 0;
+  }
+  rgb.resize((size_t)width * height * 3);
+  for (int y = 0; y < height; y++) {
+    uint8_t *row = &raw[y * (stride + 1) + 1];
+    const uint8_t *up = y > 0 ? row - (stride + 1) : NULL;
+    int filter = row[-1];
+
+    for (size_t i = 0; i < stride; i++) {
+      int a = i >= (size_t)channels ? row[i - channels] : 0;
+      int b = up ? up[i] : 0;
+      int c = up && i >= (size_t)channels ? up[i - channels] : 0;
+
+      switch (filter) {
+        case 1: row[i] += a; break;
+        case 2: row[i] += b; break;
+        case 3: row[i] += (a + b) / 2; break;
+        case 4: row[i] += Paeth(a, b, c); break;
+      }
+    }
+    for (int x = 0; x < width; x++) {
+      memcpy(&rgb[((size_t)y * width + x) * 3], &row[x * channels], 3);
+    }
+  }
+  return 1;
+}
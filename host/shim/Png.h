@@ -0,0 +1,14 @@
+/**********************************************************************************
+  8 bit RGB PNG files, for the display emulator's screen images
+**********************************************************************************/
+#ifndef HOST_PNG_H
+#define HOST_PNG_H
+
+#include <stdint.h>
+#include <vector>
+
+// rgb is width * height pixels of R, G and B, rows top down
+int PngRead(const char *path, int &width, int &height, std::vector<uint8_t> &rgb);    // 1 on success, with a message on stderr if not
+int PngWrite(const char *path, int width, int height, const std::vector<uint8_t> &rgb);
+
+#endif
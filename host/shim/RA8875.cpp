@@ -0,0 +1,549 @@
+/**********************************************************************************
+  Host RA8875: the controller's memory, what the panel shows of it and the SPI traffic the
+  library sends, see RA8875.h
+**********************************************************************************/
+#include "RA8875.h"
+#include "Png.h"
+#include <math.h>
+
+#define SCREEN_WIDTH        800
+#define SCREEN_HEIGHT       480
+
+// 5x7 characters 0x20 to 0x7E, a byte a column, the top row in bit 0
+static const uint8_t font5x7[95][5] = {
+  { 0x00, 0x00, 0x00, 0x00, 0x00 }, { 0x00, 0x00, 0x5F, 0x00, 0x00 }, { 0x00, 0x07, 0x00, 0x07, 0x00 }, { 0x14, 0x7F, 0x14, 0x7F, 0x14 },
+  { 0x24, 0x2A, 0x7F, 0x2A, 0x12 }, { 0x23, 0x13, 0x08, 0x64, 0x62 }, { 0x36, 0x49, 0x55, 0x22, 0x50 }, { 0x00, 0x05, 0x03, 0x00, 0x00 },
+  { 0x00, 0x1C, 0x22, 0x41, 0x00 }, { 0x00, 0x41, 0x22, 0x1C, 0x00 }, { 0x08, 0x2A, 0x1C, 0x2A, 0x08 }, { 0x08, 0x08, 0x3E, 0x08, 0x08 },
+  { 0x00, 0x50, 0x30, 0x00, 0x00 }, { 0x08, 0x08, 0x08, 0x08, 0x08 }, { 0x00, 0x60, 0x60, 0x00, 0x00 }, { 0x20, 0x10, 0x08, 0x04, 0x02 },
+  { 0x3E, 0x51, 0x49, 0x45, 0x3E }, { 0x00, 0x42, 0x7F, 0x40, 0x00 }, { 0x42, 0x61, 0x51, 0x49, 0x46 }, { 0x21, 0x41, 0x45, 0x4B, 0x31 },
+  { 0x18, 0x14, 0x12, 0x7F, 0x10 }, { 0x27, 0x45, 0x45, 0x45, 0x39 }, { 0x3C, 0x4A, 0x49, 0x49, 0x30 }, { 0x01, 0x71, 0x09, 0x05, 0x03 },
+  { 0x36, 0x49, 0x49, 0x49, 0x36 }, { 0x06, 0x49, 0x49, 0x29, 0x1E }, { 0x00, 0x36, 0x36, 0x00, 0x00 }, { 0x00, 0x56, 0x36, 0x00, 0x00 },
+  { 0x08, 0x14, 0x22, 0x41, 0x00 }, { 0x14, 0x14, 0x14, 0x14, 0x14 }, { 0x00, 0x41, 0x22, 0x14, 0x08 }, { 0x02, 0x01, 0x51, 0x09, 0x06 },
+  { 0x32, 0x49, 0x79, 0x41, 0x3E }, { 0x7E, 0x11, 0x11, 0x11, 0x7E }, { 0x7F, 0x49, 0x49, 0x49, 0x36 }, { 0x3E, 0x41, 0x41, 0x41, 0x22 },
+  { 0x7F, 0x41, 0x41, 0x22, 0x1C }, { 0x7F, 0x49, 0x49, 0x49, 0x41 }, { 0x7F, 0x09, 0x09, 0x09, 0x01 }, { 0x3E, 0x41, 0x49, 0x49, 0x7A },
+  { 0x7F, 0x08, 0x08, 0x08, 0x7F }, { 0x00, 0x41, 0x7F, 0x41, 0x00 }, { 0x20, 0x40, 0x41, 0x3F, 0x01 }, { 0x7F, 0x08, 0x14, 0x22, 0x41 },
+  { 0x7F, 0x40, 0x40, 0x40, 0x40 }, { 0x7F, 0x02, 0x0C, 0x02, 0x7F }, { 0x7F, 0x04, 0x08, 0x10, 0x7F }, { 0x3E, 0x41, 0x41, 0x41, 0x3E },
+  { 0x7F, 0x09, 0x09, 0x09, 0x06 }, { 0x3E, 0x41, 0x51, 0x21, 0x5E }, { 0x7F, 0x09, 0x19, 0x29, 0x46 }, { 0x46, 0x49, 0x49, 0x49, 0x31 },
+  { 0x01, 0x01, 0x7F, 0x01, 0x01 }, { 0x3F, 0x40, 0x40, 0x40, 0x3F }, { 0x1F, 0x20, 0x40, 0x20, 0x1F }, { 0x3F, 0x40, 0x38, 0x40, 0x3F },
+  { 0x63, 0x14, 0x08, 0x14, 0x63 }, { 0x07, 0x08, 0x70, 0x08, 0x07 }, { 0x61, 0x51, 0x49, 0x45, 0x43 }, { 0x00, 0x7F, 0x41, 0x41, 0x00 },
+  { 0x02, 0x04, 0x08, 0x10, 0x20 }, { 0x00, 0x41, 0x41, 0x7F, 0x00 }, { 0x04, 0x02, 0x01, 0x02, 0x04 }, { 0x40, 0x40, 0x40, 0x40, 0x40 },
+  { 0x00, 0x01, 0x02, 0x04, 0x00 }, { 0x20, 0x54, 0x54, 0x54, 0x78 }, { 0x7F, 0x48, 0x44, 0x44, 0x38 }, { 0x38, 0x44, 0x44, 0x44, 0x20 },
+  { 0x38, 0x44, 0x44, 0x48, 0x7F }, { 0x38, 0x54, 0x54, 0x54, 0x18 }, { 0x08, 0x7E, 0x09, 0x01, 0x02 }, { 0x0C, 0x52, 0x52, 0x52, 0x3E },
+  { 0x7F, 0x08, 0x04, 0x04, 0x78 }, { 0x00, 0x44, 0x7D, 0x40, 0x00 }, { 0x20, 0x40, 0x44, 0x3D, 0x00 }, { 0x7F, 0x10, 0x28, 0x44, 0x00 },
+  { 0x00, 0x41, 0x7F, 0x40, 0x00 }, { 0x7C, 0x04, 0x18, 0x04, 0x78 }, { 0x7C, 0x08, 0x04, 0x04, 0x78 }, { 0x38, 0x44, 0x44, 0x44, 0x38 },
+  { 0x7C, 0x14, 0x14, 0x14, 0x08 }, { 0x08, 0x14, 0x14, 0x18, 0x7C }, { 0x7C, 0x08, 0x04, 0x04, 0x08 }, { 0x48, 0x54, 0x54, 0x54, 0x20 },
+  { 0x04, 0x3F, 0x44, 0x40, 0x20 }, { 0x3C, 0x40, 0x40, 0x20, 0x7C }, { 0x1C, 0x20, 0x40, 0x20, 0x1C }, { 0x3C, 0x40, 0x30, 0x40, 0x3C },
+  { 0x44, 0x28, 0x10, 0x28, 0x44 }, { 0x0C, 0x50, 0x50, 0x50, 0x3C }, { 0x44, 0x64, 0x54, 0x4C, 0x44 }, { 0x00, 0x08, 0x36, 0x41, 0x00 },
+  { 0x00, 0x00, 0x7F, 0x00, 0x00 }, { 0x00, 0x41, 0x36, 0x08, 0x00 }, { 0x08, 0x04, 0x08, 0x10, 0x08 }
+};
+
+// Traffic
+
+void RA8875::Registers(int count)
+{
+  counters.transactions += 2 * count;             // Command, then data
+  counters.spiBytes += 4 * count;
+  counters.registerWrites += count;
+}
+
+void RA8875::RegisterReadModifyWrite()
+{
+  counters.transactions += 2;                     // Command, then a data read
+  counters.spiBytes += 4;
+  Registers(1);
+}
+
+void RA8875::StatusRead()
+{
+  counters.transactions++;
+  counters.spiBytes += 2;
+  counters.statusReads++;
+}
+
+void RA8875::MemoryWrite(uint32_t count)
+{
+  counters.transactions += 2;                     // The MRWC command, then the pixels in one
+  counters.spiBytes += 2 + 1 + count * (colorDepth / 8);
+  counters.pixels += count;
+}
+
+void RA8875::GraphicsMode()
+{
+  if (textMode) {
+    RegisterReadModifyWrite();
+    textMode = false;
+  }
+}
+
+void RA8875::GraphicsEngine(int registers)
+{
+  GraphicsMode();
+  Registers(registers);
+  StatusRead();                                   // Wait for the engine
+  counters.shapes++;
+}
+
+// Memory
+
+uint16_t RA8875::MemoryColor(uint16_t color) const
+{
+  if (colorDepth == 8) {                                      // RGB332, as the library converts
+    return ((color & 0xE000) >> 8) | ((color & 0x0700) >> 6) | ((color & 0x0018) >> 3);
+  }
+  return color;
+}
+
+void RA8875::Plot(int x, int y, uint16_t color)
+{
+  if (x >= 0 && x < SCREEN_WIDTH && y >= 0 && y < SCREEN_HEIGHT) {
+    memory[writeLayer][y * SCREEN_WIDTH + x] = MemoryColor(color);
+  }
+}
+
+void RA8875::Fill(int x, int y, int w, int h, uint16_t color)
+{
+  for (int row = y; row < y + h; row++) {
+    for (int column = x; column < x + w; column++) {
+      Plot(column, row, color);
+    }
+  }
+}
+
+/*****
+  Purpose: Draw a 5x7 character in the text color, stretched to a box
+
+  Parameter list:
+    uint8_t c               the character, others than 0x20 to 0x7E draw nothing
+    int x, y                top left of the box
+    int w, h
+
+  Return value;
+    void
+*****/
+void RA8875::Glyph(uint8_t c, int x, int y, int w, int h)
+{
+  if (c < 0x20 || c > 0x7E) {
+    return;
+  }
+  for (int row = 0; row < h; row++) {
+    for (int column = 0; column < w; column++) {
+      if (font5x7[c - 0x20][column * 5 / w] & (1 << (row * 7 / h))) {
+        Plot(x + column, y + row, textColor);
+      }
+    }
+  }
+}
+
+void RA8875::begin(const enum RA8875sizes, uint8_t colors, uint32_t writeClock, uint32_t)
+{
+  colorDepth = colors == 8 ? 8 : 16;
+  busClock = writeClock ? writeClock : 20000000UL;
+  memory[0].assign(SCREEN_WIDTH * SCREEN_HEIGHT, 0);
+  memory[1].assign(SCREEN_WIDTH * SCREEN_HEIGHT, 0);
+  counters = {};                                  // The initialisation is not counted
+}
+
+// Layers
+
+void RA8875::useLayers(bool on)
+{
+  RegisterReadModifyWrite();
+  layers = on && colorDepth == 8;                 // There is room for two 800x480 layers only at 8 bits
+}
+
+void RA8875::layerEffect(enum RA8875boolean efx)
+{
+  RegisterReadModifyWrite();
+  effect = efx;
+}
+
+void RA8875::writeTo(enum RA8875writes d)
+{
+  RegisterReadModifyWrite();
+  if (d == L1 || d == L2) {
+    writeLayer = d == L2 ? 1 : 0;
+  }
+}
+
+void RA8875::clearMemory(bool)
+{
+  Registers(1);
+  StatusRead();
+  memory[writeLayer].assign(SCREEN_WIDTH * SCREEN_HEIGHT, 0);
+}
+
+// Text
+
+void RA8875::setFontScale(uint8_t scale)
+{
+  RegisterReadModifyWrite();
+  fontScale = scale > 3 ? 3 : scale;
+}
+
+void RA8875::setTextColor(uint16_t color)
+{
+  Registers(3);
+  RegisterReadModifyWrite();                      // Transparent background
+  textColor = color;
+  textOpaque = false;
+}
+
+void RA8875::setTextColor(uint16_t color, uint16_t background)
+{
+  Registers(6);
+  RegisterReadModifyWrite();
+  textColor = color;
+  textBackground = background;
+  textOpaque = true;
+}
+
+/*****
+  Purpose: Print characters at the cursor and move it on
+
+  Parameter list:
+    const uint8_t *buffer
+    size_t size
+
+  Return value;
+    size_t                  size
+*****/
+size_t RA8875::write(const uint8_t *buffer, size_t size)
+{
+  if (size == 0) {
+    return 0;
+  }
+  if (gfxFont) {                                              // Drawn by the library, as a block a character
+    GraphicsMode();
+    for (size_t i = 0; i < size; i++) {
+      uint8_t c = buffer[i];
+      const GFXglyph *glyph;
+      int x, y;
+
+      if (c == '\n') {
+        cursorX = 0;
+        cursorY += gfxFont->yAdvance;
+        continue;
+      }
+      if (c < gfxFont->first || c > gfxFont->last) {
+        continue;
+      }
+      glyph = &gfxFont->glyph[c - gfxFont->first];
+      x = cursorX + glyph->xOffset;
+      y = cursorY + glyph->yOffset;
+      if (glyph->width > 0 && glyph->height > 0) {
+        Registers(8 + 4 + 8);                                 // Active window, cursor, window back
+        MemoryWrite(glyph->width * glyph->height);
+        if (textOpaque) {
+          Fill(x, y, glyph->width, glyph->height, textBackground);
+        }
+        Glyph(c, x + glyph->width / 8, y, glyph->width - glyph->width / 4, glyph->height);
+      }
+      cursorX += glyph->xAdvance;
+    }
+    return size;
+  }
+
+  int scale = fontScale + 1;
+  int cellW = 8 * scale;
+  int cellH = 16 * scale;
+
+  if (!textMode) {
+    RegisterReadModifyWrite();
+    textMode = true;
+  }
+  Registers(4);                                               // Cursor
+  counters.transactions++;                                    // MRWC
+  counters.spiBytes += 2;
+  for (size_t i = 0; i < size; i++) {
+    uint8_t c = buffer[i];
+
+    if (c == '\n') {
+      cursorX = 0;
+      cursorY += cellH;
+      continue;
+    }
+    counters.transactions++;
+    counters.spiBytes += 2;
+    counters.characters++;
+    StatusRead();                                             // Wait for the character to be drawn
+    if (textOpaque) {
+      Fill(cursorX, cursorY, cellW, cellH, textBackground);
+    }
+    Glyph(c, cursorX + scale, cursorY + 3 * scale, 5 * scale, 12 * scale);   // Where the ROM font has its capitals
+    cursorX += cellW;
+  }
+  return size;
+}
+
+// Drawing
+
+void RA8875::drawPixel(int16_t x, int16_t y, uint16_t color)
+{
+  GraphicsMode();
+  Registers(4);
+  MemoryWrite(1);
+  Plot(x, y, color);
+}
+
+void RA8875::drawPixels(uint16_t p[], uint16_t count, int16_t x, int16_t y)
+{
+  GraphicsMode();
+  Registers(4);
+  MemoryWrite(count);
+  for (int i = 0; i < count; i++) {
+    Plot(x + i, y, p[i]);
+  }
+}
+
+void RA8875::writeRect(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t *pcolors)
+{
+  if (w <= 0 || h <= 0) {
+    return;
+  }
+  GraphicsMode();
+  Registers(8 + 4);                                           // Active window and cursor
+  MemoryWrite(w * h);
+  Registers(8);                                               // The active window back to the screen
+  for (int row = 0; row < h; row++) {
+    for (int column = 0; column < w; column++) {
+      Plot(x + column, y + row, pcolors[row * w + column]);
+    }
+  }
+}
+
+void RA8875::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color)
+{
+  int dx = abs(x1 - x0);
+  int dy = -abs(y1 - y0);
+  int sx = x0 < x1 ? 1 : -1;
+  int sy = y0 < y1 ? 1 : -1;
+  int error = dx + dy;
+
+  GraphicsEngine(8 + 3 + 1);                                  // Coordinates, color and start
+  while (true) {
+    Plot(x0, y0, color);
+    if (x0 == x1 && y0 == y1) {
+      break;
+    }
+    if (2 * error >= dy) {
+      error += dy;
+      x0 += sx;
+    }
+    if (2 * error <= dx) {
+      error += dx;
+      y0 += sy;
+    }
+  }
+}
+
+void RA8875::drawLineAngle(int16_t x, int16_t y, int16_t angle, uint16_t length, uint16_t color, int offset)
+{
+  double radians = (angle + offset - 90) * M_PI / 180.0;      // 0 degrees is up
+
+  drawLine(x, y, x + (int16_t)(length * cos(radians)), y + (int16_t)(length * sin(radians)), color);
+}
+
+void RA8875::drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+  if (w <= 0 || h <= 0) {
+    return;
+  }
+  GraphicsEngine(8 + 3 + 1);
+  Fill(x, y, w, 1, color);
+  Fill(x, y + h - 1, w, 1, color);
+  Fill(x, y, 1, h, color);
+  Fill(x + w - 1, y, 1, h, color);
+}
+
+void RA8875::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+  if (w <= 0 || h <= 0) {
+    return;
+  }
+  GraphicsEngine(8 + 3 + 1);
+  Fill(x, y, w, h, color);
+}
+
+void RA8875::drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color)
+{
+  int x = r;
+  int y = 0;
+  int error = 1 - r;
+
+  GraphicsEngine(4 + 1 + 3 + 1);                              // Center, radius, color and start
+  while (x >= y) {
+    Plot(x0 + x, y0 + y, color);
+    Plot(x0 - x, y0 + y, color);
+    Plot(x0 + x, y0 - y, color);
+    Plot(x0 - x, y0 - y, color);
+    Plot(x0 + y, y0 + x, color);
+    Plot(x0 - y, y0 + x, color);
+    Plot(x0 + y, y0 - x, color);
+    Plot(x0 - y, y0 - x, color);
+    y++;
+    if (error < 0) {
+      error += 2 * y + 1;
+    } else {
+      x--;
+      error += 2 * (y - x) + 1;
+    }
+  }
+}
+
+void RA8875::fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color)
+{
+  GraphicsEngine(4 + 1 + 3 + 1);
+  for (int dy = -r; dy <= r; dy++) {
+    int dx = (int)sqrt((double)r * r - dy * dy);
+
+    Fill(x0 - dx, y0 + dy, 2 * dx + 1, 1, color);
+  }
+}
+
+// Scrolling and the BTE
+
+void RA8875::setScrollMode(enum RA8875scrollMode mode)
+{
+  RegisterReadModifyWrite();
+  scrollMode = mode;
+}
+
+void RA8875::setScrollWindow(int16_t XL, int16_t XR, int16_t YT, int16_t YB)
+{
+  Registers(8);
+  scrollLeft = XL;
+  scrollRight = XR;
+  scrollTop = YT;
+  scrollBottom = YB;
+  scrollX = 0;
+  scrollY = 0;
+}
+
+void RA8875::scroll(int16_t x, int16_t y)
+{
+  Registers(4);
+  scrollX = x;
+  scrollY = y;
+}
+
+/*****
+  Purpose: Copy a block of memory with the BTE, from one layer to another or within one
+
+  Parameter list:
+    int16_t SourceX, SourceY, Width, Height
+    int16_t DestX, DestY
+    uint8_t SourceLayer, DestLayer      1 or 2, 0 for the layer being written
+
+  Return value;
+    void
+*****/
+void RA8875::BTE_move(int16_t SourceX, int16_t SourceY, int16_t Width, int16_t Height, int16_t DestX, int16_t DestY,
+                      uint8_t SourceLayer, uint8_t DestLayer, bool, uint8_t, bool, bool)
+{
+  int from = SourceLayer == 0 ? writeLayer : SourceLayer - 1;
+  int to = DestLayer == 0 ? writeLayer : DestLayer - 1;
+  std::vector<uint16_t> block;
+
+  GraphicsMode();
+  Registers(4 + 4 + 4 + 1 + 1);                               // Source, destination, size, ROP and start
+  StatusRead();
+  counters.bteMoves++;
+  for (int row = 0; row < Height; row++) {
+    for (int column = 0; column < Width; column++) {
+      int x = SourceX + column;
+      int y = SourceY + row;
+
+      block.push_back(x >= 0 && x < SCREEN_WIDTH && y >= 0 && y < SCREEN_HEIGHT ? memory[from][y * SCREEN_WIDTH + x] : 0);
+    }
+  }
+  for (int row = 0; row < Height; row++) {
+    for (int column = 0; column < Width; column++) {
+      int x = DestX + column;
+      int y = DestY + row;
+
+      if (x >= 0 && x < SCREEN_WIDTH && y >= 0 && y < SCREEN_HEIGHT) {
+        memory[to][y * SCREEN_WIDTH + x] = block[row * Width + column];
+      }
+    }
+  }
+}
+
+// The panel
+
+uint32_t RA8875::ScreenRGB(uint16_t value) const
+{
+  if (colorDepth == 8) {
+    return (((value >> 5) * 255 / 7) << 16) | ((((value >> 2) & 7) * 255 / 7) << 8) | ((value & 3) * 255 / 3);
+  }
+  return ((((value >> 11) & 0x1F) * 255 / 31) << 16) | ((((value >> 5) & 0x3F) * 255 / 63) << 8) | ((value & 0x1F) * 255 / 31);
+}
+
+/*****
+  Purpose: What the panel shows: each layer through the scroll window, then the layer effect
+
+  Parameter list:
+    std::vector<uint8_t> &rgb   set to 800x480 pixels of R, G and B, rows top down
+
+  Return value;
+    void
+*****/
+void RA8875::HostScreen(std::vector<uint8_t> &rgb) const
+{
+  int windowW = scrollRight - scrollLeft + 1;
+  int windowH = scrollBottom - scrollTop + 1;
+  bool scroll1 = scrollMode != LAYER2ONLY;
+  bool scroll2 = scrollMode == SIMULTANEOUS || scrollMode == LAYER2ONLY;
+
+  rgb.resize(SCREEN_WIDTH * SCREEN_HEIGHT * 3);
+  for (int y = 0; y < SCREEN_HEIGHT; y++) {
+    for (int x = 0; x < SCREEN_WIDTH; x++) {
+      int plain = y * SCREEN_WIDTH + x;
+      int scrolled = plain;
+      uint16_t a, b, value;
+      uint32_t color;
+
+      if (windowW > 0 && windowH > 0 && x >= scrollLeft && x <= scrollRight && y >= scrollTop && y <= scrollBottom) {
+        int sx = scrollLeft + ((x - scrollLeft + scrollX) % windowW + windowW) % windowW;
+        int sy = scrollTop + ((y - scrollTop + scrollY) % windowH + windowH) % windowH;
+
+        scrolled = sy * SCREEN_WIDTH + sx;
+      }
+      a = memory[0][scroll1 ? scrolled : plain];
+      b = memory[1][scroll2 ? scrolled : plain];
+      value = a;
+      if (layers) {
+        switch (effect) {
+          case LAYER2:
+            value = b;
+            break;
+          case TRANSPARENT:
+            value = b != 0 ? b : a;                             // Black is the transparent color
+            break;
+          case LIGHTEN:
+            value = max(a & 0xE0, b & 0xE0) | max(a & 0x1C, b & 0x1C) | max(a & 0x03, b & 0x03);   // Each of R, G and B
+            break;
+          case OR:
+            value = a | b;
+            break;
+          case AND:
+            value = a & b;
+            break;
+          default:
+            break;
+        }
+      }
+      color = ScreenRGB(value);
+      rgb[plain * 3] = color >> 16;
+      rgb[plain * 3 + 1] = color >> 8;
+      rgb[plain * 3 + 2] = color;
+    }
+  }
+}
+
+int RA8875::HostSavePNG(const char *path) const
+{
+  std::vector<uint8_t> rgb;
+
+  HostScreen(rgb);
+  return PngWrite(path, SCREEN_WIDTH, SCREEN_HEIGHT, rgb);
+}
@@ -0,0 +1,173 @@
+/**********************************************************************************
+  Host stand-in for the RA8875 display library
+
+  The drawing calls the sketch makes, with the library's arguments, drawn into the
+  controller's memory: two 800x480 layers of 8 bit color, as begin(RA8875_800x480, 8) sets
+  up the radio's, or one of 16 bit color. HostScreen() returns what the panel shows, with
+  the layer effect and the scroll window applied as the controller applies them.
+
+  Each call also counts the SPI traffic the library sends for it: register writes are two
+  transactions of two bytes, command then data; status reads are one; memory writes are the
+  MRWC command and then one transaction carrying every pixel. The counts follow the library
+  call by call, so they are for comparing one version of the drawing code with another and
+  are close to, not exactly, what a logic analyser would see. The graphics engine and BTE
+  finish at once here, so each status poll is counted once.
+
+  ROM font text is drawn with a 5x7 font stretched over the rows of the 8x16 cell where the
+  ROM font has its capitals, scaled by the font scale. The GFX fonts in Fonts/ have no
+  bitmaps, so their characters are the same 5x7 font stretched to the glyph box, and are
+  counted as a block write of the box, as Widgets.cpp estimates them.
+**********************************************************************************/
+#ifndef HOST_RA8875_H
+#define HOST_RA8875_H
+
+#include "Arduino.h"
+#include "Adafruit_GFX.h"
+#include <vector>
+
+// RA8875_BLUE and RA8875_LIGHT_GREY are the sketch's own, in SDT.h
+#define RA8875_BLACK                0x0000
+#define RA8875_RED                  0xF800
+#define RA8875_GREEN                0x07E0
+#define RA8875_CYAN                 0x07FF
+#define RA8875_MAGENTA              0xF81F
+#define RA8875_YELLOW               0xFFE0
+#define RA8875_WHITE                0xFFFF
+#define RA8875_NAVY                 0x000F
+#define RA8875_DARK_GREEN           0x03E0
+#define RA8875_DARK_CYAN            0x03EF
+#define RA8875_MAROON               0x7800
+#define RA8875_PURPLE               0x780F
+#define RA8875_OLIVE                0x7BE0
+#define RA8875_DARK_GREY            0x7BEF
+#define RA8875_ORANGE               0xFD20
+#define RA8875_GREENYELLOW          0xAFE5
+#define RA8875_PINK                 0xF81F
+#define RA8875_LIGHT_ORANGE         0xFC80
+
+enum RA8875sizes { RA8875_480x272, RA8875_800x480, RA8875_800x480ALT, Adafruit_480x272, Adafruit_800x480 };
+enum RA8875tsize { X16 = 0, X24, X32 };
+enum RA8875writes { L1 = 0, L2, CGRAM, PATTERN, CURSOR };
+enum RA8875boolean { LAYER1, LAYER2, TRANSPARENT, LIGHTEN, OR, AND, FLOATING };
+enum RA8875scrollMode { SIMULTANEOUS, LAYER1ONLY, LAYER2ONLY, BUFFERED };
+
+// SPI traffic since the last HostResetCounters()
+struct RA8875Counters {
+  uint64_t spiBytes;                              // Every byte on MOSI and MISO, command bytes too
+  uint64_t transactions;                          // Chip select cycles
+  uint64_t registerWrites;
+  uint64_t statusReads;
+  uint64_t shapes;                                // Lines, rectangles and circles the graphics engine drew
+  uint64_t pixels;                                // Pixels sent through the memory write register
+  uint64_t characters;                            // ROM font characters
+  uint64_t bteMoves;
+};
+
+class RA8875 : public Print {
+protected:
+  int16_t cursorX = 0;
+  int16_t cursorY = 0;
+  uint16_t textColor = RA8875_WHITE;
+  uint16_t textBackground = RA8875_BLACK;
+  bool textOpaque = false;
+  uint8_t fontScale = 0;
+  const GFXfont *gfxFont = NULL;
+private:
+  std::vector<uint16_t> memory[2];                // Layer 1 and 2, in the controller's color format
+  uint8_t colorDepth = 16;
+  uint32_t busClock = 20000000UL;
+  int writeLayer = 0;
+  bool layers = false;
+  enum RA8875boolean effect = LAYER1;
+  bool textMode = false;
+  enum RA8875scrollMode scrollMode = SIMULTANEOUS;
+  int16_t scrollLeft = 0;
+  int16_t scrollRight = 799;
+  int16_t scrollTop = 0;
+  int16_t scrollBottom = 479;
+  int16_t scrollX = 0;
+  int16_t scrollY = 0;
+  RA8875Counters counters = {};
+
+  void Registers(int count);
+  void RegisterReadModifyWrite();
+  void StatusRead();
+  void MemoryWrite(uint32_t count);
+  void GraphicsEngine(int registers);
+  void GraphicsMode();
+  uint16_t MemoryColor(uint16_t color) const;
+  void Plot(int x, int y, uint16_t color);
+  void Fill(int x, int y, int w, int h, uint16_t color);
+  void Glyph(uint8_t c, int x, int y, int w, int h);
+  uint32_t ScreenRGB(uint16_t value) const;
+public:
+  RA8875(const uint8_t, const uint8_t = 255) : memory { std::vector<uint16_t>(800 * 480), std::vector<uint16_t>(800 * 480) } {}
+  void begin(const enum RA8875sizes, uint8_t colors = 16, uint32_t writeClock = 20000000UL, uint32_t = 0);
+  void setRotation(uint8_t) {}
+  int16_t width() const { return 800; }
+  int16_t height() const { return 480; }
+
+  void useLayers(bool on);
+  void layerEffect(enum RA8875boolean efx);
+  void writeTo(enum RA8875writes d);
+  void clearMemory(bool = false);
+  void clearScreen(uint16_t color = RA8875_BLACK) { fillWindow(color); }
+  void fillWindow(uint16_t color = RA8875_BLACK) { fillRect(0, 0, width(), height(), color); }
+
+  void setFontScale(uint8_t scale);
+  void setFontScale(uint8_t xscale, uint8_t) { setFontScale(xscale); }
+  void setFont(const GFXfont *font) { gfxFont = font; }
+  void setFontDefault() { gfxFont = NULL; }
+  uint8_t getFontWidth(bool = false) { return gfxFont ? gfxFont->glyph[0].xAdvance : 8 * (fontScale + 1); }
+  uint8_t getFontHeight(bool = false) { return gfxFont ? gfxFont->yAdvance : 16 * (fontScale + 1); }
+  void setTextColor(uint16_t color);
+  void setTextColor(uint16_t color, uint16_t background);
+  void setCursor(int16_t x, int16_t y, bool = false) { cursorX = x; cursorY = y; }
+  int16_t getCursorX() { return cursorX; }
+  int16_t getCursorY() { return cursorY; }
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  size_t write(const uint8_t *buffer, size_t size) override;
+  using Print::write;
+
+  void drawPixel(int16_t x, int16_t y, uint16_t color);
+  void drawPixels(uint16_t p[], uint16_t count, int16_t x, int16_t y);
+  void writeRect(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t *pcolors);
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) { drawLine(x, y, x, y + h - 1, color); }
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) { drawLine(x, y, x + w - 1, y, color); }
+  void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
+  void drawLineAngle(int16_t x, int16_t y, int16_t angle, uint16_t length, uint16_t color, int offset = 0);
+  void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+  void drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color);
+  void fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color);
+
+  void setScrollMode(enum RA8875scrollMode mode);
+  void setScrollWindow(int16_t XL, int16_t XR, int16_t YT, int16_t YB);
+  void scroll(int16_t x, int16_t y);
+  void BTE_move(int16_t SourceX, int16_t SourceY, int16_t Width, int16_t Height, int16_t DestX, int16_t DestY,
+                uint8_t SourceLayer = 0, uint8_t DestLayer = 0, bool = false, uint8_t = 0, bool = false, bool = false);
+  bool readStatus() { StatusRead(); return false; }
+
+  // Only for the RA8876 in Bearing.cpp, which the radio does not build
+  void useCanvas() {}
+  void putPicture_16bpp(int16_t, int16_t, int16_t, int16_t) {}
+  void startSend() {}
+  void endSend(bool = false) {}
+  bool DMAFinished() { return true; }
+  uint16_t Color565(uint8_t r, uint8_t g, uint8_t b) { return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3); }
+  void Color565ToRGB(uint16_t color, uint8_t &r, uint8_t &g, uint8_t &b)
+  {
+    r = ((color >> 11) & 0x1F) << 3;
+    g = ((color >> 5) & 0x3F) << 2;
+    b = (color & 0x1F) << 3;
+  }
+
+  // For host programs
+  void HostScreen(std::vector<uint8_t> &rgb) const;     // What the panel shows, 8 bit RGB rows top down
+  int HostSavePNG(const char *path) const;              // 0 if the file could not be written
+  const RA8875Counters &HostCounters() const { return counters; }
+  void HostResetCounters() { counters = {}; }
+  double HostBusMicros(const RA8875Counters &c) const { return c.spiBytes * 8e6 / busClock; }
+};
+
+#endif
@@ -0,0 +1,27 @@
+#ifndef HOST_ROTARY_H
+#define HOST_ROTARY_H
+
+#include "Arduino.h"
+
+#define DIR_NONE                    0x00
+#define DIR_CW                      0x10
+#define DIR_CCW                     0x20
+
+class Rotary {
+  unsigned char pin;
+  unsigned char pending;
+public:
+  Rotary(char pin1, char) : pin(pin1), pending(DIR_NONE) {}
+  void begin(bool = true, bool = false) {}
+  unsigned char process()
+  {
+    unsigned char result = pending;
+
+    digitalRead(pin);                             // Reads the pins, as the library does
+    pending = DIR_NONE;
+    return result;
+  }
+  void HostTurn(unsigned char direction) { pending = direction; }    // process() returns it once
+};
+
+#endif
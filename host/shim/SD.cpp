@@ -0,0 +1,138 @@
+/**********************************************************************************
+  Host stand-in for the Teensy SD library. See SD.h.
+**********************************************************************************/
+#include "SD.h"
+#include <string>
+#include <sys/stat.h>
+
+SDClass SD;
+static std::string hostSDDirectory;
+static int hostSDPresent = 0;
+
+void HostSDCard(const char *directory)
+{
+  hostSDPresent = directory != NULL;
+  hostSDDirectory = directory ? directory : "";
+}
+
+static std::string HostSDPath(const char *filename)
+{
+  std::string path = hostSDDirectory;
+
+  if (filename[0] != '/') {
+    path += '/';
+  }
+  return path + filename;
+}
+
+bool SDClass::begin(uint8_t)
+{
+  return hostSDPresent;
+}
+
+File SDClass::open(const char *filename, uint8_t mode)
+{
+  std::string path;
+  FILE *f;
+
+  if (!hostSDPresent) {
+    return File();
+  }
+  path = HostSDPath(filename);
+  if (mode == FILE_READ) {
+    return File(fopen(path.c_str(), "rb"));
+  }
+  f = fopen(path.c_str(), "r+b");                 // Not "a": the sketch seeks back to rewrite headers
+  if (f == NULL) {
+    f = fopen(path.c_str(), "w+b");
+  }
+  if (f != NULL && mode == FILE_WRITE) {
+    fseek(f, 0, SEEK_END);                        // SD's FILE_WRITE starts at the end
+  }
+  return f ? File(f) : File();
+}
+
+bool SDClass::exists(const char *filename)
+{
+  struct stat st;
+
+  return hostSDPresent && stat(HostSDPath(filename).c_str(), &st) == 0;
+}
+
+bool SDClass::remove(const char *filename)
+{
+  return hostSDPresent && ::remove(HostSDPath(filename).c_str()) == 0;
+}
+
+int File::read()
+{
+  return fp ? fgetc(fp.get()) : -1;
+}
+
+int File::read(void *buffer, size_t count)
+{
+  return fp ? (int)fread(buffer, 1, count, fp.get()) : -1;
+}
+
+int File::peek()
+{
+  int c;
+
+  if (!fp) {
+    return -1;
+  }
+  c = fgetc(fp.get());
+  if (c != EOF) {
+    ungetc(c, fp.get());
+  }
+  return c;
+}
+
+int File::available()
+{
+  uint64_t size = this->size();
+  uint64_t pos = position();
+
+  return pos < size ? (int)(size - pos < 0x7FFFFFFF ? size - pos : 0x7FFFFFFF) : 0;
+}
+
+size_t File::write(uint8_t b)
+{
+  return fp && fputc(b, fp.get()) != EOF ? 1 : 0;
+}
+
+size_t File::write(const uint8_t *buffer, size_t size)
+{
+  return fp ? fwrite(buffer, 1, size, fp.get()) : 0;
+}
+
+bool File::seek(uint64_t pos)
+{
+  return fp && fseek(fp.get(), (long)pos, SEEK_SET) == 0;
+}
+
+uint64_t File::position()
+{
+  return fp ? (uint64_t)ftell(fp.get()) : 0;
+}
+
+uint64_t File::size()
+{
+  long pos, end;
+
+  if (!fp) {
+    return 0;
+  }
+  pos = ftell(fp.get());
+  fseek(fp.get(), 0, SEEK_END);
+  end = ftell(fp.get());
+  fseek(fp.get(), pos, SEEK_SET);
+  return (uint64_t)end;
+}
+
+void File::flush()
+{
+  if (fp) {
+    fflush(fp.get());
+  }
+}
@@ -0,0 +1,51 @@
+/**********************************************************************************
+  Host stand-in for the Teensy SD library
+
+  The card is a directory on the host, set with HostSDCard(). Without one SD.begin() fails, as
+  it does on a radio with no card in it.
+**********************************************************************************/
+#ifndef HOST_SD_H
+#define HOST_SD_H
+
+#include "Arduino.h"
+#include <memory>
+
+#define FILE_READ                   0
+#define FILE_WRITE                  1
+#define O_READ                      0
+#define O_RDWR                      2
+#define O_WRITE                     2
+#define O_CREAT                     0x40
+
+class File : public Print {
+  std::shared_ptr<FILE> fp;                       // Copies share the file, as SdFat handles do
+public:
+  File() {}
+  File(FILE *f) : fp(f, fclose) {}
+  operator bool() const { return fp != nullptr; }
+  int read();
+  int read(void *buffer, size_t count);
+  int peek();
+  int available();
+  size_t write(uint8_t b) override;
+  size_t write(const uint8_t *buffer, size_t size) override;
+  size_t write(const void *buffer, size_t size) { return write((const uint8_t *)buffer, size); }
+  using Print::write;
+  bool seek(uint64_t pos);
+  uint64_t position();
+  uint64_t size();
+  void flush();
+  void close() { fp.reset(); }
+};
+
+class SDClass {
+public:
+  bool begin(uint8_t csPin = BUILTIN_SDCARD);
+  File open(const char *filename, uint8_t mode = FILE_READ);
+  bool exists(const char *filename);
+  bool remove(const char *filename);
+};
+extern SDClass SD;
+void HostSDCard(const char *directory);           // NULL for no card
+
+#endif
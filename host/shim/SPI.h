@@ -0,0 +1,28 @@
+#ifndef HOST_SPI_H
+#define HOST_SPI_H
+
+#include "Arduino.h"
+
+class SPISettings {
+public:
+  SPISettings() {}
+  SPISettings(uint32_t, uint8_t, uint8_t) {}
+};
+
+class SPIClass {
+public:
+  void begin() {}
+  void beginTransaction(SPISettings) {}
+  void endTransaction() {}
+  uint8_t transfer(uint8_t) { return 0; }
+  void transfer(const void *, void *retbuf, size_t count) { if (retbuf) memset(retbuf, 0, count); }
+};
+extern SPIClass SPI;
+
+#define SPI_MODE0                   0
+#define SPI_MODE1                   1
+#define SPI_MODE2                   2
+#define SPI_MODE3                   3
+#define MSBFIRST                    1
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef HOST_TIMELIB_H
+#define HOST_TIMELIB_H
+
+#include "Arduino.h"
+#include <time.h>
+
+typedef time_t (*getExternalTime)();
+
+void setSyncProvider(getExternalTime getTimeFunction);
+void setTime(time_t t);
+time_t now();
+int hour();
+int hourFormat12();
+int minute();
+int second();
+int day();
+int month();
+int year();
+int weekday();
+
+class teensy3_clock_class {
+public:
+  static unsigned long get();
+  static void set(unsigned long t);
+};
+extern teensy3_clock_class Teensy3Clock;
+
+#endif
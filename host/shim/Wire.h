@@ -0,0 +1,20 @@
+#ifndef HOST_WIRE_H
+#define HOST_WIRE_H
+
+#include "Arduino.h"
+
+class TwoWire {
+public:
+  void begin() {}
+  void setClock(uint32_t) {}
+  void beginTransmission(uint8_t) {}
+  uint8_t endTransmission(bool = true) { return 0; }
+  size_t write(uint8_t) { return 1; }
+  size_t write(const uint8_t *, size_t size) { return size; }
+  uint8_t requestFrom(uint8_t, uint8_t) { return 0; }
+  int available() { return 0; }
+  int read() { return -1; }
+};
+extern TwoWire Wire;
+
+#endif
@@ -0,0 +1,493 @@
+/**********************************************************************************
+  Host CMSIS-DSP functions, see arm_math.h
+**********************************************************************************/
+#include <math.h>
+#include <string.h>
+#include <vector>
+#include "arm_math.h"
+#include "arm_const_structs.h"
+
+const arm_cfft_instance_f32 arm_cfft_sR_f32_len16 = { 16, NULL, NULL, 0 };
+const arm_cfft_instance_f32 arm_cfft_sR_f32_len32 = { 32, NULL, NULL, 0 };
+const arm_cfft_instance_f32 arm_cfft_sR_f32_len64 = { 64, NULL, NULL, 0 };
+const arm_cfft_instance_f32 arm_cfft_sR_f32_len128 = { 128, NULL, NULL, 0 };
+const arm_cfft_instance_f32 arm_cfft_sR_f32_len256 = { 256, NULL, NULL, 0 };
+const arm_cfft_instance_f32 arm_cfft_sR_f32_len512 = { 512, NULL, NULL, 0 };
+const arm_cfft_instance_f32 arm_cfft_sR_f32_len1024 = { 1024, NULL, NULL, 0 };
+const arm_cfft_instance_f32 arm_cfft_sR_f32_len2048 = { 2048, NULL, NULL, 0 };
+const arm_cfft_instance_f32 arm_cfft_sR_f32_len4096 = { 4096, NULL, NULL, 0 };
+
+/*****
+  Purpose: exp(-j 2 pi k / n) for k < n / 2, computed once per length in double precision
+
+  Parameter list:
+    uint32_t n              power of two, at most 2^16
+
+  Return value;
+    const double *          n complex values, interleaved
+*****/
+static const double *HostTwiddles(uint32_t n)
+{
+  static std::vector<double> tables[17];
+  int bits = 0;
+
+  while ((1UL << bits) < n) {
+    bits++;
+  }
+  std::vector<double> &t = tables[bits];
+  if (t.empty()) {
+    t.resize(n);
+    for (uint32_t k = 0; k < n / 2; k++) {
+      t[2 * k] = cos(2.0 * M_PI * k / n);
+      t[2 * k + 1] = -sin(2.0 * M_PI * k / n);
+    }
+  }
+  return t.data();
+}
+
+void arm_cfft_f32(const arm_cfft_instance_f32 *S, float32_t *p1, uint8_t ifftFlag, uint8_t bitReverseFlag)
+{
+  uint32_t n = S->fftLen;
+  const double *w = HostTwiddles(n);
+  std::vector<double> x(2 * n);
+  double sign = ifftFlag ? -1.0 : 1.0;
+
+  for (uint32_t i = 0; i < 2 * n; i++) {
+    x[i] = p1[i];
+  }
+  for (uint32_t i = 1, j = 0; i < n; i++) {       // Bit reversed order in, natural order out
+    uint32_t bit = n >> 1;
+    for (; j & bit; bit >>= 1) {
+      j ^= bit;
+    }
+    j ^= bit;
+    if (i < j) {
+      std::swap(x[2 * i], x[2 * j]);
+      std::swap(x[2 * i + 1], x[2 * j + 1]);
+    }
+  }
+  for (uint32_t len = 2; len <= n; len <<= 1) {
+    uint32_t step = n / len;
+    for (uint32_t i = 0; i < n; i += len) {
+      for (uint32_t k = 0; k < len / 2; k++) {
+        double wr = w[2 * k * step];
+        double wi = sign * w[2 * k * step + 1];
+        double *a = &x[2 * (i + k)];
+        double *b = &x[2 * (i + k + len / 2)];
+        double tr = b[0] * wr - b[1] * wi;
+        double ti = b[0] * wi + b[1] * wr;
+        b[0] = a[0] - tr;
+        b[1] = a[1] - ti;
+        a[0] += tr;
+        a[1] += ti;
+      }
+    }
+  }
+  double scale = ifftFlag ? 1.0 / n : 1.0;
+  for (uint32_t i = 0; i < n; i++) {
+    uint32_t k = i;
+    if (bitReverseFlag == 0) {                    // CMSIS leaves the output in bit reversed order
+      k = 0;
+      for (uint32_t b = 1, r = n >> 1; b < n; b <<= 1, r >>= 1) {
+        if (i & b) {
+          k |= r;
+        }
+      }
+    }
+    p1[2 * i] = x[2 * k] * scale;
+    p1[2 * i + 1] = x[2 * k + 1] * scale;
+  }
+}
+
+void arm_fir_init_f32(arm_fir_instance_f32 *S, uint16_t numTaps, const float32_t *pCoeffs, float32_t *pState, uint32_t blockSize)
+{
+  S->numTaps = numTaps;
+  S->pCoeffs = pCoeffs;
+  S->pState = pState;
+  memset(pState, 0, (numTaps + blockSize - 1) * sizeof(float32_t));
+}
+
+void arm_fir_f32(const arm_fir_instance_f32 *S, const float32_t *pSrc, float32_t *pDst, uint32_t blockSize)
+{
+  uint32_t taps = S->numTaps;
+  float32_t *state = S->pState;                   // numTaps - 1 old samples, then the block
+
+  memcpy(&state[taps - 1], pSrc, blockSize * sizeof(float32_t));
+  for (uint32_t n = 0; n < blockSize; n++) {
+    float32_t acc = 0.0f;
+    for (uint32_t k = 0; k < taps; k++) {
+      acc += state[n + k] * S->pCoeffs[k];
+    }
+    pDst[n] = acc;
+  }
+  memmove(state, &state[blockSize], (taps - 1) * sizeof(float32_t));
+}
+
+arm_status arm_fir_decimate_init_f32(arm_fir_decimate_instance_f32 *S, uint16_t numTaps, uint8_t M, const float32_t *pCoeffs, float32_t *pState, uint32_t blockSize)
+{
+  if (M == 0 || blockSize % M != 0) {
+    return ARM_MATH_LENGTH_ERROR;
+  }
+  S->M = M;
+  S->numTaps = numTaps;
+  S->pCoeffs = pCoeffs;
+  S->pState = pState;
+  memset(pState, 0, (numTaps + blockSize - 1) * sizeof(float32_t));
+  return ARM_MATH_SUCCESS;
+}
+
+void arm_fir_decimate_f32(const arm_fir_decimate_instance_f32 *S, const float32_t *pSrc, float32_t *pDst, uint32_t blockSize)
+{
+  uint32_t taps = S->numTaps;
+  uint32_t M = S->M;
+  float32_t *state = S->pState;
+
+  memcpy(&state[taps - 1], pSrc, blockSize * sizeof(float32_t));
+  for (uint32_t j = 0; j < blockSize / M; j++) {  // As CMSIS, each output ends at the first of its M new samples
+    float32_t acc = 0.0f;
+    for (uint32_t k = 0; k < taps; k++) {
+      acc += state[j * M + k] * S->pCoeffs[k];
+    }
+    pDst[j] = acc;
+  }
+  memmove(state, &state[blockSize], (taps - 1) * sizeof(float32_t));
+}
+
+void arm_biquad_cascade_df1_init_f32(arm_biquad_casd_df1_inst_f32 *S, uint8_t numStages, const float32_t *pCoeffs, float32_t *pState)
+{
+  S->numStages = numStages;
+  S->pCoeffs = pCoeffs;
+  S->pState = pState;
+  memset(pState, 0, 4 * numStages * sizeof(float32_t));
+}
+
+void arm_biquad_cascade_df1_f32(const arm_biquad_casd_df1_inst_f32 *S, const float32_t *pSrc, float32_t *pDst, uint32_t blockSize)
+{
+  const float32_t *in = pSrc;
+
+  for (uint32_t stage = 0; stage < S->numStages; stage++) {
+    const float32_t *c = &S->pCoeffs[5 * stage];  // b0 b1 b2 a1 a2, y = b.x + a1 y1 + a2 y2
+    float32_t *st = &S->pState[4 * stage];        // x1 x2 y1 y2
+    for (uint32_t n = 0; n < blockSize; n++) {
+      float32_t x = in[n];
+      float32_t y = c[0] * x + c[1] * st[0] + c[2] * st[1] + c[3] * st[2] + c[4] * st[3];
+      st[1] = st[0];
+      st[0] = x;
+      st[3] = st[2];
+      st[2] = y;
+      pDst[n] = y;
+    }
+    in = pDst;
+  }
+}
+
+void arm_biquad_cascade_df2T_init_f32(arm_biquad_cascade_df2T_instance_f32 *S, uint8_t numStages, const float32_t *pCoeffs, float32_t *pState)
+{
+  S->numStages = numStages;
+  S->pCoeffs = pCoeffs;
+  S->pState = pState;
+  memset(pState, 0, 2 * numStages * sizeof(float32_t));
+}
+
+void arm_biquad_cascade_df2T_f32(const arm_biquad_cascade_df2T_instance_f32 *S, const float32_t *pSrc, float32_t *pDst, uint32_t blockSize)
+{
+  const float32_t *in = pSrc;
+
+  for (uint32_t stage = 0; stage < S->numStages; stage++) {
+    const float32_t *c = &S->pCoeffs[5 * stage];
+    float32_t *d = &S->pState[2 * stage];
+    for (uint32_t n = 0; n < blockSize; n++) {
+      float32_t x = in[n];
+      float32_t y = c[0] * x + d[0];
+      d[0] = c[1] * x + c[3] * y + d[1];
+      d[1] = c[2] * x + c[4] * y;
+      pDst[n] = y;
+    }
+    in = pDst;
+  }
+}
+
+void arm_lms_init_f32(arm_lms_instance_f32 *S, uint16_t numTaps, float32_t *pCoeffs, float32_t *pState, float32_t mu, uint32_t blockSize)
+{
+  S->numTaps = numTaps;
+  S->pCoeffs = pCoeffs;
+  S->pState = pState;
+  S->mu = mu;
+  memset(pState, 0, (numTaps + blockSize - 1) * sizeof(float32_t));
+}
+
+void arm_lms_f32(const arm_lms_instance_f32 *S, const float32_t *pSrc, float32_t *pRef, float32_t *pOut, float32_t *pErr, uint32_t blockSize)
+{
+  uint32_t taps = S->numTaps;
+  float32_t *state = S->pState;
+
+  for (uint32_t n = 0; n < blockSize; n++) {
+    state[taps - 1 + n] = pSrc[n];
+    float32_t acc = 0.0f;
+    for (uint32_t k = 0; k < taps; k++) {
+      acc += state[n + k] * S->pCoeffs[k];
+    }
+    pOut[n] = acc;
+    float32_t e = pRef[n] - acc;
+    pErr[n] = e;
+    for (uint32_t k = 0; k < taps; k++) {
+      S->pCoeffs[k] += S->mu * e * state[n + k];
+    }
+  }
+  memmove(state, &state[blockSize], (taps - 1) * sizeof(float32_t));
+}
+
+void arm_lms_norm_init_f32(arm_lms_norm_instance_f32 *S, uint16_t numTaps, float32_t *pCoeffs, float32_t *pState, float32_t mu, uint32_t blockSize)
+{
+  S->numTaps = numTaps;
+  S->pCoeffs = pCoeffs;
+  S->pState = pState;
+  S->mu = mu;
+  S->recipTable = NULL;
+  S->energy = 0.0f;
+  S->x0 = 0.0f;
+  memset(pState, 0, (numTaps + blockSize - 1) * sizeof(float32_t));
+}
+
+void arm_lms_norm_f32(arm_lms_norm_instance_f32 *S, const float32_t *pSrc, float32_t *pRef, float32_t *pOut, float32_t *pErr, uint32_t blockSize)
+{
+  uint32_t taps = S->numTaps;
+  float32_t *state = S->pState;
+  float32_t energy = S->energy;
+  float32_t x0 = S->x0;
+
+  for (uint32_t n = 0; n < blockSize; n++) {
+    float32_t in = pSrc[n];
+    state[taps - 1 + n] = in;
+    energy -= x0 * x0;
+    energy += in * in;
+    float32_t acc = 0.0f;
+    for (uint32_t k = 0; k < taps; k++) {
+      acc += state[n + k] * S->pCoeffs[k];
+    }
+    pOut[n] = acc;
+    float32_t e = pRef[n] - acc;
+    pErr[n] = e;
+    float32_t w = e * S->mu / (energy + 0.000000119209289f);
+    for (uint32_t k = 0; k < taps; k++) {
+      S->pCoeffs[k] += w * state[n + k];
+    }
+    x0 = state[n];
+  }
+  S->energy = energy;
+  S->x0 = x0;
+  memmove(state, &state[blockSize], (taps - 1) * sizeof(float32_t));
+}
+
+void arm_correlate_f32(const float32_t *pSrcA, uint32_t srcALen, const float32_t *pSrcB, uint32_t srcBLen, float32_t *pDst)
+{
+  uint32_t outLen = 2 * (srcALen > srcBLen ? srcALen : srcBLen) - 1;
+  uint32_t offset = srcALen >= srcBLen ? srcALen - srcBLen : 0;
+
+  memset(pDst, 0, outLen * sizeof(float32_t));
+  for (uint32_t t = 0; t < srcALen + srcBLen - 1; t++) {      // Lag t - (srcBLen - 1)
+    int32_t lag = (int32_t)t - (int32_t)(srcBLen - 1);
+    float32_t acc = 0.0f;
+    for (int32_t n = 0; n < (int32_t)srcBLen; n++) {
+      int32_t a = n + lag;
+      if (a >= 0 && a < (int32_t)srcALen) {
+        acc += pSrcA[a] * pSrcB[n];
+      }
+    }
+    pDst[offset + t] = acc;
+  }
+}
+
+void arm_cmplx_mult_cmplx_f32(const float32_t *pSrcA, const float32_t *pSrcB, float32_t *pDst, uint32_t numSamples)
+{
+  for (uint32_t i = 0; i < numSamples; i++) {
+    float32_t ar = pSrcA[2 * i], ai = pSrcA[2 * i + 1];
+    float32_t br = pSrcB[2 * i], bi = pSrcB[2 * i + 1];
+    pDst[2 * i] = ar * br - ai * bi;
+    pDst[2 * i + 1] = ar * bi + ai * br;
+  }
+}
+
+void arm_cmplx_mult_real_f32(const float32_t *pSrcCmplx, const float32_t *pSrcReal, float32_t *pCmplxDst, uint32_t numSamples)
+{
+  for (uint32_t i = 0; i < numSamples; i++) {
+    pCmplxDst[2 * i] = pSrcCmplx[2 * i] * pSrcReal[i];
+    pCmplxDst[2 * i + 1] = pSrcCmplx[2 * i + 1] * pSrcReal[i];
+  }
+}
+
+void arm_cmplx_mag_f32(const float32_t *pSrc, float32_t *pDst, uint32_t numSamples)
+{
+  for (uint32_t i = 0; i < numSamples; i++) {
+    pDst[i] = sqrtf(pSrc[2 * i] * pSrc[2 * i] + pSrc[2 * i + 1] * pSrc[2 * i + 1]);
+  }
+}
+
+void arm_cmplx_mag_squared_f32(const float32_t *pSrc, float32_t *pDst, uint32_t numSamples)
+{
+  for (uint32_t i = 0; i < numSamples; i++) {
+    pDst[i] = pSrc[2 * i] * pSrc[2 * i] + pSrc[2 * i + 1] * pSrc[2 * i + 1];
+  }
+}
+
+void arm_add_f32(const float32_t *pSrcA, const float32_t *pSrcB, float32_t *pDst, uint32_t blockSize)
+{
+  for (uint32_t i = 0; i < blockSize; i++) {
+    pDst[i] = pSrcA[i] + pSrcB[i];
+  }
+}
+
+void arm_sub_f32(const float32_t *pSrcA, const float32_t *pSrcB, float32_t *pDst, uint32_t blockSize)
+{
+  for (uint32_t i = 0; i < blockSize; i++) {
+    pDst[i] = pSrcA[i] - pSrcB[i];
+  }
+}
+
+void arm_mult_f32(const float32_t *pSrcA, const float32_t *pSrcB, float32_t *pDst, uint32_t blockSize)
+{
+  for (uint32_t i = 0; i < blockSize; i++) {
+    pDst[i] = pSrcA[i] * pSrcB[i];
+  }
+}
+
+void arm_scale_f32(const float32_t *pSrc, float32_t scale, float32_t *pDst, uint32_t blockSize)
+{
+  for (uint32_t i = 0; i < blockSize; i++) {
+    pDst[i] = pSrc[i] * scale;
+  }
+}
+
+void arm_offset_f32(const float32_t *pSrc, float32_t offset, float32_t *pDst, uint32_t blockSize)
+{
+  for (uint32_t i = 0; i < blockSize; i++) {
+    pDst[i] = pSrc[i] + offset;
+  }
+}
+
+void arm_negate_f32(const float32_t *pSrc, float32_t *pDst, uint32_t blockSize)
+{
+  for (uint32_t i = 0; i < blockSize; i++) {
+    pDst[i] = -pSrc[i];
+  }
+}
+
+void arm_abs_f32(const float32_t *pSrc, float32_t *pDst, uint32_t blockSize)
+{
+  for (uint32_t i = 0; i < blockSize; i++) {
+    pDst[i] = fabsf(pSrc[i]);
+  }
+}
+
+void arm_copy_f32(const float32_t *pSrc, float32_t *pDst, uint32_t blockSize)
+{
+  memmove(pDst, pSrc, blockSize * sizeof(float32_t));
+}
+
+void arm_fill_f32(float32_t value, float32_t *pDst, uint32_t blockSize)
+{
+  for (uint32_t i = 0; i < blockSize; i++) {
+    pDst[i] = value;
+  }
+}
+
+void arm_dot_prod_f32(const float32_t *pSrcA, const float32_t *pSrcB, uint32_t blockSize, float32_t *result)
+{
+  float32_t acc = 0.0f;
+
+  for (uint32_t i = 0; i < blockSize; i++) {
+    acc += pSrcA[i] * pSrcB[i];
+  }
+  *result = acc;
+}
+
+void arm_power_f32(const float32_t *pSrc, uint32_t blockSize, float32_t *pResult)
+{
+  arm_dot_prod_f32(pSrc, pSrc, blockSize, pResult);
+}
+
+void arm_mean_f32(const float32_t *pSrc, uint32_t blockSize, float32_t *pResult)
+{
+  float32_t sum = 0.0f;
+
+  for (uint32_t i = 0; i < blockSize; i++) {
+    sum += pSrc[i];
+  }
+  *pResult = sum / (float32_t)blockSize;
+}
+
+void arm_var_f32(const float32_t *pSrc, uint32_t blockSize, float32_t *pResult)
+{
+  float32_t mean, sum = 0.0f;
+
+  if (blockSize <= 1) {
+    *pResult = 0.0f;
+    return;
+  }
+  arm_mean_f32(pSrc, blockSize, &mean);
+  for (uint32_t i = 0; i < blockSize; i++) {
+    sum += (pSrc[i] - mean) * (pSrc[i] - mean);
+  }
+  *pResult = sum / (float32_t)(blockSize - 1);
+}
+
+void arm_max_f32(const float32_t *pSrc, uint32_t blockSize, float32_t *pResult, uint32_t *pIndex)
+{
+  uint32_t index = 0;
+
+  for (uint32_t i = 1; i < blockSize; i++) {
+    if (pSrc[i] > pSrc[index]) {
+      index = i;
+    }
+  }
+  *pResult = pSrc[index];
+  *pIndex = index;
+}
+
+void arm_min_f32(const float32_t *pSrc, uint32_t blockSize, float32_t *pResult, uint32_t *pIndex)
+{
+  uint32_t index = 0;
+
+  for (uint32_t i = 1; i < blockSize; i++) {
+    if (pSrc[i] < pSrc[index]) {
+      index = i;
+    }
+  }
+  *pResult = pSrc[index];
+  *pIndex = index;
+}
+
+void arm_q15_to_float(const q15_t *pSrc, float32_t *pDst, uint32_t blockSize)
+{
+  for (uint32_t i = 0; i < blockSize; i++) {
+    pDst[i] = (float32_t)pSrc[i] / 32768.0f;
+  }
+}
+
+void arm_float_to_q15(const float32_t *pSrc, q15_t *pDst, uint32_t blockSize)
+{
+  for (uint32_t i = 0; i < blockSize; i++) {
+    q31_t v = (q31_t)(pSrc[i] * 32768.0f);        // Truncated, as without ARM_MATH_ROUNDING
+    pDst[i] = (q15_t)(v > 32767 ? 32767 : (v < -32768 ? -32768 : v));
+  }
+}
+
+float32_t arm_sin_f32(float32_t x)
+{
+  return sinf(x);
+}
+
+float32_t arm_cos_f32(float32_t x)
+{
+  return cosf(x);
+}
+
+arm_status arm_sqrt_f32(float32_t in, float32_t *pOut)
+{
+  if (in < 0.0f) {
+    *pOut = 0.0f;
+    return ARM_MATH_ARGUMENT_ERROR;
+  }
+  *pOut = sqrtf(in);
+  return ARM_MATH_SUCCESS;
+}
@@ -0,0 +1,140 @@
+/**********************************************************************************
+  Host stand-in for CMSIS-DSP
+
+  The CMSIS-DSP functions and instance structures the sketch uses, with the same arguments,
+  layouts and conventions: FIR coefficients in time-reversed order, biquad feedback
+  coefficients with the sign CMSIS uses, and an inverse arm_cfft_f32() scaled by 1/N. They are
+  plain reference loops, written to be checked against, not to be fast.
+**********************************************************************************/
+#ifndef HOST_ARM_MATH_H
+#define HOST_ARM_MATH_H
+
+#include <stdint.h>
+
+typedef float float32_t;
+typedef double float64_t;
+typedef int8_t q7_t;
+typedef int16_t q15_t;
+typedef int32_t q31_t;
+typedef int64_t q63_t;
+
+typedef enum {
+  ARM_MATH_SUCCESS = 0,
+  ARM_MATH_ARGUMENT_ERROR = -1,
+  ARM_MATH_LENGTH_ERROR = -2,
+  ARM_MATH_SIZE_MISMATCH = -3,
+  ARM_MATH_NANINF = -4,
+  ARM_MATH_SINGULAR = -5,
+  ARM_MATH_TEST_FAILURE = -6
+} arm_status;
+
+#ifndef PI
+#define PI                          3.14159265358979f
+#endif
+
+// CMSIS core: signed saturation to a bits wide value
+static inline int32_t __SSAT(int32_t value, uint32_t bits)
+{
+  const int32_t high = (1 << (bits - 1)) - 1;
+  const int32_t low = -high - 1;
+
+  return value > high ? high : (value < low ? low : value);
+}
+
+typedef struct {
+  uint16_t fftLen;
+  const float32_t *pTwiddle;
+  const uint16_t *pBitRevTable;
+  uint16_t bitRevLength;
+} arm_cfft_instance_f32;
+
+typedef struct {
+  uint16_t numTaps;
+  float32_t *pState;
+  const float32_t *pCoeffs;
+} arm_fir_instance_f32;
+
+typedef struct {
+  uint8_t M;
+  uint16_t numTaps;
+  const float32_t *pCoeffs;
+  float32_t *pState;
+} arm_fir_decimate_instance_f32;
+
+typedef struct {
+  uint32_t numStages;
+  float32_t *pState;
+  const float32_t *pCoeffs;
+} arm_biquad_casd_df1_inst_f32;
+
+typedef struct {
+  uint8_t numStages;
+  float32_t *pState;
+  const float32_t *pCoeffs;
+} arm_biquad_cascade_df2T_instance_f32;
+
+typedef struct {
+  uint16_t numTaps;
+  float32_t *pState;
+  float32_t *pCoeffs;
+  float32_t mu;
+} arm_lms_instance_f32;
+
+typedef struct {
+  uint16_t numTaps;
+  float32_t *pState;
+  float32_t *pCoeffs;
+  float32_t mu;
+  const float32_t *recipTable;
+  float32_t energy;
+  float32_t x0;
+} arm_lms_norm_instance_f32;
+
+void arm_cfft_f32(const arm_cfft_instance_f32 *S, float32_t *p1, uint8_t ifftFlag, uint8_t bitReverseFlag);
+
+void arm_fir_init_f32(arm_fir_instance_f32 *S, uint16_t numTaps, const float32_t *pCoeffs, float32_t *pState, uint32_t blockSize);
+void arm_fir_f32(const arm_fir_instance_f32 *S, const float32_t *pSrc, float32_t *pDst, uint32_t blockSize);
+arm_status arm_fir_decimate_init_f32(arm_fir_decimate_instance_f32 *S, uint16_t numTaps, uint8_t M, const float32_t *pCoeffs, float32_t *pState, uint32_t blockSize);
+void arm_fir_decimate_f32(const arm_fir_decimate_instance_f32 *S, const float32_t *pSrc, float32_t *pDst, uint32_t blockSize);
+
+void arm_biquad_cascade_df1_init_f32(arm_biquad_casd_df1_inst_f32 *S, uint8_t numStages, const float32_t *pCoeffs, float32_t *pState);
+void arm_biquad_cascade_df1_f32(const arm_biquad_casd_df1_inst_f32 *S, const float32_t *pSrc, float32_t *pDst, uint32_t blockSize);
+void arm_biquad_cascade_df2T_init_f32(arm_biquad_cascade_df2T_instance_f32 *S, uint8_t numStages, const float32_t *pCoeffs, float32_t *pState);
+void arm_biquad_cascade_df2T_f32(const arm_biquad_cascade_df2T_instance_f32 *S, const float32_t *pSrc, float32_t *pDst, uint32_t blockSize);
+
+void arm_lms_init_f32(arm_lms_instance_f32 *S, uint16_t numTaps, float32_t *pCoeffs, float32_t *pState, float32_t mu, uint32_t blockSize);
+void arm_lms_f32(const arm_lms_instance_f32 *S, const float32_t *pSrc, float32_t *pRef, float32_t *pOut, float32_t *pErr, uint32_t blockSize);
+void arm_lms_norm_init_f32(arm_lms_norm_instance_f32 *S, uint16_t numTaps, float32_t *pCoeffs, float32_t *pState, float32_t mu, uint32_t blockSize);
+void arm_lms_norm_f32(arm_lms_norm_instance_f32 *S, const float32_t *pSrc, float32_t *pRef, float32_t *pOut, float32_t *pErr, uint32_t blockSize);
+
+void arm_correlate_f32(const float32_t *pSrcA, uint32_t srcALen, const float32_t *pSrcB, uint32_t srcBLen, float32_t *pDst);
+
+void arm_cmplx_mult_cmplx_f32(const float32_t *pSrcA, const float32_t *pSrcB, float32_t *pDst, uint32_t numSamples);
+void arm_cmplx_mult_real_f32(const float32_t *pSrcCmplx, const float32_t *pSrcReal, float32_t *pCmplxDst, uint32_t numSamples);
+void arm_cmplx_mag_f32(const float32_t *pSrc, float32_t *pDst, uint32_t numSamples);
+void arm_cmplx_mag_squared_f32(const float32_t *pSrc, float32_t *pDst, uint32_t numSamples);
+
+void arm_add_f32(const float32_t *pSrcA, const float32_t *pSrcB, float32_t *pDst, uint32_t blockSize);
+void arm_sub_f32(const float32_t *pSrcA, const float32_t *pSrcB, float32_t *pDst, uint32_t blockSize);
+void arm_mult_f32(const float32_t *pSrcA, const float32_t *pSrcB, float32_t *pDst, uint32_t blockSize);
+void arm_scale_f32(const float32_t *pSrc, float32_t scale, float32_t *pDst, uint32_t blockSize);
+void arm_offset_f32(const float32_t *pSrc, float32_t offset, float32_t *pDst, uint32_t blockSize);
+void arm_negate_f32(const float32_t *pSrc, float32_t *pDst, uint32_t blockSize);
+void arm_abs_f32(const float32_t *pSrc, float32_t *pDst, uint32_t blockSize);
+void arm_copy_f32(const float32_t *pSrc, float32_t *pDst, uint32_t blockSize);
+void arm_fill_f32(float32_t value, float32_t *pDst, uint32_t blockSize);
+void arm_dot_prod_f32(const float32_t *pSrcA, const float32_t *pSrcB, uint32_t blockSize, float32_t *result);
+void arm_power_f32(const float32_t *pSrc, uint32_t blockSize, float32_t *pResult);
+void arm_mean_f32(const float32_t *pSrc, uint32_t blockSize, float32_t *pResult);
+void arm_var_f32(const float32_t *pSrc, uint32_t blockSize, float32_t *pResult);
+void arm_max_f32(const float32_t *pSrc, uint32_t blockSize, float32_t *pResult, uint32_t *pIndex);
+void arm_min_f32(const float32_t *pSrc, uint32_t blockSize, float32_t *pResult, uint32_t *pIndex);
+
+void arm_q15_to_float(const q15_t *pSrc, float32_t *pDst, uint32_t blockSize);
+void arm_float_to_q15(const float32_t *pSrc, q15_t *pDst, uint32_t blockSize);
+
+float32_t arm_sin_f32(float32_t x);
+float32_t arm_cos_f32(float32_t x);
+arm_status arm_sqrt_f32(float32_t in, float32_t *pOut);
+
+#endif
@@ -0,0 +1,24 @@
+#ifndef HOST_SI5351_H
+#define HOST_SI5351_H
+
+#include "Arduino.h"
+
+#define SI5351_FREQ_MULT            100ULL
+#define SI5351_CRYSTAL_LOAD_6PF     (1 << 6)
+#define SI5351_CRYSTAL_LOAD_8PF     (2 << 6)
+#define SI5351_CRYSTAL_LOAD_10PF    (3 << 6)
+
+enum si5351_clock { SI5351_CLK0, SI5351_CLK1, SI5351_CLK2, SI5351_CLK3, SI5351_CLK4, SI5351_CLK5, SI5351_CLK6, SI5351_CLK7 };
+enum si5351_drive { SI5351_DRIVE_2MA, SI5351_DRIVE_4MA, SI5351_DRIVE_6MA, SI5351_DRIVE_8MA };
+
+class Si5351 {
+public:
+  uint64_t freq[8] = { 0 };
+  bool init(uint8_t, uint32_t, int32_t) { return true; }
+  uint8_t set_freq(uint64_t f, enum si5351_clock clk) { freq[clk] = f; return 0; }
+  void drive_strength(enum si5351_clock, enum si5351_drive) {}
+  void output_enable(enum si5351_clock, uint8_t) {}
+  void set_correction(int32_t, uint8_t) {}
+};
+
+#endif
@@ -0,0 +1,8 @@
+#ifndef HOST_IMXRT_HW_H
+#define HOST_IMXRT_HW_H
+
+#include <stdint.h>
+
+void set_audioClock(int nfact, int32_t nmult, uint32_t ndiv, bool force = false);
+
+#endif